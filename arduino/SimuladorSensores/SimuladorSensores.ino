@@ -11,8 +11,18 @@
  * Ejemplos:
  * - TEMP:T-001:23.5
  * - PRES:P-105:85
+ * - VIB:V-001:12,-40,388,...  (bloque de MUESTRAS_VIBRACION conteos)
+ *
+ * Con MODO_BINARIO = 1 se envían tramas binarias compactas (ver
+ * include/ProtocoloBinario.h): SYNC 0xA5, N, SECUENCIA (2), N lecturas de
+ * TIPO (1) + ID (2) + VALOR (4) y CRC-16/CCITT (2). Las lecturas se agrupan
+ * en lotes de LECTURAS_POR_TRAMA y cada trama se envía con un solo
+ * Serial.write.
  */
 
+// Formato de salida: 0 = texto TIPO:ID:VALOR, 1 = tramas binarias
+#define MODO_BINARIO 0
+
 // Intervalo de envío de datos (milisegundos)
 const unsigned long INTERVALO_ENVIO = 2000;
 
@@ -22,6 +32,96 @@ unsigned long tiempoAnterior = 0;
 // Contadores para IDs de sensores
 int contadorTemp = 1;
 int contadorPres = 1;
+int contadorVib = 1;
+
+// Vibración: bloque de muestras por envío y fase de la senoidal simulada
+const int MUESTRAS_VIBRACION = 32;
+int faseVibracion = 0;
+
+// --- Protocolo binario ---
+const uint8_t SYNC_TRAMA = 0xA5;
+const uint8_t TRAMA_TEMP = 1;
+const uint8_t TRAMA_PRES = 2;
+const uint8_t TRAMA_VIB = 3;
+const int LECTURAS_POR_TRAMA = 8;
+const int TAM_LECTURA_TRAMA = 7;
+
+uint8_t trama[4 + LECTURAS_POR_TRAMA * TAM_LECTURA_TRAMA + 2]; // Buffer de la trama en curso
+int lecturasEnTrama = 0;                                        // Lecturas acumuladas
+uint16_t secuenciaTrama = 0;                                    // Secuencia de la siguiente trama
+unsigned long tiempoInicioTrama = 0;                            // millis() de la primera lectura del lote
+const unsigned long MAX_ESPERA_TRAMA = 250;                     // Espera máxima antes de enviar un lote parcial
+
+/**
+ * @brief CRC-16/CCITT-FALSE (polinomio 0x1021, inicial 0xFFFF)
+ */
+uint16_t calcularCRC16(const uint8_t *datos, int longitud)
+{
+    uint16_t crc = 0xFFFF;
+    for (int i = 0; i < longitud; i++)
+    {
+        crc ^= (uint16_t)datos[i] << 8;
+        for (int bit = 0; bit < 8; bit++)
+        {
+            crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : (crc << 1);
+        }
+    }
+    return crc;
+}
+
+/**
+ * @brief Cierra la trama en curso (cabecera + CRC) y la envía en un solo write
+ */
+void enviarTrama()
+{
+    if (lecturasEnTrama == 0)
+    {
+        return;
+    }
+
+    trama[0] = SYNC_TRAMA;
+    trama[1] = lecturasEnTrama;
+    trama[2] = secuenciaTrama & 0xFF;
+    trama[3] = secuenciaTrama >> 8;
+
+    int longitud = 4 + lecturasEnTrama * TAM_LECTURA_TRAMA;
+    uint16_t crc = calcularCRC16(trama + 1, longitud - 1);
+    trama[longitud++] = crc & 0xFF;
+    trama[longitud++] = crc >> 8;
+
+    Serial.write(trama, longitud);
+
+    secuenciaTrama++;
+    lecturasEnTrama = 0;
+}
+
+/**
+ * @brief Agrega una lectura a la trama en curso y la envía si está llena
+ * @param tipo Código de tipo (TRAMA_TEMP, TRAMA_PRES)
+ * @param id Parte numérica del ID del sensor
+ * @param valor Valor de ancho fijo (décimas de °C o PSI)
+ */
+void agregarLecturaBinaria(uint8_t tipo, uint16_t id, int32_t valor)
+{
+    if (lecturasEnTrama == 0)
+    {
+        tiempoInicioTrama = millis();
+    }
+
+    uint8_t *p = trama + 4 + lecturasEnTrama * TAM_LECTURA_TRAMA;
+    p[0] = tipo;
+    p[1] = id & 0xFF;
+    p[2] = id >> 8;
+    p[3] = valor & 0xFF;
+    p[4] = (valor >> 8) & 0xFF;
+    p[5] = (valor >> 16) & 0xFF;
+    p[6] = (valor >> 24) & 0xFF;
+
+    if (++lecturasEnTrama == LECTURAS_POR_TRAMA)
+    {
+        enviarTrama();
+    }
+}
 
 /**
  * @brief Configuración inicial del ESP32
@@ -34,11 +134,13 @@ void setup()
     // Inicializar generador de números aleatorios
     randomSeed(analogRead(0));
 
-    // Mensaje de inicio
+    // Mensaje de inicio (solo en modo texto: en binario ensuciaría el flujo)
     delay(2000);
+#if !MODO_BINARIO
     Serial.println("ESP32 - Simulador de Sensores IoT Iniciado");
     Serial.println("Formato: TIPO:ID:VALOR");
     Serial.println("========================================");
+#endif
 }
 
 /**
@@ -53,11 +155,16 @@ void enviarDatosTemperatura()
     // Generar temperatura aleatoria entre 15.0 y 45.0 °C
     float temperatura = 15.0 + random(0, 300) / 10.0;
 
+#if MODO_BINARIO
+    // Valor de ancho fijo en décimas de grado
+    agregarLecturaBinaria(TRAMA_TEMP, contadorTemp, (int32_t)lround(temperatura * 10.0));
+#else
     // Enviar datos en formato TIPO:ID:VALOR
     Serial.print("TEMP:");
     Serial.print(id);
     Serial.print(":");
     Serial.println(temperatura, 1);
+#endif
 
     // Incrementar contador (ciclar entre 1-10)
     contadorTemp = (contadorTemp % 10) + 1;
@@ -75,16 +182,61 @@ void enviarDatosPresion()
     // Generar presión aleatoria entre 50 y 150 PSI
     int presion = random(50, 151);
 
+#if MODO_BINARIO
+    agregarLecturaBinaria(TRAMA_PRES, contadorPres, presion);
+#else
     // Enviar datos en formato TIPO:ID:VALOR
     Serial.print("PRES:");
     Serial.print(id);
     Serial.print(":");
     Serial.println(presion);
+#endif
 
     // Incrementar contador (ciclar entre 1-10)
     contadorPres = (contadorPres % 10) + 1;
 }
 
+/**
+ * @brief Genera y envía un bloque de muestras simuladas de vibración
+ *
+ * Simula un acelerómetro muestreado a alta frecuencia: una senoidal de
+ * 1/16 de la frecuencia de muestreo con ruido, en conteos enteros.
+ */
+void enviarDatosVibracion()
+{
+    char id[20];
+    sprintf(id, "V-%03d", contadorVib);
+
+#if !MODO_BINARIO
+    Serial.print("VIB:");
+    Serial.print(id);
+    Serial.print(":");
+#endif
+
+    for (int i = 0; i < MUESTRAS_VIBRACION; i++)
+    {
+        int cuenta = (int)(1000.0 * sin(2.0 * PI * faseVibracion / 16.0)) + random(-100, 101);
+        faseVibracion = (faseVibracion + 1) & 15;
+
+#if MODO_BINARIO
+        agregarLecturaBinaria(TRAMA_VIB, contadorVib, cuenta);
+#else
+        if (i > 0)
+        {
+            Serial.print(",");
+        }
+        Serial.print(cuenta);
+#endif
+    }
+
+#if !MODO_BINARIO
+    Serial.println();
+#endif
+
+    // Incrementar contador (ciclar entre 1-4)
+    contadorVib = (contadorVib % 4) + 1;
+}
+
 /**
  * @brief Loop principal del programa
  */
@@ -97,16 +249,29 @@ void loop()
     {
         tiempoAnterior = tiempoActual;
 
-        // Alternar entre enviar datos de temperatura y presión
-        if (random(0, 2) == 0)
+        // Alternar entre enviar datos de temperatura, presión y vibración
+        long tipo = random(0, 3);
+        if (tipo == 0)
         {
             enviarDatosTemperatura();
         }
-        else
+        else if (tipo == 1)
         {
             enviarDatosPresion();
         }
+        else
+        {
+            enviarDatosVibracion();
+        }
+    }
+
+#if MODO_BINARIO
+    // No retener un lote parcial más de MAX_ESPERA_TRAMA
+    if (lecturasEnTrama > 0 && tiempoActual - tiempoInicioTrama >= MAX_ESPERA_TRAMA)
+    {
+        enviarTrama();
     }
+#endif
 
     // Pequeña pausa para no saturar el procesador
     delay(10);
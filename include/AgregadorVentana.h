@@ -0,0 +1,306 @@
+/**
+ * @file AgregadorVentana.h
+ * @brief Agregados de ventana deslizante y media móvil exponencial en O(1)
+ * @author FabiRamiro
+ * @date 2026-10-18
+ */
+
+#ifndef AGREGADORVENTANA_H
+#define AGREGADORVENTANA_H
+
+#include <iostream>
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+#include "EstadisticasLista.h"
+
+/**
+ * @class AgregadorVentana
+ * @brief Suma, media, mínimo, máximo de las últimas N lecturas y EWMA
+ * @tparam T Tipo de las lecturas
+ *
+ * Cada agregar() cuesta O(1) amortizado:
+ * - La suma de la ventana se actualiza sumando el valor que entra y
+ *   restando el que sale de un buffer circular; cada vez que el buffer da
+ *   una vuelta se recalcula exacta para que no se acumule error de redondeo.
+ * - Mínimo y máximo usan colas monótonas: cada valor entra y sale a lo sumo
+ *   una vez de cada cola, y el extremo de la ventana siempre está al frente.
+ * - La EWMA se actualiza con ewma += alfa * (x - ewma).
+ */
+template <typename T>
+class AgregadorVentana
+{
+public:
+    typedef typename AcumuladorPorDefecto<T>::tipo Acum; ///< Tipo de la suma
+    static const int TAMANO_POR_DEFECTO = 60;           ///< Lecturas por ventana
+
+private:
+    /**
+     * @brief Cola monótona de (valor, secuencia) sobre un buffer circular
+     * @tparam Comparar std::less para mínimos, std::greater para máximos
+     */
+    template <typename Comparar>
+    struct ColaMonotona
+    {
+        T *valores;             ///< Valores candidatos
+        long long *secuencias;  ///< Posición global de cada candidato
+        int capacidad;          ///< Tamaño del buffer (= ventana)
+        int inicio;             ///< Índice del frente
+        int cantidad;           ///< Candidatos en la cola
+
+        ColaMonotona() : valores(nullptr), secuencias(nullptr), capacidad(0), inicio(0), cantidad(0) {}
+
+        ~ColaMonotona()
+        {
+            delete[] valores;
+            delete[] secuencias;
+        }
+
+        void reservar(int nuevaCapacidad)
+        {
+            delete[] valores;
+            delete[] secuencias;
+            valores = new T[nuevaCapacidad];
+            secuencias = new long long[nuevaCapacidad];
+            capacidad = nuevaCapacidad;
+            inicio = 0;
+            cantidad = 0;
+        }
+
+        void agregar(T valor, long long secuencia, int ventana)
+        {
+            Comparar cmp;
+
+            // El frente sale cuando queda fuera de la ventana (antes de insertar,
+            // así nunca hay más de "ventana" candidatos en el buffer)
+            if (cantidad > 0 && secuencias[inicio] <= secuencia - ventana)
+            {
+                inicio = (inicio + 1) % capacidad;
+                cantidad--;
+            }
+
+            // Los candidatos que el nuevo valor domina ya nunca serán el extremo
+            while (cantidad > 0 && !cmp(valores[(inicio + cantidad - 1) % capacidad], valor))
+            {
+                cantidad--;
+            }
+
+            int pos = (inicio + cantidad) % capacidad;
+            valores[pos] = valor;
+            secuencias[pos] = secuencia;
+            cantidad++;
+        }
+
+        T frente() const
+        {
+            return valores[inicio];
+        }
+    };
+
+    T *valores;             ///< Buffer circular de la ventana
+    int tamano;             ///< Lecturas por ventana
+    int cantidad;           ///< Lecturas presentes en la ventana
+    int posicion;           ///< Próxima posición de escritura
+    long long secuencia;    ///< Lecturas agregadas en total
+    Acum suma;              ///< Suma de la ventana
+
+    ColaMonotona<std::less<T> > minimos;     ///< Candidatos a mínimo
+    ColaMonotona<std::greater<T> > maximos;  ///< Candidatos a máximo
+
+    double alfa;            ///< Factor de suavizado de la EWMA (0, 1]
+    double ewma;            ///< Media móvil exponencial
+    bool hayEwma;           ///< false hasta la primera lectura
+
+public:
+    /**
+     * @brief Constructor
+     * @param tamanoVentana Lecturas por ventana
+     * @param alfaEwma Factor de suavizado de la EWMA
+     */
+    AgregadorVentana(int tamanoVentana = TAMANO_POR_DEFECTO, double alfaEwma = 0.2)
+        : valores(nullptr), tamano(0)
+    {
+        configurar(tamanoVentana, alfaEwma);
+    }
+
+    /**
+     * @brief Destructor: libera el buffer circular
+     */
+    ~AgregadorVentana()
+    {
+        delete[] valores;
+    }
+
+    /**
+     * @brief Cambia el tamaño de la ventana y el alfa (reinicia los agregados)
+     * @param tamanoVentana Lecturas por ventana (mínimo 1)
+     * @param alfaEwma Factor de suavizado, se limita a (0, 1]
+     */
+    void configurar(int tamanoVentana, double alfaEwma)
+    {
+        tamanoVentana = (tamanoVentana < 1) ? 1 : tamanoVentana;
+        if (tamanoVentana != tamano)
+        {
+            delete[] valores;
+            valores = new T[tamanoVentana];
+            tamano = tamanoVentana;
+        }
+
+        minimos.reservar(tamano);
+        maximos.reservar(tamano);
+        cantidad = 0;
+        posicion = 0;
+        secuencia = 0;
+        suma = 0;
+
+        alfa = (alfaEwma <= 0.0 || alfaEwma > 1.0) ? 1.0 : alfaEwma;
+        ewma = 0.0;
+        hayEwma = false;
+    }
+
+    /**
+     * @brief Agrega una lectura a la ventana y a la EWMA
+     * @param valor Nueva lectura
+     */
+    void agregar(T valor)
+    {
+        if (cantidad == tamano)
+        {
+            suma -= static_cast<Acum>(valores[posicion]);
+        }
+        else
+        {
+            cantidad++;
+        }
+
+        valores[posicion] = valor;
+        suma += static_cast<Acum>(valor);
+        posicion++;
+
+        if (posicion == tamano)
+        {
+            posicion = 0;
+            // Una vuelta completa: recalcular la suma exacta (O(1) amortizado)
+            suma = 0;
+            for (int i = 0; i < cantidad; i++)
+            {
+                suma += static_cast<Acum>(valores[i]);
+            }
+        }
+
+        minimos.agregar(valor, secuencia, tamano);
+        maximos.agregar(valor, secuencia, tamano);
+        secuencia++;
+
+        double x = static_cast<double>(valor);
+        ewma = hayEwma ? ewma + alfa * (x - ewma) : x;
+        hayEwma = true;
+    }
+
+    /**
+     * @brief Lecturas presentes en la ventana
+     * @return Entre 0 y el tamaño de la ventana
+     */
+    int getCantidad() const
+    {
+        return cantidad;
+    }
+
+    /**
+     * @brief Tamaño configurado de la ventana
+     * @return Lecturas por ventana
+     */
+    int getTamano() const
+    {
+        return tamano;
+    }
+
+    /**
+     * @brief Bytes reservados por el buffer circular y las colas monótonas
+     * @return Memoria dinámica del agregador
+     */
+    std::size_t getBytesReservados() const
+    {
+        return static_cast<std::size_t>(tamano) * sizeof(T) +
+               static_cast<std::size_t>(minimos.capacidad + maximos.capacidad) * (sizeof(T) + sizeof(long long));
+    }
+
+    /**
+     * @brief Suma de la ventana
+     * @return Suma en el tipo acumulador
+     */
+    Acum getSuma() const
+    {
+        return suma;
+    }
+
+    /**
+     * @brief Media de la ventana
+     * @return Media (0 si no hay lecturas)
+     */
+    double getMedia() const
+    {
+        return (cantidad > 0) ? static_cast<double>(suma) / cantidad : 0.0;
+    }
+
+    /**
+     * @brief Mínimo de la ventana
+     * @return Mínimo (T() si no hay lecturas)
+     */
+    T getMinimo() const
+    {
+        return (cantidad > 0) ? minimos.frente() : T();
+    }
+
+    /**
+     * @brief Máximo de la ventana
+     * @return Máximo (T() si no hay lecturas)
+     */
+    T getMaximo() const
+    {
+        return (cantidad > 0) ? maximos.frente() : T();
+    }
+
+    /**
+     * @brief Media móvil exponencial
+     * @return EWMA (0 si no hay lecturas)
+     */
+    double getEWMA() const
+    {
+        return ewma;
+    }
+
+    /**
+     * @brief Factor de suavizado de la EWMA
+     * @return Alfa configurado
+     */
+    double getAlfa() const
+    {
+        return alfa;
+    }
+
+    /**
+     * @brief Imprime los agregados en una línea
+     * @param prefijo Etiqueta del sensor (ej: "[Sensor Temp]")
+     * @param unidad Unidad de las lecturas
+     */
+    void imprimir(const char *prefijo, const char *unidad) const
+    {
+        if (cantidad == 0)
+        {
+            std::cout << "  " << prefijo << " Ventana: sin lecturas." << std::endl;
+            return;
+        }
+
+        std::cout << "  " << prefijo << " Ventana(" << cantidad << "/" << tamano << "): media = "
+                  << getMedia() << ", min = " << getMinimo() << ", max = " << getMaximo()
+                  << " " << unidad << " | EWMA(" << alfa << ") = " << ewma
+                  << " " << unidad << std::endl;
+    }
+
+private:
+    AgregadorVentana(const AgregadorVentana &);            // No copiable
+    AgregadorVentana &operator=(const AgregadorVentana &); // No asignable
+};
+
+#endif // AGREGADORVENTANA_H
@@ -0,0 +1,181 @@
+/**
+ * @file AlgoritmosLista.h
+ * @brief Reducciones por segmentos sobre ListaSensor con políticas de ejecución
+ * @author FabiRamiro
+ * @date 2026-10-18
+ */
+
+#ifndef ALGORITMOSLISTA_H
+#define ALGORITMOSLISTA_H
+
+#include <numeric>
+#include <functional>
+#include <utility>
+#include <type_traits>
+#include "ListaSensor.h"
+
+#ifdef USAR_EJECUCION_PARALELA
+#include <execution>
+#endif
+
+/*
+ * Una lista enlazada no se puede repartir entre hilos elemento a elemento,
+ * pero sus segmentos sí: se arma un índice de segmentos (un arreglo, de
+ * acceso aleatorio) y la política de ejecución reparte los segmentos; cada
+ * tarea reduce su segmento contiguo de forma secuencial.
+ */
+
+/**
+ * @brief Arreglo temporal con los segmentos de una lista
+ * @tparam T Tipo de las lecturas
+ */
+template <typename T>
+class IndiceSegmentos
+{
+private:
+    Segmento<T> *segmentos; ///< Segmentos en orden
+    int cantidad;           ///< Número de segmentos
+
+public:
+    /**
+     * @brief Indexa los segmentos de la lista
+     * @param lista Lista a indexar
+     */
+    template <typename Lista>
+    explicit IndiceSegmentos(const Lista &lista)
+        : segmentos(new Segmento<T>[lista.getNumSegmentos() > 0 ? lista.getNumSegmentos() : 1]), cantidad(0)
+    {
+        for (Segmento<T> s : lista.segmentos())
+        {
+            segmentos[cantidad++] = s;
+        }
+    }
+
+    ~IndiceSegmentos()
+    {
+        delete[] segmentos;
+    }
+
+    const Segmento<T> *begin() const { return segmentos; }
+    const Segmento<T> *end() const { return segmentos + cantidad; }
+
+private:
+    IndiceSegmentos(const IndiceSegmentos &);            // No copiable
+    IndiceSegmentos &operator=(const IndiceSegmentos &); // No asignable
+};
+
+/**
+ * @brief Marca para ejecutar las reducciones sin política (secuencial)
+ *
+ * Sirve en compiladores sin <execution>; con soporte se puede pasar
+ * std::execution::seq, par o par_unseq.
+ */
+struct EjecucionSecuencial
+{
+};
+
+#ifdef USAR_EJECUCION_PARALELA
+typedef std::execution::parallel_policy PoliticaHistorial; ///< Política de los reportes sobre historiales
+#else
+typedef EjecucionSecuencial PoliticaHistorial; ///< Política de los reportes sobre historiales
+#endif
+
+/**
+ * @brief Política usada para recorrer historiales largos en esta compilación
+ * @return std::execution::par si hay soporte, EjecucionSecuencial si no
+ */
+inline const PoliticaHistorial &politicaHistorial()
+{
+#ifdef USAR_EJECUCION_PARALELA
+    return std::execution::par;
+#else
+    static const EjecucionSecuencial secuencial = EjecucionSecuencial();
+    return secuencial;
+#endif
+}
+
+namespace detalle
+{
+    template <typename Politica, typename It, typename R, typename Reducir, typename Transformar>
+    R transformReduce(std::false_type, Politica &&politica, It primero, It ultimo, R inicial,
+                      Reducir reducir, Transformar transformar)
+    {
+        return std::transform_reduce(std::forward<Politica>(politica), primero, ultimo, inicial, reducir, transformar);
+    }
+
+    template <typename Politica, typename It, typename R, typename Reducir, typename Transformar>
+    R transformReduce(std::true_type, Politica &&, It primero, It ultimo, R inicial,
+                      Reducir reducir, Transformar transformar)
+    {
+        return std::transform_reduce(primero, ultimo, inicial, reducir, transformar);
+    }
+}
+
+/**
+ * @brief transform_reduce sobre todas las lecturas de la lista, por segmentos
+ * @param politica Política de ejecución (ej: std::execution::par o EjecucionSecuencial)
+ * @param lista Lista a recorrer
+ * @param inicial Valor inicial de la reducción
+ * @param reducir Operación binaria asociativa y conmutativa
+ * @param transformar Transformación aplicada a cada lectura
+ * @return Resultado de la reducción
+ */
+template <typename Politica, typename Lista, typename R, typename Reducir, typename Transformar>
+R transformarReducirSegmentos(Politica &&politica, const Lista &lista, R inicial,
+                              Reducir reducir, Transformar transformar)
+{
+    typedef typename Lista::value_type T;
+    IndiceSegmentos<T> indice(lista);
+
+    typedef typename std::is_same<typename std::decay<Politica>::type, EjecucionSecuencial>::type EsSecuencial;
+
+    return detalle::transformReduce(EsSecuencial(), std::forward<Politica>(politica), indice.begin(), indice.end(),
+                                    inicial, reducir,
+                                    [&reducir, &transformar](const Segmento<T> &s)
+                                    {
+                                        // Los segmentos nunca están vacíos
+                                        R parcial = transformar(*s.begin());
+                                        for (const T *p = s.begin() + 1; p != s.end(); ++p)
+                                        {
+                                            parcial = reducir(parcial, transformar(*p));
+                                        }
+                                        return parcial;
+                                    });
+}
+
+/**
+ * @brief Suma de todas las lecturas en el acumulador de la lista
+ * @param politica Política de ejecución
+ * @param lista Lista a sumar
+ * @return Suma en Lista::TipoAcumulador
+ */
+template <typename Politica, typename Lista>
+typename Lista::TipoAcumulador sumarSegmentos(Politica &&politica, const Lista &lista)
+{
+    typedef typename Lista::TipoAcumulador Acum;
+    typedef typename Lista::value_type T;
+    return transformarReducirSegmentos(std::forward<Politica>(politica), lista, Acum(0), std::plus<Acum>(),
+                                       [](T x)
+                                       { return static_cast<Acum>(x); });
+}
+
+/**
+ * @brief Suma de cuadrados de las desviaciones respecto de una media
+ * @param politica Política de ejecución
+ * @param lista Lista a recorrer
+ * @param media Media de referencia
+ * @return Suma de (x - media)^2
+ */
+template <typename Politica, typename Lista>
+double sumaCuadradosSegmentos(Politica &&politica, const Lista &lista, double media)
+{
+    typedef typename Lista::value_type T;
+    return transformarReducirSegmentos(std::forward<Politica>(politica), lista, 0.0, std::plus<double>(),
+                                       [media](T x)
+                                       {
+                                           double d = static_cast<double>(x) - media;
+                                           return d * d;
+                                       });
+}
+
+#endif // ALGORITMOSLISTA_H
@@ -0,0 +1,103 @@
+/**
+ * @file AnilloCompartido.h
+ * @brief Formato del anillo en memoria compartida (/dev/shm) entre el sistema y sus consumidores
+ * @author FabiRamiro
+ * @date 2026-10-18
+ *
+ * Este encabezado es el contrato entre PublicadorAnillo (un único escritor,
+ * dentro del sistema) y LectorAnillo (cualquier cantidad de procesos
+ * lectores). Solo usa tipos de ancho fijo y atómicos sin bloqueo, así que
+ * el mismo mapa de bytes se interpreta igual en ambos lados.
+ */
+
+#ifndef ANILLOCOMPARTIDO_H
+#define ANILLOCOMPARTIDO_H
+
+#include <atomic>
+#include <cstdint>
+
+const std::uint32_t MAGIA_ANILLO = 0x4C4C4E41; ///< "ANLL": el escritor terminó de inicializar
+const std::uint32_t VERSION_ANILLO = 1;        ///< Versión del formato
+const int TAM_NOMBRE_ANILLO = 32;              ///< Nombre del sensor (con el nulo)
+const int TAM_TIPO_ANILLO = 8;                 ///< Tipo corto del sensor (con el nulo)
+
+/**
+ * @brief Contenido de un registro
+ */
+enum TipoRegistroAnillo
+{
+    REGISTRO_ANILLO_LECTURA = 1, ///< Lectura aceptada por un sensor (valor)
+    REGISTRO_ANILLO_AGREGADO = 2 ///< Resumen periódico de un sensor (promedio, mínimo, máximo)
+};
+
+/**
+ * @brief Un registro publicado, tal como lo copia el lector
+ */
+struct RegistroAnillo
+{
+    std::uint64_t secuencia;           ///< Número de registro (0, 1, 2, ...)
+    std::int64_t marcaNs;              ///< Hora de publicación (ns desde la época Unix)
+    double valor;                      ///< Valor de la lectura, o promedio en un agregado
+    double minimo;                     ///< Mínimo del historial (solo agregados)
+    double maximo;                     ///< Máximo del historial (solo agregados)
+    std::int32_t manejador;            ///< Manejador del sensor en el sistema
+    std::int32_t numLecturas;          ///< Lecturas del historial (solo agregados)
+    std::uint32_t tipo;                ///< TipoRegistroAnillo
+    char tipoSensor[TAM_TIPO_ANILLO];  ///< "TEMP", "PRES", "VIB"...
+    char nombre[TAM_NOMBRE_ANILLO];    ///< Identificador del sensor
+};
+
+/**
+ * @brief Ranura del anillo: el registro y su sello de versión
+ *
+ * El sello del registro n vale 2n + 1 mientras el escritor lo copia y
+ * 2n + 2 cuando terminó. El lector lee el sello, copia el registro y
+ * vuelve a leer el sello: si cambió o no es 2n + 2, el escritor ya dio
+ * la vuelta y el registro se perdió.
+ */
+struct alignas(64) RanuraAnillo
+{
+    std::atomic<std::uint64_t> sello; ///< Versión del contenido (ver arriba)
+    RegistroAnillo registro;          ///< Contenido
+};
+
+/**
+ * @brief Cabecera al comienzo del segmento, seguida de 'capacidad' ranuras
+ *
+ * La primera línea de caché no cambia después de abrir; 'publicados' va
+ * en su propia línea porque el escritor la actualiza en cada registro.
+ */
+struct alignas(64) CabeceraAnillo
+{
+    std::atomic<std::uint32_t> magia;               ///< MAGIA_ANILLO cuando el resto es válido
+    std::uint32_t version;                          ///< VERSION_ANILLO
+    std::uint32_t capacidad;                        ///< Ranuras (potencia de 2)
+    std::uint32_t tamRanura;                        ///< sizeof(RanuraAnillo) del escritor
+    std::int64_t pidEscritor;                       ///< Proceso que publica
+    std::atomic<std::uint32_t> activo;              ///< 1 mientras el escritor publica
+    alignas(64) std::atomic<std::uint64_t> publicados; ///< Registros escritos (el próximo es este)
+};
+
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "El anillo necesita atomicos de 64 bits sin bloqueo");
+
+/**
+ * @brief Bytes del segmento para una capacidad
+ * @param capacidad Ranuras del anillo
+ * @return Tamaño total del segmento
+ */
+inline std::uint64_t tamanoSegmentoAnillo(std::uint32_t capacidad)
+{
+    return sizeof(CabeceraAnillo) + static_cast<std::uint64_t>(capacidad) * sizeof(RanuraAnillo);
+}
+
+/**
+ * @brief Ranuras que siguen a la cabecera
+ * @param cabecera Comienzo del segmento mapeado
+ * @return Primera ranura
+ */
+inline RanuraAnillo *ranurasAnillo(CabeceraAnillo *cabecera)
+{
+    return reinterpret_cast<RanuraAnillo *>(cabecera + 1);
+}
+
+#endif // ANILLOCOMPARTIDO_H
@@ -0,0 +1,207 @@
+/**
+ * @file ArenaSensores.h
+ * @brief Arena de memoria que agrupa los sensores por tipo en bloques contiguos
+ * @author FabiRamiro
+ * @date 2026-10-18
+ */
+
+#ifndef ARENASENSORES_H
+#define ARENASENSORES_H
+
+#include <cstddef>
+#include <new>
+
+/**
+ * @class ArenaSensores
+ * @brief Reserva sensores en "slabs" contiguos, uno por cada tipo concreto
+ *
+ * Cada tipo de sensor (SensorTemperatura, SensorPresion, ...) tiene su propio
+ * pool formado por slabs de SENSORES_POR_SLAB objetos. Los objetos se
+ * construyen con placement new dentro del slab, de modo que nunca se mueven
+ * (los punteros son estables) y los sensores del mismo tipo quedan contiguos
+ * en memoria. La liberación es en bloque: se ejecutan los destructores slab
+ * por slab y después se libera cada slab con una sola llamada.
+ *
+ * Cada slab lleva una máscara de 32 bits con las casillas ocupadas. Un
+ * sensor dado de baja se destruye con liberar(): su casilla queda libre
+ * para el próximo crear() del mismo tipo, y un slab que se vacía se
+ * devuelve al sistema, así que la arena ocupa lo que ocupan los sensores
+ * vivos aunque la flota rote.
+ */
+class ArenaSensores
+{
+public:
+    static const int SENSORES_POR_SLAB = 32; ///< Objetos por slab (un bit de ocupación cada uno)
+    static const unsigned SLAB_LLENO = 0xFFFFFFFFu; ///< Máscara de un slab sin casillas libres
+
+    /**
+     * @brief Pool de un solo tipo de sensor
+     *
+     * Guarda la información necesaria para destruir los objetos sin conocer
+     * su tipo estático (tamaño y función destructora).
+     */
+    struct Pool
+    {
+        const void *tipo;          ///< Identificador único del tipo
+        std::size_t tamano;        ///< sizeof del tipo concreto
+        void (*destruir)(void *);  ///< Invoca el destructor del tipo concreto
+        char **slabs;              ///< Arreglo de slabs reservados
+        unsigned *ocupados;        ///< Casillas construidas de cada slab (bit i = objeto i)
+        int numSlabs;              ///< Slabs en uso
+        int capacidadSlabs;        ///< Capacidad de slabs y ocupados
+        int primerLibre;           ///< Ningún slab anterior a este tiene casillas libres
+        int numObjetos;            ///< Objetos construidos en el pool
+    };
+
+private:
+    Pool *pools;       ///< Arreglo de pools (uno por tipo)
+    int numPools;      ///< Pools en uso
+    int capacidadPools; ///< Capacidad del arreglo de pools
+
+public:
+    /**
+     * @brief Constructor por defecto (arena vacía)
+     */
+    ArenaSensores();
+
+    /**
+     * @brief Destructor - Libera en bloque todos los sensores
+     */
+    ~ArenaSensores();
+
+    /**
+     * @brief Construye un sensor de tipo S dentro de su pool
+     * @tparam S Tipo concreto del sensor
+     * @param nombre Identificador del sensor
+     * @return Puntero estable al sensor construido
+     */
+    template <typename S>
+    S *crear(const char *nombre)
+    {
+        Pool &pool = obtenerPool(idTipo<S>(), sizeof(S), &destruirObjeto<S>);
+        int slab;
+        int casilla;
+        void *memoria = reservarEspacio(pool, slab, casilla);
+        S *sensor = new (memoria) S(nombre);
+        pool.ocupados[slab] |= 1u << casilla;
+        pool.numObjetos++;
+        return sensor;
+    }
+
+    /**
+     * @brief Destruye un sensor de la arena y libera su casilla
+     * @param objeto Sensor devuelto por crear()
+     * @param tipo Identificador de su tipo (idTipo<S>())
+     * @return false si el objeto no pertenece a ningún slab de ese tipo
+     *
+     * Si el slab queda vacío se libera. O(slabs del tipo) para ubicar el slab.
+     */
+    bool liberar(void *objeto, const void *tipo);
+
+    /**
+     * @brief Recorre de forma contigua todos los sensores de tipo S
+     * @tparam S Tipo concreto del sensor
+     * @tparam F Función o functor invocable como f(S&)
+     * @param funcion Operación a aplicar a cada sensor
+     *
+     * Cada slab se trata como un arreglo S[], por lo que el bucle es
+     * monomórfico y no hay saltos de puntero entre un sensor y el siguiente.
+     * Las casillas libres de un slab incompleto se saltan con su máscara.
+     */
+    template <typename S, typename F>
+    void recorrer(F funcion) const
+    {
+        const Pool *pool = buscarPool(idTipo<S>());
+        if (pool == nullptr)
+        {
+            return;
+        }
+
+        for (int s = 0; s < pool->numSlabs; s++)
+        {
+            S *bloque = reinterpret_cast<S *>(pool->slabs[s]);
+            unsigned ocupados = pool->ocupados[s];
+            for (int i = 0; i < SENSORES_POR_SLAB; i++)
+            {
+                if ((ocupados & (1u << i)) != 0)
+                {
+                    funcion(bloque[i]);
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Busca el pool de un tipo sin crearlo
+     * @param tipo Identificador devuelto por idTipo<S>()
+     * @return Puntero al pool, nullptr si no hay sensores de ese tipo
+     */
+    const Pool *buscarPool(const void *tipo) const;
+
+    /**
+     * @brief Destruye todos los sensores y libera todos los slabs
+     */
+    void liberarTodo();
+
+    /**
+     * @brief Número de pools (tipos distintos) registrados
+     * @return Cantidad de pools
+     */
+    int getNumPools() const;
+
+    /**
+     * @brief Acceso de solo lectura a un pool por índice
+     * @param indice Índice del pool (0..getNumPools()-1)
+     * @return Referencia al pool
+     */
+    const Pool &getPool(int indice) const;
+
+    /**
+     * @brief Objetos construidos en toda la arena
+     * @return Sensores vivos (o dados de baja y aún sin liberar)
+     */
+    int getNumObjetos() const;
+
+    /**
+     * @brief Bytes reservados por todos los slabs de la arena
+     * @return Total de bytes
+     */
+    std::size_t getBytesReservados() const;
+
+    /**
+     * @brief Identificador único por tipo (dirección de una variable estática)
+     * @tparam S Tipo concreto
+     * @return Puntero usado como etiqueta del tipo
+     */
+    template <typename S>
+    static const void *idTipo()
+    {
+        static const char id = 0;
+        return &id;
+    }
+
+private:
+    ArenaSensores(const ArenaSensores &);            // No copiable
+    ArenaSensores &operator=(const ArenaSensores &); // No asignable
+
+    template <typename S>
+    static void destruirObjeto(void *objeto)
+    {
+        static_cast<S *>(objeto)->~S();
+    }
+
+    /**
+     * @brief Busca el pool del tipo indicado o lo crea si no existe
+     */
+    Pool &obtenerPool(const void *tipo, std::size_t tamano, void (*destruir)(void *));
+
+    /**
+     * @brief Devuelve la primera casilla libre del pool (reserva slab si hace falta)
+     * @param pool Pool del tipo
+     * @param slab Slab de la casilla devuelta
+     * @param casilla Posición dentro del slab
+     */
+    void *reservarEspacio(Pool &pool, int &slab, int &casilla);
+};
+
+#endif // ARENASENSORES_H
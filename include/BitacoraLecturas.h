@@ -0,0 +1,266 @@
+/**
+ * @file BitacoraLecturas.h
+ * @brief Bitácora de escritura anticipada (WAL) con confirmación en grupo
+ * @author FabiRamiro
+ * @date 2026-10-18
+ */
+
+#ifndef BITACORALECTURAS_H
+#define BITACORALECTURAS_H
+
+#include <mutex>
+#include "SensorBase.h"
+
+class ListaGeneral;
+
+/**
+ * @brief Tipo de cada registro de la bitácora
+ */
+enum TipoRegistroBitacora
+{
+    REGISTRO_SENSOR = 1,    ///< Alta de sensor: manejador, tipo y nombre
+    REGISTRO_LECTURA = 2,   ///< Una lectura: manejador y valor
+    REGISTRO_BLOQUE = 3,    ///< Bloque de muestras crudas: manejador y cuentas
+    REGISTRO_PROCESO = 4,   ///< Pasada de procesamiento: todos, o los manejadores listados
+    REGISTRO_HISTORIAL = 5, ///< Historial restaurado de un punto de control
+    REGISTRO_BAJA = 6       ///< Baja de sensor: manejador (que una alta posterior puede reutilizar)
+};
+
+/**
+ * @brief Resultado de reproducir la bitácora al arrancar
+ */
+struct ResultadoReproduccion
+{
+    long registros;          ///< Registros válidos aplicados
+    long lecturas;           ///< Lecturas y muestras restauradas
+    int sensores;            ///< Sensores creados o reutilizados
+    long bytesDescartados;   ///< Cola incompleta o corrupta eliminada
+    long long milisegundos;  ///< Duración de la reproducción
+};
+
+/**
+ * @class BitacoraLecturas
+ * @brief Registro de solo anexado de todo lo que acepta la ingesta
+ *
+ * Es un observador más de ListaGeneral: cada alta de sensor, lectura o
+ * bloque se serializa en un buffer en memoria. Los registros se escriben
+ * y se sincronizan con fdatasync() en grupo, cada N lecturas o cuando la
+ * más antigua sin confirmar supera M milisegundos, de modo que el costo
+ * del fsync se reparte entre muchas lecturas. Lo que se pierde en un
+ * corte es, como mucho, el último grupo sin confirmar.
+ *
+ * Formato de cada registro (orden de bytes de la máquina):
+ *   uint32 crc | uint32 longitud | uint8 tipo | cuerpo
+ * El CRC-32 cubre la longitud, el tipo y el cuerpo. Al reproducir, el
+ * primer registro incompleto o con CRC inválido marca el final del log y
+ * la cola se trunca.
+ *
+ * Un punto de control reescribe el estado actual (sensores, historiales y
+ * muestras pendientes) en un archivo nuevo, lo sincroniza y lo renombra
+ * sobre la bitácora: el log anterior queda truncado de forma atómica.
+ * En Windows se usa _commit() en lugar de fdatasync() y MoveFileEx()
+ * para el reemplazo.
+ *
+ * Las lecturas y bloques de fragmentos distintos pueden llegar a la vez;
+ * el anexado al buffer (y la confirmación de grupo que dispare) se
+ * serializa con un mutex propio.
+ */
+class BitacoraLecturas : public ObservadorLecturas
+{
+public:
+    static const int TAM_BUFFER = 1 << 16;           ///< Bytes del buffer de registros
+    static const int MAX_VALORES_REGISTRO = 4096;    ///< Valores por registro de bloque o historial
+    static const int LECTURAS_POR_GRUPO = 256;       ///< N por defecto
+    static const int INTERVALO_GRUPO_MS = 50;        ///< M por defecto
+    static const long long LIMITE_ARCHIVO = 64LL << 20; ///< Tamaño que dispara un punto de control
+
+private:
+    char ruta[256];              ///< Ruta de la bitácora
+    int descriptor;              ///< Archivo abierto (-1 si está cerrada)
+    ListaGeneral *sistema;       ///< Registro que se reproduce y se respalda
+
+    char *buffer;                ///< Registros aún no escritos
+    int usados;                  ///< Bytes usados del buffer
+    std::mutex escritura;        ///< Serializa el anexado desde la ingesta
+    int indiceRegistro;          ///< Inicio del último registro reservado
+
+    int lecturasPorGrupo;        ///< Lecturas que fuerzan una confirmación
+    int intervaloMs;             ///< Antigüedad máxima de una lectura sin confirmar
+    long long limiteArchivo;     ///< Tamaño que dispara un punto de control (0 = nunca)
+    int pendientes;              ///< Lecturas sin confirmar
+    long long primeraPendienteMs; ///< Momento de la lectura sin confirmar más antigua
+
+    long long tamanoArchivo;     ///< Bytes escritos en el archivo actual
+    long long tamanoPuntoControl; ///< Tamaño del archivo tras el último punto de control
+    unsigned long grupos;        ///< Confirmaciones (fdatasync) realizadas
+    unsigned long puntosControl; ///< Puntos de control realizados
+
+public:
+    /**
+     * @brief Constructor: bitácora cerrada
+     * @param lecturasGrupo Lecturas por confirmación (N)
+     * @param intervaloGrupoMs Milisegundos máximos sin confirmar (M)
+     */
+    BitacoraLecturas(int lecturasGrupo = LECTURAS_POR_GRUPO, int intervaloGrupoMs = INTERVALO_GRUPO_MS);
+
+    /**
+     * @brief Destructor: confirma lo pendiente y cierra el archivo
+     */
+    ~BitacoraLecturas();
+
+    /**
+     * @brief Reproduce la bitácora existente y empieza a registrar la ingesta
+     * @param rutaArchivo Ruta del archivo (se crea si no existe)
+     * @param lista Registro de sensores donde se reconstruye el estado
+     * @param resultado Estadísticas de la reproducción (puede ser nullptr)
+     * @return false si no se pudo abrir o escribir el archivo
+     *
+     * Los observadores que deban ver los sensores reconstruidos tienen que
+     * estar agregados a la lista antes. Tras reproducir se hace un punto
+     * de control, y la bitácora se agrega como observador de la lista.
+     */
+    bool abrir(const char *rutaArchivo, ListaGeneral &lista, ResultadoReproduccion *resultado);
+
+    /**
+     * @brief Configura la confirmación en grupo
+     * @param lecturasGrupo Lecturas por confirmación (N, 1 = fsync por lectura)
+     * @param intervaloGrupoMs Milisegundos máximos sin confirmar (M)
+     * @param limiteBytes Tamaño que dispara un punto de control automático (0 = nunca)
+     */
+    void configurar(int lecturasGrupo, int intervaloGrupoMs, long long limiteBytes);
+
+    /**
+     * @brief Registra el alta de un sensor
+     * @param sensor Sensor registrado
+     * @param tipo Identificador del tipo en la arena
+     */
+    void sensorRegistrado(SensorBase &sensor, const void *tipo) override;
+
+    /**
+     * @brief Registra la baja de un sensor
+     * @param sensor Sensor dado de baja
+     * @param manejador Manejador que tenía
+     */
+    void sensorEliminado(SensorBase &sensor, int manejador) override;
+
+    /**
+     * @brief Registra una lectura
+     * @param sensor Sensor que recibió la lectura
+     * @param valor Valor registrado
+     */
+    void lecturaRegistrada(SensorBase &sensor, double valor) override;
+
+    /**
+     * @brief Registra un bloque de muestras crudas
+     * @param sensor Sensor que recibió el bloque
+     * @param cuentas Muestras del bloque
+     * @param cantidad Número de muestras
+     */
+    void bloqueRegistrado(SensorBase &sensor, const int *cuentas, int cantidad) override;
+
+    /**
+     * @brief Registra que se procesaron todos los sensores
+     *
+     * Al reproducir se vuelve a procesar en el mismo punto, así el
+     * historial queda igual que antes del corte.
+     */
+    void registrarProceso();
+
+    /**
+     * @brief Registra una pasada incremental sobre los sensores indicados
+     * @param manejadores Sensores que se van a procesar
+     * @param cantidad Número de manejadores
+     *
+     * Al reproducir se procesan exactamente esos sensores, aunque el
+     * estado de modificados tras un punto de control sea otro.
+     */
+    void registrarProceso(const int *manejadores, int cantidad);
+
+    /**
+     * @brief Escribe y sincroniza todo lo pendiente (un fdatasync)
+     * @return false si falló la escritura
+     */
+    bool confirmar();
+
+    /**
+     * @brief Confirmación por tiempo y punto de control por tamaño
+     *
+     * Se llama periódicamente desde los bucles de captura para que las
+     * lecturas no queden sin confirmar cuando la ingesta se detiene.
+     */
+    void revisar();
+
+    /**
+     * @brief Reescribe el estado actual y trunca la bitácora
+     * @return false si no se pudo escribir el punto de control (la bitácora anterior se conserva)
+     */
+    bool puntoControl();
+
+    /**
+     * @brief Indica si la bitácora está abierta
+     * @return true si registra la ingesta
+     */
+    bool estaAbierta() const;
+
+    /**
+     * @brief Imprime el estado de la bitácora
+     */
+    void imprimirEstado() const;
+
+private:
+    /**
+     * @brief Reserva un registro en el buffer
+     * @param tipo Tipo del registro
+     * @param longitudCuerpo Bytes del cuerpo (sin contar el tipo)
+     * @return Puntero al cuerpo, a completar antes de cerrarRegistro()
+     */
+    char *abrirRegistro(TipoRegistroBitacora tipo, int longitudCuerpo);
+
+    /**
+     * @brief Calcula el CRC del último registro reservado
+     */
+    void cerrarRegistro();
+
+    /**
+     * @brief Serializa el alta de un sensor
+     * @param sensor Sensor registrado
+     */
+    void escribirAlta(const SensorBase &sensor);
+
+    /**
+     * @brief Serializa muestras crudas en registros de a lo sumo MAX_VALORES_REGISTRO
+     * @param manejador Manejador del sensor
+     * @param cuentas Muestras
+     * @param cantidad Número de muestras
+     */
+    void escribirBloque(int manejador, const int *cuentas, int cantidad);
+
+    /**
+     * @brief Escribe el buffer al archivo, sin sincronizar
+     * @return false si falló la escritura
+     */
+    bool escribirBuffer();
+
+    /**
+     * @brief Cuenta lecturas sin confirmar y confirma si se llegó a N o a M ms
+     * @param lecturas Lecturas agregadas
+     */
+    void contarPendientes(int lecturas);
+
+    /**
+     * @brief Escribe los registros del estado actual de la lista
+     */
+    void escribirEstado();
+
+    /**
+     * @brief Aplica los registros de un archivo a la lista
+     * @param resultado Estadísticas a completar
+     * @return Bytes válidos del archivo (-1 si no se pudo leer)
+     */
+    long reproducir(ResultadoReproduccion &resultado);
+
+    BitacoraLecturas(const BitacoraLecturas &);            // No copiable
+    BitacoraLecturas &operator=(const BitacoraLecturas &); // No asignable
+};
+
+#endif // BITACORALECTURAS_H
@@ -0,0 +1,124 @@
+/**
+ * @file BufferReordenamiento.h
+ * @brief Buffer acotado de reordenamiento por número de secuencia con supresión de duplicados
+ * @author FabiRamiro
+ * @date 2026-10-18
+ */
+
+#ifndef BUFFERREORDENAMIENTO_H
+#define BUFFERREORDENAMIENTO_H
+
+#include <cstddef>
+
+/**
+ * @brief Qué se hizo con una lectura con número de secuencia
+ */
+enum ResultadoSecuencia
+{
+    SECUENCIA_EN_ORDEN = 0,   ///< Llegó después de todas las aceptadas
+    SECUENCIA_REORDENADA = 1, ///< Llegó tarde pero dentro de la ventana: se intercala en su lugar
+    SECUENCIA_DUPLICADA = 2,  ///< Ya se había recibido: se descarta
+    SECUENCIA_TARDIA = 3      ///< Su hueco ya se cerró (o es demasiado vieja): se descarta
+};
+
+/**
+ * @class BufferReordenamiento
+ * @brief Ventana deslizante de secuencias que entrega las lecturas en orden
+ *
+ * Las lecturas con secuencia en [siguiente, siguiente + VENTANA) se guardan
+ * en un buffer circular indexado por secuencia & (VENTANA - 1) y salen en
+ * orden en cuanto no queda un hueco delante. Si llega una secuencia que no
+ * entra en la ventana, la ventana avanza: lo guardado sale y los huecos se
+ * dan por perdidos. Así una lectura atrasada se intercala antes de llegar
+ * al historial, que solo recibe anexados en orden y nunca se reordena.
+ *
+ * Las secuencias ya emitidas se recuerdan en un mapa de bits circular de
+ * HISTORIA bits (1 = se recibió, 0 = hueco): una repetición se reconoce
+ * como duplicada y un hueco que llega tarde como tardía. Cada secuencia
+ * entra y sale de la ventana una vez, así que el costo es O(1) amortizado
+ * por lectura.
+ *
+ * Una secuencia más de HISTORIA por detrás puede ser un reinicio del
+ * dispositivo (su contador volvió a empezar, o dio la vuelta) o una trama
+ * vieja retransmitida. Solo se toma como reinicio con evidencia: que la
+ * secuencia esté cerca de cero (menor que MARGEN_REINICIO) o que la
+ * siguiente lectura también venga por detrás, justo después de ella. En
+ * ese caso se vacía la ventana y se continúa desde la primera secuencia
+ * baja; una trama vieja aislada se descarta como tardía.
+ */
+class BufferReordenamiento
+{
+public:
+    static const int VENTANA = 64;    ///< Lecturas que pueden esperar a que se llene un hueco
+    static const int HISTORIA = 1024; ///< Secuencias emitidas que se recuerdan (duplicados)
+    static const int MAX_LISTAS = VENTANA + 1; ///< Lecturas que puede emitir una inserción
+    static const int MARGEN_REINICIO = VENTANA; ///< Secuencias que cuentan como contador recién reiniciado
+
+private:
+    double valores[VENTANA];                   ///< Lecturas en espera, por ranura
+    unsigned long long ocupadas;               ///< Bit i: la ranura i tiene una lectura
+    unsigned long long vistas[HISTORIA / 64];  ///< Mapa de bits de las secuencias emitidas
+    long long siguiente;                       ///< Primera secuencia sin emitir
+    long long mayor;                           ///< Mayor secuencia aceptada
+    bool iniciado;                             ///< Se recibió al menos una secuencia
+    int pendientes;                            ///< Lecturas en la ventana
+    long long candidato;                       ///< Secuencia baja que podría ser un reinicio
+    double valorCandidato;                     ///< Lectura de esa secuencia
+    bool hayCandidato;                         ///< La lectura anterior fue una secuencia baja
+
+    long long enOrden;       ///< Lecturas aceptadas en orden
+    long long reordenadas;   ///< Lecturas aceptadas fuera de orden
+    long long duplicadas;    ///< Lecturas descartadas por repetidas
+    long long tardias;       ///< Lecturas descartadas por llegar después de cerrar su hueco
+    long long huecos;        ///< Secuencias dadas por perdidas
+    unsigned long reinicios; ///< Reinicios de secuencia detectados
+
+public:
+    /**
+     * @brief Constructor: ventana vacía, empieza en la primera secuencia que llegue
+     */
+    BufferReordenamiento();
+
+    /**
+     * @brief Inserta una lectura y emite las que ya pueden pasar al historial
+     * @param secuencia Número de secuencia de la lectura
+     * @param valor Valor de la lectura
+     * @param listas Destino de las lecturas emitidas, en orden (al menos MAX_LISTAS)
+     * @param numListas Lecturas escritas en listas
+     * @return Qué se hizo con la lectura
+     */
+    ResultadoSecuencia insertar(long long secuencia, double valor, double *listas, int &numListas);
+
+    /**
+     * @brief Emite todo lo que espera en la ventana, dando los huecos por perdidos
+     * @param listas Destino de las lecturas emitidas (al menos VENTANA)
+     * @return Lecturas emitidas
+     */
+    int vaciar(double *listas);
+
+    int getPendientes() const;            ///< Lecturas esperando un hueco
+    long long getSiguiente() const;       ///< Primera secuencia sin emitir
+    long long getEnOrden() const;         ///< Lecturas aceptadas en orden
+    long long getReordenadas() const;     ///< Lecturas aceptadas fuera de orden
+    long long getDuplicadas() const;      ///< Lecturas descartadas por repetidas
+    long long getTardias() const;         ///< Lecturas descartadas por tardías
+    long long getHuecos() const;          ///< Secuencias dadas por perdidas
+    unsigned long getReinicios() const;   ///< Reinicios de secuencia detectados
+
+private:
+    /**
+     * @brief Emite la ranura de 'siguiente' (o la da por perdida) y avanza una secuencia
+     * @param listas Destino de la lectura emitida
+     * @param numListas Lecturas escritas en listas (se incrementa)
+     */
+    void avanzar(double *listas, int &numListas);
+
+    /**
+     * @brief Indica si una secuencia emitida tenía lectura
+     * @param secuencia Secuencia en [siguiente - HISTORIA, siguiente)
+     * @return true si se recibió
+     */
+    bool fueVista(long long secuencia) const;
+};
+
+#endif // BUFFERREORDENAMIENTO_H
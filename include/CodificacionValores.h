@@ -0,0 +1,292 @@
+/**
+ * @file CodificacionValores.h
+ * @brief Tipos de lectura compactos para los historiales (punto fijo, media precisión, desplazamiento)
+ * @author FabiRamiro
+ * @date 2026-10-18
+ *
+ * Cada tipo guarda el valor codificado en 1 o 2 bytes y se usa como T de
+ * ListaSensor en lugar de float o int: ListaSensor<PuntoFijo16<10>, double,
+ * EstadisticaSuma>. Como Nodo<T> reserva 512 bytes de lecturas, un nodo
+ * guarda 2 o 4 veces más valores y un recorrido trae más valores por
+ * línea de caché, sin cambiar la lista ni sus algoritmos.
+ *
+ * - Se construyen implícitamente desde el valor real (redondeo al más
+ *   cercano; fuera de rango se satura al extremo representable). Quien
+ *   guarda lecturas de campo consulta satura() antes de insertar para
+ *   advertir y contar las que no caben.
+ * - Se convierten implícitamente a double: sumas, promedios, varianzas y
+ *   reportes operan sobre el valor decodificado en el acumulador de la
+ *   lista (double o long long), nunca en 8 o 16 bits.
+ * - Las comparaciones (mínimo, máximo) se hacen sobre el código, sin
+ *   decodificar: el código conserva el orden de los valores.
+ * - El constructor por defecto es trivial, como en int o float, para que
+ *   crear un nodo no inicialice sus lecturas; T() tiene código cero.
+ */
+
+#ifndef CODIFICACIONVALORES_H
+#define CODIFICACIONVALORES_H
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+/**
+ * @class PuntoFijo16
+ * @brief Valor en punto fijo de 16 bits con signo: valor = codigo / Escala
+ * @tparam Escala Pasos por unidad (10 = resolución de 0.1)
+ *
+ * Con Escala 10 representa de -3276.8 a 3276.7 en pasos de 0.1, exacto
+ * para lecturas que llegan con un decimal.
+ */
+template <int Escala>
+class PuntoFijo16
+{
+    static_assert(Escala > 0, "La escala debe ser positiva");
+
+private:
+    std::int16_t codigo; ///< valor * Escala, redondeado
+
+public:
+    PuntoFijo16() = default;
+
+    /**
+     * @brief Codifica un valor
+     * @param valor Valor real (se satura al rango representable)
+     */
+    PuntoFijo16(double valor) : codigo(codificar(valor)) {}
+
+    /**
+     * @brief Decodifica el valor
+     * @return codigo / Escala
+     */
+    operator double() const
+    {
+        return static_cast<double>(codigo) / Escala;
+    }
+
+    /**
+     * @brief Código almacenado
+     * @return Valor escalado
+     */
+    std::int16_t getCodigo() const
+    {
+        return codigo;
+    }
+
+    /**
+     * @brief Indica si un valor queda fuera del rango y se guardaría saturado
+     * @param valor Valor real
+     * @return true si el código sería -32768 o 32767 por saturación (o NaN)
+     */
+    static bool satura(double valor)
+    {
+        double escalado = valor * Escala;
+        return !(escalado > -32768.5 && escalado < 32767.5);
+    }
+
+    friend bool operator<(PuntoFijo16 a, PuntoFijo16 b) { return a.codigo < b.codigo; }
+    friend bool operator>(PuntoFijo16 a, PuntoFijo16 b) { return a.codigo > b.codigo; }
+    friend bool operator==(PuntoFijo16 a, PuntoFijo16 b) { return a.codigo == b.codigo; }
+    friend bool operator!=(PuntoFijo16 a, PuntoFijo16 b) { return a.codigo != b.codigo; }
+
+private:
+    static std::int16_t codificar(double valor)
+    {
+        double escalado = valor * Escala;
+        if (!(escalado > -32768.5)) // También NaN
+        {
+            return -32768;
+        }
+        if (escalado >= 32767.5)
+        {
+            return 32767;
+        }
+        return static_cast<std::int16_t>(std::floor(escalado + 0.5));
+    }
+};
+
+/**
+ * @class Flotante16
+ * @brief Valor en media precisión IEEE 754 (binary16)
+ *
+ * 11 bits significativos (unas 3 cifras decimales) y rango de ±65504; los
+ * valores mayores pasan a infinito. Útil para magnitudes derivadas sin una
+ * resolución fija, donde importa el error relativo y no el absoluto.
+ */
+class Flotante16
+{
+private:
+    std::uint16_t codigo; ///< Bits binary16
+
+public:
+    Flotante16() = default;
+
+    /**
+     * @brief Codifica un valor (redondeo al par más cercano)
+     * @param valor Valor real
+     */
+    Flotante16(float valor) : codigo(codificar(valor)) {}
+
+    /**
+     * @brief Decodifica el valor
+     * @return Valor exacto del código como double
+     */
+    operator double() const
+    {
+        return static_cast<double>(decodificar(codigo));
+    }
+
+    /**
+     * @brief Código almacenado
+     * @return Bits binary16
+     */
+    std::uint16_t getCodigo() const
+    {
+        return codigo;
+    }
+
+    friend bool operator<(Flotante16 a, Flotante16 b) { return a.clave() < b.clave(); }
+    friend bool operator>(Flotante16 a, Flotante16 b) { return a.clave() > b.clave(); }
+    friend bool operator==(Flotante16 a, Flotante16 b) { return a.clave() == b.clave(); }
+    friend bool operator!=(Flotante16 a, Flotante16 b) { return a.clave() != b.clave(); }
+
+private:
+    /**
+     * @brief Entero con el mismo orden que el valor (+0 y -0 iguales)
+     */
+    int clave() const
+    {
+        int magnitud = codigo & 0x7FFF;
+        return (codigo & 0x8000) ? -magnitud : magnitud;
+    }
+
+    static std::uint16_t codificar(float valor)
+    {
+        std::uint32_t bits;
+        std::memcpy(&bits, &valor, sizeof(bits));
+        std::uint16_t signo = static_cast<std::uint16_t>((bits >> 16) & 0x8000u);
+        std::uint32_t magnitud = bits & 0x7FFFFFFFu;
+
+        if (magnitud >= 0x7F800000u) // Infinito o NaN
+        {
+            return static_cast<std::uint16_t>(signo | 0x7C00u | ((magnitud > 0x7F800000u) ? 0x0200u : 0u));
+        }
+        if (magnitud >= 0x477FF000u) // >= 65520: redondea a infinito
+        {
+            return static_cast<std::uint16_t>(signo | 0x7C00u);
+        }
+        if (magnitud < 0x38800000u) // < 2^-14: subnormal en media precisión
+        {
+            if (magnitud < 0x33000000u) // < 2^-25: redondea a cero
+            {
+                return signo;
+            }
+            int desplazamiento = 126 - static_cast<int>(magnitud >> 23);
+            std::uint32_t mantisa = (magnitud & 0x007FFFFFu) | 0x00800000u;
+            std::uint32_t resultado = mantisa >> desplazamiento;
+            std::uint32_t resto = mantisa & ((1u << desplazamiento) - 1u);
+            std::uint32_t mitad = 1u << (desplazamiento - 1);
+            if (resto > mitad || (resto == mitad && (resultado & 1u)))
+            {
+                resultado++;
+            }
+            return static_cast<std::uint16_t>(signo | resultado);
+        }
+
+        // Normal: se rebaja el sesgo del exponente (127 -> 15) y se redondea la mantisa;
+        // un acarreo pasa al exponente, que es lo correcto
+        std::uint32_t resultado = (magnitud - 0x38000000u) >> 13;
+        std::uint32_t resto = magnitud & 0x1FFFu;
+        if (resto > 0x1000u || (resto == 0x1000u && (resultado & 1u)))
+        {
+            resultado++;
+        }
+        return static_cast<std::uint16_t>(signo | resultado);
+    }
+
+    static float decodificar(std::uint16_t h)
+    {
+        std::uint32_t signo = static_cast<std::uint32_t>(h & 0x8000u) << 16;
+        std::uint32_t exponente = (h >> 10) & 0x1Fu;
+        std::uint32_t mantisa = h & 0x03FFu;
+
+        if (exponente == 0)
+        {
+            float subnormal = static_cast<float>(mantisa) * (1.0f / 16777216.0f); // mantisa * 2^-24, exacto
+            return signo ? -subnormal : subnormal;
+        }
+
+        std::uint32_t bits = (exponente == 0x1Fu) ? (signo | 0x7F800000u | (mantisa << 13))
+                                                  : (signo | ((exponente + 112u) << 23) | (mantisa << 13));
+        float valor;
+        std::memcpy(&valor, &bits, sizeof(valor));
+        return valor;
+    }
+};
+
+/**
+ * @class Desplazado8
+ * @brief Valor de 8 bits sin signo con desplazamiento: valor = Base + codigo / Escala
+ * @tparam Base Menor valor representable
+ * @tparam Escala Pasos por unidad (1 = enteros)
+ *
+ * Representa 256 pasos desde Base. Con Escala 1 el valor decodificado es
+ * entero y se puede acumular en long long sin perder nada.
+ */
+template <int Base, int Escala = 1>
+class Desplazado8
+{
+    static_assert(Escala > 0, "La escala debe ser positiva");
+
+private:
+    std::uint8_t codigo; ///< (valor - Base) * Escala, redondeado
+
+public:
+    Desplazado8() = default;
+
+    /**
+     * @brief Codifica un valor
+     * @param valor Valor real (se satura a [Base, Base + 255 / Escala])
+     */
+    Desplazado8(double valor) : codigo(codificar(valor)) {}
+
+    /**
+     * @brief Decodifica el valor
+     * @return Base + codigo / Escala
+     */
+    operator double() const
+    {
+        return Base + static_cast<double>(codigo) / Escala;
+    }
+
+    /**
+     * @brief Código almacenado
+     * @return Pasos desde Base
+     */
+    std::uint8_t getCodigo() const
+    {
+        return codigo;
+    }
+
+    friend bool operator<(Desplazado8 a, Desplazado8 b) { return a.codigo < b.codigo; }
+    friend bool operator>(Desplazado8 a, Desplazado8 b) { return a.codigo > b.codigo; }
+    friend bool operator==(Desplazado8 a, Desplazado8 b) { return a.codigo == b.codigo; }
+    friend bool operator!=(Desplazado8 a, Desplazado8 b) { return a.codigo != b.codigo; }
+
+private:
+    static std::uint8_t codificar(double valor)
+    {
+        double pasos = (valor - Base) * Escala;
+        if (!(pasos > -0.5)) // También NaN
+        {
+            return 0;
+        }
+        if (pasos >= 255.5)
+        {
+            return 255;
+        }
+        return static_cast<std::uint8_t>(std::floor(pasos + 0.5));
+    }
+};
+
+#endif // CODIFICACIONVALORES_H
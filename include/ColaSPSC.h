@@ -0,0 +1,105 @@
+/**
+ * @file ColaSPSC.h
+ * @brief Cola circular sin bloqueo de un productor y un consumidor
+ * @author FabiRamiro
+ * @date 2026-10-18
+ */
+
+#ifndef COLASPSC_H
+#define COLASPSC_H
+
+#include <atomic>
+#include <cstddef>
+
+/**
+ * @class ColaSPSC
+ * @brief Cola circular lock-free para un hilo productor y un hilo consumidor
+ * @tparam T Tipo de elemento (debe ser copiable)
+ * @tparam CAPACIDAD Número de posiciones (potencia de 2)
+ *
+ * El productor solo escribe la cola (final) y el consumidor solo escribe la
+ * cabeza (inicio), así que basta con orden acquire/release entre ambos
+ * índices. Los índices están en líneas de caché separadas para que
+ * productor y consumidor no se invaliden mutuamente. Si la cola está llena
+ * insertar() falla sin bloquear y el elemento se cuenta como descartado.
+ */
+template <typename T, std::size_t CAPACIDAD>
+class ColaSPSC
+{
+    static_assert((CAPACIDAD & (CAPACIDAD - 1)) == 0, "La capacidad debe ser potencia de 2");
+
+private:
+    static const std::size_t MASCARA = CAPACIDAD - 1;
+
+    alignas(64) std::atomic<std::size_t> cabeza; ///< Próxima posición a leer (consumidor)
+    alignas(64) std::atomic<std::size_t> cola;   ///< Próxima posición a escribir (productor)
+    alignas(64) std::atomic<unsigned long> descartados; ///< Inserciones fallidas por cola llena
+    T elementos[CAPACIDAD];                       ///< Almacenamiento circular
+
+public:
+    /**
+     * @brief Constructor: cola vacía
+     */
+    ColaSPSC() : cabeza(0), cola(0), descartados(0) {}
+
+    /**
+     * @brief Inserta un elemento (solo desde el hilo productor)
+     * @param elemento Elemento a insertar
+     * @return false si la cola estaba llena
+     */
+    bool insertar(const T &elemento)
+    {
+        std::size_t posCola = cola.load(std::memory_order_relaxed);
+        if (posCola - cabeza.load(std::memory_order_acquire) == CAPACIDAD)
+        {
+            descartados.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        elementos[posCola & MASCARA] = elemento;
+        cola.store(posCola + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Extrae el elemento más antiguo (solo desde el hilo consumidor)
+     * @param elemento Destino del elemento extraído
+     * @return false si la cola estaba vacía
+     */
+    bool extraer(T &elemento)
+    {
+        std::size_t posCabeza = cabeza.load(std::memory_order_relaxed);
+        if (posCabeza == cola.load(std::memory_order_acquire))
+        {
+            return false;
+        }
+
+        elemento = elementos[posCabeza & MASCARA];
+        cabeza.store(posCabeza + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Número aproximado de elementos en la cola
+     * @return Elementos pendientes
+     */
+    std::size_t tamano() const
+    {
+        return cola.load(std::memory_order_acquire) - cabeza.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Número de elementos descartados por cola llena
+     * @return Inserciones fallidas
+     */
+    unsigned long getDescartados() const
+    {
+        return descartados.load(std::memory_order_relaxed);
+    }
+
+private:
+    ColaSPSC(const ColaSPSC &);            // No copiable
+    ColaSPSC &operator=(const ColaSPSC &); // No asignable
+};
+
+#endif // COLASPSC_H
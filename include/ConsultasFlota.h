@@ -0,0 +1,236 @@
+/**
+ * @file ConsultasFlota.h
+ * @brief Consultas agregadas y top-k sobre toda la flota de sensores
+ * @author FabiRamiro
+ * @date 2026-10-18
+ */
+
+#ifndef CONSULTASFLOTA_H
+#define CONSULTASFLOTA_H
+
+#include "SensorBase.h"
+
+/**
+ * @brief Campo del resumen por el que se ordena un top-k
+ */
+enum CampoConsulta
+{
+    CAMPO_ULTIMO = 0,   ///< Última lectura
+    CAMPO_PROMEDIO = 1, ///< Promedio histórico
+    CAMPO_MAXIMO = 2,   ///< Máximo histórico
+    CAMPO_MINIMO = 3    ///< Mínimo histórico
+};
+
+/**
+ * @brief Agregados de un sensor, actualizados en O(1) en cada lectura
+ */
+struct ResumenSensor
+{
+    const SensorBase *sensor;  ///< Sensor resumido
+    long long lecturas;        ///< Lecturas recibidas
+    double suma;               ///< Suma de las lecturas
+    double minimo;             ///< Menor lectura
+    double maximo;             ///< Mayor lectura
+    double ultimo;             ///< Última lectura
+    long long ultimaMs;        ///< Instante de la última lectura (o del registro)
+
+    /**
+     * @brief Promedio de las lecturas
+     * @return Promedio (0 si no hay lecturas)
+     */
+    double promedio() const
+    {
+        return (lecturas > 0) ? suma / lecturas : 0.0;
+    }
+
+    /**
+     * @brief Valor del campo pedido
+     * @param campo Campo a leer
+     * @return Valor del campo
+     */
+    double campo(CampoConsulta campo) const;
+};
+
+/**
+ * @brief Una posición del resultado de un top-k
+ */
+struct ResultadoTopK
+{
+    int manejador;      ///< Manejador del sensor
+    const char *nombre; ///< Nombre del sensor
+    double valor;       ///< Valor del campo consultado
+};
+
+/**
+ * @brief Resultado de una agregación sobre un grupo de sensores
+ */
+struct AgregadoFlota
+{
+    int sensores;          ///< Sensores que cumplen el filtro
+    int sensoresConDatos;  ///< De ellos, los que tienen al menos una lectura
+    long long lecturas;    ///< Lecturas totales del grupo
+    double suma;           ///< Suma de todas las lecturas
+    double minimo;         ///< Menor lectura del grupo
+    double maximo;         ///< Mayor lectura del grupo
+    double sumaUltimos;    ///< Suma de la última lectura de cada sensor
+
+    /**
+     * @brief Promedio de todas las lecturas del grupo
+     * @return Promedio (0 si no hay lecturas)
+     */
+    double promedio() const
+    {
+        return (lecturas > 0) ? suma / lecturas : 0.0;
+    }
+
+    /**
+     * @brief Promedio de la última lectura de cada sensor ("ahora mismo")
+     * @return Promedio (0 si ningún sensor tiene datos)
+     */
+    double promedioUltimos() const
+    {
+        return (sensoresConDatos > 0) ? sumaUltimos / sensoresConDatos : 0.0;
+    }
+};
+
+/**
+ * @class ConsultasFlota
+ * @brief Capa de consultas sobre la flota sin imprimir ni recorrer historiales
+ *
+ * Se registra como observador de ListaGeneral y mantiene un ResumenSensor
+ * por manejador que se actualiza en O(1) con cada lectura, así que las
+ * consultas nunca tocan las listas de lecturas.
+ *
+ * El filtro por prefijo de ID usa un índice de manejadores ordenado por
+ * nombre (se reconstruye solo cuando se registran o se dan de baja sensores): una
+ * búsqueda binaria ubica el primer nombre con el prefijo y se recorren
+ * únicamente los que coinciden. El top-k usa un montículo de tamaño k,
+ * O(n log k), sin ordenar el grupo completo. Los nombres se consideran
+ * fijos una vez registrado el sensor.
+ */
+class ConsultasFlota : public ObservadorLecturas
+{
+private:
+    ResumenSensor *resumenes; ///< Resumen de cada sensor, por manejador
+    int numSensores;          ///< Manejadores conocidos
+    int capacidad;            ///< Capacidad de resumenes
+
+    int *indiceNombres;       ///< Manejadores ordenados por nombre
+    int numIndexados;         ///< Manejadores en el índice
+    bool indiceValido;        ///< false si hay sensores sin indexar
+
+public:
+    /**
+     * @brief Constructor: sin sensores
+     */
+    ConsultasFlota();
+
+    /**
+     * @brief Destructor: libera resúmenes e índice
+     */
+    ~ConsultasFlota();
+
+    /**
+     * @brief Actualiza el resumen del sensor
+     * @param sensor Sensor que recibió la lectura
+     * @param valor Valor registrado
+     */
+    void lecturaRegistrada(SensorBase &sensor, double valor) override;
+
+    /**
+     * @brief Actualiza el resumen con un bloque de muestras
+     * @param sensor Sensor que recibió el bloque
+     * @param cuentas Muestras del bloque
+     * @param cantidad Número de muestras
+     */
+    void bloqueRegistrado(SensorBase &sensor, const int *cuentas, int cantidad) override;
+
+    /**
+     * @brief Crea el resumen vacío del sensor
+     * @param sensor Sensor registrado
+     * @param tipo Identificador del tipo en la arena
+     */
+    void sensorRegistrado(SensorBase &sensor, const void *tipo) override;
+
+    /**
+     * @brief Descarta el resumen de un sensor dado de baja
+     * @param sensor Sensor dado de baja
+     * @param manejador Manejador que tenía
+     */
+    void sensorEliminado(SensorBase &sensor, int manejador) override;
+
+    /**
+     * @brief Los k sensores con mayor (o menor) valor de un campo
+     * @param prefijo Prefijo del ID ("" = todos)
+     * @param k Número de posiciones pedidas
+     * @param campo Campo por el que se ordena
+     * @param mayores true para los mayores, false para los menores
+     * @param salida Arreglo de al menos k posiciones, ordenado al volver
+     * @return Posiciones llenadas (menos de k si el grupo es pequeño)
+     *
+     * Solo participan los sensores con al menos una lectura.
+     */
+    int topK(const char *prefijo, int k, CampoConsulta campo, bool mayores, ResultadoTopK *salida);
+
+    /**
+     * @brief Agregados del grupo de sensores con un prefijo
+     * @param prefijo Prefijo del ID ("" = todos)
+     * @return Conteos, suma, extremos y promedios del grupo
+     */
+    AgregadoFlota agregar(const char *prefijo);
+
+    /**
+     * @brief Sensores sin lecturas en los últimos milisegundos indicados
+     * @param prefijo Prefijo del ID ("" = todos)
+     * @param sinDatosMs Antigüedad mínima de la última lectura
+     * @param salida Manejadores encontrados (puede ser nullptr)
+     * @param maximo Capacidad de salida
+     * @return Total de sensores inactivos (puede superar maximo)
+     */
+    int inactivos(const char *prefijo, long long sinDatosMs, int *salida, int maximo);
+
+    /**
+     * @brief Resumen de un sensor
+     * @param manejador Manejador del sensor
+     * @return Resumen, nullptr si no existe
+     */
+    const ResumenSensor *getResumen(int manejador) const;
+
+    /**
+     * @brief Número de sensores conocidos
+     * @return Manejadores con resumen
+     */
+    int getNumSensores() const;
+
+    /**
+     * @brief Milisegundos del reloj monótono
+     * @return Marca de tiempo actual
+     */
+    static long long ahoraMs();
+
+private:
+    /**
+     * @brief Rango [desde, hasta) del índice cuyos nombres empiezan con el prefijo
+     * @param prefijo Prefijo buscado
+     * @param desde Primera posición del rango
+     * @param hasta Una posición después de la última
+     */
+    void rangoPrefijo(const char *prefijo, int &desde, int &hasta);
+
+    /**
+     * @brief Reordena el índice de nombres si hay sensores nuevos
+     */
+    void actualizarIndice();
+
+    /**
+     * @brief Resumen del sensor, nullptr si no está registrado
+     * @param sensor Sensor buscado
+     * @return Resumen modificable
+     */
+    ResumenSensor *resumenDe(const SensorBase &sensor);
+
+    ConsultasFlota(const ConsultasFlota &);            // No copiable
+    ConsultasFlota &operator=(const ConsultasFlota &); // No asignable
+};
+
+#endif // CONSULTASFLOTA_H
@@ -0,0 +1,225 @@
+/**
+ * @file EscritorReporte.h
+ * @brief Escritor de reportes con buffer grande y formateo rápido
+ * @author FabiRamiro
+ * @date 2026-10-18
+ */
+
+#ifndef ESCRITORREPORTE_H
+#define ESCRITORREPORTE_H
+
+/**
+ * @brief Formato de salida de un reporte
+ */
+enum FormatoReporte
+{
+    REPORTE_TEXTO = 0, ///< Texto para personas (el formato de siempre)
+    REPORTE_CSV = 1,   ///< Una fila por lectura: sensor,tipo,indice,valor
+    REPORTE_JSON = 2   ///< Una línea JSON por sensor (JSON lines)
+};
+
+/**
+ * @class EscritorReporte
+ * @brief Acumula texto en un buffer reutilizable y lo escribe en bloque
+ *
+ * Los números se formatean directamente en el buffer (std::to_chars) y
+ * nada se envía al sistema operativo hasta que el buffer se llena o se
+ * llama a vaciar(): cada vaciado es una sola llamada write(). Así un
+ * reporte con millones de lecturas no paga un formateo de ostream ni un
+ * flush por valor o por línea.
+ *
+ * Si el destino es la salida estándar, antes de escribir se vacía
+ * std::cout para que los mensajes previos salgan en orden.
+ */
+class EscritorReporte
+{
+public:
+    static const int TAM_BUFFER = 1 << 16; ///< Bytes del buffer (64 KB)
+
+private:
+    char *buffer;                 ///< Buffer de salida
+    int usados;                   ///< Bytes pendientes de escribir
+    int descriptor;               ///< Destino (1 = salida estándar)
+    bool propio;                  ///< true si el descriptor lo abrió este escritor
+    unsigned long long escritos;  ///< Bytes enviados en total
+    unsigned long vaciados;       ///< Llamadas de escritura realizadas
+
+public:
+    /**
+     * @brief Constructor
+     * @param destino Descriptor de archivo de destino (1 = salida estándar)
+     */
+    explicit EscritorReporte(int destino = 1);
+
+    /**
+     * @brief Destructor: vacía lo pendiente y cierra el archivo si es propio
+     */
+    ~EscritorReporte();
+
+    /**
+     * @brief Escritor compartido sobre la salida estándar (buffer reutilizado)
+     * @return Referencia al escritor de la salida estándar
+     */
+    static EscritorReporte &salidaEstandar();
+
+    /**
+     * @brief Redirige la salida a un archivo nuevo (lo trunca si existe)
+     * @param ruta Ruta del archivo
+     * @return false si no se pudo abrir
+     */
+    bool abrirArchivo(const char *ruta);
+
+    /**
+     * @brief Vacía lo pendiente y vuelve a la salida estándar
+     */
+    void cerrarArchivo();
+
+    /**
+     * @brief Escribe todo lo pendiente con una llamada al sistema
+     */
+    void vaciar();
+
+    /**
+     * @brief Agrega una cadena terminada en nulo
+     * @param texto Cadena (nullptr no escribe nada)
+     * @return Referencia al escritor
+     */
+    EscritorReporte &operator<<(const char *texto);
+
+    /**
+     * @brief Agrega un carácter
+     * @param c Carácter
+     * @return Referencia al escritor
+     */
+    EscritorReporte &operator<<(char c);
+
+    EscritorReporte &operator<<(int valor);                ///< Agrega un entero
+    EscritorReporte &operator<<(long valor);               ///< Agrega un entero largo
+    EscritorReporte &operator<<(long long valor);          ///< Agrega un entero largo
+    EscritorReporte &operator<<(unsigned long valor);      ///< Agrega un entero sin signo
+    EscritorReporte &operator<<(unsigned long long valor); ///< Agrega un entero sin signo
+    EscritorReporte &operator<<(float valor);              ///< Agrega un float (representación más corta)
+    EscritorReporte &operator<<(double valor);             ///< Agrega un double (representación más corta)
+
+    /**
+     * @brief Agrega un real con un número fijo de cifras significativas
+     * @param valor Valor a escribir
+     * @param cifras Cifras significativas (equivale a "%g" de printf)
+     * @return Referencia al escritor
+     *
+     * Para estadísticas calculadas, donde la representación más corta de
+     * un double resulta demasiado larga para leerla.
+     */
+    EscritorReporte &real(double valor, int cifras);
+
+    /**
+     * @brief Agrega una cadena JSON entre comillas, con escapes
+     * @param texto Cadena a escapar
+     * @return Referencia al escritor
+     */
+    EscritorReporte &cadenaJSON(const char *texto);
+
+    /**
+     * @brief Bytes enviados al destino desde la creación
+     * @return Total de bytes escritos
+     */
+    unsigned long long getBytesEscritos() const;
+
+    /**
+     * @brief Llamadas de escritura realizadas
+     * @return Número de vaciados con datos
+     */
+    unsigned long getVaciados() const;
+
+private:
+    /**
+     * @brief Garantiza espacio contiguo en el buffer
+     * @param bytes Bytes necesarios (como máximo TAM_BUFFER)
+     */
+    void reservar(int bytes)
+    {
+        if (usados + bytes > TAM_BUFFER)
+        {
+            vaciar();
+        }
+    }
+
+    EscritorReporte(const EscritorReporte &);            // No copiable
+    EscritorReporte &operator=(const EscritorReporte &); // No asignable
+};
+
+/**
+ * @brief Escribe las lecturas de una lista en el formato pedido
+ * @param escritor Destino
+ * @param lista Lista con begin()/end()/getContador() (ListaSensor)
+ * @param formato Formato del reporte
+ * @param nombre Nombre del sensor (para CSV)
+ * @param tipo Tipo corto del sensor (para CSV)
+ * @param limite Lecturas a mostrar al inicio y al final (0 = todas)
+ * @return Número de lecturas omitidas por el límite
+ *
+ * En TEXTO escribe "  Lecturas: a -> b -> ...\n"; en JSON escribe el
+ * arreglo de valores (sin salto de línea); en CSV una fila por lectura.
+ * Con límite, las lecturas intermedias se omiten y se indica cuántas.
+ */
+template <typename Lista>
+int escribirLecturas(EscritorReporte &escritor, const Lista &lista, FormatoReporte formato,
+                      const char *nombre, const char *tipo, int limite)
+{
+    int total = lista.getContador();
+    int omitidas = (limite > 0 && total > 2 * limite) ? total - 2 * limite : 0;
+    int finCabeza = (omitidas > 0) ? limite : total;
+    int inicioCola = finCabeza + omitidas;
+
+    if (formato == REPORTE_TEXTO && total == 0)
+    {
+        escritor << "  [Lista vacía]\n";
+        return 0;
+    }
+
+    if (formato == REPORTE_TEXTO)
+    {
+        escritor << "  Lecturas: ";
+    }
+    else if (formato == REPORTE_JSON)
+    {
+        escritor << '[';
+    }
+
+    int indice = 0;
+    for (typename Lista::const_iterator it = lista.begin(); it != lista.end(); ++it, ++indice)
+    {
+        if (indice >= finCabeza && indice < inicioCola)
+        {
+            continue;
+        }
+
+        if (formato == REPORTE_CSV)
+        {
+            escritor << nombre << ',' << tipo << ',' << indice << ',' << *it << '\n';
+            continue;
+        }
+
+        if (indice > 0)
+        {
+            escritor << (formato == REPORTE_TEXTO ? " -> " : ",");
+        }
+        if (indice == inicioCola && omitidas > 0 && formato == REPORTE_TEXTO)
+        {
+            escritor << "... (" << omitidas << " omitidas) ... -> ";
+        }
+        escritor << *it;
+    }
+
+    if (formato == REPORTE_TEXTO)
+    {
+        escritor << '\n';
+    }
+    else if (formato == REPORTE_JSON)
+    {
+        escritor << ']';
+    }
+    return omitidas;
+}
+
+#endif // ESCRITORREPORTE_H
@@ -0,0 +1,338 @@
+/**
+ * @file EstadisticasLista.h
+ * @brief Políticas de estadísticas en tiempo de compilación para ListaSensor
+ * @author FabiRamiro
+ * @date 2026-10-18
+ */
+
+#ifndef ESTADISTICASLISTA_H
+#define ESTADISTICASLISTA_H
+
+#include <cmath>
+#include <type_traits>
+
+/**
+ * @brief Tipo acumulador por defecto para un tipo de lectura
+ * @tparam T Tipo de las lecturas
+ *
+ * Los enteros acumulan en long long (sin desbordar en historiales largos);
+ * los flotantes en double.
+ */
+template <typename T>
+struct AcumuladorPorDefecto
+{
+    typedef typename std::conditional<std::is_integral<T>::value, long long, double>::type tipo;
+};
+
+/*
+ * Cada política de estadística es una plantilla <T, Acum> con la interfaz:
+ *  - void agregar(T valor)            al insertar
+ *  - void quitar(T valor)             al eliminar
+ *  - bool necesitaRecalculo() const   true si quitar() dejó el estado inválido
+ *  - void reiniciar()                 vuelve al estado de lista vacía
+ * ListaSensor hereda de las políticas elegidas: las que no se piden no
+ * ocupan memoria ni generan código.
+ */
+
+/**
+ * @brief Suma de las lecturas: promedio en O(1)
+ * @tparam T Tipo de las lecturas
+ * @tparam Acum Tipo acumulador
+ */
+template <typename T, typename Acum>
+class EstadisticaSuma
+{
+private:
+    Acum suma; ///< Suma de los valores presentes
+
+public:
+    EstadisticaSuma() : suma(0) {}
+
+    /**
+     * @brief Suma de los valores presentes
+     * @return Suma en el tipo acumulador
+     */
+    Acum getSuma() const
+    {
+        return suma;
+    }
+
+protected:
+    void agregar(T valor) { suma += static_cast<Acum>(valor); }
+    void quitar(T valor) { suma -= static_cast<Acum>(valor); }
+    bool necesitaRecalculo() const { return false; }
+    void reiniciar() { suma = 0; }
+};
+
+/**
+ * @brief Mínimo y máximo de las lecturas
+ * @tparam T Tipo de las lecturas
+ * @tparam Acum Tipo acumulador (no se usa)
+ *
+ * Quitar un valor que era el mínimo o el máximo obliga a recorrer la lista
+ * una vez para recalcularlos.
+ */
+template <typename T, typename Acum>
+class EstadisticaMinMax
+{
+private:
+    T minimo;      ///< Menor valor presente
+    T maximo;      ///< Mayor valor presente
+    bool hayDatos; ///< false si la lista está vacía
+    bool invalido; ///< Se quitó un extremo y hay que recalcular
+
+public:
+    EstadisticaMinMax() : minimo(T()), maximo(T()), hayDatos(false), invalido(false) {}
+
+    /**
+     * @brief Menor valor presente
+     * @return Mínimo (T() si la lista está vacía)
+     */
+    T getMinimo() const
+    {
+        return minimo;
+    }
+
+    /**
+     * @brief Mayor valor presente
+     * @return Máximo (T() si la lista está vacía)
+     */
+    T getMaximo() const
+    {
+        return maximo;
+    }
+
+protected:
+    void agregar(T valor)
+    {
+        if (!hayDatos)
+        {
+            minimo = valor;
+            maximo = valor;
+            hayDatos = true;
+            return;
+        }
+        minimo = (valor < minimo) ? valor : minimo;
+        maximo = (valor > maximo) ? valor : maximo;
+    }
+
+    void quitar(T valor)
+    {
+        if (!(minimo < valor) || !(valor < maximo))
+        {
+            invalido = true;
+        }
+    }
+
+    bool necesitaRecalculo() const { return invalido; }
+
+    void reiniciar()
+    {
+        minimo = T();
+        maximo = T();
+        hayDatos = false;
+        invalido = false;
+    }
+};
+
+/**
+ * @brief Media y varianza por el método de Welford (con eliminación)
+ * @tparam T Tipo de las lecturas
+ * @tparam Acum Tipo acumulador (si es entero, se usa double)
+ */
+template <typename T, typename Acum>
+class EstadisticaVarianza
+{
+public:
+    typedef typename std::conditional<std::is_floating_point<Acum>::value, Acum, double>::type Real;
+
+private:
+    long long n; ///< Valores presentes
+    Real media;  ///< Media móvil
+    Real m2;     ///< Suma de cuadrados de las desviaciones
+
+public:
+    EstadisticaVarianza() : n(0), media(0), m2(0) {}
+
+    /**
+     * @brief Varianza muestral de los valores presentes
+     * @return Varianza (0 con menos de dos valores)
+     */
+    Real getVarianza() const
+    {
+        return (n > 1) ? m2 / static_cast<Real>(n - 1) : Real(0);
+    }
+
+    /**
+     * @brief Desviación estándar muestral
+     * @return Raíz de la varianza
+     */
+    Real getDesviacion() const
+    {
+        return std::sqrt(getVarianza());
+    }
+
+protected:
+    void agregar(T valor)
+    {
+        Real x = static_cast<Real>(valor);
+        n++;
+        Real d = x - media;
+        media += d / static_cast<Real>(n);
+        m2 += d * (x - media);
+    }
+
+    void quitar(T valor)
+    {
+        if (n <= 1)
+        {
+            reiniciar();
+            return;
+        }
+        Real x = static_cast<Real>(valor);
+        n--;
+        Real d = x - media;
+        media -= d / static_cast<Real>(n);
+        m2 -= d * (x - media);
+        m2 = (m2 < Real(0)) ? Real(0) : m2; // Redondeo acumulado
+    }
+
+    bool necesitaRecalculo() const { return false; }
+
+    void reiniciar()
+    {
+        n = 0;
+        media = 0;
+        m2 = 0;
+    }
+};
+
+/**
+ * @brief Boceto de cuantiles con error relativo acotado (cubetas logarítmicas)
+ * @tparam T Tipo de las lecturas
+ * @tparam Acum Tipo acumulador (no se usa)
+ *
+ * Cada valor cae en la cubeta ceil(log_g |x|) con g = (1+a)/(1-a) y a = 5 %,
+ * así que cualquier cuantil se estima con error relativo de a lo sumo 5 %.
+ * El tamaño es fijo (~3 KB) e independiente del número de lecturas, y
+ * admite eliminaciones exactas. Los valores con |x| menor que g^-200 se
+ * cuentan como cero y los mayores que g^200 se saturan en la última cubeta.
+ */
+template <typename T, typename Acum>
+class EstadisticaBoceto
+{
+public:
+    static const int INDICE_MAXIMO = 200; ///< Cubetas por signo a cada lado de 1
+
+private:
+    static const int NUM_CUBETAS = 2 * INDICE_MAXIMO + 1;
+
+    int positivos[NUM_CUBETAS]; ///< Conteos de valores > 0
+    int negativos[NUM_CUBETAS]; ///< Conteos de valores < 0 (por magnitud)
+    int ceros;                  ///< Valores con magnitud despreciable
+    int total;                  ///< Valores presentes
+
+    static double gamma()
+    {
+        return 1.05 / 0.95;
+    }
+
+    static int indice(double magnitud)
+    {
+        int i = static_cast<int>(std::ceil(std::log(magnitud) / std::log(gamma())));
+        i = (i < -INDICE_MAXIMO) ? -INDICE_MAXIMO : i;
+        i = (i > INDICE_MAXIMO) ? INDICE_MAXIMO : i;
+        return i + INDICE_MAXIMO;
+    }
+
+    static double representante(int cubeta)
+    {
+        double g = gamma();
+        return 2.0 * std::pow(g, cubeta - INDICE_MAXIMO) / (g + 1.0);
+    }
+
+    void contar(T valor, int delta)
+    {
+        double x = static_cast<double>(valor);
+        if (std::fabs(x) < std::pow(gamma(), -INDICE_MAXIMO))
+        {
+            ceros += delta;
+        }
+        else if (x > 0)
+        {
+            positivos[indice(x)] += delta;
+        }
+        else
+        {
+            negativos[indice(-x)] += delta;
+        }
+        total += delta;
+    }
+
+public:
+    EstadisticaBoceto()
+    {
+        reiniciar();
+    }
+
+    /**
+     * @brief Estima un cuantil de los valores presentes
+     * @param q Cuantil en [0, 1] (0.5 = mediana)
+     * @return Valor aproximado (0 si la lista está vacía)
+     */
+    double getCuantil(double q) const
+    {
+        if (total == 0)
+        {
+            return 0.0;
+        }
+
+        q = (q < 0.0) ? 0.0 : ((q > 1.0) ? 1.0 : q);
+        int rango = static_cast<int>(q * (total - 1));
+        int acumulado = 0;
+
+        for (int i = NUM_CUBETAS - 1; i >= 0; i--)
+        {
+            acumulado += negativos[i];
+            if (acumulado > rango)
+            {
+                return -representante(i);
+            }
+        }
+
+        acumulado += ceros;
+        if (acumulado > rango)
+        {
+            return 0.0;
+        }
+
+        for (int i = 0; i < NUM_CUBETAS; i++)
+        {
+            acumulado += positivos[i];
+            if (acumulado > rango)
+            {
+                return representante(i);
+            }
+        }
+
+        return representante(NUM_CUBETAS - 1);
+    }
+
+protected:
+    void agregar(T valor) { contar(valor, 1); }
+    void quitar(T valor) { contar(valor, -1); }
+    bool necesitaRecalculo() const { return false; }
+
+    void reiniciar()
+    {
+        for (int i = 0; i < NUM_CUBETAS; i++)
+        {
+            positivos[i] = 0;
+            negativos[i] = 0;
+        }
+        ceros = 0;
+        total = 0;
+    }
+};
+
+#endif // ESTADISTICASLISTA_H
@@ -0,0 +1,124 @@
+/**
+ * @file GestorEpocas.h
+ * @brief Reclamación de memoria basada en épocas para lectores sin bloqueo
+ * @author FabiRamiro
+ * @date 2026-10-18
+ */
+
+#ifndef GESTOREPOCAS_H
+#define GESTOREPOCAS_H
+
+#include <atomic>
+
+/**
+ * @class GestorEpocas
+ * @brief Libera objetos retirados solo cuando ningún lector puede verlos
+ *
+ * Cada lector ocupa una ranura y, antes de leer una estructura compartida,
+ * la "fija" con la época global vigente; al terminar la suelta. El escritor,
+ * después de reemplazar un puntero compartido, retira el objeto viejo con
+ * la época actual y avanza la época. Un objeto retirado en la época e se
+ * libera cuando todas las ranuras activas tienen una época mayor que e.
+ *
+ * Los lectores nunca esperan y el escritor nunca espera a los lectores: si
+ * un lector tarda, los objetos retirados simplemente se acumulan hasta que
+ * termine. retirar() y reclamar() deben llamarse desde un único hilo escritor.
+ */
+class GestorEpocas
+{
+public:
+    static const int MAX_LECTORES = 64; ///< Ranuras de lector disponibles
+
+private:
+    /**
+     * @brief Ranura de un lector (una por línea de caché)
+     */
+    struct alignas(64) Ranura
+    {
+        std::atomic<unsigned long long> epoca; ///< Época fijada (0 = inactivo)
+        std::atomic<bool> ocupada;             ///< Ranura asignada a un lector
+    };
+
+    /**
+     * @brief Objeto retirado pendiente de liberar
+     */
+    struct Retirado
+    {
+        void *objeto;                 ///< Objeto a liberar
+        void (*liberar)(void *);      ///< Función que lo libera
+        unsigned long long epoca;     ///< Época en la que se retiró
+    };
+
+    Ranura ranuras[MAX_LECTORES];                 ///< Estado de cada lector
+    std::atomic<unsigned long long> epocaGlobal;  ///< Época vigente (empieza en 1)
+    Retirado *retirados;                          ///< Objetos pendientes (solo escritor)
+    int numRetirados;                             ///< Pendientes en uso
+    int capacidadRetirados;                       ///< Capacidad del arreglo
+    unsigned long liberados;                      ///< Total de objetos liberados
+
+public:
+    /**
+     * @brief Constructor: sin lectores ni objetos retirados
+     */
+    GestorEpocas();
+
+    /**
+     * @brief Destructor: libera todo lo pendiente (no debe haber lectores activos)
+     */
+    ~GestorEpocas();
+
+    /**
+     * @brief Reserva una ranura para un hilo lector
+     * @return Índice de la ranura, -1 si no hay libres
+     */
+    int registrarLector();
+
+    /**
+     * @brief Devuelve la ranura de un lector
+     * @param ranura Índice devuelto por registrarLector()
+     */
+    void liberarLector(int ranura);
+
+    /**
+     * @brief Marca el inicio de una lectura (sin bloqueo)
+     * @param ranura Ranura del lector
+     */
+    void fijar(int ranura);
+
+    /**
+     * @brief Marca el fin de una lectura
+     * @param ranura Ranura del lector
+     */
+    void soltar(int ranura);
+
+    /**
+     * @brief Retira un objeto que ya no es alcanzable desde el puntero compartido
+     * @param objeto Objeto a liberar más adelante
+     * @param liberar Función que lo libera
+     */
+    void retirar(void *objeto, void (*liberar)(void *));
+
+    /**
+     * @brief Libera los objetos que ningún lector activo puede estar viendo
+     * @return Número de objetos liberados
+     */
+    int reclamar();
+
+    /**
+     * @brief Objetos retirados que aún esperan a algún lector
+     * @return Cantidad pendiente
+     */
+    int getPendientes() const;
+
+    /**
+     * @brief Total de objetos liberados desde la creación
+     * @return Cantidad liberada
+     */
+    unsigned long getLiberados() const;
+
+private:
+    GestorEpocas(const GestorEpocas &);            // No copiable
+    GestorEpocas &operator=(const GestorEpocas &); // No asignable
+};
+
+#endif // GESTOREPOCAS_H
@@ -0,0 +1,237 @@
+/**
+ * @file GestorMemoria.h
+ * @brief Contabilidad de memoria por sensor y presupuesto global con desalojo
+ * @author FabiRamiro
+ * @date 2026-10-18
+ */
+
+#ifndef GESTORMEMORIA_H
+#define GESTORMEMORIA_H
+
+#include <atomic>
+#include <cstddef>
+#include "SensorBase.h"
+
+/**
+ * @brief Qué se descarta cuando la flota supera el presupuesto
+ */
+enum PoliticaDesalojo
+{
+    DESALOJO_LECTURAS_ANTIGUAS = 0, ///< El segmento más antiguo de toda la flota primero
+    DESALOJO_SENSORES_INACTIVOS = 1 ///< El historial del sensor que lleva más tiempo sin datos (LRU)
+};
+
+/**
+ * @class GestorMemoria
+ * @brief Observador que mide la memoria de cada sensor y hace cumplir un presupuesto
+ *
+ * Cada notificación de ingesta vuelve a medir al sensor con
+ * getBytesMemoria() (aritmética sobre contadores, O(1)) y actualiza el
+ * total de la flota por diferencia. Si el total supera el presupuesto se
+ * desaloja según la política, pero no dentro del aviso: el desalojo toca
+ * sensores de otros fragmentos, así que lo hace el hilo escritor en
+ * tomarDesalojos() (o al configurar y en las altas):
+ * - Lecturas antiguas: cada vez que un sensor crece (un segmento nuevo)
+ *   su manejador entra en una cola FIFO global; desalojar es sacar el
+ *   frente y descartar el segmento más antiguo de ese sensor.
+ * - Sensores inactivos: una lista LRU intrusiva (arreglos de anterior y
+ *   siguiente por manejador) se actualiza en O(1) con cada lectura
+ *   mientras esta política tenga presupuesto; desalojar es vaciar el
+ *   historial del sensor del final de la lista.
+ * Cada entrada de la cola y cada paso por la lista corresponde a una
+ * inserción previa, así que el desalojo es O(1) amortizado por inserción.
+ * Los sensores siempre conservan su segmento más reciente.
+ *
+ * Si aun desalojando no queda espacio, se rechaza el alta de sensores
+ * nuevos (ListaGeneral::crearSensor devuelve nullptr), que es lo que
+ * protege al sistema de una ráfaga de IDs desconocidos.
+ *
+ * Los avisos de ingesta de fragmentos distintos pueden llegar a la vez:
+ * la medición de cada sensor es suya, y el total, la FIFO y la lista LRU
+ * se actualizan bajo un spinlock interno que solo se toma cuando la
+ * medición cambia (un segmento nuevo) o cuando la política LRU está activa.
+ */
+class GestorMemoria : public ObservadorLecturas
+{
+private:
+    SensorBase **sensores;  ///< Sensores conocidos, por manejador
+    std::size_t *bytes;     ///< Última medición de cada sensor
+    int *anterior;          ///< LRU: sensor usado justo después (más reciente)
+    int *siguiente;         ///< LRU: sensor usado justo antes (más antiguo)
+    bool *enLRU;            ///< El sensor está enlazado en la lista LRU
+    int numSensores;        ///< Sensores conocidos
+    int capacidad;          ///< Capacidad de los arreglos por manejador
+    int masReciente;        ///< Cabeza de la lista LRU (-1 si vacía)
+    int menosReciente;      ///< Cola de la lista LRU (-1 si vacía)
+
+    int *colaSegmentos;     ///< FIFO de manejadores por segmento creado
+    int capacidadCola;      ///< Capacidad de la FIFO (potencia de 2)
+    int inicioCola;         ///< Frente de la FIFO
+    int tamanoCola;         ///< Entradas en la FIFO
+
+    std::size_t presupuesto; ///< Bytes permitidos (0 = sin límite)
+    PoliticaDesalojo politica; ///< Política de desalojo
+    std::size_t total;       ///< Bytes de toda la flota
+    std::size_t pico;        ///< Máximo total observado
+
+    unsigned long desalojos;        ///< Segmentos o historiales desalojados
+    long long lecturasDescartadas;  ///< Lecturas perdidas por desalojo
+    unsigned long altasRechazadas;  ///< Sensores nuevos rechazados
+    bool huboDesalojo;              ///< Desalojo desde la última consulta
+
+    std::atomic<bool> ocupado;      ///< Protege total, pico, FIFO y LRU entre fragmentos
+
+public:
+    /**
+     * @brief Constructor
+     * @param presupuestoBytes Bytes permitidos para toda la flota (0 = sin límite)
+     * @param politicaDesalojo Qué descartar al superar el presupuesto
+     */
+    GestorMemoria(std::size_t presupuestoBytes = 0, PoliticaDesalojo politicaDesalojo = DESALOJO_LECTURAS_ANTIGUAS);
+
+    /**
+     * @brief Destructor
+     */
+    ~GestorMemoria();
+
+    /**
+     * @brief Cambia el presupuesto y la política (desaloja de inmediato si hace falta)
+     * @param presupuestoBytes Bytes permitidos (0 = sin límite)
+     * @param politicaDesalojo Política de desalojo
+     */
+    void configurar(std::size_t presupuestoBytes, PoliticaDesalojo politicaDesalojo);
+
+    /**
+     * @brief Mide el sensor que recibió la lectura
+     * @param sensor Sensor que recibió la lectura
+     * @param valor Valor registrado
+     */
+    void lecturaRegistrada(SensorBase &sensor, double valor) override;
+
+    /**
+     * @brief Mide el sensor una sola vez por bloque
+     * @param sensor Sensor que recibió el bloque
+     * @param cuentas Muestras del bloque
+     * @param cantidad Número de muestras
+     */
+    void bloqueRegistrado(SensorBase &sensor, const int *cuentas, int cantidad) override;
+
+    /**
+     * @brief Vuelve a medir un sensor cuyo historial cambió fuera de la ingesta
+     * @param sensor Sensor procesado, desalojado o restaurado
+     */
+    void historialModificado(SensorBase &sensor) override;
+
+    /**
+     * @brief Empieza a contabilizar un sensor
+     * @param sensor Sensor registrado
+     * @param tipo Identificador del tipo en la arena
+     */
+    void sensorRegistrado(SensorBase &sensor, const void *tipo) override;
+
+    /**
+     * @brief Deja de contabilizar un sensor dado de baja y descuenta sus bytes
+     * @param sensor Sensor dado de baja
+     * @param manejador Manejador que tenía
+     *
+     * Sus entradas en la FIFO no se buscan: al salir se descartan si el
+     * manejador está libre o se aplican al sensor que lo reutilizó.
+     */
+    void sensorEliminado(SensorBase &sensor, int manejador) override;
+
+    /**
+     * @brief Rechaza el alta si el presupuesto está agotado aun desalojando
+     * @param nombre Identificador del sensor a crear
+     * @return true si hay espacio
+     */
+    bool admiteSensorNuevo(const char *nombre) override;
+
+    /**
+     * @brief Vuelve a medir todos los sensores
+     *
+     * Se usa después de operaciones que cambian los historiales sin pasar
+     * por la ingesta ni avisar por historialModificado().
+     */
+    void recalcular();
+
+    /**
+     * @brief Aplica el presupuesto e indica si hubo desalojos desde la última llamada
+     * @return true si algún historial cambió por el presupuesto
+     *
+     * Es donde la ingesta salda el exceso: debe llamarse desde el hilo
+     * escritor, sin avisos de ingesta en curso.
+     */
+    bool tomarDesalojos();
+
+    std::size_t getBytesTotales() const;    ///< Bytes de toda la flota
+    std::size_t getPico() const;            ///< Máximo total observado
+    std::size_t getPresupuesto() const;     ///< Bytes permitidos (0 = sin límite)
+    unsigned long getDesalojos() const;     ///< Desalojos realizados
+    long long getLecturasDescartadas() const; ///< Lecturas perdidas por desalojo
+    unsigned long getAltasRechazadas() const; ///< Sensores nuevos rechazados
+
+    /**
+     * @brief Bytes medidos de un sensor
+     * @param manejador Manejador del sensor
+     * @return Bytes (0 si el manejador no es válido)
+     */
+    std::size_t getBytesSensor(int manejador) const;
+
+    /**
+     * @brief Imprime el estado del presupuesto y los sensores que más ocupan
+     * @param maxSensores Sensores a listar
+     */
+    void imprimirEstadisticas(int maxSensores) const;
+
+private:
+    /**
+     * @brief Vuelve a medir un sensor y ajusta el total
+     * @param m Manejador
+     * @return Diferencia en bytes respecto de la medición anterior
+     */
+    long long medir(int m);
+
+    /**
+     * @brief Toma el spinlock interno
+     */
+    void bloquear();
+
+    /**
+     * @brief Suelta el spinlock interno
+     */
+    void desbloquear();
+
+    /**
+     * @brief Mueve el sensor al frente de la lista LRU
+     * @param m Manejador
+     */
+    void tocar(int m);
+
+    /**
+     * @brief Saca el sensor de la lista LRU
+     * @param m Manejador
+     */
+    void desenlazar(int m);
+
+    /**
+     * @brief Agrega un manejador al final de la FIFO de segmentos
+     * @param m Manejador
+     */
+    void encolarSegmento(int m);
+
+    /**
+     * @brief Desaloja hasta cumplir el presupuesto o quedarse sin candidatos
+     */
+    void aplicarPresupuesto();
+
+    /**
+     * @brief Asegura espacio para el manejador indicado
+     * @param m Manejador
+     */
+    void asegurarCapacidad(int m);
+
+    GestorMemoria(const GestorMemoria &);            // No copiable
+    GestorMemoria &operator=(const GestorMemoria &); // No asignable
+};
+
+#endif // GESTORMEMORIA_H
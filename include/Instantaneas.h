@@ -0,0 +1,259 @@
+/**
+ * @file Instantaneas.h
+ * @brief Instantáneas inmutables del estado de los sensores para lectores concurrentes
+ * @author FabiRamiro
+ * @date 2026-10-18
+ */
+
+#ifndef INSTANTANEAS_H
+#define INSTANTANEAS_H
+
+#include <atomic>
+#include "SensorBase.h"
+#include "GestorEpocas.h"
+
+/**
+ * @brief Copia inmutable del historial y resumen de un sensor
+ */
+struct InstantaneaSensor
+{
+    char nombre[50];       ///< Identificador del sensor
+    const char *tipo;      ///< Tipo corto (cadena estática: "TEMP", "PRES", ...)
+    int manejador;         ///< Índice del sensor en su registro
+    int numLecturas;       ///< Valores en el historial copiado
+    double *valores;       ///< Historial en orden de llegada
+    double promedio;       ///< Promedio del historial
+    double minimo;         ///< Valor mínimo del historial
+    double maximo;         ///< Valor máximo del historial
+    unsigned long version; ///< Versión del sensor con la que se construyó
+
+    /**
+     * @brief Imprime el resumen de la instantánea
+     */
+    void imprimir() const;
+};
+
+/**
+ * @brief Vista consistente de todos los sensores en un instante
+ *
+ * Los resúmenes de los sensores que no cambiaron se comparten entre
+ * instantáneas consecutivas; solo se copian los sensores modificados.
+ */
+struct InstantaneaFlota
+{
+    unsigned long numero;                 ///< Número de publicación
+    int numSensores;                      ///< Sensores en la vista
+    const InstantaneaSensor **sensores;   ///< Resumen de cada sensor, por manejador
+    long long lecturasTotales;            ///< Lecturas registradas hasta la publicación
+
+    /**
+     * @brief Imprime todos los sensores de la vista
+     */
+    void imprimir() const;
+};
+
+/**
+ * @class PublicadorInstantaneas
+ * @brief Publica instantáneas copy-on-write para leer el estado sin bloqueos
+ *
+ * El publicador se registra como observador de ListaGeneral; cada lectura
+ * marca a su sensor como modificado y suma a su contador propio, así que
+ * los avisos de fragmentos distintos no comparten estado. publicar(), en
+ * el hilo escritor, reconstruye solo los sensores modificados,
+ * arma una nueva InstantaneaFlota y la intercambia de forma atómica.
+ * Las versiones reemplazadas se retiran al GestorEpocas y se liberan
+ * cuando ningún lector las está usando.
+ *
+ * Los hilos lectores (reportes, promedios) usan LectorInstantaneas: nunca
+ * toman un mutex y siempre ven una vista completa y coherente, aunque la
+ * ingesta siga escribiendo en paralelo.
+ */
+class PublicadorInstantaneas : public ObservadorLecturas
+{
+private:
+    std::atomic<const InstantaneaFlota *> actual; ///< Última vista publicada
+
+    GestorEpocas epocas;                  ///< Reclamación de versiones viejas
+
+    SensorBase **sensores;                ///< Sensores conocidos, por manejador
+    const InstantaneaSensor **ultimas;    ///< Último resumen publicado de cada sensor
+    unsigned long *versiones;             ///< Versión actual de cada sensor
+    long long *lecturas;                  ///< Lecturas observadas de cada sensor
+    int numSensores;                      ///< Sensores conocidos
+    int capacidad;                        ///< Capacidad de los arreglos
+
+    unsigned long publicaciones;          ///< Vistas publicadas
+    long long lecturasRetiradas;          ///< Lecturas de sensores dados de baja
+    long long ultimaPublicacionMs;        ///< Momento de la última publicación (reloj monótono)
+
+public:
+    /**
+     * @brief Constructor: publica una vista vacía
+     */
+    PublicadorInstantaneas();
+
+    /**
+     * @brief Destructor: libera todas las vistas (no debe haber lectores activos)
+     */
+    ~PublicadorInstantaneas();
+
+    /**
+     * @brief Marca el sensor como modificado
+     * @param sensor Sensor que recibió la lectura
+     * @param valor Valor registrado
+     */
+    void lecturaRegistrada(SensorBase &sensor, double valor) override;
+
+    /**
+     * @brief Marca el sensor como modificado una sola vez por bloque
+     * @param sensor Sensor que recibió el bloque
+     * @param cuentas Muestras del bloque
+     * @param cantidad Número de muestras
+     */
+    void bloqueRegistrado(SensorBase &sensor, const int *cuentas, int cantidad) override;
+
+    /**
+     * @brief Agrega el sensor a las próximas vistas
+     * @param sensor Sensor registrado
+     * @param tipo Identificador del tipo en la arena
+     */
+    void sensorRegistrado(SensorBase &sensor, const void *tipo) override;
+
+    /**
+     * @brief Quita el sensor de las próximas vistas
+     * @param sensor Sensor dado de baja
+     * @param manejador Manejador que tenía
+     *
+     * Su último resumen sigue en la vista vigente: se retira al publicar
+     * la siguiente.
+     */
+    void sensorEliminado(SensorBase &sensor, int manejador) override;
+
+    /**
+     * @brief Marca el sensor como modificado (procesamiento, desalojo o restauración)
+     * @param sensor Sensor cuyo historial cambió fuera de la ingesta
+     */
+    void historialModificado(SensorBase &sensor) override;
+
+    /**
+     * @brief Marca todos los sensores como modificados
+     *
+     * Se usa después de operaciones que cambian el historial sin pasar por
+     * la ingesta ni avisar por historialModificado().
+     */
+    void invalidarTodo();
+
+    /**
+     * @brief Publica una vista nueva con los sensores modificados (solo hilo escritor)
+     * @return Número de sensores reconstruidos
+     */
+    int publicar();
+
+    /**
+     * @brief Publica solo si pasó el intervalo desde la última publicación
+     * @param intervaloMs Intervalo mínimo entre publicaciones
+     * @return true si se publicó una vista nueva
+     *
+     * Evita copiar historiales en cada lectura cuando la ingesta es rápida.
+     */
+    bool publicarPeriodico(int intervaloMs);
+
+    /**
+     * @brief Reserva una ranura de lector para el hilo que llama
+     * @return Ranura, -1 si no hay disponibles
+     */
+    int registrarLector();
+
+    /**
+     * @brief Libera una ranura de lector
+     * @param ranura Ranura devuelta por registrarLector()
+     */
+    void liberarLector(int ranura);
+
+    /**
+     * @brief Número de vistas publicadas
+     * @return Publicaciones realizadas
+     */
+    unsigned long getPublicaciones() const;
+
+    /**
+     * @brief Versiones retiradas que todavía esperan a algún lector
+     * @return Objetos pendientes de liberar
+     */
+    int getPendientes() const;
+
+private:
+    friend class LectorInstantaneas;
+
+    /**
+     * @brief Construye el resumen inmutable de un sensor
+     * @param m Manejador del sensor
+     * @return Nuevo resumen
+     */
+    const InstantaneaSensor *construir(int m) const;
+
+    /**
+     * @brief Asegura espacio para el manejador indicado
+     * @param m Manejador
+     */
+    void asegurarCapacidad(int m);
+
+    static void liberarSensor(void *objeto);
+    static void liberarFlota(void *objeto);
+
+    PublicadorInstantaneas(const PublicadorInstantaneas &);            // No copiable
+    PublicadorInstantaneas &operator=(const PublicadorInstantaneas &); // No asignable
+};
+
+/**
+ * @class LectorInstantaneas
+ * @brief Acceso de solo lectura a la vista publicada, sin bloqueos (RAII)
+ *
+ * Mientras el objeto existe la vista obtenida no se libera. Conviene
+ * mantenerlo vivo solo durante la lectura: un lector que nunca suelta su
+ * vista impide reclamar memoria, aunque no detiene al escritor.
+ */
+class LectorInstantaneas
+{
+private:
+    PublicadorInstantaneas &publicador; ///< Origen de las vistas
+    int ranura;                         ///< Ranura de épocas del hilo lector
+    const InstantaneaFlota *vista;      ///< Vista fijada
+
+public:
+    /**
+     * @brief Fija la vista más reciente
+     * @param origen Publicador de instantáneas
+     * @param ranuraLector Ranura obtenida con registrarLector()
+     */
+    LectorInstantaneas(PublicadorInstantaneas &origen, int ranuraLector);
+
+    /**
+     * @brief Suelta la vista fijada
+     */
+    ~LectorInstantaneas();
+
+    /**
+     * @brief Vista fijada
+     * @return Referencia a la vista
+     */
+    const InstantaneaFlota &operator*() const
+    {
+        return *vista;
+    }
+
+    /**
+     * @brief Acceso a los miembros de la vista fijada
+     * @return Puntero a la vista
+     */
+    const InstantaneaFlota *operator->() const
+    {
+        return vista;
+    }
+
+private:
+    LectorInstantaneas(const LectorInstantaneas &);            // No copiable
+    LectorInstantaneas &operator=(const LectorInstantaneas &); // No asignable
+};
+
+#endif // INSTANTANEAS_H
@@ -0,0 +1,102 @@
+/**
+ * @file LectorAnillo.h
+ * @brief Biblioteca de lectura del anillo de memoria compartida para consumidores locales
+ * @author FabiRamiro
+ * @date 2026-10-18
+ *
+ * Solo depende de AnilloCompartido.h: un tablero o un registrador se
+ * compila con este par de archivos (o enlaza la biblioteca LectorAnillo)
+ * sin arrastrar el resto del sistema.
+ */
+
+#ifndef LECTORANILLO_H
+#define LECTORANILLO_H
+
+#include "AnilloCompartido.h"
+
+/**
+ * @brief Resultado de pedir el siguiente registro
+ */
+enum ResultadoLectorAnillo
+{
+    LECTOR_ANILLO_REGISTRO = 0, ///< Se copió un registro
+    LECTOR_ANILLO_VACIO = 1,    ///< No hay registros nuevos todavía
+    LECTOR_ANILLO_PERDIDOS = 2  ///< El escritor sobrescribió registros no leídos: se saltó al más viejo disponible
+};
+
+/**
+ * @class LectorAnillo
+ * @brief Lector de un anillo publicado por PublicadorAnillo
+ *
+ * Cada lector lleva su propia posición (el número de secuencia del
+ * próximo registro) y no escribe nada en el segmento, que se mapea solo
+ * lectura: agregar lectores no afecta al escritor ni a los demás.
+ * siguiente() no hace llamadas al sistema; cuando no hay nada nuevo
+ * devuelve LECTOR_ANILLO_VACIO y es el consumidor quien decide si
+ * esperar o hacer otra cosa.
+ */
+class LectorAnillo
+{
+private:
+    const CabeceraAnillo *cabecera; ///< Segmento mapeado (nullptr = cerrado)
+    const RanuraAnillo *ranuras;    ///< Ranuras que siguen a la cabecera
+    std::uint64_t mascara;          ///< capacidad - 1
+    std::uint64_t capacidad;        ///< Ranuras del anillo
+    std::uint64_t tamano;           ///< Bytes mapeados
+    std::uint64_t posicion;         ///< Secuencia del próximo registro a leer
+    std::uint64_t perdidos;         ///< Registros sobrescritos antes de leerlos
+
+public:
+    /**
+     * @brief Constructor: lector cerrado
+     */
+    LectorAnillo();
+
+    /**
+     * @brief Destructor: desmapea el segmento
+     */
+    ~LectorAnillo();
+
+    /**
+     * @brief Se conecta a un anillo existente
+     * @param nombre Nombre del segmento (el mismo que se pasó al publicador)
+     * @param desdeElPrincipio true = empezar por el registro más viejo que se conserva,
+     *                         false = solo los que se publiquen a partir de ahora
+     * @return true si el segmento existe, está inicializado y tiene este formato
+     */
+    bool abrir(const char *nombre, bool desdeElPrincipio);
+
+    /**
+     * @brief Desmapea el segmento
+     */
+    void cerrar();
+
+    /**
+     * @brief Copia el siguiente registro y avanza la posición
+     * @param destino Registro copiado (solo válido con LECTOR_ANILLO_REGISTRO)
+     * @return Resultado de la lectura
+     */
+    ResultadoLectorAnillo siguiente(RegistroAnillo &destino);
+
+    /**
+     * @brief Indica si el escritor sigue publicando en este segmento
+     * @return false si el publicador lo cerró o lo reemplazó
+     */
+    bool escritorActivo() const;
+
+    /**
+     * @brief Registros publicados que este lector todavía no leyó
+     * @return Cantidad pendiente (puede superar la capacidad si el lector quedó atrás)
+     */
+    std::uint64_t getPendientes() const;
+
+    std::uint64_t getPosicion() const;  ///< Secuencia del próximo registro a leer
+    std::uint64_t getPerdidos() const;  ///< Registros sobrescritos antes de leerlos
+    std::uint64_t getCapacidad() const; ///< Ranuras del anillo
+
+private:
+    LectorAnillo(const LectorAnillo &);            // No copiable
+    LectorAnillo &operator=(const LectorAnillo &); // No asignable
+};
+
+#endif // LECTORANILLO_H
@@ -0,0 +1,171 @@
+/**
+ * @file LectorMultiPuerto.h
+ * @brief Lector de múltiples puertos serie con un único bucle epoll (Linux)
+ * @author FabiRamiro
+ * @date 2026-10-18
+ */
+
+#ifndef LECTORMULTIPUERTO_H
+#define LECTORMULTIPUERTO_H
+
+#include "ProtocoloBinario.h"
+
+#ifdef __linux__
+
+/**
+ * @class ReceptorLecturas
+ * @brief Interfaz que recibe los datos ya enmarcados de cada dispositivo
+ *
+ * Cada llamada indica el índice del dispositivo de origen, de modo que las
+ * lecturas quedan etiquetadas con la placa que las envió.
+ */
+class ReceptorLecturas
+{
+public:
+    /**
+     * @brief Destructor virtual
+     */
+    virtual ~ReceptorLecturas() {}
+
+    /**
+     * @brief Se invoca por cada línea completa de un dispositivo en modo texto
+     * @param dispositivo Índice del dispositivo de origen
+     * @param nombre Ruta del dispositivo (ej: "/dev/ttyUSB0")
+     * @param linea Línea recibida sin el salto de línea final
+     */
+    virtual void lineaRecibida(int dispositivo, const char *nombre, const char *linea) = 0;
+
+    /**
+     * @brief Se invoca por cada lectura de un dispositivo en modo binario
+     * @param dispositivo Índice del dispositivo de origen
+     * @param nombre Ruta del dispositivo
+     * @param lectura Lectura decodificada de la trama
+     */
+    virtual void lecturaRecibida(int dispositivo, const char *nombre, const LecturaBinaria &lectura) = 0;
+};
+
+/**
+ * @class LectorMultiPuerto
+ * @brief Gestiona decenas de puertos serie/pty desde un solo hilo con epoll
+ *
+ * Todos los descriptores se abren en modo no bloqueante y se registran en
+ * una instancia de epoll. Cada dispositivo tiene su propio buffer de línea
+ * (o su propio DecodificadorTramas en modo binario), así que los datos de
+ * distintas placas nunca se mezclan aunque lleguen intercalados. Si un
+ * dispositivo se desconecta (EOF, EIO, HUP) se cierra y se reintenta abrir
+ * con espera exponencial (de ESPERA_INICIAL_MS hasta ESPERA_MAXIMA_MS).
+ */
+class LectorMultiPuerto
+{
+public:
+    static const int MAX_DISPOSITIVOS = 64;    ///< Dispositivos simultáneos
+    static const int TAM_LINEA = 256;          ///< Longitud máxima de una línea
+    static const int ESPERA_INICIAL_MS = 100;  ///< Primera espera de reconexión
+    static const int ESPERA_MAXIMA_MS = 10000; ///< Tope de la espera de reconexión
+
+private:
+    /**
+     * @brief Estado de un dispositivo
+     */
+    struct Dispositivo
+    {
+        char ruta[64];                     ///< Ruta del dispositivo
+        int fd;                            ///< Descriptor abierto, -1 si desconectado
+        bool binario;                      ///< true = tramas binarias
+        char linea[TAM_LINEA];             ///< Línea en construcción (modo texto)
+        int longitudLinea;                 ///< Bytes acumulados en la línea
+        bool descartandoLinea;             ///< La línea actual excedió TAM_LINEA
+        DecodificadorTramas decodificador; ///< Decodificador propio (modo binario)
+        long long proximoIntentoMs;        ///< Instante del siguiente reintento
+        int esperaMs;                      ///< Espera actual de reconexión
+        unsigned long mensajes;            ///< Líneas o lecturas entregadas
+        unsigned long reconexiones;        ///< Reaperturas exitosas tras una caída
+    };
+
+    int epollFd;                                ///< Descriptor de epoll
+    Dispositivo dispositivos[MAX_DISPOSITIVOS]; ///< Dispositivos registrados
+    int numDispositivos;                        ///< Dispositivos en uso
+
+public:
+    /**
+     * @brief Constructor: crea la instancia de epoll
+     */
+    LectorMultiPuerto();
+
+    /**
+     * @brief Destructor: cierra todos los descriptores
+     */
+    ~LectorMultiPuerto();
+
+    /**
+     * @brief Registra un dispositivo e intenta abrirlo
+     * @param ruta Ruta del puerto (ej: "/dev/ttyUSB0", "/dev/pts/3")
+     * @param binario true si el dispositivo envía tramas binarias
+     * @return Índice del dispositivo, -1 si no hay espacio
+     *
+     * Si la apertura falla el dispositivo queda registrado y se reintenta
+     * automáticamente con espera exponencial.
+     */
+    int agregarPuerto(const char *ruta, bool binario);
+
+    /**
+     * @brief Espera eventos y entrega al receptor los datos enmarcados
+     * @param timeoutMs Espera máxima en milisegundos (-1 = indefinida)
+     * @param receptor Destino de las líneas/lecturas
+     * @return Número de líneas o lecturas entregadas, -1 si epoll falló
+     */
+    int ejecutarCiclo(int timeoutMs, ReceptorLecturas &receptor);
+
+    /**
+     * @brief Número de dispositivos registrados
+     * @return Cantidad de dispositivos
+     */
+    int getNumDispositivos() const;
+
+    /**
+     * @brief Número de dispositivos con el descriptor abierto
+     * @return Cantidad de dispositivos conectados
+     */
+    int getConectados() const;
+
+    /**
+     * @brief Imprime el estado y contadores de cada dispositivo
+     */
+    void imprimirEstado() const;
+
+private:
+    LectorMultiPuerto(const LectorMultiPuerto &);            // No copiable
+    LectorMultiPuerto &operator=(const LectorMultiPuerto &); // No asignable
+
+    /**
+     * @brief Abre y configura (raw, 115200) el dispositivo indicado
+     * @return true si quedó abierto y registrado en epoll
+     */
+    bool abrir(int indice, long long ahoraMs);
+
+    /**
+     * @brief Cierra el dispositivo y programa la reconexión
+     */
+    void desconectar(int indice, long long ahoraMs);
+
+    /**
+     * @brief Lee todo lo disponible y lo enmarca por dispositivo
+     * @return Mensajes entregados al receptor
+     */
+    int leerDispositivo(int indice, long long ahoraMs, ReceptorLecturas &receptor);
+
+    /**
+     * @brief Reintenta abrir los dispositivos cuyo plazo ya venció
+     * @return Milisegundos hasta el próximo reintento pendiente (-1 si no hay)
+     */
+    int reintentarConexiones(long long ahoraMs);
+
+    /**
+     * @brief Reloj monotónico en milisegundos
+     */
+    static long long ahoraMilisegundos();
+};
+
+#endif // __linux__
+
+#endif // LECTORMULTIPUERTO_H
@@ -1,6 +1,6 @@
 /**
  * @file ListaGeneral.h
- * @brief Lista enlazada NO genérica para gestión polimórfica de sensores
+ * @brief Registro contiguo NO genérico para gestión polimórfica de sensores
  * @author FabiRamiro
  * @date 2025-10-31
  */
@@ -8,62 +8,276 @@
 #ifndef LISTAGENERAL_H
 #define LISTAGENERAL_H
 
+#include <atomic>
+#include <mutex>
 #include "SensorBase.h"
+#include "ArenaSensores.h"
+#include "GestorEpocas.h"
 
 /**
- * @brief Nodo para la lista de gestión polimórfica
+ * @class ListaGeneral
+ * @brief Registro de sensores para gestionar múltiples tipos de sensores
+ *
+ * Utiliza polimorfismo para almacenar diferentes tipos de sensores
+ * (SensorTemperatura, SensorPresion) en una única estructura.
+ *
+ * Los sensores se guardan en un arreglo contiguo de punteros a SensorBase
+ * (acceso O(1) por índice) y los objetos se construyen en una ArenaSensores,
+ * agrupados por tipo en slabs contiguos. El índice de cada sensor es un
+ * manejador estable: no cambia mientras el sensor esté registrado.
+ *
+ * Un sensor sale del registro con eliminarSensor() o, si lleva más de un
+ * TTL sin lecturas, con expirarInactivos(). Su manejador queda libre para
+ * la próxima alta y los recorridos usan un arreglo denso de manejadores
+ * vivos, así que el costo de una pasada depende de los sensores vivos y no
+ * de cuántos pasaron por el registro. El objeto no se destruye en el acto:
+ * se retira a un GestorEpocas y se libera (con su casilla de la arena) en
+ * la siguiente baja o reclamarEliminados(), cuando ningún lector fijado
+ * con LectorRegistro puede estar usándolo.
+ *
+ * La lista es además el observador de todos sus sensores: cada lectura
+ * registrada se reenvía a los observadores agregados con
+ * agregarObservador() (motor de alertas, etc.).
+ *
+ * Al reenviar, la lista marca al sensor como modificado y lo agrega a una
+ * lista de modificados (O(1) por lectura). procesarModificados() recorre
+ * solo esa lista: el costo de la pasada depende de cuántos sensores
+ * cambiaron y no del tamaño de la flota, y los demás conservan en caché
+ * el ResultadoProceso de su último procesamiento.
  *
- * Almacena punteros a SensorBase para aprovechar el polimorfismo
+ * El registro está dividido en fragmentos (potencia de dos) según el hash
+ * del nombre. Cada fragmento tiene su índice por nombre (tabla hash), su
+ * lista de modificados y un cerrojo propio en su línea de caché, así que
+ * buscarSensor(), buscarIndice(), obtenerSensor() y el aviso de cada
+ * lectura pueden llamarse desde varios hilos a la vez y solo compiten los
+ * que caen en el mismo fragmento. Las altas se serializan entre sí, pero no
+ * frenan a las búsquedas. La casilla de cada manejador es atómica: una
+ * búsqueda por manejador concurrente con una baja ve el sensor o nullptr.
+ *
+ * Cada fragmento tiene también su cerrojo de despacho: los avisos de
+ * ingesta (lecturas, bloques y cambios de historial) de sensores de
+ * fragmentos distintos llegan a los observadores a la vez, y los de un
+ * mismo fragmento en orden. Las altas, las bajas y admiteSensorNuevo()
+ * toman todos los cerrojos de despacho (en orden de fragmento), así que
+ * ningún aviso de ingesta queda a medias. Por eso los observadores deben
+ * tolerar avisos concurrentes de sensores distintos: el estado de cada
+ * sensor es solo suyo y lo compartido va protegido (ver cada observador).
+ * Se agregan antes de empezar a registrar desde varios hilos, y sus
+ * propios métodos (drenar alertas, presupuesto, punto de control)
+ * corresponden al hilo escritor y no deben correr junto a esa ingesta.
+ *
+ * Los recorridos de toda la flota (procesar, imprimir, reportes) siguen el
+ * orden de inserción, sin importar el fragmento ni los manejadores
+ * reutilizados; la lista de modificados se entrega ordenada por manejador.
+ * Un sensor no debe procesarse mientras otro hilo le registra lecturas.
+ * Altas, bajas y pasadas corresponden al hilo escritor; un hilo que busca
+ * sensores mientras puede haber bajas lo hace dentro de un LectorRegistro.
  */
-struct NodoSensor
+class ListaGeneral : public ObservadorLecturas
 {
-    SensorBase *sensor;    ///< Puntero polimórfico al sensor
-    NodoSensor *siguiente; ///< Puntero al siguiente nodo
+public:
+    static const int MAX_OBSERVADORES = 8;     ///< Observadores de ingesta simultáneos
+    static const int FRAGMENTOS_DEFECTO = 16;  ///< Fragmentos del registro por defecto
+    static const int MAX_FRAGMENTOS = 256;     ///< Fragmentos máximos
+
+private:
+    static const int MAX_RETIRADOS = 32; ///< Crecimientos posibles de los arreglos (al doble desde 16)
 
     /**
-     * @brief Constructor del nodo
-     * @param s Puntero al sensor
+     * @brief Casilla del índice por nombre de un fragmento
      */
-    NodoSensor(SensorBase *s) : sensor(s), siguiente(nullptr) {}
-};
+    struct EntradaIndice
+    {
+        unsigned hash;      ///< Hash del nombre
+        int manejador;      ///< Manejador del sensor
+        SensorBase *sensor; ///< Sensor (nullptr = casilla libre)
+    };
 
-/**
- * @class ListaGeneral
- * @brief Lista enlazada simple para gestionar múltiples tipos de sensores
- *
- * Utiliza polimorfismo para almacenar diferentes tipos de sensores
- * (SensorTemperatura, SensorPresion) en una única estructura
- */
-class ListaGeneral
-{
-private:
-    NodoSensor *cabeza; ///< Primer nodo de la lista
-    int contador;       ///< Número de sensores en la lista
+    /**
+     * @brief Sensor dado de baja que espera a los lectores para liberarse
+     */
+    struct Baja
+    {
+        ListaGeneral *lista; ///< Registro dueño de la arena
+        SensorBase *sensor;  ///< Sensor a destruir
+        const void *tipo;    ///< Pool de la arena, nullptr si se creó con new
+    };
+
+    /**
+     * @brief Fragmento del registro (uno por línea de caché)
+     */
+    struct alignas(64) Fragmento
+    {
+        std::atomic<bool> ocupado; ///< Cerrojo de giro del fragmento
+        std::recursive_mutex despacho; ///< Serializa los avisos de los sensores del fragmento
+        EntradaIndice *tabla;      ///< Índice por nombre con sondeo lineal
+        int capacidadTabla;        ///< Casillas de la tabla (potencia de dos)
+        int numEntradas;           ///< Casillas ocupadas
+        int *modificados;          ///< Manejadores modificados, en orden de primera modificación
+        int numModificados;        ///< Manejadores en modificados
+        int capacidadModificados;  ///< Capacidad de modificados
+    };
+
+    std::atomic<std::atomic<SensorBase *> *> sensores; ///< Sensor de cada manejador (nullptr si está libre)
+    std::atomic<const void **> tipos;    ///< Tipo de arena de cada sensor (nullptr si se creó con new)
+    std::atomic<int> numManejadores;     ///< Manejadores asignados alguna vez (el mayor + 1)
+    int capacidad;                       ///< Capacidad reservada de los arreglos
+    ArenaSensores arena;                 ///< Memoria de los sensores creados con crearSensor()
+
+    int *vivos;     ///< Manejadores de los sensores registrados, en orden de alta
+    int numVivos;   ///< Sensores registrados
+    int *libres;    ///< Manejadores liberados por bajas, para reutilizar
+    int numLibres;  ///< Manejadores en libres
+    GestorEpocas epocas;  ///< Sensores dados de baja pendientes de liberar
+    unsigned long bajas;  ///< Sensores dados de baja desde la creación
+
+    // Al crecer, los arreglos viejos se conservan hasta el destructor: un
+    // lector sin cerrojo puede estar usándolos (a lo sumo duplican la memoria)
+    std::atomic<SensorBase *> *sensoresRetirados[MAX_RETIRADOS]; ///< Arreglos de sensores reemplazados
+    const void **tiposRetirados[MAX_RETIRADOS];    ///< Arreglos de tipos reemplazados
+    int numRetirados;                              ///< Arreglos reemplazados de cada clase
+
+    Fragmento *fragmentos;  ///< Fragmentos del registro
+    int numFragmentos;      ///< Cantidad de fragmentos (potencia de dos)
+    alignas(64) std::atomic<bool> altaOcupada; ///< Serializa las altas
+
+    ObservadorLecturas *observadores[MAX_OBSERVADORES]; ///< Destinos de cada lectura
+    int numObservadores;                                ///< Observadores en uso
+    bool *modificados;     ///< El sensor cambió (se escribe con el cerrojo de su fragmento)
+    long long *ultimaLectura; ///< Ms (reloj monótono) de la última lectura o del alta, con el mismo cerrojo
+    int *listaModificados; ///< Modificados de todos los fragmentos, por manejador (getModificados)
+    int capacidadLista;    ///< Capacidad de listaModificados
+    bool silencioso;       ///< Sin mensajes de altas, bajas ni procesamiento (también en los sensores)
 
 public:
     /**
-     * @brief Constructor por defecto
+     * @brief Constructor
+     * @param fragmentos Fragmentos del registro (se redondea a potencia de dos, 1..MAX_FRAGMENTOS)
      */
-    ListaGeneral();
+    explicit ListaGeneral(int fragmentos = FRAGMENTOS_DEFECTO);
 
     /**
-     * @brief Destructor - Libera todos los sensores y nodos
+     * @brief Destructor - Libera todos los sensores
+     *
+     * Los sensores de la arena se destruyen en bloque; los insertados
+     * con insertarSensor() se liberan con delete.
      */
     ~ListaGeneral();
 
+    /**
+     * @brief Crea un sensor de tipo S en la arena y lo registra
+     * @tparam S Tipo concreto del sensor (SensorTemperatura, SensorPresion...)
+     * @param nombre Identificador del sensor
+     * @return Puntero estable al sensor creado, nullptr si algún observador rechazó el alta
+     */
+    template <typename S>
+    S *crearSensor(const char *nombre)
+    {
+        bloquearAlta();
+        S *sensor = nullptr;
+        if (admiteSensorNuevo(nombre))
+        {
+            sensor = arena.crear<S>(nombre);
+            registrar(sensor, ArenaSensores::idTipo<S>());
+        }
+        desbloquearAlta();
+        return sensor;
+    }
+
     /**
      * @brief Inserta un nuevo sensor en la lista
-     * @param sensor Puntero al sensor a insertar
+     * @param sensor Puntero al sensor a insertar (creado con new; la lista toma su propiedad)
      */
     void insertarSensor(SensorBase *sensor);
 
+    /**
+     * @brief Da de baja un sensor
+     * @param nombre Identificador del sensor
+     * @return false si no existe
+     *
+     * Deja de encontrarse por nombre y de recorrerse en el acto; los
+     * observadores reciben sensorEliminado(). El objeto se libera más
+     * tarde (ver reclamarEliminados()).
+     */
+    bool eliminarSensor(const char *nombre);
+
+    /**
+     * @brief Da de baja los sensores que llevan más de un TTL sin lecturas
+     * @param ttlMs Milisegundos sin lecturas (desde el alta si nunca recibió una)
+     * @return Sensores dados de baja
+     *
+     * Una sola pasada sobre los vivos; el arreglo de vivos se compacta una
+     * vez al final. Las lecturas restauradas o reproducidas cuentan como
+     * lecturas.
+     */
+    int expirarInactivos(long long ttlMs);
+
+    /**
+     * @brief Libera los sensores dados de baja que ningún lector fijado puede ver
+     * @return Sensores liberados
+     *
+     * Cada baja reclama primero las anteriores, así que un sensor dado de
+     * baja sigue siendo válido al menos hasta la siguiente baja: quien
+     * guardó su nombre (una alerta en cola) tiene ese margen para usarlo.
+     */
+    int reclamarEliminados();
+
+    /**
+     * @brief Sensores dados de baja que aún no se liberaron
+     * @return Bajas pendientes
+     */
+    int getBajasPendientes() const;
+
+    /**
+     * @brief Reserva una ranura de lector para un hilo que busca sensores
+     * @return Ranura, -1 si no hay disponibles
+     */
+    int registrarLector();
+
+    /**
+     * @brief Libera una ranura de lector
+     * @param ranura Ranura devuelta por registrarLector()
+     */
+    void liberarLector(int ranura);
+
     /**
      * @brief Busca un sensor por su nombre
      * @param nombre Identificador del sensor
      * @return Puntero al sensor encontrado, nullptr si no existe
+     *
+     * Fuera del hilo escritor, el puntero vale mientras dure el
+     * LectorRegistro dentro del cual se buscó.
      */
     SensorBase *buscarSensor(const char *nombre) const;
 
+    /**
+     * @brief Busca el manejador (índice) de un sensor por su nombre
+     * @param nombre Identificador del sensor
+     * @return Índice del sensor, -1 si no existe
+     */
+    int buscarIndice(const char *nombre) const;
+
+    /**
+     * @brief Acceso O(1) a un sensor por su manejador
+     * @param indice Manejador devuelto por buscarIndice() (0..getNumManejadores()-1)
+     * @return Puntero al sensor, nullptr si el índice no es válido o está libre
+     */
+    SensorBase *obtenerSensor(int indice) const;
+
+    /**
+     * @brief Acceso a los sensores registrados en orden de alta
+     * @param posicion Posición (0..getContador()-1)
+     * @return Puntero al sensor, nullptr si la posición no es válida
+     */
+    SensorBase *obtenerVivo(int posicion) const;
+
+    /**
+     * @brief Momento de la última lectura de un sensor
+     * @param indice Manejador del sensor
+     * @return Ms del reloj monótono (del alta si no tuvo lecturas), -1 si el manejador está libre
+     */
+    long long getUltimaLectura(int indice) const;
+
     /**
      * @brief Procesa todos los sensores de la lista polimórficamente
      *
@@ -71,16 +285,345 @@ public:
      */
     void procesarTodosSensores();
 
+    /**
+     * @brief Procesa los sensores agrupados por tipo, sin llamadas virtuales
+     *
+     * Cada tipo de TiposRegistrados (ver RegistroTipos.h) se procesa como un
+     * lote monomórfico sobre su pool contiguo de la arena. Los sensores de
+     * otros tipos o insertados con insertarSensor() se procesan después con
+     * la llamada polimórfica habitual.
+     */
+    void procesarPorLotes();
+
+    /**
+     * @brief Procesa solo los sensores que cambiaron desde su último procesamiento
+     * @return Sensores procesados
+     *
+     * Los sensores sin lecturas nuevas no se visitan: su ResultadoProceso
+     * anterior sigue vigente (ver imprimirResultados()).
+     */
+    int procesarModificados();
+
+    /**
+     * @brief Procesa los sensores indicados y los marca como al día
+     * @param manejadores Manejadores a procesar (se ignoran los inválidos)
+     * @param cantidad Número de manejadores
+     * @return Sensores procesados
+     *
+     * Lo usan procesarModificados() y la bitácora, que repite así una
+     * pasada incremental exactamente sobre los mismos sensores.
+     */
+    int procesarSensores(const int *manejadores, int cantidad);
+
+    /**
+     * @brief Obtiene la lista de sensores modificados de todos los fragmentos
+     * @return Manejadores en orden creciente (válido hasta la siguiente llamada o pasada)
+     */
+    const int *getModificados();
+
+    /**
+     * @brief Obtiene el número de sensores modificados
+     * @return Sensores pendientes de procesar
+     */
+    int getNumModificados() const;
+
+    /**
+     * @brief Imprime el último resultado de cada sensor sin volver a procesar
+     */
+    void imprimirResultados() const;
+
     /**
      * @brief Imprime información de todos los sensores
      */
     void imprimirTodosSensores() const;
 
+    /**
+     * @brief Escribe el reporte de todos los sensores
+     * @param escritor Destino del reporte
+     * @param formato Texto, CSV (con cabecera) o JSON lines (una línea por sensor)
+     * @param limite Lecturas a mostrar al inicio y al final de cada sensor (0 = todas)
+     *
+     * No vacía el escritor: quien llama decide cuándo escribir.
+     */
+    void escribirReporte(EscritorReporte &escritor, FormatoReporte formato, int limite) const;
+
+    /**
+     * @brief Registra lo que espera en las ventanas de secuencias de todos los sensores
+     * @return Lecturas registradas
+     *
+     * Se llama al terminar una captura o antes de procesar, para que una
+     * lectura que espera un hueco que nunca llegará no quede retenida.
+     */
+    int vaciarReordenamientos();
+
+    /**
+     * @brief Imprime las estadísticas de secuencias de los sensores con lecturas numeradas
+     */
+    void imprimirReordenamiento() const;
+
+    /**
+     * @brief Obtiene el número de fragmentos del registro
+     * @return Fragmentos (potencia de dos)
+     */
+    int getNumFragmentos() const;
+
+    /**
+     * @brief Imprime cuántos sensores y modificados tiene cada fragmento
+     */
+    void imprimirFragmentos() const;
+
     /**
      * @brief Obtiene el número de sensores registrados
-     * @return Cantidad de sensores
+     * @return Cantidad de sensores vivos
      */
     int getContador() const;
+
+    /**
+     * @brief Cota de los manejadores asignados
+     * @return El mayor manejador asignado + 1 (incluye los libres)
+     */
+    int getNumManejadores() const;
+
+    /**
+     * @brief Imprime sensores vivos, manejadores libres, bajas y objetos de la arena
+     */
+    void imprimirBajas() const;
+
+    /**
+     * @brief Agrega un observador que recibirá cada lectura de cada sensor
+     * @param observador Observador (no se toma su propiedad)
+     * @return false si ya hay MAX_OBSERVADORES
+     *
+     * El observador recibe sensorRegistrado() de los sensores ya existentes
+     * antes de empezar a recibir lecturas.
+     */
+    bool agregarObservador(ObservadorLecturas *observador);
+
+    /**
+     * @brief Activa o desactiva los mensajes informativos del registro y de sus sensores
+     * @param activo true para no informar altas, bajas, lecturas ni procesamiento
+     *
+     * Se aplica a los sensores registrados y a los que se registren
+     * mientras siga activo. Las advertencias y los rechazos se imprimen
+     * siempre; solo lo que el sensor informa al construirse queda fuera.
+     */
+    void setSilencioso(bool activo);
+
+    /**
+     * @brief Reenvía una lectura a todos los observadores
+     * @param sensor Sensor que recibió la lectura
+     * @param valor Valor registrado
+     */
+    void lecturaRegistrada(SensorBase &sensor, double valor) override;
+
+    /**
+     * @brief Reenvía un bloque de muestras a todos los observadores
+     * @param sensor Sensor que recibió el bloque
+     * @param cuentas Muestras del bloque
+     * @param cantidad Número de muestras
+     */
+    void bloqueRegistrado(SensorBase &sensor, const int *cuentas, int cantidad) override;
+
+    /**
+     * @brief Marca el sensor como modificado y reenvía el aviso a los observadores
+     * @param sensor Sensor cuyo historial cambió fuera de la ingesta
+     */
+    void historialModificado(SensorBase &sensor) override;
+
+private:
+    friend class LectorRegistro;
+
+    ListaGeneral(const ListaGeneral &);            // No copiable
+    ListaGeneral &operator=(const ListaGeneral &); // No asignable
+
+    /**
+     * @brief Milisegundos del reloj monótono
+     * @return Marca de tiempo actual
+     */
+    static long long ahoraMs();
+
+    /**
+     * @brief Hash del nombre de un sensor (FNV-1a con mezcla final)
+     * @param nombre Identificador del sensor
+     * @return Hash; los bits altos eligen el fragmento y los bajos la casilla
+     */
+    static unsigned hashNombre(const char *nombre);
+
+    /**
+     * @brief Fragmento al que pertenece un hash
+     * @param hash Hash del nombre
+     * @return Fragmento
+     */
+    Fragmento &fragmentoDe(unsigned hash) const;
+
+    /**
+     * @brief Toma el cerrojo de un fragmento (espera activa)
+     * @param fragmento Fragmento a bloquear
+     */
+    static void bloquear(Fragmento &fragmento);
+
+    /**
+     * @brief Suelta el cerrojo de un fragmento
+     * @param fragmento Fragmento a liberar
+     */
+    static void desbloquear(Fragmento &fragmento);
+
+    /**
+     * @brief Toma el cerrojo de altas
+     */
+    void bloquearAlta();
+
+    /**
+     * @brief Suelta el cerrojo de altas
+     */
+    void desbloquearAlta();
+
+    /**
+     * @brief Toma los cerrojos de despacho de todos los fragmentos (altas y bajas)
+     */
+    void pausarAvisos() const;
+
+    /**
+     * @brief Suelta los cerrojos de despacho en orden inverso
+     */
+    void reanudarAvisos() const;
+
+    /**
+     * @brief Agrega un sensor al índice de su fragmento (con el cerrojo tomado)
+     * @param fragmento Fragmento del sensor
+     * @param hash Hash del nombre
+     * @param manejador Manejador del sensor
+     * @param sensor Sensor
+     */
+    static void indexar(Fragmento &fragmento, unsigned hash, int manejador, SensorBase *sensor);
+
+    /**
+     * @brief Quita un manejador del índice de su fragmento (con el cerrojo tomado)
+     * @param fragmento Fragmento del sensor
+     * @param hash Hash del nombre
+     * @param manejador Manejador a quitar
+     *
+     * Borrado con corrimiento hacia atrás: el sondeo lineal sigue sin lápidas.
+     */
+    static void desindexar(Fragmento &fragmento, unsigned hash, int manejador);
+
+    /**
+     * @brief Busca un nombre en el índice de su fragmento (con el cerrojo tomado)
+     * @param fragmento Fragmento del nombre
+     * @param hash Hash del nombre
+     * @param nombre Identificador del sensor
+     * @return Casilla del sensor, nullptr si no existe
+     */
+    static const EntradaIndice *buscarEntrada(const Fragmento &fragmento, unsigned hash, const char *nombre);
+
+    /**
+     * @brief Sensor de un manejador, desde cualquier hilo
+     * @param manejador Manejador menor que numManejadores
+     * @return Sensor registrado, nullptr si la casilla está libre
+     */
+    SensorBase *sensorEn(int manejador) const
+    {
+        return sensores.load(std::memory_order_acquire)[manejador].load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Junta y ordena los modificados de todos los fragmentos en listaModificados
+     * @return Manejadores juntados
+     */
+    int juntarModificados();
+
+    /**
+     * @brief Duplica los arreglos por manejador (con el cerrojo de altas tomado)
+     */
+    void crecer();
+
+    /**
+     * @brief Agrega un sensor al arreglo contiguo (crece al doble si hace falta)
+     * @param sensor Sensor a registrar
+     * @param tipo Identificador del pool de la arena, nullptr si debe liberarse con delete
+     */
+    void registrar(SensorBase *sensor, const void *tipo);
+
+    /**
+     * @brief Quita un sensor del registro y lo retira a las épocas (con el cerrojo de altas)
+     * @param manejador Manejador del sensor
+     * @param vistoAntesDe Solo si su última lectura es anterior a este momento (ms)
+     * @return false si recibió una lectura después (no se da de baja)
+     *
+     * No compacta el arreglo de vivos: lo hace quien llama, una vez por lote.
+     */
+    bool darDeBaja(int manejador, long long vistoAntesDe);
+
+    /**
+     * @brief Quita de vivos los manejadores dados de baja, conservando el orden
+     */
+    void compactarVivos();
+
+    /**
+     * @brief Destruye un sensor retirado (función de liberación de las épocas)
+     * @param objeto Baja a liberar
+     */
+    static void liberarBaja(void *objeto);
+
+    /**
+     * @brief Agrega el sensor a la lista de modificados de su fragmento si no estaba
+     * @param fragmento Fragmento del sensor
+     * @param sensor Sensor registrado
+     * @param lectura true si el aviso viene de la ingesta (actualiza la última lectura)
+     * @return false si el sensor ya fue dado de baja (no se marca)
+     */
+    bool marcarModificado(Fragmento &fragmento, const SensorBase &sensor, bool lectura);
+
+    /**
+     * @brief Marca como al día a los modificados de todos los fragmentos
+     */
+    void limpiarModificados();
+
+    /**
+     * @brief Avisa a los observadores que el procesamiento cambió el historial
+     * @param indice Manejador del sensor procesado
+     */
+    void notificarProcesado(int indice);
+
+    /**
+     * @brief Consulta a los observadores si se puede crear un sensor
+     * @param nombre Identificador del sensor a crear
+     * @return false si algún observador rechaza el alta
+     */
+    bool admiteSensorNuevo(const char *nombre) const;
+};
+
+/**
+ * @class LectorRegistro
+ * @brief Fija la época del registro mientras un hilo usa sensores buscados (RAII)
+ *
+ * Un sensor dado de baja mientras existe el objeto no se libera hasta que
+ * se destruye, así que los punteros obtenidos con buscarSensor() dentro de
+ * su alcance siguen siendo válidos. Las lecturas registradas sobre un
+ * sensor ya dado de baja se descartan en el registro.
+ */
+class LectorRegistro
+{
+private:
+    ListaGeneral &lista; ///< Registro leído
+    int ranura;          ///< Ranura de épocas del hilo lector
+
+public:
+    /**
+     * @brief Fija la época vigente
+     * @param registro Registro de sensores
+     * @param ranuraLector Ranura obtenida con ListaGeneral::registrarLector()
+     */
+    LectorRegistro(ListaGeneral &registro, int ranuraLector);
+
+    /**
+     * @brief Suelta la época fijada
+     */
+    ~LectorRegistro();
+
+private:
+    LectorRegistro(const LectorRegistro &);            // No copiable
+    LectorRegistro &operator=(const LectorRegistro &); // No asignable
 };
 
-#endif // LISTAGENERAL_H
\ No newline at end of file
+#endif // LISTAGENERAL_H
@@ -9,47 +9,223 @@
 #define LISTASENSOR_H
 
 #include <iostream>
+#include <iterator>
+#include <cstddef>
+#include <type_traits>
+#include "EstadisticasLista.h"
+#include "EscritorReporte.h"
 
 /**
- * @brief Estructura de nodo genérico para la lista enlazada
+ * @brief Nodo de la lista: un segmento con varias lecturas contiguas
  * @tparam T Tipo de dato que almacenará el nodo (int, float, double, etc.)
+ *
+ * Guardar varias lecturas por nodo reduce los saltos de puntero al
+ * recorrer la lista y deja cada segmento como un arreglo contiguo que
+ * los algoritmos pueden procesar (y vectorizar) de una sola vez.
  */
 template <typename T>
 struct Nodo
 {
-    T dato;             ///< Valor almacenado en el nodo
+    static const int CAPACIDAD = (sizeof(T) >= 64) ? 8 : 512 / static_cast<int>(sizeof(T)); ///< Lecturas por nodo
+
+    T datos[CAPACIDAD]; ///< Lecturas almacenadas en orden de llegada
+    int cantidad;       ///< Lecturas ocupadas (nunca 0 dentro de la lista)
     Nodo<T> *siguiente; ///< Puntero al siguiente nodo de la lista
 
     /**
-     * @brief Constructor del nodo
+     * @brief Constructor del nodo con su primera lectura
      * @param valor Valor inicial del nodo
      */
-    Nodo(T valor) : dato(valor), siguiente(nullptr) {}
+    Nodo(T valor) : cantidad(1), siguiente(nullptr)
+    {
+        datos[0] = valor;
+    }
+};
+
+/**
+ * @class IteradorLista
+ * @brief Iterador de avance (forward) sobre las lecturas de una ListaSensor
+ * @tparam T Tipo de las lecturas
+ *
+ * Es de solo lectura: modificar valores sin pasar por la lista dejaría
+ * desactualizadas sus estadísticas.
+ */
+template <typename T>
+class IteradorLista
+{
+public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef T value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef const T *pointer;
+    typedef const T &reference;
+
+private:
+    const Nodo<T> *nodo; ///< Nodo actual (nullptr = fin)
+    int indice;          ///< Posición dentro del nodo
+
+public:
+    IteradorLista() : nodo(nullptr), indice(0) {}
+    explicit IteradorLista(const Nodo<T> *inicio) : nodo(inicio), indice(0) {}
+
+    reference operator*() const { return nodo->datos[indice]; }
+    pointer operator->() const { return &nodo->datos[indice]; }
+
+    IteradorLista &operator++()
+    {
+        if (++indice == nodo->cantidad)
+        {
+            nodo = nodo->siguiente;
+            indice = 0;
+        }
+        return *this;
+    }
+
+    IteradorLista operator++(int)
+    {
+        IteradorLista copia(*this);
+        ++(*this);
+        return copia;
+    }
+
+    bool operator==(const IteradorLista &otro) const
+    {
+        return nodo == otro.nodo && indice == otro.indice;
+    }
+
+    bool operator!=(const IteradorLista &otro) const
+    {
+        return !(*this == otro);
+    }
+};
+
+/**
+ * @brief Segmento contiguo de lecturas (un nodo de la lista)
+ * @tparam T Tipo de las lecturas
+ *
+ * begin()/end() son punteros, así que un segmento se puede pasar
+ * directamente a cualquier algoritmo de acceso aleatorio.
+ */
+template <typename T>
+struct Segmento
+{
+    const T *inicio; ///< Primera lectura
+    const T *fin;    ///< Una posición después de la última
+
+    const T *begin() const { return inicio; }
+    const T *end() const { return fin; }
+    int tamano() const { return static_cast<int>(fin - inicio); }
+};
+
+/**
+ * @class IteradorSegmentos
+ * @brief Iterador de avance sobre los segmentos de una ListaSensor
+ * @tparam T Tipo de las lecturas
+ */
+template <typename T>
+class IteradorSegmentos
+{
+public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef Segmento<T> value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef const Segmento<T> *pointer;
+    typedef Segmento<T> reference;
+
+private:
+    const Nodo<T> *nodo; ///< Nodo actual (nullptr = fin)
+
+public:
+    IteradorSegmentos() : nodo(nullptr) {}
+    explicit IteradorSegmentos(const Nodo<T> *inicio) : nodo(inicio) {}
+
+    Segmento<T> operator*() const
+    {
+        Segmento<T> s = {nodo->datos, nodo->datos + nodo->cantidad};
+        return s;
+    }
+
+    IteradorSegmentos &operator++()
+    {
+        nodo = nodo->siguiente;
+        return *this;
+    }
+
+    IteradorSegmentos operator++(int)
+    {
+        IteradorSegmentos copia(*this);
+        nodo = nodo->siguiente;
+        return copia;
+    }
+
+    bool operator==(const IteradorSegmentos &otro) const { return nodo == otro.nodo; }
+    bool operator!=(const IteradorSegmentos &otro) const { return nodo != otro.nodo; }
+};
+
+/**
+ * @brief Rango de segmentos para usar en un for de rango
+ * @tparam T Tipo de las lecturas
+ */
+template <typename T>
+struct RangoSegmentos
+{
+    IteradorSegmentos<T> primero; ///< Primer segmento
+    IteradorSegmentos<T> ultimo;  ///< Fin del rango
+
+    IteradorSegmentos<T> begin() const { return primero; }
+    IteradorSegmentos<T> end() const { return ultimo; }
 };
 
 /**
  * @class ListaSensor
  * @brief Lista enlazada simple genérica para gestionar lecturas de sensores
- * @tparam T Tipo de dato de las lecturas (int para presión, float para temperatura)
+ * @tparam T Tipo de dato de las lecturas (int, float o un tipo compacto de
+ *         CodificacionValores.h, que decodifica a double)
+ * @tparam Acum Tipo en el que se acumulan sumas y promedios
+ * @tparam Estadisticas Políticas de EstadisticasLista.h que se mantienen al
+ *         insertar y eliminar (ej: EstadisticaSuma, EstadisticaMinMax)
+ *
+ * Las estadísticas se eligen en tiempo de compilación: la lista hereda de
+ * cada política pedida, así que una lista sin políticas no guarda estado
+ * extra ni ejecuta código adicional. Con EstadisticaSuma el promedio es
+ * O(1); sin ella se recorre la lista acumulando en Acum.
+ *
+ * Cada nodo guarda un segmento de hasta Nodo<T>::CAPACIDAD lecturas. La
+ * lista se recorre con begin()/end() (iterador forward, compatible con
+ * <algorithm> y <numeric>) o segmento a segmento con segmentos(); ver
+ * AlgoritmosLista.h para reducciones con políticas de ejecución paralela.
  *
  * Implementa la Regla de los Tres para gestión correcta de memoria dinámica:
  * - Destructor
  * - Constructor de copia
  * - Operador de asignación
  */
-template <typename T>
-class ListaSensor
+template <typename T,
+          typename Acum = typename AcumuladorPorDefecto<T>::tipo,
+          template <typename, typename> class... Estadisticas>
+class ListaSensor : public Estadisticas<T, Acum>...
 {
+public:
+    /// Tipo del promedio: Acum si es flotante, double si es entero
+    typedef typename std::conditional<std::is_floating_point<Acum>::value, Acum, double>::type TipoPromedio;
+    typedef Acum TipoAcumulador;                 ///< Tipo de las sumas
+    typedef T value_type;                        ///< Tipo de las lecturas
+    typedef IteradorLista<T> const_iterator;     ///< Iterador de solo lectura
+    typedef IteradorLista<T> iterator;           ///< Igual que const_iterator
+
 private:
     Nodo<T> *cabeza; ///< Puntero al primer nodo de la lista
+    Nodo<T> *cola;   ///< Último nodo (inserción en O(1))
     int contador;    ///< Número de elementos en la lista
+    int numNodos;    ///< Número de nodos (segmentos)
+    bool silenciosa; ///< No informa altas ni descartes por consola (las advertencias sí)
 
 public:
     /**
      * @brief Constructor por defecto
      * Inicializa una lista vacía
      */
-    ListaSensor() : cabeza(nullptr), contador(0)
+    ListaSensor() : cabeza(nullptr), cola(nullptr), contador(0), numNodos(0), silenciosa(false)
     {
         std::cout << "[Log] ListaSensor<T> creada." << std::endl;
     }
@@ -61,7 +237,10 @@ public:
      */
     ~ListaSensor()
     {
-        std::cout << "[Log] Destruyendo ListaSensor<T>..." << std::endl;
+        if (!silenciosa)
+        {
+            std::cout << "[Log] Destruyendo ListaSensor<T>..." << std::endl;
+        }
         limpiar();
     }
 
@@ -71,7 +250,7 @@ public:
      *
      * Realiza una copia profunda de todos los nodos
      */
-    ListaSensor(const ListaSensor<T> &otra) : cabeza(nullptr), contador(0)
+    ListaSensor(const ListaSensor &otra) : cabeza(nullptr), cola(nullptr), contador(0), numNodos(0), silenciosa(false)
     {
         copiar(otra);
     }
@@ -81,7 +260,7 @@ public:
      * @param otra Lista a asignar
      * @return Referencia a esta lista
      */
-    ListaSensor<T> &operator=(const ListaSensor<T> &otra)
+    ListaSensor &operator=(const ListaSensor &otra)
     {
         if (this != &otra)
         {
@@ -94,51 +273,50 @@ public:
     /**
      * @brief Inserta un nuevo elemento al final de la lista
      * @param valor Valor a insertar
+     *
+     * O(1): se escribe en el último nodo y solo se crea uno nuevo cuando
+     * este se llena.
      */
     void insertar(T valor)
     {
-        Nodo<T> *nuevoNodo = new Nodo<T>(valor);
-
-        if (cabeza == nullptr)
+        if (cola == nullptr)
+        {
+            cabeza = cola = new Nodo<T>(valor);
+            numNodos++;
+        }
+        else if (cola->cantidad == Nodo<T>::CAPACIDAD)
         {
-            cabeza = nuevoNodo;
+            cola->siguiente = new Nodo<T>(valor);
+            cola = cola->siguiente;
+            numNodos++;
         }
         else
         {
-            Nodo<T> *actual = cabeza;
-            while (actual->siguiente != nullptr)
-            {
-                actual = actual->siguiente;
-            }
-            actual->siguiente = nuevoNodo;
+            cola->datos[cola->cantidad++] = valor;
         }
 
         contador++;
-        std::cout << "[Log] Nodo<T> insertado. Valor: " << valor << std::endl;
+        estadisticasAgregar(valor);
+        if (!silenciosa)
+        {
+            std::cout << "[Log] Nodo<T> insertado. Valor: " << valor << std::endl;
+        }
     }
 
     /**
      * @brief Calcula el promedio de todos los elementos de la lista
-     * @return Promedio de tipo T
+     * @return Promedio en TipoPromedio (sin truncar aunque T sea entero)
      */
-    T calcularPromedio() const
+    TipoPromedio calcularPromedio() const
     {
         if (contador == 0)
         {
             std::cout << "[Advertencia] Lista vacía. Promedio = 0." << std::endl;
-            return static_cast<T>(0);
+            return static_cast<TipoPromedio>(0);
         }
 
-        T suma = static_cast<T>(0);
-        Nodo<T> *actual = cabeza;
-
-        while (actual != nullptr)
-        {
-            suma += actual->dato;
-            actual = actual->siguiente;
-        }
-
-        return suma / static_cast<T>(contador);
+        Acum suma = sumarTodo(std::is_base_of<EstadisticaSuma<T, Acum>, ListaSensor>());
+        return static_cast<TipoPromedio>(suma) / static_cast<TipoPromedio>(contador);
     }
 
     /**
@@ -153,78 +331,207 @@ public:
             return static_cast<T>(0);
         }
 
-        // Buscar el nodo con valor mínimo
-        Nodo<T> *actual = cabeza;
+        // Buscar el primer mínimo (recorrido contiguo dentro de cada nodo)
         Nodo<T> *minNodo = cabeza;
         Nodo<T> *prevMin = nullptr;
-        Nodo<T> *prevActual = nullptr;
+        int minIndice = 0;
 
-        while (actual != nullptr)
+        Nodo<T> *prevActual = nullptr;
+        for (Nodo<T> *actual = cabeza; actual != nullptr; actual = actual->siguiente)
         {
-            if (actual->dato < minNodo->dato)
+            const T *datos = actual->datos;
+            for (int i = 0; i < actual->cantidad; i++)
             {
-                minNodo = actual;
-                prevMin = prevActual;
+                if (datos[i] < minNodo->datos[minIndice])
+                {
+                    minNodo = actual;
+                    prevMin = prevActual;
+                    minIndice = i;
+                }
             }
             prevActual = actual;
-            actual = actual->siguiente;
         }
 
-        T valorMinimo = minNodo->dato;
+        T valorMinimo = minNodo->datos[minIndice];
 
-        // Eliminar el nodo mínimo
-        if (prevMin == nullptr)
+        // Eliminar la lectura y cerrar el hueco dentro del nodo
+        for (int i = minIndice + 1; i < minNodo->cantidad; i++)
         {
-            // El mínimo es la cabeza
-            cabeza = minNodo->siguiente;
+            minNodo->datos[i - 1] = minNodo->datos[i];
         }
-        else
+        minNodo->cantidad--;
+
+        // Un nodo vacío se quita de la lista
+        if (minNodo->cantidad == 0)
         {
-            prevMin->siguiente = minNodo->siguiente;
+            if (prevMin == nullptr)
+            {
+                cabeza = minNodo->siguiente;
+            }
+            else
+            {
+                prevMin->siguiente = minNodo->siguiente;
+            }
+            if (cola == minNodo)
+            {
+                cola = prevMin;
+            }
+            delete minNodo;
+            numNodos--;
         }
 
-        delete minNodo;
         contador--;
+        estadisticasQuitar(valorMinimo);
 
-        std::cout << "[Log] Nodo<T> con valor mínimo (" << valorMinimo << ") eliminado." << std::endl;
+        if (!silenciosa)
+        {
+            std::cout << "[Log] Nodo<T> con valor mínimo (" << valorMinimo << ") eliminado." << std::endl;
+        }
 
         return valorMinimo;
     }
 
     /**
-     * @brief Imprime todos los elementos de la lista
+     * @brief Descarta el segmento más antiguo (el primer nodo)
+     * @return Lecturas descartadas (0 si la lista está vacía)
+     *
+     * Cuesta O(CAPACIDAD) más el recálculo de las políticas que lo pidan
+     * (EstadisticaMinMax si se descartó un extremo). Cada lectura se
+     * descarta a lo sumo una vez, así que repartido sobre las inserciones
+     * el descarte es O(1) amortizado.
      */
-    void imprimir() const
+    int eliminarSegmentoInicial()
     {
         if (cabeza == nullptr)
         {
-            std::cout << "  [Lista vacía]" << std::endl;
-            return;
+            return 0;
         }
 
-        Nodo<T> *actual = cabeza;
-        std::cout << "  Lecturas: ";
-        while (actual != nullptr)
+        Nodo<T> *viejo = cabeza;
+        int descartadas = viejo->cantidad;
+        cabeza = viejo->siguiente;
+        if (cola == viejo)
         {
-            std::cout << actual->dato;
-            if (actual->siguiente != nullptr)
-            {
-                std::cout << " -> ";
-            }
-            actual = actual->siguiente;
+            cola = nullptr;
+        }
+        numNodos--;
+        contador -= descartadas;
+
+        for (int i = 0; i < descartadas; i++)
+        {
+            int expansion[] = {0, (Estadisticas<T, Acum>::quitar(viejo->datos[i]), 0)...};
+            (void)expansion;
         }
-        std::cout << std::endl;
+        int recalculos[] = {0, (recalcularSiHaceFalta<Estadisticas>(), 0)...};
+        (void)recalculos;
+
+        delete viejo;
+        if (!silenciosa)
+        {
+            std::cout << "[Log] Segmento de " << descartadas << " lectura(s) descartado." << std::endl;
+        }
+        return descartadas;
     }
 
     /**
-     * @brief Obtiene el número de elementos en la lista
+     * @brief Imprime todos los elementos de la lista
+     */
+    void imprimir() const
+    {
+        EscritorReporte &salida = EscritorReporte::salidaEstandar();
+        escribirLecturas(salida, *this, REPORTE_TEXTO, "", "", 0);
+        salida.vaciar();
+    }
+
+    /**
+     * @brief Activa o desactiva los mensajes [Log] de la lista
+     * @param activo true para no informar altas, descartes ni liberaciones
+     *
+     * Las advertencias (lista vacía) se imprimen siempre.
+     */
+    void setSilenciosa(bool activo)
+    {
+        silenciosa = activo;
+    }
+
+    /**
+     * @brief Iterador a la primera lectura
+     * @return Iterador de solo lectura
+     */
+    const_iterator begin() const
+    {
+        return const_iterator(cabeza);
+    }
+
+    /**
+     * @brief Iterador una posición después de la última lectura
+     * @return Iterador de fin
+     */
+    const_iterator end() const
+    {
+        return const_iterator();
+    }
+
+    /**
+     * @brief Recorrido por segmentos contiguos (uno por nodo)
+     * @return Rango de segmentos para un for de rango
+     */
+    RangoSegmentos<T> segmentos() const
+    {
+        RangoSegmentos<T> rango = {IteradorSegmentos<T>(cabeza), IteradorSegmentos<T>()};
+        return rango;
+    }
+
+    /**
+     * @brief Obtiene el número de segmentos (nodos) de la lista
      * @return Cantidad de nodos
      */
+    int getNumSegmentos() const
+    {
+        return numNodos;
+    }
+
+    /**
+     * @brief Bytes reservados por los nodos (lecturas, contador y enlace)
+     * @return numNodos * sizeof(Nodo<T>)
+     */
+    std::size_t getBytesReservados() const
+    {
+        return static_cast<std::size_t>(numNodos) * sizeof(Nodo<T>);
+    }
+
+    /**
+     * @brief Obtiene el número de elementos en la lista
+     * @return Cantidad de lecturas
+     */
     int getContador() const
     {
         return contador;
     }
 
+    /**
+     * @brief Copia los valores de la lista, en orden, a un arreglo contiguo
+     * @tparam U Tipo de los elementos destino
+     * @param destino Arreglo destino
+     * @param maximo Capacidad del arreglo destino
+     * @return Número de valores copiados
+     */
+    template <typename U>
+    int copiarEn(U *destino, int maximo) const
+    {
+        int copiados = 0;
+        for (const Nodo<T> *actual = cabeza; actual != nullptr && copiados < maximo; actual = actual->siguiente)
+        {
+            int n = (actual->cantidad < maximo - copiados) ? actual->cantidad : maximo - copiados;
+            for (int i = 0; i < n; i++)
+            {
+                destino[copiados + i] = static_cast<U>(actual->datos[i]);
+            }
+            copiados += n;
+        }
+        return copiados;
+    }
+
     /**
      * @brief Verifica si la lista está vacía
      * @return true si no hay elementos, false en caso contrario
@@ -244,30 +551,99 @@ private:
         while (actual != nullptr)
         {
             Nodo<T> *siguiente = actual->siguiente;
-            std::cout << "  [Log] Nodo<T> liberado: " << actual->dato << std::endl;
+            if (!silenciosa)
+            {
+                for (int i = 0; i < actual->cantidad; i++)
+                {
+                    std::cout << "  [Log] Nodo<T> liberado: " << actual->datos[i] << std::endl;
+                }
+            }
             delete actual;
             actual = siguiente;
         }
         cabeza = nullptr;
+        cola = nullptr;
         contador = 0;
+        numNodos = 0;
+
+        int expansion[] = {0, (Estadisticas<T, Acum>::reiniciar(), 0)...};
+        (void)expansion;
     }
 
     /**
-     * @brief Copia profunda de otra lista
-     * @param otra Lista a copiar
+     * @brief Suma tomada de EstadisticaSuma (O(1))
      */
-    void copiar(const ListaSensor<T> &otra)
+    Acum sumarTodo(std::true_type) const
     {
-        if (otra.cabeza == nullptr)
+        return this->getSuma();
+    }
+
+    /**
+     * @brief Suma recorriendo la lista (sin EstadisticaSuma)
+     */
+    Acum sumarTodo(std::false_type) const
+    {
+        Acum suma = static_cast<Acum>(0);
+        for (const Nodo<T> *actual = cabeza; actual != nullptr; actual = actual->siguiente)
         {
-            return;
+            for (int i = 0; i < actual->cantidad; i++)
+            {
+                suma += static_cast<Acum>(actual->datos[i]);
+            }
         }
+        return suma;
+    }
 
-        Nodo<T> *actualOtra = otra.cabeza;
-        while (actualOtra != nullptr)
+    /**
+     * @brief Actualiza cada política con un valor insertado
+     * @param valor Valor insertado
+     */
+    void estadisticasAgregar(T valor)
+    {
+        int expansion[] = {0, (Estadisticas<T, Acum>::agregar(valor), 0)...};
+        (void)expansion;
+        (void)valor; // Sin políticas no se usa
+    }
+
+    /**
+     * @brief Actualiza cada política con un valor eliminado
+     * @param valor Valor eliminado
+     */
+    void estadisticasQuitar(T valor)
+    {
+        int expansion[] = {0, (Estadisticas<T, Acum>::quitar(valor), 0)...};
+        int recalculos[] = {0, (recalcularSiHaceFalta<Estadisticas>(), 0)...};
+        (void)expansion;
+        (void)recalculos;
+        (void)valor;
+    }
+
+    /**
+     * @brief Reconstruye una política recorriendo la lista si quedó inválida
+     * @tparam E Política a revisar
+     */
+    template <template <typename, typename> class E>
+    void recalcularSiHaceFalta()
+    {
+        if (E<T, Acum>::necesitaRecalculo())
+        {
+            E<T, Acum>::reiniciar();
+            for (const_iterator it = begin(); it != end(); ++it)
+            {
+                E<T, Acum>::agregar(*it);
+            }
+        }
+    }
+
+    /**
+     * @brief Copia profunda de otra lista
+     * @param otra Lista a copiar
+     */
+    void copiar(const ListaSensor &otra)
+    {
+        for (const_iterator it = otra.begin(); it != otra.end(); ++it)
         {
-            insertar(actualOtra->dato);
-            actualOtra = actualOtra->siguiente;
+            insertar(*it);
         }
     }
 };
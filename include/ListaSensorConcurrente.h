@@ -0,0 +1,295 @@
+/**
+ * @file ListaSensorConcurrente.h
+ * @brief Variante de ListaSensor con inserción concurrente de varios productores
+ * @author FabiRamiro
+ * @date 2026-10-18
+ */
+
+#ifndef LISTASENSORCONCURRENTE_H
+#define LISTASENSORCONCURRENTE_H
+
+#include <iostream>
+#include <atomic>
+#include "EstadisticasLista.h"
+
+/**
+ * @brief Nodo de la lista concurrente
+ * @tparam T Tipo de dato almacenado
+ */
+template <typename T>
+struct NodoConcurrente
+{
+    T dato;                                    ///< Valor almacenado
+    std::atomic<NodoConcurrente<T> *> siguiente; ///< Enlace publicado por el productor
+    bool eliminado;                            ///< Borrado lógico (solo lo usa el consumidor)
+
+    /**
+     * @brief Constructor del nodo
+     * @param valor Valor inicial
+     */
+    NodoConcurrente(T valor) : dato(valor), siguiente(nullptr), eliminado(false) {}
+};
+
+/**
+ * @class ListaSensorConcurrente
+ * @brief Lista enlazada para varios productores y un consumidor (MPSC)
+ * @tparam T Tipo de dato de las lecturas
+ *
+ * insertar() es wait-free: cada productor intercambia atómicamente el
+ * puntero a la cola por su nodo y luego enlaza el nodo anterior con el
+ * suyo. No hay reintentos ni bloqueos, así que varios hilos de ingesta
+ * pueden registrar lecturas del mismo sensor a la vez.
+ *
+ * calcularPromedio(), eliminarMinimo() e imprimir() los llama un único
+ * hilo consumidor. Solo ven los nodos ya enlazados; un nodo cuyo
+ * productor todavía no publicó el enlace aparece en la siguiente pasada.
+ *
+ * Reclamación de memoria: el único nodo que un productor puede seguir
+ * tocando es el que era la cola cuando hizo el intercambio, y solo hasta
+ * publicar su enlace siguiente. Por eso el consumidor libera un nodo solo
+ * si su enlace siguiente ya es visible; si el eliminado es el último nodo
+ * visible, queda marcado como borrado y se libera en una pasada posterior,
+ * cuando ya tenga sucesor.
+ *
+ * A diferencia de ListaSensor no registra cada inserción en consola, para
+ * no serializar a los productores en std::cout.
+ *
+ * Es una variante independiente: los sensores del sistema siguen usando
+ * ListaSensor (ingesta de un solo hilo) y esta lista solo la usa
+ * tools/BenchmarkListaConcurrente.
+ */
+template <typename T>
+class ListaSensorConcurrente
+{
+public:
+    typedef typename AcumuladorPorDefecto<T>::tipo Acum; ///< Tipo de la suma (long long si T es entero)
+    /// Tipo del promedio: Acum si es flotante, double si es entero (como en ListaSensor)
+    typedef typename std::conditional<std::is_floating_point<Acum>::value, Acum, double>::type TipoPromedio;
+
+private:
+    NodoConcurrente<T> centinela;              ///< Nodo inicial fijo (nunca se libera)
+    alignas(64) std::atomic<NodoConcurrente<T> *> cola; ///< Último nodo insertado
+    alignas(64) std::atomic<int> insertados;   ///< Lecturas insertadas por los productores
+    alignas(64) int eliminados;                ///< Lecturas eliminadas (solo consumidor)
+
+public:
+    /**
+     * @brief Constructor por defecto: lista vacía
+     */
+    ListaSensorConcurrente() : centinela(T()), cola(&centinela), insertados(0), eliminados(0)
+    {
+        std::cout << "[Log] ListaSensorConcurrente<T> creada." << std::endl;
+    }
+
+    /**
+     * @brief Destructor: libera todos los nodos (no debe haber productores activos)
+     */
+    ~ListaSensorConcurrente()
+    {
+        std::cout << "[Log] Destruyendo ListaSensorConcurrente<T>..." << std::endl;
+        NodoConcurrente<T> *actual = centinela.siguiente.load(std::memory_order_acquire);
+        while (actual != nullptr)
+        {
+            NodoConcurrente<T> *siguiente = actual->siguiente.load(std::memory_order_acquire);
+            delete actual;
+            actual = siguiente;
+        }
+    }
+
+    /**
+     * @brief Inserta un valor al final (seguro desde varios hilos productores)
+     * @param valor Valor a insertar
+     */
+    void insertar(T valor)
+    {
+        NodoConcurrente<T> *nuevo = new NodoConcurrente<T>(valor);
+        NodoConcurrente<T> *anterior = cola.exchange(nuevo, std::memory_order_acq_rel);
+        anterior->siguiente.store(nuevo, std::memory_order_release);
+        insertados.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Calcula el promedio de los valores visibles (solo consumidor)
+     * @return Promedio en TipoPromedio (sin truncar ni desbordar aunque T sea entero)
+     */
+    TipoPromedio calcularPromedio() const
+    {
+        Acum suma = static_cast<Acum>(0);
+        int cantidad = 0;
+
+        for (const NodoConcurrente<T> *actual = primero(); actual != nullptr; actual = sucesor(actual))
+        {
+            if (!actual->eliminado)
+            {
+                suma += actual->dato;
+                cantidad++;
+            }
+        }
+
+        if (cantidad == 0)
+        {
+            std::cout << "[Advertencia] Lista vacía. Promedio = 0." << std::endl;
+            return static_cast<TipoPromedio>(0);
+        }
+
+        return static_cast<TipoPromedio>(suma) / static_cast<TipoPromedio>(cantidad);
+    }
+
+    /**
+     * @brief Encuentra y elimina el valor más bajo visible (solo consumidor)
+     * @return Valor eliminado (0 si la lista está vacía)
+     *
+     * De paso libera los nodos borrados lógicamente que ya tienen sucesor.
+     */
+    T eliminarMinimo()
+    {
+        purgar();
+
+        NodoConcurrente<T> *minNodo = nullptr;
+        NodoConcurrente<T> *prevMin = nullptr;
+        NodoConcurrente<T> *prevActual = &centinela;
+
+        for (NodoConcurrente<T> *actual = primero(); actual != nullptr; actual = sucesor(actual))
+        {
+            if (!actual->eliminado && (minNodo == nullptr || actual->dato < minNodo->dato))
+            {
+                minNodo = actual;
+                prevMin = prevActual;
+            }
+            prevActual = actual;
+        }
+
+        if (minNodo == nullptr)
+        {
+            std::cout << "[Advertencia] Lista vacía. No se puede eliminar mínimo." << std::endl;
+            return static_cast<T>(0);
+        }
+
+        T valorMinimo = minNodo->dato;
+        eliminados++;
+
+        NodoConcurrente<T> *siguiente = minNodo->siguiente.load(std::memory_order_acquire);
+        if (siguiente != nullptr)
+        {
+            prevMin->siguiente.store(siguiente, std::memory_order_relaxed);
+            delete minNodo;
+        }
+        else
+        {
+            minNodo->eliminado = true; // Puede ser la cola: se libera más adelante
+        }
+
+        std::cout << "[Log] NodoConcurrente<T> con valor mínimo (" << valorMinimo
+                  << ") eliminado." << std::endl;
+
+        return valorMinimo;
+    }
+
+    /**
+     * @brief Imprime los valores visibles (solo consumidor)
+     */
+    void imprimir() const
+    {
+        if (estaVacia())
+        {
+            std::cout << "  [Lista vacía]" << std::endl;
+            return;
+        }
+
+        std::cout << "  Lecturas:";
+        for (const NodoConcurrente<T> *actual = primero(); actual != nullptr; actual = sucesor(actual))
+        {
+            if (!actual->eliminado)
+            {
+                std::cout << " " << actual->dato;
+            }
+        }
+        std::cout << std::endl;
+    }
+
+    /**
+     * @brief Copia los valores visibles, en orden, a un arreglo contiguo (solo consumidor)
+     * @tparam U Tipo de los elementos destino
+     * @param destino Arreglo destino
+     * @param maximo Capacidad del arreglo destino
+     * @return Número de valores copiados
+     */
+    template <typename U>
+    int copiarEn(U *destino, int maximo) const
+    {
+        int copiados = 0;
+        for (const NodoConcurrente<T> *actual = primero(); actual != nullptr && copiados < maximo;
+             actual = sucesor(actual))
+        {
+            if (!actual->eliminado)
+            {
+                destino[copiados++] = static_cast<U>(actual->dato);
+            }
+        }
+        return copiados;
+    }
+
+    /**
+     * @brief Obtiene el número de elementos (aproximado mientras haya productores)
+     * @return Insertados menos eliminados
+     */
+    int getContador() const
+    {
+        return insertados.load(std::memory_order_relaxed) - eliminados;
+    }
+
+    /**
+     * @brief Verifica si la lista está vacía
+     * @return true si no hay elementos
+     */
+    bool estaVacia() const
+    {
+        return getContador() == 0;
+    }
+
+private:
+    /**
+     * @brief Primer nodo enlazado después del centinela
+     */
+    NodoConcurrente<T> *primero() const
+    {
+        return centinela.siguiente.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Sucesor publicado de un nodo
+     */
+    static NodoConcurrente<T> *sucesor(const NodoConcurrente<T> *nodo)
+    {
+        return nodo->siguiente.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Libera los nodos borrados lógicamente que ya tienen sucesor
+     */
+    void purgar()
+    {
+        NodoConcurrente<T> *previo = &centinela;
+        NodoConcurrente<T> *actual = primero();
+
+        while (actual != nullptr)
+        {
+            NodoConcurrente<T> *siguiente = sucesor(actual);
+            if (actual->eliminado && siguiente != nullptr)
+            {
+                previo->siguiente.store(siguiente, std::memory_order_relaxed);
+                delete actual;
+            }
+            else
+            {
+                previo = actual;
+            }
+            actual = siguiente;
+        }
+    }
+
+    ListaSensorConcurrente(const ListaSensorConcurrente &);            // No copiable
+    ListaSensorConcurrente &operator=(const ListaSensorConcurrente &); // No asignable
+};
+
+#endif // LISTASENSORCONCURRENTE_H
@@ -0,0 +1,229 @@
+/**
+ * @file MotorAlertas.h
+ * @brief Motor de reglas de alerta evaluado en el momento de la ingesta
+ * @author FabiRamiro
+ * @date 2026-10-18
+ */
+
+#ifndef MOTORALERTAS_H
+#define MOTORALERTAS_H
+
+#include "SensorBase.h"
+#include "ArenaSensores.h"
+#include "ColaSPSC.h"
+#include <atomic>
+
+/**
+ * @brief Tipos de regla soportados
+ */
+enum TipoRegla
+{
+    REGLA_MAXIMO = 0, ///< Dispara si valor > umbral; se rearma si valor < umbral - histéresis
+    REGLA_MINIMO = 1, ///< Dispara si valor < umbral; se rearma si valor > umbral + histéresis
+    REGLA_TASA = 2    ///< Dispara si |valor - anterior| > umbral; se rearma bajo umbral - histéresis
+};
+
+/**
+ * @brief Alerta generada por una regla
+ */
+struct Alerta
+{
+    char sensor[50];       ///< Nombre del sensor (copia: el sensor puede darse de baja antes de consumirla)
+    int manejador;         ///< Manejador del sensor en el registro
+    int idRegla;           ///< Identificador de la regla que disparó
+    int tipoRegla;         ///< TipoRegla de la regla
+    float valor;           ///< Valor medido (o cambio, en reglas de tasa)
+    float umbral;          ///< Umbral de la regla
+    long long marcaNs;     ///< Instante de la lectura (reloj monotónico, ns)
+};
+
+/**
+ * @class MotorAlertas
+ * @brief Evalúa reglas de umbral, tasa de cambio e histéresis en cada lectura
+ *
+ * Las reglas (por sensor o por tipo de sensor) se compilan en una tabla
+ * compacta de predicados: cada sensor registrado tiene su propio tramo
+ * contiguo con solo las reglas que le aplican, indexado por su manejador.
+ * Evaluar una lectura recorre únicamente ese tramo, así que el coste no
+ * crece con el número total de reglas. El estado de histéresis vive en el
+ * propio predicado, y las alertas se publican en una ColaSPSC que otro
+ * hilo puede consumir sin bloquear la ingesta.
+ *
+ * Los avisos de sensores de fragmentos distintos pueden llegar a la vez:
+ * todo el estado que toca una lectura es del propio sensor (su tramo, su
+ * último valor, su contador de evaluaciones), y solo la inserción en la
+ * cola, que ocurre únicamente al disparar, se serializa entre productores.
+ */
+class MotorAlertas : public ObservadorLecturas
+{
+public:
+    static const std::size_t CAPACIDAD_COLA = 1024; ///< Alertas en espera antes de descartar
+
+private:
+    /**
+     * @brief Regla tal como la define el usuario
+     */
+    struct Regla
+    {
+        char sensor[50];   ///< Nombre del sensor ("" si es regla por tipo)
+        const void *tipo;  ///< Tipo de sensor (nullptr si es regla por sensor)
+        int tipoRegla;     ///< TipoRegla
+        float umbral;      ///< Umbral de disparo
+        float histeresis;  ///< Margen de rearme
+    };
+
+    /**
+     * @brief Predicado compilado (12 bytes) con su estado de histéresis
+     */
+    struct Predicado
+    {
+        float umbral;            ///< Umbral de disparo
+        float histeresis;        ///< Margen de rearme
+        unsigned short idRegla;  ///< Índice de la regla de origen
+        unsigned char tipoRegla; ///< TipoRegla
+        unsigned char activa;    ///< 1 si la alerta está disparada
+    };
+
+    Regla *reglas;       ///< Reglas definidas
+    int numReglas;       ///< Reglas en uso
+    int capacidadReglas; ///< Capacidad del arreglo de reglas
+
+    Predicado *tabla;    ///< Tabla compilada (tramos contiguos por sensor)
+    int numPredicados;   ///< Predicados en uso
+    int numHuecos;       ///< Predicados de tramos de sensores dados de baja
+    int capacidadTabla;  ///< Capacidad de la tabla
+
+    SensorBase **sensores; ///< Sensores conocidos, por manejador
+    const void **tipos;    ///< Tipo de arena de cada sensor
+    int *inicio;           ///< Inicio del tramo de cada sensor en la tabla
+    int *cantidad;         ///< Predicados del tramo de cada sensor
+    float *ultimo;         ///< Último valor de cada sensor (para reglas de tasa)
+    bool *tieneUltimo;     ///< Si el sensor ya tiene un valor anterior
+    unsigned long *evaluadas; ///< Lecturas evaluadas de cada manejador
+    int numSensores;       ///< Sensores conocidos (manejador máximo + 1)
+    int capacidadSensores; ///< Capacidad de los arreglos por sensor
+
+    ColaSPSC<Alerta, CAPACIDAD_COLA> cola;  ///< Alertas pendientes de consumir
+    std::atomic<bool> productorOcupado;     ///< Serializa los productores de la cola
+    unsigned long evaluacionesRetiradas;    ///< Lecturas evaluadas de sensores dados de baja
+    std::atomic<unsigned long> disparos;    ///< Alertas generadas
+
+public:
+    /**
+     * @brief Constructor por defecto (sin reglas)
+     */
+    MotorAlertas();
+
+    /**
+     * @brief Destructor - Libera las tablas
+     */
+    ~MotorAlertas();
+
+    /**
+     * @brief Agrega una regla para un sensor concreto
+     * @param nombreSensor Identificador del sensor
+     * @param tipoRegla REGLA_MAXIMO, REGLA_MINIMO o REGLA_TASA
+     * @param umbral Umbral de disparo
+     * @param histeresis Margen de rearme (>= 0)
+     * @return Identificador de la regla
+     */
+    int agregarReglaSensor(const char *nombreSensor, TipoRegla tipoRegla, float umbral, float histeresis);
+
+    /**
+     * @brief Agrega una regla para todos los sensores de tipo S
+     * @tparam S Tipo concreto (SensorTemperatura, SensorPresion...)
+     * @param tipoRegla REGLA_MAXIMO, REGLA_MINIMO o REGLA_TASA
+     * @param umbral Umbral de disparo
+     * @param histeresis Margen de rearme (>= 0)
+     * @return Identificador de la regla
+     */
+    template <typename S>
+    int agregarReglaTipo(TipoRegla tipoRegla, float umbral, float histeresis)
+    {
+        return agregarRegla("", ArenaSensores::idTipo<S>(), tipoRegla, umbral, histeresis);
+    }
+
+    /**
+     * @brief Extrae la siguiente alerta pendiente (hilo consumidor)
+     * @param alerta Destino de la alerta
+     * @return true si había una alerta
+     */
+    bool extraerAlerta(Alerta &alerta);
+
+    /**
+     * @brief Extrae e imprime todas las alertas pendientes
+     * @return Número de alertas impresas
+     */
+    int imprimirAlertas();
+
+    /**
+     * @brief Imprime las reglas definidas y los contadores del motor
+     */
+    void imprimirReglas() const;
+
+    /**
+     * @brief Evalúa las reglas del sensor con la lectura recién registrada
+     * @param sensor Sensor que recibió la lectura
+     * @param valor Valor registrado
+     */
+    void lecturaRegistrada(SensorBase &sensor, double valor) override;
+
+    /**
+     * @brief Evalúa un bloque de vibración usando su pico absoluto
+     * @param sensor Sensor que recibió el bloque
+     * @param cuentas Muestras del bloque
+     * @param cantidad Número de muestras
+     */
+    void bloqueRegistrado(SensorBase &sensor, const int *cuentas, int cantidad) override;
+
+    /**
+     * @brief Compila el tramo de predicados de un sensor nuevo
+     * @param sensor Sensor registrado
+     * @param tipo Identificador del tipo en la arena
+     */
+    void sensorRegistrado(SensorBase &sensor, const void *tipo) override;
+
+    /**
+     * @brief Descarta el tramo de un sensor dado de baja
+     * @param sensor Sensor dado de baja
+     * @param manejador Manejador que tenía
+     *
+     * El tramo queda como hueco en la tabla; cuando los huecos superan la
+     * mitad se compacta conservando el estado de histéresis de los demás.
+     * Las alertas ya encoladas del sensor apuntan a su nombre: deben
+     * consumirse antes de que el registro libere el objeto.
+     */
+    void sensorEliminado(SensorBase &sensor, int manejador) override;
+
+private:
+    MotorAlertas(const MotorAlertas &);            // No copiable
+    MotorAlertas &operator=(const MotorAlertas &); // No asignable
+
+    /**
+     * @brief Agrega una regla y recompila la tabla
+     */
+    int agregarRegla(const char *nombreSensor, const void *tipo, TipoRegla tipoRegla,
+                     float umbral, float histeresis);
+
+    /**
+     * @brief Construye el tramo de predicados de un sensor al final de la tabla
+     */
+    void compilarSensor(int manejador);
+
+    /**
+     * @brief Reconstruye la tabla completa (tras agregar una regla)
+     */
+    void recompilar();
+
+    /**
+     * @brief Junta los tramos vivos al principio de la tabla (sin recompilar)
+     */
+    void compactarTabla();
+
+    /**
+     * @brief Evalúa el tramo de un sensor con un valor y un cambio dados
+     */
+    void evaluar(SensorBase &sensor, int manejador, float valor, float cambio, bool hayCambio);
+};
+
+#endif // MOTORALERTAS_H
@@ -0,0 +1,325 @@
+/**
+ * @file MotorCorrelacion.h
+ * @brief Correlación y covarianza entre sensores: ventanas móviles por par y matriz de ventana completa
+ * @author FabiRamiro
+ * @date 2026-10-18
+ */
+
+#ifndef MOTORCORRELACION_H
+#define MOTORCORRELACION_H
+
+#include <atomic>
+#include "SensorBase.h"
+
+/**
+ * @brief Cómo se emparejan las lecturas de los dos sensores de un par
+ */
+enum ModoAlineacion
+{
+    ALINEAR_POR_INDICE = 0, ///< La i-ésima lectura de A con la (i + retardo)-ésima de B
+    ALINEAR_POR_TIEMPO = 1  ///< Cada lectura de A con el último valor recibido de B
+};
+
+/**
+ * @class VentanaCovarianza
+ * @brief Medias, varianzas y covarianza de los últimos N pares (x, y) en O(1) por par
+ *
+ * Guarda los pares en un anillo y mantiene las medias, los momentos
+ * centrales de segundo orden (M2) y el co-momento con las fórmulas
+ * incrementales de Welford: agregar un par y retirar el más antiguo
+ * cuestan lo mismo sin importar el tamaño de la ventana. Cada vez que
+ * entran tantos pares como caben, los acumulados se recalculan desde el
+ * anillo en dos pasadas, lo que acota el error que dejan las restas
+ * (O(1) amortizado).
+ */
+class VentanaCovarianza
+{
+private:
+    double *x;          ///< Valores de la primera serie (anillo)
+    double *y;          ///< Valores de la segunda serie (anillo)
+    int capacidad;      ///< Pares de la ventana
+    int cantidad;       ///< Pares en la ventana
+    int inicio;         ///< Posición del par más antiguo
+    int desdeRecalculo; ///< Pares agregados desde el último recálculo
+    double mediaX;      ///< Media de x en la ventana
+    double mediaY;      ///< Media de y en la ventana
+    double m2X;         ///< Suma de (x - mediaX)^2
+    double m2Y;         ///< Suma de (y - mediaY)^2
+    double coMomento;   ///< Suma de (x - mediaX)(y - mediaY)
+
+public:
+    /**
+     * @brief Constructor
+     * @param ventana Pares que conserva (>= 2)
+     */
+    explicit VentanaCovarianza(int ventana);
+
+    /**
+     * @brief Destructor - Libera el anillo
+     */
+    ~VentanaCovarianza();
+
+    /**
+     * @brief Agrega un par; si la ventana está llena retira el más antiguo
+     * @param vx Valor de la primera serie
+     * @param vy Valor de la segunda serie
+     */
+    void agregar(double vx, double vy);
+
+    /**
+     * @brief Vacía la ventana
+     */
+    void reiniciar();
+
+    /**
+     * @brief Covarianza muestral de la ventana
+     * @return Co-momento / (n - 1), o 0 con menos de dos pares
+     */
+    double covarianza() const;
+
+    /**
+     * @brief Coeficiente de correlación de Pearson de la ventana
+     * @return Valor en [-1, 1], o NaN con menos de dos pares o una serie constante
+     */
+    double correlacion() const;
+
+    /**
+     * @brief Pares en la ventana
+     * @return Entre 0 y la capacidad
+     */
+    int getCantidad() const;
+
+    /**
+     * @brief Pares que conserva la ventana
+     * @return Capacidad del anillo
+     */
+    int getCapacidad() const;
+
+private:
+    VentanaCovarianza(const VentanaCovarianza &);            // No copiable
+    VentanaCovarianza &operator=(const VentanaCovarianza &); // No asignable
+
+    /**
+     * @brief Recalcula medias y momentos desde el anillo (dos pasadas)
+     */
+    void recalcular();
+};
+
+/**
+ * @class MotorCorrelacion
+ * @brief Vigila pares de sensores en la ingesta y calcula matrices de correlación bajo demanda
+ *
+ * Dos mecanismos complementarios:
+ * - Pares vigilados: como observador del registro, cada lectura de un
+ *   sensor alimenta solo los pares en los que participa (una cadena por
+ *   manejador), se alinea con la otra serie y actualiza la ventana móvil
+ *   del par en O(1). Un par se marca acoplado cuando |r| alcanza su umbral
+ *   con la ventana llena, y se cuentan los episodios.
+ * - Matriz de ventana completa: calcularMatriz() copia las últimas N
+ *   lecturas de cada sensor a una matriz contigua, las estandariza (media
+ *   cero y norma uno) y obtiene la correlación de cada par como un
+ *   producto punto, con un kernel vectorizable y los pares repartidos
+ *   entre varios hilos.
+ *
+ * Los historiales no guardan marcas de tiempo: la matriz alinea las
+ * series por posición desde la lectura más reciente, y los pares
+ * vigilados por índice o por orden de llegada (ALINEAR_POR_TIEMPO).
+ *
+ * Los dos sensores de un par pueden estar en fragmentos distintos del
+ * registro y recibir lecturas a la vez, así que cada par tiene su propio
+ * spinlock; las cadenas por manejador solo cambian en altas y bajas.
+ */
+class MotorCorrelacion : public ObservadorLecturas
+{
+public:
+    static const int TAM_NOMBRE = 50; ///< Largo máximo de un identificador de sensor
+
+private:
+    /**
+     * @brief Par vigilado con su alineación y su ventana
+     */
+    struct ParVigilado
+    {
+        char nombreA[TAM_NOMBRE]; ///< Sensor de la primera serie (x)
+        char nombreB[TAM_NOMBRE]; ///< Sensor de la segunda serie (y)
+        int manejadorA;           ///< Manejador de A (-1 sin resolver)
+        int manejadorB;           ///< Manejador de B (-1 sin resolver)
+        int siguienteA;           ///< Siguiente par en la cadena de A (-1 al final)
+        int siguienteB;           ///< Siguiente par en la cadena de B (-1 al final)
+        int modo;                 ///< ModoAlineacion
+        int retardo;              ///< Desfase de B respecto de A en lecturas (por índice)
+        int saltarA;              ///< Lecturas de A que faltan por saltar (retardo negativo o pareja descartada)
+        int saltarB;              ///< Lecturas de B que faltan por saltar (retardo positivo o pareja descartada)
+        double umbral;            ///< |r| a partir del cual el par está acoplado (0 = sin umbral)
+
+        double *pendientes;       ///< Lecturas sin pareja del sensor adelantado (anillo)
+        int inicioPendientes;     ///< Posición de la más antigua
+        int numPendientes;        ///< Lecturas en espera
+        bool pendientesDeA;       ///< true si las pendientes son de A
+        double ultimoB;           ///< Último valor de B (por tiempo)
+        bool hayUltimoB;          ///< Si B ya tiene un valor
+
+        VentanaCovarianza *ventana; ///< Pares alineados
+        unsigned long emparejadas;  ///< Pares agregados a la ventana
+        unsigned long descartadas;  ///< Parejas perdidas por desfase mayor a la ventana
+        unsigned long episodios;    ///< Veces que el par pasó a acoplado
+        bool acoplado;              ///< Si |r| alcanzó el umbral con la ventana llena (con histéresis)
+
+        std::atomic<bool> ocupado;  ///< Turno entre las lecturas de A y de B
+    };
+
+    ParVigilado **pares; ///< Pares vigilados
+    int numPares;        ///< Pares en uso
+    int capacidadPares;  ///< Capacidad del arreglo de pares
+
+    SensorBase **sensores; ///< Sensores conocidos, por manejador
+    int *primerPar;        ///< Primer par de la cadena de cada manejador (-1 si ninguno)
+    int numSensores;       ///< Sensores conocidos (manejador máximo + 1)
+    int capacidadSensores; ///< Capacidad de los arreglos por sensor
+
+    char (*nombresMatriz)[TAM_NOMBRE]; ///< Sensores de la última matriz
+    double *matriz;                    ///< Correlaciones (fila mayor, NaN sin datos)
+    int dimension;                     ///< Sensores de la última matriz
+    int ventanaMatriz;                 ///< Lecturas por sensor de la última matriz
+    int hilosMatriz;                   ///< Hilos usados en la última matriz
+    double milisegundosMatriz;         ///< Duración del cálculo de la última matriz
+
+public:
+    /**
+     * @brief Constructor por defecto (sin pares)
+     */
+    MotorCorrelacion();
+
+    /**
+     * @brief Destructor - Libera pares y matriz
+     */
+    ~MotorCorrelacion();
+
+    /**
+     * @brief Agrega un par vigilado
+     * @param nombreA Sensor de la primera serie (ej: temperatura)
+     * @param nombreB Sensor de la segunda serie (ej: presión)
+     * @param ventana Pares alineados de la ventana móvil (>= 2)
+     * @param modo ALINEAR_POR_INDICE o ALINEAR_POR_TIEMPO
+     * @param retardo Lecturas que B va detrás de A (solo por índice): con
+     *        retardo k se correlaciona A[i] con B[i + k], útil cuando la
+     *        presión reacciona después de la temperatura; negativo si B se
+     *        adelanta
+     * @param umbral |r| desde el que el par cuenta como acoplado (0 = sin umbral)
+     * @return Identificador del par, o -1 si los nombres son inválidos o iguales
+     *
+     * Si los sensores ya existen el par queda resuelto de inmediato; si no,
+     * se resuelve cuando se registren.
+     */
+    int agregarPar(const char *nombreA, const char *nombreB, int ventana,
+                   ModoAlineacion modo, int retardo, double umbral);
+
+    /**
+     * @brief Calcula la matriz de correlación de ventana completa
+     * @param lista Sensores a correlacionar
+     * @param cantidad Número de sensores
+     * @param ventana Lecturas más recientes de cada sensor (>= 2)
+     * @param hilos Hilos de cálculo (0 = según los núcleos disponibles)
+     * @return Sensores con datos válidos (al menos 'ventana' lecturas y no constantes)
+     *
+     * Debe llamarse desde el hilo de ingesta (lee los historiales); el
+     * cálculo de los pares se hace sobre una copia y no toca los sensores.
+     */
+    int calcularMatriz(SensorBase *const *lista, int cantidad, int ventana, int hilos);
+
+    /**
+     * @brief Correlación de dos sensores de la última matriz
+     * @param i Posición del primer sensor
+     * @param j Posición del segundo sensor
+     * @return Coeficiente de Pearson, o NaN si alguno no tenía datos
+     */
+    double getCorrelacion(int i, int j) const;
+
+    /**
+     * @brief Correlación móvil actual de un par vigilado
+     * @param idPar Identificador devuelto por agregarPar()
+     * @return Coeficiente de Pearson, o NaN sin datos suficientes
+     */
+    double getCorrelacionPar(int idPar) const;
+
+    /**
+     * @brief Covarianza móvil actual de un par vigilado
+     * @param idPar Identificador devuelto por agregarPar()
+     * @return Covarianza muestral, o 0 sin datos suficientes
+     */
+    double getCovarianzaPar(int idPar) const;
+
+    /**
+     * @brief Imprime el estado de los pares vigilados
+     */
+    void imprimirPares() const;
+
+    /**
+     * @brief Imprime los pares más correlacionados de la última matriz
+     * @param umbral |r| mínimo a mostrar
+     * @param maximo Pares a mostrar como mucho
+     */
+    void imprimirMatriz(double umbral, int maximo) const;
+
+    /**
+     * @brief Número de pares vigilados
+     * @return Pares agregados
+     */
+    int getNumPares() const;
+
+    /**
+     * @brief Sensores de la última matriz
+     * @return Dimensión de la matriz (0 si no se ha calculado)
+     */
+    int getDimension() const;
+
+    /**
+     * @brief Alinea la lectura con la otra serie de cada par del sensor
+     * @param sensor Sensor que recibió la lectura
+     * @param valor Valor registrado
+     */
+    void lecturaRegistrada(SensorBase &sensor, double valor) override;
+
+    /**
+     * @brief Resuelve los pares que nombran al sensor nuevo
+     * @param sensor Sensor registrado
+     * @param tipo Identificador del tipo en la arena
+     */
+    void sensorRegistrado(SensorBase &sensor, const void *tipo) override;
+
+    /**
+     * @brief Desenlaza el sensor de sus pares y vacía sus ventanas
+     * @param sensor Sensor dado de baja
+     * @param manejador Manejador que tenía
+     *
+     * Los pares siguen definidos: si vuelve a registrarse un sensor con el
+     * mismo nombre se resuelven otra vez y empiezan con la ventana vacía.
+     */
+    void sensorEliminado(SensorBase &sensor, int manejador) override;
+
+private:
+    MotorCorrelacion(const MotorCorrelacion &);            // No copiable
+    MotorCorrelacion &operator=(const MotorCorrelacion &); // No asignable
+
+    /**
+     * @brief Enlaza el lado de un par a la cadena de un manejador si el nombre coincide
+     */
+    void resolver(int idPar, SensorBase &sensor);
+
+    /**
+     * @brief Vacía la alineación y la ventana de un par
+     */
+    static void reiniciarPar(ParVigilado &par);
+
+    /**
+     * @brief Alinea una lectura de un lado del par y alimenta la ventana
+     */
+    static void alimentar(ParVigilado &par, bool esA, double valor);
+
+    /**
+     * @brief Agrega un par alineado a la ventana y actualiza el estado de acople
+     */
+    static void emparejar(ParVigilado &par, double vx, double vy);
+};
+
+#endif // MOTORCORRELACION_H
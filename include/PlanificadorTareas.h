@@ -0,0 +1,184 @@
+/**
+ * @file PlanificadorTareas.h
+ * @brief Planificador de tareas periódicas sobre una rueda de temporización
+ * @author FabiRamiro
+ * @date 2026-10-18
+ */
+
+#ifndef PLANIFICADORTAREAS_H
+#define PLANIFICADORTAREAS_H
+
+/**
+ * @class TareaPeriodica
+ * @brief Interfaz de un trabajo que el planificador ejecuta cada cierto tiempo
+ *
+ * ejecutar() corre en el hilo que llama a PlanificadorTareas::correr(), el
+ * mismo que registra las lecturas, así que puede tocar la lista de
+ * sensores sin bloqueos. Debe ser breve: mientras corre, las demás tareas
+ * (incluida la captura) esperan.
+ */
+class TareaPeriodica
+{
+public:
+    /**
+     * @brief Destructor virtual
+     */
+    virtual ~TareaPeriodica() {}
+
+    /**
+     * @brief Ejecuta una vez el trabajo
+     */
+    virtual void ejecutar() = 0;
+};
+
+/**
+ * @brief Estadísticas de ejecución de una tarea
+ */
+struct EstadisticasTarea
+{
+    unsigned long ejecuciones; ///< Veces que corrió
+    unsigned long desbordes;   ///< Ejecuciones que duraron más que su periodo
+    unsigned long omitidas;    ///< Periodos saltados por ir atrasada
+    long long jitterTotalUs;   ///< Suma de los retrasos respecto de la hora programada
+    long long jitterMaxUs;     ///< Mayor retraso
+    long long duracionTotalUs; ///< Suma de las duraciones
+    long long duracionMaxUs;   ///< Mayor duración
+};
+
+/**
+ * @class PlanificadorTareas
+ * @brief Planificador cooperativo sobre una rueda de temporización de 1 ms
+ *
+ * La rueda tiene NUM_RANURAS ranuras de un milisegundo. Una tarea que vence
+ * en el instante t se enlaza en la ranura t & (NUM_RANURAS - 1) con el
+ * número de vueltas completas que faltan; cada milisegundo que avanza el
+ * reloj se visita una sola ranura, así que programar y vencer son O(1)
+ * sin importar cuántas tareas haya ni lo largo de sus periodos.
+ *
+ * Una tarea se reprograma sobre su grilla (vencimiento + periodo), no
+ * sobre la hora real de ejecución, para que el retraso no se acumule. Si
+ * va tan atrasada que ya pasó su siguiente vencimiento, los periodos
+ * perdidos se cuentan como omitidos en lugar de ejecutarse en ráfaga.
+ *
+ * El planificador no crea hilos: correr() intercala las tareas en el hilo
+ * que llama y duerme hasta el próximo vencimiento.
+ */
+class PlanificadorTareas
+{
+public:
+    static const int MAX_TAREAS = 16;   ///< Tareas registrables
+    static const int NUM_RANURAS = 256; ///< Ranuras de la rueda (potencia de 2, 1 ms cada una)
+    static const int TAM_NOMBRE = 32;   ///< Longitud máxima del nombre de una tarea
+
+private:
+    /**
+     * @brief Tarea registrada y su posición en la rueda
+     */
+    struct Tarea
+    {
+        char nombre[TAM_NOMBRE];          ///< Nombre para las estadísticas
+        TareaPeriodica *trabajo;          ///< Trabajo a ejecutar (no se toma su propiedad)
+        int periodoMs;                    ///< Periodo de ejecución
+        long long vencimientoMs;          ///< Próxima hora programada (relativa al origen)
+        int vueltas;                      ///< Vueltas completas de la rueda que faltan
+        int siguiente;                    ///< Siguiente tarea de la misma ranura (-1 = fin)
+        bool activa;                      ///< Se sigue programando
+        EstadisticasTarea estadisticas;   ///< Jitter, duración y desbordes
+    };
+
+    Tarea tareas[MAX_TAREAS];      ///< Tareas registradas
+    int numTareas;                 ///< Tareas en uso
+    int ranuras[NUM_RANURAS];      ///< Primera tarea de cada ranura (-1 = vacía)
+    long long origenUs;            ///< Reloj monótono al crear el planificador
+    long long tickActual;          ///< Último milisegundo cuya ranura ya se visitó
+    bool detenido;                 ///< Pedido de salida de correr()
+
+public:
+    /**
+     * @brief Constructor: rueda vacía, el reloj empieza en 0
+     */
+    PlanificadorTareas();
+
+    /**
+     * @brief Registra una tarea periódica
+     * @param nombre Nombre para las estadísticas
+     * @param trabajo Trabajo a ejecutar (debe vivir mientras el planificador corra)
+     * @param periodoMs Periodo en milisegundos (>= 1)
+     * @param primeraMs Retraso de la primera ejecución (0 = en el próximo milisegundo)
+     * @return Identificador de la tarea, -1 si no hay lugar o el periodo no es válido
+     */
+    int agregarTarea(const char *nombre, TareaPeriodica *trabajo, int periodoMs, int primeraMs);
+
+    /**
+     * @brief Deja de programar una tarea (la que ya está en la rueda no se ejecuta)
+     * @param id Identificador devuelto por agregarTarea()
+     */
+    void quitarTarea(int id);
+
+    /**
+     * @brief Avanza la rueda hasta la hora actual y ejecuta lo vencido
+     * @return Tareas ejecutadas
+     */
+    int ejecutarPendientes();
+
+    /**
+     * @brief Milisegundos hasta el próximo vencimiento
+     * @return 0 si hay algo vencido, -1 si no hay tareas activas
+     */
+    int msHastaProxima() const;
+
+    /**
+     * @brief Ejecuta las tareas durante un tiempo o hasta detener()
+     * @param duracionMs Tiempo máximo (0 = hasta detener())
+     */
+    void correr(long long duracionMs);
+
+    /**
+     * @brief Pide que correr() termine al volver de la tarea actual
+     */
+    void detener();
+
+    /**
+     * @brief Obtiene las estadísticas de una tarea
+     * @param id Identificador de la tarea
+     * @return Estadísticas (nullptr si el id no es válido)
+     */
+    const EstadisticasTarea *getEstadisticas(int id) const;
+
+    /**
+     * @brief Imprime jitter, duración y desbordes de cada tarea
+     */
+    void imprimirEstadisticas() const;
+
+private:
+    /**
+     * @brief Microsegundos desde el origen (reloj monótono)
+     * @return Tiempo transcurrido
+     */
+    long long ahoraUs() const;
+
+    /**
+     * @brief Lleva la rueda a la hora actual conservando el desfase de cada tarea
+     *
+     * Entre dos llamadas a correr() el planificador no avanza; el tiempo
+     * detenido no cuenta como retraso ni como periodos omitidos.
+     */
+    void reanudar();
+
+    /**
+     * @brief Enlaza una tarea en la ranura de su vencimiento
+     * @param id Tarea a programar
+     */
+    void programar(int id);
+
+    /**
+     * @brief Ejecuta una tarea vencida, mide su jitter y duración y la reprograma
+     * @param id Tarea vencida
+     */
+    void ejecutarTarea(int id);
+
+    PlanificadorTareas(const PlanificadorTareas &);            // No copiable
+    PlanificadorTareas &operator=(const PlanificadorTareas &); // No asignable
+};
+
+#endif // PLANIFICADORTAREAS_H
@@ -0,0 +1,190 @@
+/**
+ * @file ProtocoloBinario.h
+ * @brief Protocolo binario compacto de tramas para el ESP32 y su decodificador
+ * @author FabiRamiro
+ * @date 2026-10-18
+ *
+ * Formato de trama (enteros en little-endian):
+ *
+ * | Campo     | Bytes | Descripción                                   |
+ * | :-------- | :---- | :-------------------------------------------- |
+ * | SYNC      | 1     | Byte de sincronización (0xA5)                 |
+ * | N         | 1     | Lecturas en la trama (1..MAX_LECTURAS_TRAMA)  |
+ * | SECUENCIA | 2     | Número de secuencia de la trama               |
+ * | LECTURA   | 7 * N | TIPO (1) + ID (2) + VALOR (4, entero con signo)|
+ * | CRC       | 2     | CRC-16/CCITT-FALSE de N..última lectura       |
+ *
+ * El valor es de ancho fijo: la temperatura viaja en décimas de grado
+ * (23.5 °C -> 235), la presión en PSI enteros y la vibración en conteos
+ * del acelerómetro (un bloque de muestras ocupa varias lecturas seguidas
+ * con el mismo ID).
+ */
+
+#ifndef PROTOCOLOBINARIO_H
+#define PROTOCOLOBINARIO_H
+
+const unsigned char SYNC_TRAMA = 0xA5;        ///< Byte de sincronización
+const int MAX_LECTURAS_TRAMA = 32;            ///< Lecturas máximas por trama
+const int TAM_CABECERA_TRAMA = 4;             ///< SYNC + N + SECUENCIA
+const int TAM_LECTURA_TRAMA = 7;              ///< TIPO + ID + VALOR
+const int TAM_CRC_TRAMA = 2;                  ///< Bytes del CRC
+const int TAM_MAX_TRAMA = TAM_CABECERA_TRAMA + MAX_LECTURAS_TRAMA * TAM_LECTURA_TRAMA + TAM_CRC_TRAMA;
+const int ESCALA_TEMPERATURA = 10;            ///< Décimas de grado por unidad
+
+/**
+ * @brief Códigos de tipo de sensor dentro de la trama
+ */
+enum TipoTrama
+{
+    TRAMA_TEMP = 1, ///< Temperatura (décimas de °C)
+    TRAMA_PRES = 2, ///< Presión (PSI)
+    TRAMA_VIB = 3   ///< Vibración (una muestra del acelerómetro en conteos)
+};
+
+/**
+ * @brief Lectura individual decodificada de una trama
+ */
+struct LecturaBinaria
+{
+    unsigned char tipo;       ///< Código TipoTrama
+    unsigned short id;        ///< Parte numérica del ID (T-001 -> 1)
+    int valorCrudo;           ///< Valor de ancho fijo (32 bits) tal como viaja en la trama
+    unsigned short secuencia; ///< Secuencia de la trama de origen
+
+    /**
+     * @brief Convierte el valor crudo a unidades físicas
+     * @return Temperatura en °C o presión en PSI
+     */
+    double valor() const;
+
+    /**
+     * @brief Nombre textual del tipo ("TEMP", "PRES", ...)
+     * @return Cadena constante, "????" si el tipo es desconocido
+     */
+    const char *nombreTipo() const;
+
+    /**
+     * @brief Reconstruye el ID textual del sensor (ej: "T-001")
+     * @param destino Buffer de salida
+     * @param tamano Tamaño del buffer
+     */
+    void formatearId(char *destino, int tamano) const;
+};
+
+/**
+ * @brief Calcula el CRC-16/CCITT-FALSE (polinomio 0x1021, inicial 0xFFFF)
+ * @param datos Bytes de entrada
+ * @param longitud Número de bytes
+ * @return CRC calculado
+ */
+unsigned short calcularCRC16(const unsigned char *datos, int longitud);
+
+/**
+ * @brief Codifica un lote de lecturas en una trama
+ * @param lecturas Lecturas a codificar (se ignora su campo secuencia)
+ * @param cantidad Número de lecturas (1..MAX_LECTURAS_TRAMA)
+ * @param secuencia Número de secuencia de la trama
+ * @param destino Buffer de al menos TAM_MAX_TRAMA bytes
+ * @return Bytes escritos, 0 si la cantidad no es válida
+ */
+int codificarTrama(const LecturaBinaria *lecturas, int cantidad,
+                   unsigned short secuencia, unsigned char *destino);
+
+/**
+ * @class DecodificadorTramas
+ * @brief Decodificador incremental de tramas con resincronización
+ *
+ * Recibe bytes en trozos de cualquier tamaño (como llegan del puerto serial)
+ * y entrega las lecturas de las tramas válidas. Si una trama llega corrupta
+ * (CRC o longitud inválidos) se descarta solo el byte de sincronización y
+ * se busca el siguiente 0xA5, de modo que el flujo se recupera en cuanto
+ * aparece la siguiente trama íntegra.
+ */
+class DecodificadorTramas
+{
+private:
+    static const int TAM_BUFFER = 2 * TAM_MAX_TRAMA; ///< Capacidad del buffer de entrada
+
+    unsigned char buffer[TAM_BUFFER];                ///< Bytes pendientes de decodificar
+    int ocupados;                                    ///< Bytes válidos en el buffer
+    LecturaBinaria pendientes[MAX_LECTURAS_TRAMA];   ///< Lecturas de la última trama
+    int numPendientes;                               ///< Lecturas decodificadas
+    int posPendiente;                                ///< Siguiente lectura a entregar
+    bool haySecuencia;                               ///< Se recibió al menos una trama
+    unsigned short secuenciaEsperada;                ///< Secuencia de la siguiente trama
+
+    unsigned long tramasValidas;   ///< Tramas aceptadas
+    unsigned long erroresCRC;      ///< Tramas descartadas por CRC o longitud
+    unsigned long bytesDescartados; ///< Bytes ignorados durante la resincronización
+    unsigned long tramasPerdidas;  ///< Huecos detectados en la secuencia
+
+public:
+    /**
+     * @brief Constructor por defecto
+     */
+    DecodificadorTramas();
+
+    /**
+     * @brief Agrega bytes recibidos al decodificador
+     * @param datos Bytes recibidos
+     * @param n Cantidad de bytes
+     * @return Bytes aceptados (puede ser menor que n si el buffer está lleno;
+     *         en ese caso se deben consumir lecturas y volver a llamar)
+     */
+    int alimentar(const unsigned char *datos, int n);
+
+    /**
+     * @brief Obtiene la siguiente lectura decodificada
+     * @param lectura Destino de la lectura
+     * @return true si había una lectura disponible
+     */
+    bool siguienteLectura(LecturaBinaria &lectura);
+
+    /**
+     * @brief Reinicia el estado (buffer, secuencia y estadísticas)
+     */
+    void reiniciar();
+
+    /**
+     * @brief Imprime las estadísticas de decodificación
+     */
+    void imprimirEstadisticas() const;
+
+    /**
+     * @brief Obtiene el número de tramas aceptadas
+     * @return Tramas con CRC válido
+     */
+    unsigned long getTramasValidas() const;
+
+    /**
+     * @brief Obtiene el número de tramas descartadas
+     * @return Tramas con CRC o longitud inválidos
+     */
+    unsigned long getErroresCRC() const;
+
+    /**
+     * @brief Obtiene los bytes ignorados durante la resincronización
+     * @return Cantidad de bytes descartados
+     */
+    unsigned long getBytesDescartados() const;
+
+    /**
+     * @brief Obtiene los huecos detectados en la secuencia
+     * @return Tramas que no llegaron (según el número de secuencia)
+     */
+    unsigned long getTramasPerdidas() const;
+
+private:
+    /**
+     * @brief Busca y decodifica la siguiente trama válida del buffer
+     * @return true si se decodificó una trama
+     */
+    bool decodificarTrama();
+
+    /**
+     * @brief Elimina los primeros n bytes del buffer
+     */
+    void consumir(int n);
+};
+
+#endif // PROTOCOLOBINARIO_H
@@ -0,0 +1,107 @@
+/**
+ * @file ProtocoloConsultas.h
+ * @brief Protocolo binario del servidor de consultas (socket Unix local)
+ * @author FabiRamiro
+ * @date 2026-10-18
+ *
+ * Petición:  u32 longitud | u8 operacion | u32 id | carga
+ * Respuesta: u32 longitud | u8 operacion | u8 estado | u32 id | carga
+ *
+ * 'longitud' cuenta los bytes que la siguen. Los enteros y reales van en
+ * el orden de bytes del host (el socket es local) y sin alineación. El
+ * cliente puede enviar muchas peticiones seguidas sin esperar (pipelining):
+ * las respuestas llegan en el mismo orden y llevan el id de su petición.
+ *
+ * Cargas de petición y de respuesta (OK) por operación:
+ * - CONSULTA_ESTADO:        -                      -> u64 instantanea | i32 sensores | i64 lecturas
+ * - CONSULTA_SENSOR:        nombre                 -> char tipo[8] | i32 manejador | i32 lecturas |
+ *                                                     f64 ultima | f64 promedio | f64 minimo | f64 maximo
+ * - CONSULTA_ESTADISTICAS:  i32 desde | i32 hasta | nombre
+ *                                                  -> i32 cantidad | f64 promedio | f64 minimo |
+ *                                                     f64 maximo | f64 p50 | f64 p90 | f64 p99
+ * - CONSULTA_RANGO:         i32 desde | i32 hasta | nombre
+ *                                                  -> i32 desde | i32 cantidad | f64 valores[cantidad]
+ * - CONSULTA_TOPK:          u8 campo | u8 mayores | u16 k | prefijo
+ *                                                  -> i32 n | n x (f64 valor | u8 largo | nombre)
+ *
+ * 'desde' y 'hasta' son posiciones en el historial del sensor (orden de
+ * llegada), 'hasta' excluida; un valor negativo cuenta desde el final y
+ * 'hasta' = 0 significa "hasta la última". Así (0, 0) es todo el
+ * historial y (-100, 0) las últimas cien lecturas. Los nombres y
+ * prefijos ocupan el resto de la carga, sin nulo final.
+ */
+
+#ifndef PROTOCOLOCONSULTAS_H
+#define PROTOCOLOCONSULTAS_H
+
+#include <cstdint>
+#include <cstring>
+
+const int TAM_CABECERA_PETICION = 9;   ///< longitud + operacion + id
+const int TAM_CABECERA_RESPUESTA = 10; ///< longitud + operacion + estado + id
+const int MAX_PETICION = 1024;         ///< Bytes máximos de una petición (con la cabecera)
+const int MAX_VALORES_RANGO = 8192;    ///< Valores máximos en una respuesta de rango
+const int MAX_TOPK = 256;              ///< k máximo de una consulta top-k
+const int TAM_TIPO_CONSULTA = 8;       ///< Tipo corto del sensor en la respuesta (con el nulo)
+
+/**
+ * @brief Operaciones
+ */
+enum OperacionConsulta
+{
+    CONSULTA_ESTADO = 0,        ///< Número de instantánea, sensores y lecturas totales
+    CONSULTA_SENSOR = 1,        ///< Resumen de un sensor por nombre
+    CONSULTA_ESTADISTICAS = 2,  ///< Promedio, extremos y cuantiles de un rango del historial
+    CONSULTA_RANGO = 3,         ///< Valores de un rango del historial
+    CONSULTA_TOPK = 4           ///< Los k sensores con mayor (o menor) valor de un campo
+};
+
+/**
+ * @brief Estado de una respuesta
+ */
+enum EstadoConsulta
+{
+    CONSULTA_OK = 0,             ///< Respuesta con carga
+    CONSULTA_NO_ENCONTRADO = 1,  ///< El sensor no existe en la instantánea
+    CONSULTA_INVALIDA = 2        ///< Operación desconocida o carga mal formada
+};
+
+/**
+ * @brief Campo por el que ordena CONSULTA_TOPK
+ */
+enum CampoTopK
+{
+    TOPK_PROMEDIO = 0, ///< Promedio del historial
+    TOPK_MINIMO = 1,   ///< Mínimo del historial
+    TOPK_MAXIMO = 2,   ///< Máximo del historial
+    TOPK_ULTIMA = 3,   ///< Última lectura
+    TOPK_LECTURAS = 4  ///< Cantidad de lecturas
+};
+
+/**
+ * @brief Copia un valor a un buffer sin alineación y avanza
+ * @param destino Posición de escritura (se avanza)
+ * @param valor Valor a copiar
+ */
+template <typename T>
+inline void escribirCampo(unsigned char *&destino, T valor)
+{
+    std::memcpy(destino, &valor, sizeof(T));
+    destino += sizeof(T);
+}
+
+/**
+ * @brief Lee un valor de un buffer sin alineación y avanza
+ * @param origen Posición de lectura (se avanza)
+ * @return Valor leído
+ */
+template <typename T>
+inline T leerCampo(const unsigned char *&origen)
+{
+    T valor;
+    std::memcpy(&valor, origen, sizeof(T));
+    origen += sizeof(T);
+    return valor;
+}
+
+#endif // PROTOCOLOCONSULTAS_H
@@ -0,0 +1,163 @@
+/**
+ * @file PublicadorAnillo.h
+ * @brief Publicación de lecturas y agregados en un anillo de memoria compartida
+ * @author FabiRamiro
+ * @date 2026-10-18
+ */
+
+#ifndef PUBLICADORANILLO_H
+#define PUBLICADORANILLO_H
+
+#include "AnilloCompartido.h"
+#include "SensorBase.h"
+
+class PublicadorInstantaneas;
+
+/**
+ * @class PublicadorAnillo
+ * @brief Observador que escribe cada lectura aceptada en un anillo de /dev/shm
+ *
+ * El anillo es de un solo escritor y múltiples lectores: el sistema
+ * escribe sin esperar a nadie y cada consumidor local (tableros,
+ * registradores) lleva su propia posición con el número de secuencia de
+ * los registros. Publicar un registro son unas pocas escrituras en la
+ * memoria mapeada, sin llamadas al sistema ni bloqueos; un lector lento
+ * no frena la ingesta, solo pierde los registros que el escritor ya
+ * sobrescribió (y se entera, ver LectorAnillo). Dentro del proceso, los
+ * avisos de fragmentos distintos se turnan para escribir con un spinlock
+ * que solo cubre la escritura del registro, de modo que el anillo sigue
+ * viendo un único escritor.
+ *
+ * Además de las lecturas, publicarAgregados() escribe periódicamente el
+ * resumen (promedio, mínimo, máximo) de los sensores que cambiaron desde
+ * la vista anterior, tomado de la última instantánea publicada.
+ *
+ * Mientras no se llame a abrir(), las notificaciones no hacen nada.
+ */
+class PublicadorAnillo : public ObservadorLecturas
+{
+public:
+    static const int CAPACIDAD_DEFECTO = 4096; ///< Ranuras por defecto (potencia de 2)
+    static const int TAM_NOMBRE_SEGMENTO = 64; ///< Longitud máxima del nombre del segmento
+
+private:
+    CabeceraAnillo *cabecera;            ///< Segmento mapeado (nullptr = cerrado)
+    RanuraAnillo *ranuras;               ///< Ranuras que siguen a la cabecera
+    std::uint64_t mascara;               ///< capacidad - 1
+    std::uint64_t publicados;            ///< Copia local del contador (protegida por escribiendo)
+    std::atomic<bool> escribiendo;       ///< Turno de escritura entre fragmentos
+    std::uint64_t tamano;                ///< Bytes mapeados
+    char nombreSegmento[TAM_NOMBRE_SEGMENTO]; ///< Nombre pasado a shm_open ("/...")
+
+    unsigned long *versionesPublicadas;  ///< Versión + 1 del último agregado de cada sensor (0 = ninguno)
+    int capacidadVersiones;              ///< Capacidad de versionesPublicadas
+
+public:
+    /**
+     * @brief Constructor: anillo cerrado
+     */
+    PublicadorAnillo();
+
+    /**
+     * @brief Destructor: cierra y elimina el segmento
+     */
+    ~PublicadorAnillo();
+
+    /**
+     * @brief Crea el segmento y empieza a publicar
+     * @param nombre Nombre del segmento (ej: "sensores" queda en /dev/shm/sensores)
+     * @param capacidad Ranuras del anillo (se redondea a potencia de 2)
+     * @return true si se pudo crear y mapear
+     *
+     * Si ya existía un segmento con ese nombre (de una ejecución anterior)
+     * se reemplaza: los lectores conectados a él lo ven inactivo.
+     */
+    bool abrir(const char *nombre, int capacidad = CAPACIDAD_DEFECTO);
+
+    /**
+     * @brief Marca el anillo inactivo, lo desmapea y elimina el nombre
+     *
+     * Los lectores que ya lo tenían mapeado pueden terminar de leer lo
+     * publicado; el segmento se libera cuando el último lo desmapea.
+     */
+    void cerrar();
+
+    /**
+     * @brief Indica si se está publicando
+     * @return true si el anillo está abierto
+     */
+    bool estaAbierto() const;
+
+    /**
+     * @brief Publica la lectura aceptada
+     * @param sensor Sensor que recibió la lectura
+     * @param valor Valor registrado
+     */
+    void lecturaRegistrada(SensorBase &sensor, double valor) override;
+
+    /**
+     * @brief Publica cada muestra del bloque como una lectura
+     * @param sensor Sensor que recibió el bloque
+     * @param cuentas Muestras del bloque
+     * @param cantidad Número de muestras
+     */
+    void bloqueRegistrado(SensorBase &sensor, const int *cuentas, int cantidad) override;
+
+    /**
+     * @brief Publica el resumen de los sensores que cambiaron desde el último llamado
+     * @param origen Publicador de instantáneas (se lee su vista actual)
+     * @return Agregados escritos
+     *
+     * Debe llamarse desde el hilo de la ingesta (el único escritor).
+     */
+    int publicarAgregados(PublicadorInstantaneas &origen);
+
+    /**
+     * @brief Registros escritos desde abrir()
+     * @return Cantidad de registros
+     */
+    unsigned long long getPublicados() const;
+
+    /**
+     * @brief Imprime el nombre, la capacidad y los registros publicados
+     */
+    void imprimirEstado() const;
+
+private:
+    /**
+     * @brief Toma la próxima ranura, la marca en escritura y la devuelve
+     * @return Registro a completar (luego confirmar())
+     */
+    RegistroAnillo &reservar();
+
+    /**
+     * @brief Toma el turno de escritura
+     */
+    void bloquear();
+
+    /**
+     * @brief Suelta el turno de escritura
+     */
+    void desbloquear();
+
+    /**
+     * @brief Sella el registro reservado y lo hace visible a los lectores
+     */
+    void confirmar();
+
+    /**
+     * @brief Completa los campos comunes de un registro
+     * @param registro Registro reservado
+     * @param tipo TipoRegistroAnillo
+     * @param manejador Manejador del sensor
+     * @param tipoSensor Tipo corto del sensor
+     * @param nombre Identificador del sensor
+     */
+    static void completar(RegistroAnillo &registro, TipoRegistroAnillo tipo, int manejador,
+                          const char *tipoSensor, const char *nombre);
+
+    PublicadorAnillo(const PublicadorAnillo &);            // No copiable
+    PublicadorAnillo &operator=(const PublicadorAnillo &); // No asignable
+};
+
+#endif // PUBLICADORANILLO_H
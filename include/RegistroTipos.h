@@ -0,0 +1,113 @@
+/**
+ * @file RegistroTipos.h
+ * @brief Registro de tipos de sensor en tiempo de compilación y procesamiento por lotes
+ * @author FabiRamiro
+ * @date 2026-10-18
+ */
+
+#ifndef REGISTROTIPOS_H
+#define REGISTROTIPOS_H
+
+#include <type_traits>
+#include "ArenaSensores.h"
+#include "SensorTemperatura.h"
+#include "SensorPresion.h"
+#include "SensorVibracion.h"
+#include "Trazas.h"
+
+/**
+ * @brief Lista de tipos de sensor conocidos en tiempo de compilación
+ * @tparam Tipos Tipos concretos (deben ser clases final derivadas de SensorBase)
+ *
+ * Para cada tipo de la lista se genera un bucle monomórfico que recorre su
+ * pool contiguo en la ArenaSensores y llama a procesarLectura() con una
+ * llamada cualificada (S::procesarLectura), que el compilador resuelve de
+ * forma estática y puede expandir en línea. Los sensores de tipos que no
+ * están en la lista siguen usando la llamada virtual de SensorBase.
+ */
+template <typename... Tipos>
+struct RegistroTipos;
+
+/**
+ * @brief Caso base: lista vacía
+ */
+template <>
+struct RegistroTipos<>
+{
+    static const int cantidad = 0; ///< Número de tipos registrados
+
+    /**
+     * @brief Indica si un identificador de tipo pertenece a la lista
+     * @param tipo Identificador devuelto por ArenaSensores::idTipo<S>()
+     * @return false (lista vacía)
+     */
+    static bool contieneTipo(const void *tipo)
+    {
+        (void)tipo;
+        return false;
+    }
+
+    /**
+     * @brief Procesa por lotes los pools de la arena (nada que hacer)
+     * @param arena Arena de sensores
+     * @return Número de sensores procesados
+     */
+    static int procesar(const ArenaSensores &arena)
+    {
+        (void)arena;
+        return 0;
+    }
+};
+
+/**
+ * @brief Caso recursivo: procesa el tipo S y continúa con el resto
+ */
+template <typename S, typename... Resto>
+struct RegistroTipos<S, Resto...>
+{
+    static_assert(std::is_base_of<SensorBase, S>::value,
+                  "Los tipos registrados deben derivar de SensorBase");
+
+    static const int cantidad = 1 + RegistroTipos<Resto...>::cantidad; ///< Número de tipos registrados
+
+    /**
+     * @brief Indica si un identificador de tipo pertenece a la lista
+     * @param tipo Identificador devuelto por ArenaSensores::idTipo<S>()
+     * @return true si el tipo está registrado
+     */
+    static bool contieneTipo(const void *tipo)
+    {
+        return tipo == ArenaSensores::idTipo<S>() || RegistroTipos<Resto...>::contieneTipo(tipo);
+    }
+
+    /**
+     * @brief Procesa cada tipo de la lista como un lote monomórfico
+     * @param arena Arena donde viven los sensores
+     * @return Número de sensores procesados
+     */
+    static int procesar(const ArenaSensores &arena)
+    {
+        int procesados = 0;
+        arena.recorrer<S>([&procesados](S &sensor)
+                          {
+                              if (sensor.getManejador() < 0)
+                              {
+                                  return; // Dado de baja, espera su liberación
+                              }
+                              MuestraTraza muestra(ETAPA_PROCESO);
+                              sensor.S::procesarLectura(); // Llamada estática, sin vtable
+                              procesados++;
+                          });
+        return procesados + RegistroTipos<Resto...>::procesar(arena);
+    }
+};
+
+/**
+ * @brief Tipos de sensor que se procesan por lotes en ListaGeneral
+ *
+ * Para agregar un tipo nuevo al camino rápido basta con añadirlo aquí;
+ * si no se añade, funciona igual a través de la interfaz virtual.
+ */
+typedef RegistroTipos<SensorTemperatura, SensorPresion, SensorVibracion> TiposRegistrados;
+
+#endif // REGISTROTIPOS_H
@@ -9,6 +9,116 @@
 #define SENSORBASE_H
 
 #include <iostream>
+#include <cstddef>
+#include "EscritorReporte.h"
+#include "BufferReordenamiento.h"
+#include "AgregadorVentana.h"
+
+class SensorBase;
+
+/**
+ * @class ObservadorLecturas
+ * @brief Interfaz para reaccionar a cada lectura en el momento de la ingesta
+ *
+ * Los sensores notifican a su observador desde registrarLectura(), de modo
+ * que alertas, trazas o contadores se actualizan sin esperar al siguiente
+ * procesamiento.
+ *
+ * Detrás de ListaGeneral, los avisos de ingesta (lecturas, bloques e
+ * historialModificado) de sensores de fragmentos distintos pueden llegar
+ * a la vez desde hilos distintos; los de un mismo sensor nunca se
+ * solapan. Las altas, las bajas y admiteSensorNuevo() llegan en exclusiva.
+ */
+class ObservadorLecturas
+{
+public:
+    /**
+     * @brief Destructor virtual
+     */
+    virtual ~ObservadorLecturas() {}
+
+    /**
+     * @brief Se invoca después de registrar una lectura individual
+     * @param sensor Sensor que recibió la lectura
+     * @param valor Valor registrado
+     */
+    virtual void lecturaRegistrada(SensorBase &sensor, double valor) = 0;
+
+    /**
+     * @brief Se invoca después de registrar un bloque de muestras enteras
+     * @param sensor Sensor que recibió el bloque
+     * @param cuentas Muestras del bloque
+     * @param cantidad Número de muestras
+     *
+     * Por defecto notifica cada muestra como una lectura individual.
+     */
+    virtual void bloqueRegistrado(SensorBase &sensor, const int *cuentas, int cantidad)
+    {
+        for (int i = 0; i < cantidad; i++)
+        {
+            lecturaRegistrada(sensor, cuentas[i]);
+        }
+    }
+
+    /**
+     * @brief Se invoca cuando un sensor entra en el registro
+     * @param sensor Sensor registrado (ya tiene su manejador asignado)
+     * @param tipo Identificador del tipo en la arena (nullptr si se creó con new)
+     */
+    virtual void sensorRegistrado(SensorBase &sensor, const void *tipo)
+    {
+        (void)sensor;
+        (void)tipo;
+    }
+
+    /**
+     * @brief Se invoca cuando un sensor sale del registro
+     * @param sensor Sensor dado de baja (sigue siendo válido durante la llamada)
+     * @param manejador Manejador que tenía; el registro puede reutilizarlo en un alta posterior
+     *
+     * El observador debe soltar todo lo que guarde del sensor: el objeto
+     * se libera cuando ningún lector lo puede estar usando.
+     */
+    virtual void sensorEliminado(SensorBase &sensor, int manejador)
+    {
+        (void)sensor;
+        (void)manejador;
+    }
+
+    /**
+     * @brief Se invoca cuando el historial cambia fuera de la ingesta
+     * @param sensor Sensor modificado (procesamiento, desalojo o restauración)
+     */
+    virtual void historialModificado(SensorBase &sensor)
+    {
+        (void)sensor;
+    }
+
+    /**
+     * @brief Se consulta antes de crear un sensor en el registro
+     * @param nombre Identificador del sensor a crear
+     * @return false para rechazar el alta (ej: presupuesto de memoria agotado)
+     */
+    virtual bool admiteSensorNuevo(const char *nombre)
+    {
+        (void)nombre;
+        return true;
+    }
+};
+
+/**
+ * @brief Resultado del último procesamiento de un sensor
+ *
+ * Cada procesarLectura() lo sobrescribe; mientras el sensor no reciba
+ * lecturas nuevas sigue siendo válido y se reutiliza sin volver a procesar.
+ */
+struct ResultadoProceso
+{
+    bool valido;       ///< Hubo datos suficientes para calcularlo
+    int lecturas;      ///< Valores sobre los que se calculó
+    double valor;      ///< Valor principal: promedio (TEMP, PRES) o último RMS (VIB)
+    double dispersion; ///< Rango (PRES), pico (VIB) o 0 (TEMP: la desviación va en su reporte)
+};
 
 /**
  * @class SensorBase
@@ -21,7 +131,12 @@
 class SensorBase
 {
 protected:
-    char nombre[50]; ///< Identificador único del sensor
+    char nombre[50];                 ///< Identificador único del sensor
+    ObservadorLecturas *observador;  ///< Destino de las notificaciones de ingesta
+    int manejador;                   ///< Índice del sensor en su registro (-1 si no está registrado)
+    BufferReordenamiento *reorden;   ///< Ventana de secuencias (se crea con la primera lectura numerada)
+    ResultadoProceso resultado;      ///< Último procesamiento (lo completa procesarLectura())
+    bool silencioso;                 ///< No informa lecturas ni procesamiento por consola (las advertencias sí)
 
 public:
     /**
@@ -58,6 +173,159 @@ public:
      */
     virtual void imprimirInfo() const = 0;
 
+    /**
+     * @brief Obtiene el nombre corto del tipo de sensor
+     * @return Cadena estática con el tipo (ej: "TEMP")
+     */
+    virtual const char *getTipo() const
+    {
+        return "GENERICO";
+    }
+
+    /**
+     * @brief Obtiene el número de valores en el historial del sensor
+     * @return Cantidad de valores almacenados
+     */
+    virtual int getNumLecturas() const
+    {
+        return 0;
+    }
+
+    /**
+     * @brief Copia el historial del sensor a un arreglo contiguo
+     * @param destino Arreglo destino
+     * @param maximo Capacidad del arreglo destino
+     * @return Número de valores copiados
+     */
+    virtual int copiarLecturas(double *destino, int maximo) const
+    {
+        (void)destino;
+        (void)maximo;
+        return 0;
+    }
+
+    /**
+     * @brief Agrega valores al historial sin pasar por la ingesta
+     * @param valores Valores en orden de llegada
+     * @param cantidad Número de valores
+     * @return true si el sensor admite restaurar su historial
+     *
+     * Lo usa la bitácora al reproducir un punto de control: los valores
+     * no se notifican como lecturas ni se vuelven a registrar; el
+     * observador solo recibe historialModificado().
+     */
+    virtual bool restaurarLecturas(const double *valores, int cantidad)
+    {
+        (void)valores;
+        (void)cantidad;
+        return false;
+    }
+
+    /**
+     * @brief Copia las muestras crudas que aún no pasaron al historial
+     * @param destino Arreglo destino
+     * @param maximo Capacidad del arreglo destino
+     * @return Número de muestras copiadas (0 si el sensor no acumula muestras)
+     */
+    virtual int copiarMuestrasPendientes(int *destino, int maximo) const
+    {
+        (void)destino;
+        (void)maximo;
+        return 0;
+    }
+
+    /**
+     * @brief Memoria que ocupa el sensor, incluido su historial
+     * @return Bytes del objeto más los reservados por historial y buffers
+     */
+    virtual std::size_t getBytesMemoria() const
+    {
+        return sizeof(*this);
+    }
+
+    /**
+     * @brief Descarta los segmentos más antiguos del historial
+     * @param segmentos Máximo de segmentos a descartar
+     * @return Lecturas descartadas
+     *
+     * Siempre se conserva el segmento más reciente, el que recibe las
+     * lecturas nuevas. Lo usa GestorMemoria para cumplir el presupuesto.
+     */
+    virtual int descartarLecturasAntiguas(int segmentos)
+    {
+        (void)segmentos;
+        return 0;
+    }
+
+    /**
+     * @brief Escribe el reporte del sensor en el formato pedido
+     * @param escritor Destino del reporte
+     * @param formato Texto, CSV (una fila por lectura) o JSON (una línea)
+     * @param limite Lecturas a mostrar al inicio y al final (0 = todas)
+     *
+     * La implementación por defecto usa copiarLecturas(); los sensores
+     * concretos la redefinen para recorrer su historial sin copiarlo.
+     */
+    virtual void escribirReporte(EscritorReporte &escritor, FormatoReporte formato, int limite) const;
+
+    /**
+     * @brief Registra un valor en el historial por la ruta de ingesta del tipo concreto
+     * @param valor Valor en las unidades del sensor
+     * @return false si el sensor no admite valores genéricos
+     *
+     * Equivale a registrarLectura() del sensor concreto: se imprime, se
+     * agrega a los agregados y se notifica al observador.
+     */
+    virtual bool registrarValor(double valor)
+    {
+        (void)valor;
+        return false;
+    }
+
+    /**
+     * @brief Registra una lectura numerada por el dispositivo
+     * @param valor Valor en las unidades del sensor
+     * @param secuencia Número de secuencia de la lectura en el dispositivo
+     * @return Si se aceptó (en orden o intercalada) o se descartó (duplicada o tardía)
+     *
+     * La lectura pasa por el BufferReordenamiento del sensor: las que llegan
+     * adelantadas esperan a que se llene el hueco y las repetidas se
+     * descartan. Lo que sale de la ventana entra con registrarValor(), en
+     * orden de secuencia.
+     */
+    ResultadoSecuencia registrarLecturaSecuencia(double valor, long long secuencia);
+
+    /**
+     * @brief Registra lo que espera en la ventana de secuencias, sin esperar más los huecos
+     * @return Lecturas registradas
+     */
+    int vaciarReordenamiento();
+
+    /**
+     * @brief Obtiene la ventana de secuencias del sensor
+     * @return nullptr si el sensor nunca recibió lecturas numeradas
+     */
+    const BufferReordenamiento *getReordenamiento() const;
+
+    /**
+     * @brief Configura la ventana deslizante y la EWMA del sensor
+     * @param tamano Lecturas por ventana
+     * @param alfa Factor de suavizado de la EWMA (0, 1]
+     * @return true si el sensor mantiene agregados de ventana
+     */
+    virtual bool configurarVentana(int tamano, double alfa)
+    {
+        (void)tamano;
+        (void)alfa;
+        return false;
+    }
+
+    /**
+     * @brief Obtiene el resultado del último procesamiento
+     * @return Resultado en caché (valido = false si nunca se procesó con datos)
+     */
+    const ResultadoProceso &getResultado() const;
+
     /**
      * @brief Obtiene el nombre del sensor
      * @return Puntero constante al nombre del sensor
@@ -69,6 +337,149 @@ public:
      * @param nombreSensor Nuevo nombre para el sensor
      */
     void setNombre(const char *nombreSensor);
+
+    /**
+     * @brief Establece el observador que recibirá cada lectura registrada
+     * @param nuevoObservador Observador (nullptr para desactivar)
+     */
+    void setObservador(ObservadorLecturas *nuevoObservador);
+
+    /**
+     * @brief Activa o desactiva los mensajes informativos del sensor y de su historial
+     * @param activo true para no informar cada lectura, bloque y procesamiento
+     *
+     * Las advertencias (sin lecturas, secuencias descartadas) se imprimen
+     * siempre. Lo usa la reproducción de la bitácora.
+     */
+    virtual void setSilencioso(bool activo);
+
+    /**
+     * @brief Indica si el sensor está en modo silencioso
+     * @return true si no informa lecturas ni procesamiento
+     */
+    bool esSilencioso() const;
+
+    /**
+     * @brief Obtiene el manejador del sensor en su registro
+     * @return Índice asignado por ListaGeneral, -1 si no está registrado
+     */
+    int getManejador() const;
+
+    /**
+     * @brief Asigna el manejador del sensor (lo usa el registro)
+     * @param nuevoManejador Índice dentro del registro
+     */
+    void setManejador(int nuevoManejador);
+
+protected:
+    /**
+     * @brief Memoria de la ventana de secuencias (para getBytesMemoria())
+     * @return Bytes reservados, 0 si no se creó
+     */
+    std::size_t getBytesReordenamiento() const
+    {
+        return (reorden != nullptr) ? sizeof(BufferReordenamiento) : 0;
+    }
+
+    /**
+     * @brief Abre la línea JSON del sensor: {"sensor":..,"tipo":..,"lecturas":
+     * @param escritor Destino del reporte
+     */
+    void abrirReporteJSON(EscritorReporte &escritor) const;
+
+    /**
+     * @brief Cierra la línea JSON del sensor con el número de lecturas omitidas
+     * @param escritor Destino del reporte
+     * @param omitidas Lecturas omitidas por el límite
+     */
+    void cerrarReporteJSON(EscritorReporte &escritor, int omitidas) const;
+
+    /**
+     * @brief Notifica al observador una lectura recién registrada
+     * @param valor Valor registrado
+     */
+    void notificarLectura(double valor)
+    {
+        if (observador != nullptr)
+        {
+            observador->lecturaRegistrada(*this, valor);
+        }
+    }
+
+    /**
+     * @brief Notifica al observador que el historial cambió fuera de la ingesta
+     */
+    void notificarModificacion()
+    {
+        if (observador != nullptr)
+        {
+            observador->historialModificado(*this);
+        }
+    }
+
+    /**
+     * @brief Descarta los segmentos más antiguos de un historial (conserva el último)
+     * @param historial Historial del sensor (ListaSensor)
+     * @param segmentos Máximo de segmentos a descartar
+     * @return Lecturas descartadas
+     *
+     * Implementación común de descartarLecturasAntiguas().
+     */
+    template <typename Historial>
+    int descartarSegmentos(Historial &historial, int segmentos)
+    {
+        int quitadas = 0;
+        for (int s = 0; s < segmentos && historial.getNumSegmentos() > 1; s++)
+        {
+            quitadas += historial.eliminarSegmentoInicial();
+        }
+        if (quitadas > 0)
+        {
+            notificarModificacion();
+        }
+        return quitadas;
+    }
+
+    /**
+     * @brief Agrega valores al historial y a la ventana sin notificarlos como lecturas
+     * @param historial Historial del sensor (ListaSensor)
+     * @param ventana Agregados móviles del sensor
+     * @param valores Valores en orden de llegada (se convierten al tipo de la ventana)
+     * @param cantidad Número de valores
+     *
+     * Implementación común de restaurarLecturas().
+     */
+    template <typename Historial, typename T>
+    void restaurarEn(Historial &historial, AgregadorVentana<T> &ventana, const double *valores, int cantidad)
+    {
+        for (int i = 0; i < cantidad; i++)
+        {
+            T valor = static_cast<T>(valores[i]);
+            historial.insertar(valor);
+            ventana.agregar(valor);
+        }
+        if (cantidad > 0)
+        {
+            notificarModificacion();
+        }
+    }
+
+    /**
+     * @brief Notifica al observador un bloque recién registrado
+     * @param cuentas Muestras del bloque
+     * @param cantidad Número de muestras
+     */
+    void notificarBloque(const int *cuentas, int cantidad)
+    {
+        if (observador != nullptr)
+        {
+            observador->bloqueRegistrado(*this, cuentas, cantidad);
+        }
+    }
+
+private:
+    SensorBase(const SensorBase &);            // No copiable
+    SensorBase &operator=(const SensorBase &); // No asignable
 };
 
 #endif // SENSORBASE_H
\ No newline at end of file
@@ -10,18 +10,29 @@
 
 #include "SensorBase.h"
 #include "ListaSensor.h"
+#include "CodificacionValores.h"
+#include "AgregadorVentana.h"
 
 /**
  * @class SensorPresion
  * @brief Sensor especializado para medir presión en PSI
  *
- * Almacena lecturas de tipo int y procesa los datos calculando
+ * Recibe lecturas de tipo int y procesa los datos calculando
  * el promedio de todas las lecturas registradas
+ *
+ * El historial (ListaSensor<PuntoFijo16<1>, long long, ...>) guarda cada lectura en punto fijo de 16 bits con paso de
+ * 1 PSI: la mitad que un int y exacto para cualquier lectura entera de
+ * -32768 a 32767 PSI, así que los picos fuera del rango de trabajo (50 a
+ * 150 PSI) llegan intactos al promedio, al rango y a la bitácora. Una
+ * lectura fuera de ese rango se guarda saturada al extremo: se advierte
+ * y se cuenta en getLecturasSaturadas().
  */
-class SensorPresion : public SensorBase
+class SensorPresion final : public SensorBase
 {
 private:
-    ListaSensor<int> historial; ///< Lista enlazada de lecturas de presión
+    ListaSensor<PuntoFijo16<1>, long long, EstadisticaSuma, EstadisticaMinMax> historial; ///< Lecturas de presión (16 bits) con suma y rango
+    AgregadorVentana<int> ventana; ///< Media, mínimo, máximo y EWMA de las últimas lecturas
+    int saturadas; ///< Lecturas guardadas al extremo del rango de 16 bits
 
 public:
     /**
@@ -54,6 +65,82 @@ public:
      * Implementación del método virtual puro de SensorBase
      */
     void imprimirInfo() const override;
+
+    /**
+     * @brief Escribe el reporte del sensor recorriendo el historial en su lugar
+     * @param escritor Destino del reporte
+     * @param formato Formato del reporte
+     * @param limite Lecturas a mostrar al inicio y al final (0 = todas)
+     */
+    void escribirReporte(EscritorReporte &escritor, FormatoReporte formato, int limite) const override;
+
+    /**
+     * @brief Obtiene el nombre corto del tipo de sensor
+     * @return "PRES"
+     */
+    const char *getTipo() const override;
+
+    /**
+     * @brief Obtiene el número de valores en el historial
+     * @return Lecturas almacenadas
+     */
+    int getNumLecturas() const override;
+
+    /**
+     * @brief Obtiene cuántas lecturas se guardaron saturadas en el historial
+     * @return Lecturas fuera del rango de 16 bits
+     */
+    int getLecturasSaturadas() const;
+
+    /**
+     * @brief Copia el historial a un arreglo contiguo
+     * @param destino Arreglo destino
+     * @param maximo Capacidad del arreglo destino
+     * @return Número de valores copiados
+     */
+    int copiarLecturas(double *destino, int maximo) const override;
+
+    /**
+     * @brief Configura la ventana deslizante y la EWMA (reinicia los agregados)
+     * @param tamano Lecturas por ventana
+     * @param alfa Factor de suavizado de la EWMA
+     * @return true
+     */
+    bool configurarVentana(int tamano, double alfa) override;
+
+    /**
+     * @brief Agrega valores al historial sin notificarlos (reproducción de la bitácora)
+     * @param valores Valores en orden de llegada
+     * @param cantidad Número de valores
+     * @return true
+     */
+    bool restaurarLecturas(const double *valores, int cantidad) override;
+
+    /**
+     * @brief Memoria del sensor: objeto, historial y ventana
+     * @return Bytes ocupados
+     */
+    std::size_t getBytesMemoria() const override;
+
+    /**
+     * @brief Descarta los segmentos más antiguos del historial (conserva el último)
+     * @param segmentos Máximo de segmentos a descartar
+     * @return Lecturas descartadas
+     */
+    int descartarLecturasAntiguas(int segmentos) override;
+
+    /**
+     * @brief Registra un valor genérico con registrarLectura()
+     * @param valor Valor en las unidades del sensor
+     * @return true
+     */
+    bool registrarValor(double valor) override;
+
+    /**
+     * @brief Activa o desactiva los mensajes del sensor y de su historial
+     * @param activo true para no informar lecturas ni procesamiento
+     */
+    void setSilencioso(bool activo) override;
 };
 
 #endif // SENSORPRESION_H
\ No newline at end of file
@@ -10,18 +10,29 @@
 
 #include "SensorBase.h"
 #include "ListaSensor.h"
+#include "CodificacionValores.h"
+#include "AgregadorVentana.h"
 
 /**
  * @class SensorTemperatura
  * @brief Sensor especializado para medir temperatura en grados Celsius
  *
- * Almacena lecturas de tipo float y procesa los datos eliminando
+ * Recibe lecturas de tipo float y procesa los datos eliminando
  * el valor más bajo y calculando el promedio de los restantes
+ *
+ * El historial (ListaSensor<PuntoFijo16<10>, double, EstadisticaSuma>) guarda cada lectura en punto fijo de 16 bits con
+ * resolución de 0.1 °C (la del ESP32): la mitad de memoria que un float
+ * y exacto para las lecturas reales. Una lectura manual con más
+ * decimales se redondea en el historial; la ventana y las alertas ven
+ * el valor original. Una lectura fuera de ±3276.7 °C se guarda saturada
+ * al extremo: se advierte y se cuenta en getLecturasSaturadas().
  */
-class SensorTemperatura : public SensorBase
+class SensorTemperatura final : public SensorBase
 {
 private:
-    ListaSensor<float> historial; ///< Lista enlazada de lecturas de temperatura
+    ListaSensor<PuntoFijo16<10>, double, EstadisticaSuma> historial; ///< Lecturas de temperatura en décimas (solo suma para el promedio)
+    AgregadorVentana<float> ventana; ///< Media, mínimo, máximo y EWMA de las últimas lecturas
+    int saturadas; ///< Lecturas guardadas al extremo del rango de 16 bits
 
 public:
     /**
@@ -54,6 +65,91 @@ public:
      * Implementación del método virtual puro de SensorBase
      */
     void imprimirInfo() const override;
+
+    /**
+     * @brief Escribe el reporte del sensor recorriendo el historial en su lugar
+     * @param escritor Destino del reporte
+     * @param formato Formato del reporte
+     * @param limite Lecturas a mostrar al inicio y al final (0 = todas)
+     */
+    void escribirReporte(EscritorReporte &escritor, FormatoReporte formato, int limite) const override;
+
+    /**
+     * @brief Obtiene el nombre corto del tipo de sensor
+     * @return "TEMP"
+     */
+    const char *getTipo() const override;
+
+    /**
+     * @brief Obtiene el número de valores en el historial
+     * @return Lecturas almacenadas
+     */
+    int getNumLecturas() const override;
+
+    /**
+     * @brief Desviación estándar muestral del historial (para el reporte)
+     * @return Desviación en °C (0 con menos de dos lecturas)
+     *
+     * Suma y suma de cuadrados recorren el historial por segmentos con
+     * politicaHistorial(); procesarLectura() no la calcula.
+     */
+    double calcularDesviacion() const;
+
+    /**
+     * @brief Obtiene cuántas lecturas se guardaron saturadas en el historial
+     * @return Lecturas fuera del rango de 16 bits
+     */
+    int getLecturasSaturadas() const;
+
+    /**
+     * @brief Copia el historial a un arreglo contiguo
+     * @param destino Arreglo destino
+     * @param maximo Capacidad del arreglo destino
+     * @return Número de valores copiados
+     */
+    int copiarLecturas(double *destino, int maximo) const override;
+
+    /**
+     * @brief Configura la ventana deslizante y la EWMA (reinicia los agregados)
+     * @param tamano Lecturas por ventana
+     * @param alfa Factor de suavizado de la EWMA
+     * @return true
+     */
+    bool configurarVentana(int tamano, double alfa) override;
+
+    /**
+     * @brief Agrega valores al historial sin notificarlos (reproducción de la bitácora)
+     * @param valores Valores en orden de llegada
+     * @param cantidad Número de valores
+     * @return true
+     */
+    bool restaurarLecturas(const double *valores, int cantidad) override;
+
+    /**
+     * @brief Memoria del sensor: objeto, historial y ventana
+     * @return Bytes ocupados
+     */
+    std::size_t getBytesMemoria() const override;
+
+    /**
+     * @brief Descarta los segmentos más antiguos del historial (conserva el último)
+     * @param segmentos Máximo de segmentos a descartar
+     * @return Lecturas descartadas
+     */
+    int descartarLecturasAntiguas(int segmentos) override;
+
+    /**
+     * @brief Registra un valor genérico con registrarLectura()
+     * @param valor Valor en las unidades del sensor
+     * @return true
+     */
+    bool registrarValor(double valor) override;
+
+    /**
+     * @brief Activa o desactiva los mensajes del sensor y de su historial
+     * @param activo true para no informar lecturas ni procesamiento
+     */
+    void setSilencioso(bool activo) override;
 };
 
 #endif // SENSORTEMPERATURA_H
\ No newline at end of file
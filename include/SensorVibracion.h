@@ -0,0 +1,185 @@
+/**
+ * @file SensorVibracion.h
+ * @brief Sensor de vibración de alta frecuencia con procesamiento por bloques
+ * @author FabiRamiro
+ * @date 2026-10-18
+ */
+
+#ifndef SENSORVIBRACION_H
+#define SENSORVIBRACION_H
+
+#include "SensorBase.h"
+#include "ListaSensor.h"
+#include "CodificacionValores.h"
+#include "AgregadorVentana.h"
+
+/**
+ * @class SensorVibracion
+ * @brief Sensor especializado para medir vibración (conteos enteros del acelerómetro)
+ *
+ * La vibración llega a frecuencias de kHz, así que las muestras no se guardan
+ * una por nodo: se acumulan en un buffer contiguo y se procesan por ventanas
+ * de TAM_VENTANA muestras. Por cada ventana se calcula el RMS, el pico y la
+ * energía por bandas de una FFT radix-2 (con ventana de Hann). El historial
+ * enlazado guarda solo el RMS de cada ventana procesada, en media precisión
+ * (error relativo menor a 0.05%, suficiente para seguir la tendencia).
+ */
+class SensorVibracion final : public SensorBase
+{
+public:
+    static const int TAM_VENTANA = 256;               ///< Muestras por ventana (potencia de 2)
+    static const int NUM_BANDAS = 8;                  ///< Bandas de energía del espectro
+    static const int MAX_MUESTRAS_PENDIENTES = 65536; ///< Tope del buffer sin procesar
+
+private:
+    ListaSensor<Flotante16, double, EstadisticaSuma, EstadisticaVarianza> historial; ///< RMS de cada ventana procesada
+    AgregadorVentana<float> ventanaRMS; ///< Agregados móviles del RMS por ventana
+
+    int *muestras;                ///< Buffer contiguo de muestras sin procesar
+    int numMuestras;              ///< Muestras en el buffer
+    int capacidadMuestras;        ///< Capacidad del buffer
+    unsigned long descartadas;    ///< Muestras perdidas por exceder el tope
+
+    float ultimoRMS;                    ///< RMS de la última ventana
+    int ultimoPico;                     ///< Pico absoluto de la última ventana
+    float ultimasBandas[NUM_BANDAS];    ///< Energía por banda de la última ventana
+    unsigned long ventanasProcesadas;   ///< Total de ventanas procesadas
+
+public:
+    /**
+     * @brief Constructor con nombre del sensor
+     * @param nombreSensor Identificador único del sensor
+     */
+    SensorVibracion(const char *nombreSensor);
+
+    /**
+     * @brief Destructor - Libera el buffer de muestras y la lista de RMS
+     */
+    ~SensorVibracion();
+
+    /**
+     * @brief Registra una única muestra de vibración
+     * @param cuenta Valor del acelerómetro (conteos)
+     */
+    void registrarLectura(int cuenta);
+
+    /**
+     * @brief Registra un bloque de muestras consecutivas
+     * @param cuentas Arreglo de muestras
+     * @param cantidad Número de muestras
+     *
+     * Las muestras se copian en bloque al buffer contiguo.
+     */
+    void registrarBloque(const int *cuentas, int cantidad);
+
+    /**
+     * @brief Procesa las ventanas completas: RMS, pico y bandas de la FFT
+     *
+     * Implementación del método virtual puro de SensorBase. Las muestras
+     * que no completan una ventana quedan para el siguiente procesamiento.
+     */
+    void procesarLectura() override;
+
+    /**
+     * @brief Imprime información del sensor y sus lecturas
+     *
+     * Implementación del método virtual puro de SensorBase
+     */
+    void imprimirInfo() const override;
+
+    /**
+     * @brief Escribe el reporte del sensor recorriendo el historial en su lugar
+     * @param escritor Destino del reporte
+     * @param formato Formato del reporte
+     * @param limite Lecturas a mostrar al inicio y al final (0 = todas)
+     */
+    void escribirReporte(EscritorReporte &escritor, FormatoReporte formato, int limite) const override;
+
+    /**
+     * @brief Obtiene el nombre corto del tipo de sensor
+     * @return "VIB"
+     */
+    const char *getTipo() const override;
+
+    /**
+     * @brief Obtiene el número de valores en el historial
+     * @return Ventanas con RMS almacenado
+     */
+    int getNumLecturas() const override;
+
+    /**
+     * @brief Copia el historial a un arreglo contiguo
+     * @param destino Arreglo destino
+     * @param maximo Capacidad del arreglo destino
+     * @return Número de valores copiados
+     */
+    int copiarLecturas(double *destino, int maximo) const override;
+
+    /**
+     * @brief Configura la ventana deslizante y la EWMA (reinicia los agregados)
+     * @param tamano Lecturas por ventana
+     * @param alfa Factor de suavizado de la EWMA
+     * @return true
+     */
+    bool configurarVentana(int tamano, double alfa) override;
+
+    /**
+     * @brief Agrega valores al historial sin notificarlos (reproducción de la bitácora)
+     * @param valores Valores en orden de llegada
+     * @param cantidad Número de valores
+     * @return true
+     */
+    bool restaurarLecturas(const double *valores, int cantidad) override;
+
+    /**
+     * @brief Memoria del sensor: objeto, historial y ventana
+     * @return Bytes ocupados
+     */
+    std::size_t getBytesMemoria() const override;
+
+    /**
+     * @brief Descarta los segmentos más antiguos del historial (conserva el último)
+     * @param segmentos Máximo de segmentos a descartar
+     * @return Lecturas descartadas
+     */
+    int descartarLecturasAntiguas(int segmentos) override;
+
+    /**
+     * @brief Registra un valor genérico con registrarLectura()
+     * @param valor Valor en las unidades del sensor
+     * @return true
+     */
+    bool registrarValor(double valor) override;
+
+    /**
+     * @brief Activa o desactiva los mensajes del sensor y de su historial
+     * @param activo true para no informar lecturas ni procesamiento
+     */
+    void setSilencioso(bool activo) override;
+
+    /**
+     * @brief Copia las muestras del buffer que no completan una ventana
+     * @param destino Arreglo destino
+     * @param maximo Capacidad del arreglo destino
+     * @return Número de muestras copiadas
+     */
+    int copiarMuestrasPendientes(int *destino, int maximo) const override;
+
+    /**
+     * @brief Obtiene el número de muestras pendientes de procesar
+     * @return Muestras en el buffer
+     */
+    int getMuestrasPendientes() const;
+
+private:
+    SensorVibracion(const SensorVibracion &);            // No copiable
+    SensorVibracion &operator=(const SensorVibracion &); // No asignable
+
+    /**
+     * @brief Analiza una ventana de TAM_VENTANA muestras
+     * @param ventana Inicio de la ventana dentro del buffer
+     */
+    void analizarVentana(const int *ventana);
+};
+
+#endif // SENSORVIBRACION_H
@@ -8,6 +8,8 @@
 #ifndef SERIALREADER_H
 #define SERIALREADER_H
 
+#include "ProtocoloBinario.h"
+
 /**
  * @class SerialReader
  * @brief Clase para simular la lectura de datos desde el puerto serial
@@ -15,11 +17,22 @@
  * En un entorno real, esta clase manejaría la comunicación con el ESP32
  * a través del puerto serial. Para propósitos de demostración, simula
  * las lecturas de manera aleatoria.
+ *
+ * Soporta dos formatos: texto ("TIPO:ID:VALOR", uno por línea) y el
+ * protocolo binario de tramas de ProtocoloBinario.h. En modo binario los
+ * bytes pasan por un DecodificadorTramas que resincroniza tras corrupción;
+ * la simulación genera tramas con lotes de lecturas, entrega los bytes en
+ * trozos de tamaño irregular e inyecta ruido de vez en cuando para ejercitar
+ * la recuperación del decodificador.
  */
 class SerialReader
 {
 private:
-    bool conectado; ///< Estado de conexión con el dispositivo
+    bool conectado;                    ///< Estado de conexión con el dispositivo
+    bool modoBinario;                  ///< true = tramas binarias, false = texto
+    DecodificadorTramas decodificador; ///< Decodificador del flujo binario
+    unsigned short secuenciaSimulada;  ///< Secuencia de la siguiente trama simulada
+    int fase;                          ///< Fase de la vibración simulada
 
 public:
     /**
@@ -57,6 +70,45 @@ public:
      * @return true si hay datos disponibles
      */
     bool hayDatos() const;
+
+    /**
+     * @brief Selecciona el formato de datos del dispositivo
+     * @param binario true para tramas binarias, false para líneas de texto
+     */
+    void setModoBinario(bool binario);
+
+    /**
+     * @brief Indica si el lector está en modo binario
+     * @return true si se usan tramas binarias
+     */
+    bool esModoBinario() const;
+
+    /**
+     * @brief Lee la siguiente lectura decodificada del flujo binario
+     * @param lectura Destino de la lectura
+     * @return true si se obtuvo una lectura (solo en modo binario)
+     */
+    bool leerLectura(LecturaBinaria &lectura);
+
+    /**
+     * @brief Acceso al decodificador (estadísticas de tramas)
+     * @return Referencia constante al decodificador
+     */
+    const DecodificadorTramas &getDecodificador() const;
+
+private:
+    /**
+     * @brief Genera los bytes que enviaría el ESP32 en modo binario
+     * @param destino Buffer de al menos TAM_MAX_TRAMA + 8 bytes
+     * @return Número de bytes generados
+     */
+    int simularBytes(unsigned char *destino);
+
+    /**
+     * @brief Genera una muestra del acelerómetro simulado (senoidal con ruido)
+     * @return Muestra en conteos
+     */
+    int simularMuestraVibracion();
 };
 
 #endif // SERIALREADER_H
\ No newline at end of file
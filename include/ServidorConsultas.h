@@ -0,0 +1,207 @@
+/**
+ * @file ServidorConsultas.h
+ * @brief Servidor de consultas embebido sobre un socket Unix, respondido desde instantáneas
+ * @author FabiRamiro
+ * @date 2026-10-18
+ */
+
+#ifndef SERVIDORCONSULTAS_H
+#define SERVIDORCONSULTAS_H
+
+#include <atomic>
+#include <thread>
+#include "ProtocoloConsultas.h"
+
+class PublicadorInstantaneas;
+struct InstantaneaFlota;
+struct InstantaneaSensor;
+
+/**
+ * @class ServidorConsultas
+ * @brief Responde consultas de procesos locales sin tocar la lista de sensores
+ *
+ * El servidor corre en su propio hilo con un bucle epoll sobre el socket
+ * de escucha y los clientes (Linux). Nunca lee ListaGeneral: cada lote de
+ * peticiones se responde desde la última InstantaneaFlota publicada,
+ * fijada con LectorInstantaneas, así que una consulta no frena la
+ * ingesta ni la ingesta deja una consulta a medias. Los datos tienen la
+ * antigüedad de la última publicación (PublicadorInstantaneas::publicar).
+ *
+ * Por cada lectura del socket se procesan todas las peticiones completas
+ * que llegaron (pipelining) contra una misma instantánea y las respuestas
+ * se envían con una sola escritura (batching). Si el cliente no lee y su
+ * buffer de salida se llena, se deja de procesar su entrada hasta que
+ * drene, sin afectar a los demás clientes.
+ *
+ * La búsqueda por nombre usa un índice ordenado de la instantánea que se
+ * reconstruye solo cuando cambia el número de publicación.
+ */
+class ServidorConsultas
+{
+public:
+    static const int MAX_CLIENTES = 32;      ///< Conexiones simultáneas
+    static const int TAM_ENTRADA = 1 << 16;  ///< Buffer de peticiones por cliente
+    static const int TAM_SALIDA = 1 << 18;   ///< Buffer de respuestas por cliente
+    static const int TAM_RUTA = 108;         ///< Longitud máxima de la ruta del socket (sun_path)
+    static const int MAX_RESPUESTA = TAM_CABECERA_RESPUESTA + 8 + 8 * MAX_VALORES_RANGO; ///< Respuesta más larga
+
+private:
+    /**
+     * @brief Estado de una conexión
+     */
+    struct Cliente
+    {
+        int fd;                  ///< Descriptor, -1 si la ranura está libre
+        unsigned char *entrada;  ///< Peticiones recibidas sin procesar
+        int usadosEntrada;       ///< Bytes en entrada
+        unsigned char *salida;   ///< Respuestas pendientes de enviar
+        int usadosSalida;        ///< Bytes en salida
+        int enviadosSalida;      ///< Bytes de salida ya enviados
+        bool esperandoEscritura; ///< Registrado para EPOLLOUT (y no para EPOLLIN)
+        bool finEntrada;         ///< El cliente cerró su lado: se cierra al vaciar la salida
+    };
+
+    PublicadorInstantaneas &publicador; ///< Origen de las instantáneas
+    Cliente clientes[MAX_CLIENTES];      ///< Conexiones
+    char ruta[TAM_RUTA];                 ///< Ruta del socket
+    int escucha;                         ///< Socket de escucha (-1 = detenido)
+    int epollFd;                         ///< Descriptor de epoll
+    int despertador;                     ///< eventfd para detener el hilo
+    std::thread hilo;                    ///< Hilo del servidor
+    std::atomic<bool> activo;            ///< Señal de parada
+    int ranuraLector;                    ///< Ranura de épocas del hilo del servidor
+
+    int *indiceNombres;                  ///< Manejadores ordenados por nombre
+    int capacidadIndice;                 ///< Capacidad de indiceNombres
+    int numIndexados;                    ///< Manejadores en el índice
+    unsigned long numeroIndexado;        ///< Instantánea con la que se construyó el índice
+    bool hayIndice;                      ///< El índice corresponde a alguna instantánea
+    double *auxiliar;                    ///< Copia de valores para los cuantiles
+    int capacidadAuxiliar;               ///< Capacidad de auxiliar
+
+    std::atomic<unsigned long long> peticiones; ///< Peticiones respondidas
+    std::atomic<unsigned long long> lotes;      ///< Lotes (lecturas del socket con peticiones)
+    std::atomic<int> conectados;                ///< Clientes conectados
+
+public:
+    /**
+     * @brief Constructor: servidor detenido
+     * @param origen Publicador de instantáneas de donde se responde
+     */
+    explicit ServidorConsultas(PublicadorInstantaneas &origen);
+
+    /**
+     * @brief Destructor: detiene el servidor
+     */
+    ~ServidorConsultas();
+
+    /**
+     * @brief Crea el socket y lanza el hilo del servidor
+     * @param rutaSocket Ruta del socket Unix (se reemplaza si existe)
+     * @return true si quedó escuchando
+     */
+    bool iniciar(const char *rutaSocket);
+
+    /**
+     * @brief Cierra todas las conexiones, detiene el hilo y borra el socket
+     */
+    void detener();
+
+    /**
+     * @brief Indica si el servidor está escuchando
+     * @return true si está activo
+     */
+    bool estaActivo() const;
+
+    /**
+     * @brief Imprime ruta, clientes y peticiones respondidas
+     */
+    void imprimirEstado() const;
+
+private:
+    /**
+     * @brief Bucle del hilo: acepta, lee, responde y envía
+     */
+    void ejecutar();
+
+    /**
+     * @brief Acepta todas las conexiones pendientes
+     */
+    void aceptar();
+
+    /**
+     * @brief Lee del cliente y responde las peticiones completas
+     * @param c Índice del cliente
+     * @return false si la conexión se cerró
+     */
+    bool atenderLectura(int c);
+
+    /**
+     * @brief Responde las peticiones completas del buffer de entrada contra una instantánea
+     * @param c Índice del cliente
+     * @return false si una petición está mal formada (se cierra la conexión)
+     */
+    bool procesarLote(int c);
+
+    /**
+     * @brief Envía lo pendiente y ajusta el interés en EPOLLOUT
+     * @param c Índice del cliente
+     * @return false si la conexión se cerró
+     */
+    bool enviar(int c);
+
+    /**
+     * @brief Cierra y libera la conexión
+     * @param c Índice del cliente
+     */
+    void cerrarCliente(int c);
+
+    /**
+     * @brief Escribe la respuesta a una petición en el buffer de salida
+     * @param vista Instantánea fijada para el lote
+     * @param peticion Petición completa (con la cabecera)
+     * @param longitud Bytes de la petición
+     * @param destino Comienzo de la respuesta en el buffer de salida
+     * @return Bytes escritos
+     */
+    int responder(const InstantaneaFlota &vista, const unsigned char *peticion, int longitud,
+                  unsigned char *destino);
+
+    /**
+     * @brief Busca un sensor por nombre en la instantánea
+     * @param vista Instantánea fijada
+     * @param nombre Nombre (no terminado en nulo)
+     * @param largo Longitud del nombre
+     * @return Resumen del sensor, nullptr si no existe
+     */
+    const InstantaneaSensor *buscar(const InstantaneaFlota &vista, const char *nombre, int largo);
+
+    /**
+     * @brief Posiciones del índice cuyos nombres empiezan con un prefijo
+     * @param vista Instantánea fijada
+     * @param prefijo Prefijo (no terminado en nulo)
+     * @param largo Longitud del prefijo (0 = todos)
+     * @param desde Primera posición del índice
+     * @param hasta Posición siguiente a la última
+     */
+    void rangoPrefijo(const InstantaneaFlota &vista, const char *prefijo, int largo, int &desde, int &hasta);
+
+    /**
+     * @brief Reconstruye el índice de nombres si la instantánea cambió
+     * @param vista Instantánea fijada
+     */
+    void actualizarIndice(const InstantaneaFlota &vista);
+
+    /**
+     * @brief Convierte 'desde' y 'hasta' del protocolo en un rango válido del historial
+     * @param total Lecturas del historial
+     * @param desde Posición inicial (negativa = desde el final); sale normalizada
+     * @param hasta Posición final excluida (<= 0 = desde el final); sale normalizada
+     */
+    static void normalizarRango(int total, int &desde, int &hasta);
+
+    ServidorConsultas(const ServidorConsultas &);            // No copiable
+    ServidorConsultas &operator=(const ServidorConsultas &); // No asignable
+};
+
+#endif // SERVIDORCONSULTAS_H
@@ -0,0 +1,218 @@
+/**
+ * @file Trazas.h
+ * @brief Trazas muestreadas de la ruta de ingesta con exportación a Chrome Trace
+ * @author FabiRamiro
+ * @date 2026-10-18
+ */
+
+#ifndef TRAZAS_H
+#define TRAZAS_H
+
+#include <atomic>
+#include <chrono>
+
+/**
+ * @brief Etapas de la ruta de una lectura que se pueden medir
+ */
+enum EtapaTraza
+{
+    ETAPA_CICLO = 0,     ///< Una lectura completa, de la llegada al historial (raíz)
+    ETAPA_LECTURA = 1,   ///< SerialReader::leerLinea() / leerLectura()
+    ETAPA_TRAMA = 2,     ///< Decodificación de una trama binaria
+    ETAPA_PARSEO = 3,    ///< Separación de TIPO:ID:VALOR o del bloque de muestras
+    ETAPA_BUSQUEDA = 4,  ///< Búsqueda (o alta) del sensor por ID
+    ETAPA_DESPACHO = 5,  ///< Reenvío a los observadores (alertas, instantáneas, bitácora...)
+    ETAPA_INSERCION = 6, ///< Inserción en el historial y en los agregados de ventana
+    ETAPA_PROCESO = 7,   ///< procesarLectura() de un sensor
+    NUM_ETAPAS = 8       ///< Cantidad de etapas
+};
+
+/**
+ * @brief Un tramo medido
+ */
+struct EventoTraza
+{
+    long long inicioNs;   ///< Inicio (reloj monótono)
+    long long duracionNs; ///< Duración
+    unsigned int muestra; ///< Lectura muestreada a la que pertenece
+    unsigned char etapa;  ///< EtapaTraza
+};
+
+/**
+ * @class Trazas
+ * @brief Registro global de tramos, con un buffer circular por hilo
+ *
+ * Se traza una de cada N lecturas (N configurable en tiempo de ejecución,
+ * 0 = desactivado). MuestraTraza decide al comienzo del ciclo si la lectura
+ * se traza y TramoTraza mide cada etapa solo si el ciclo en curso está
+ * muestreado. Desactivado, el costo es una lectura atómica relajada por
+ * ciclo y una variable thread_local por tramo.
+ *
+ * Cada hilo escribe en su propio buffer circular (se crea al registrar su
+ * primer tramo), sin bloqueos: cuando se llena, los eventos más viejos se
+ * sobrescriben. exportarChrome() y imprimirResumen() leen los buffers de
+ * todos los hilos y deben llamarse con la captura detenida.
+ */
+class Trazas
+{
+public:
+    static const int CAPACIDAD_HILO = 8192; ///< Eventos por hilo (potencia de 2)
+    static const int MAX_HILOS = 16;        ///< Hilos con buffer propio
+
+    static inline std::atomic<int> periodo{0};                ///< Una de cada N lecturas (0 = apagado)
+    static inline thread_local unsigned int muestraActual = 0; ///< Lectura trazada en este hilo (0 = ninguna)
+    static inline thread_local unsigned int ciclosHilo = 0;    ///< Ciclos vistos por este hilo
+
+    /**
+     * @brief Cambia la tasa de muestreo
+     * @param cadaN Trazar una de cada N lecturas (0 = desactivar)
+     */
+    static void configurar(int cadaN);
+
+    /**
+     * @brief Obtiene la tasa de muestreo
+     * @return N (0 = desactivado)
+     */
+    static int getPeriodo();
+
+    /**
+     * @brief Reloj monótono en nanosegundos
+     * @return Tiempo actual
+     */
+    static long long relojNs()
+    {
+        return static_cast<long long>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                          std::chrono::steady_clock::now().time_since_epoch())
+                                          .count());
+    }
+
+    /**
+     * @brief Asigna un número a una lectura muestreada
+     * @return Número de muestra (nunca 0)
+     */
+    static unsigned int nuevaMuestra();
+
+    /**
+     * @brief Guarda un tramo en el buffer del hilo actual
+     * @param etapa Etapa medida
+     * @param inicioNs Inicio del tramo
+     * @param duracionNs Duración del tramo
+     */
+    static void registrar(EtapaTraza etapa, long long inicioNs, long long duracionNs);
+
+    /**
+     * @brief Escribe los tramos en formato Chrome Trace Event (JSON)
+     * @param ruta Archivo destino (se abre en Perfetto o about:tracing)
+     * @return Eventos escritos, -1 si no se pudo crear el archivo
+     */
+    static long exportarChrome(const char *ruta);
+
+    /**
+     * @brief Imprime por etapa la cantidad de tramos y su duración media y máxima
+     */
+    static void imprimirResumen();
+
+    /**
+     * @brief Descarta los tramos guardados (los buffers se conservan)
+     */
+    static void limpiar();
+
+    /**
+     * @brief Nombre de una etapa
+     * @param etapa Etapa
+     * @return Cadena estática (ej: "parseo")
+     */
+    static const char *nombreEtapa(int etapa);
+};
+
+/**
+ * @class MuestraTraza
+ * @brief Decide si el ciclo que empieza se traza y mide el ciclo completo
+ *
+ * Se declara al comienzo de cada lectura (o de cada procesamiento). Si ya
+ * hay un ciclo muestreado en curso en el hilo, no hace nada: los tramos
+ * internos pertenecen al ciclo exterior.
+ */
+class MuestraTraza
+{
+private:
+    long long inicioNs;   ///< Inicio del ciclo (0 = no muestreado)
+    unsigned char etapa;  ///< Etapa con la que se registra el ciclo
+
+public:
+    /**
+     * @brief Inicia el ciclo
+     * @param raiz Etapa con la que se registra el ciclo completo
+     */
+    explicit MuestraTraza(EtapaTraza raiz = ETAPA_CICLO) : inicioNs(0), etapa(static_cast<unsigned char>(raiz))
+    {
+        int cadaN = Trazas::periodo.load(std::memory_order_relaxed);
+        if (cadaN == 0 || Trazas::muestraActual != 0)
+        {
+            return;
+        }
+        if (++Trazas::ciclosHilo % static_cast<unsigned int>(cadaN) != 0)
+        {
+            return;
+        }
+        Trazas::muestraActual = Trazas::nuevaMuestra();
+        inicioNs = Trazas::relojNs();
+    }
+
+    /**
+     * @brief Registra el ciclo y libera el hilo para la siguiente muestra
+     */
+    ~MuestraTraza()
+    {
+        if (inicioNs != 0)
+        {
+            Trazas::registrar(static_cast<EtapaTraza>(etapa), inicioNs, Trazas::relojNs() - inicioNs);
+            Trazas::muestraActual = 0;
+        }
+    }
+
+private:
+    MuestraTraza(const MuestraTraza &);            // No copiable
+    MuestraTraza &operator=(const MuestraTraza &); // No asignable
+};
+
+/**
+ * @class TramoTraza
+ * @brief Mide una etapa dentro de un ciclo muestreado (no hace nada si no lo está)
+ */
+class TramoTraza
+{
+private:
+    long long inicioNs;   ///< Inicio del tramo (0 = no se mide)
+    unsigned char etapa;  ///< Etapa medida
+
+public:
+    /**
+     * @brief Empieza a medir
+     * @param etapaTramo Etapa medida
+     */
+    explicit TramoTraza(EtapaTraza etapaTramo) : inicioNs(0), etapa(static_cast<unsigned char>(etapaTramo))
+    {
+        if (Trazas::muestraActual != 0)
+        {
+            inicioNs = Trazas::relojNs();
+        }
+    }
+
+    /**
+     * @brief Registra el tramo
+     */
+    ~TramoTraza()
+    {
+        if (inicioNs != 0)
+        {
+            Trazas::registrar(static_cast<EtapaTraza>(etapa), inicioNs, Trazas::relojNs() - inicioNs);
+        }
+    }
+
+private:
+    TramoTraza(const TramoTraza &);            // No copiable
+    TramoTraza &operator=(const TramoTraza &); // No asignable
+};
+
+#endif // TRAZAS_H
@@ -0,0 +1,219 @@
+/**
+ * @file ArenaSensores.cpp
+ * @brief Implementación de la arena de sensores agrupados por tipo
+ * @author FabiRamiro
+ * @date 2026-10-18
+ */
+
+#include "ArenaSensores.h"
+#include <iostream>
+
+ArenaSensores::ArenaSensores() : pools(nullptr), numPools(0), capacidadPools(0)
+{
+}
+
+ArenaSensores::~ArenaSensores()
+{
+    liberarTodo();
+}
+
+void ArenaSensores::liberarTodo()
+{
+    for (int p = 0; p < numPools; p++)
+    {
+        Pool &pool = pools[p];
+
+        for (int s = 0; s < pool.numSlabs; s++)
+        {
+            char *slab = pool.slabs[s];
+
+            for (int i = 0; i < SENSORES_POR_SLAB; i++)
+            {
+                if ((pool.ocupados[s] & (1u << i)) != 0)
+                {
+                    pool.destruir(slab + i * pool.tamano);
+                }
+            }
+
+            ::operator delete(slab); // Un solo free por slab
+        }
+
+        delete[] pool.slabs;
+        delete[] pool.ocupados;
+    }
+
+    if (numPools > 0)
+    {
+        std::cout << "[Arena] " << numPools << " pool(s) de sensores liberados en bloque." << std::endl;
+    }
+
+    delete[] pools;
+    pools = nullptr;
+    numPools = 0;
+    capacidadPools = 0;
+}
+
+bool ArenaSensores::liberar(void *objeto, const void *tipo)
+{
+    Pool *pool = const_cast<Pool *>(buscarPool(tipo));
+    if (pool == nullptr || objeto == nullptr)
+    {
+        return false;
+    }
+
+    const char *direccion = static_cast<const char *>(objeto);
+    std::size_t bytesSlab = SENSORES_POR_SLAB * pool->tamano;
+    for (int s = 0; s < pool->numSlabs; s++)
+    {
+        if (direccion < pool->slabs[s] || direccion >= pool->slabs[s] + bytesSlab)
+        {
+            continue;
+        }
+
+        int casilla = static_cast<int>((direccion - pool->slabs[s]) / pool->tamano);
+        if ((pool->ocupados[s] & (1u << casilla)) == 0)
+        {
+            return false;
+        }
+
+        pool->destruir(pool->slabs[s] + casilla * pool->tamano);
+        pool->ocupados[s] &= ~(1u << casilla);
+        pool->numObjetos--;
+
+        if (pool->ocupados[s] == 0)
+        {
+            // Slab vacío: se devuelve y los siguientes se corren un lugar
+            ::operator delete(pool->slabs[s]);
+            for (int t = s + 1; t < pool->numSlabs; t++)
+            {
+                pool->slabs[t - 1] = pool->slabs[t];
+                pool->ocupados[t - 1] = pool->ocupados[t];
+            }
+            pool->numSlabs--;
+        }
+        pool->primerLibre = (s < pool->primerLibre) ? s : pool->primerLibre;
+        return true;
+    }
+    return false;
+}
+
+int ArenaSensores::getNumObjetos() const
+{
+    int total = 0;
+    for (int p = 0; p < numPools; p++)
+    {
+        total += pools[p].numObjetos;
+    }
+    return total;
+}
+
+int ArenaSensores::getNumPools() const
+{
+    return numPools;
+}
+
+const ArenaSensores::Pool &ArenaSensores::getPool(int indice) const
+{
+    return pools[indice];
+}
+
+std::size_t ArenaSensores::getBytesReservados() const
+{
+    std::size_t total = 0;
+    for (int p = 0; p < numPools; p++)
+    {
+        total += static_cast<std::size_t>(pools[p].numSlabs) * SENSORES_POR_SLAB * pools[p].tamano;
+    }
+    return total;
+}
+
+const ArenaSensores::Pool *ArenaSensores::buscarPool(const void *tipo) const
+{
+    for (int p = 0; p < numPools; p++)
+    {
+        if (pools[p].tipo == tipo)
+        {
+            return &pools[p];
+        }
+    }
+    return nullptr;
+}
+
+ArenaSensores::Pool &ArenaSensores::obtenerPool(const void *tipo, std::size_t tamano,
+                                                void (*destruir)(void *))
+{
+    for (int p = 0; p < numPools; p++)
+    {
+        if (pools[p].tipo == tipo)
+        {
+            return pools[p];
+        }
+    }
+
+    if (numPools == capacidadPools)
+    {
+        int nuevaCapacidad = (capacidadPools == 0) ? 4 : capacidadPools * 2;
+        Pool *nuevos = new Pool[nuevaCapacidad];
+        for (int p = 0; p < numPools; p++)
+        {
+            nuevos[p] = pools[p];
+        }
+        delete[] pools;
+        pools = nuevos;
+        capacidadPools = nuevaCapacidad;
+    }
+
+    Pool &pool = pools[numPools++];
+    pool.tipo = tipo;
+    pool.tamano = tamano;
+    pool.destruir = destruir;
+    pool.slabs = nullptr;
+    pool.ocupados = nullptr;
+    pool.numSlabs = 0;
+    pool.capacidadSlabs = 0;
+    pool.primerLibre = 0;
+    pool.numObjetos = 0;
+    return pool;
+}
+
+void *ArenaSensores::reservarEspacio(Pool &pool, int &slab, int &casilla)
+{
+    // Primero las casillas que dejaron los sensores liberados
+    while (pool.primerLibre < pool.numSlabs && pool.ocupados[pool.primerLibre] == SLAB_LLENO)
+    {
+        pool.primerLibre++;
+    }
+
+    if (pool.primerLibre == pool.numSlabs)
+    {
+        if (pool.numSlabs == pool.capacidadSlabs)
+        {
+            int nuevaCapacidad = (pool.capacidadSlabs == 0) ? 4 : pool.capacidadSlabs * 2;
+            char **nuevos = new char *[nuevaCapacidad];
+            unsigned *nuevosOcupados = new unsigned[nuevaCapacidad];
+            for (int s = 0; s < pool.numSlabs; s++)
+            {
+                nuevos[s] = pool.slabs[s];
+                nuevosOcupados[s] = pool.ocupados[s];
+            }
+            delete[] pool.slabs;
+            delete[] pool.ocupados;
+            pool.slabs = nuevos;
+            pool.ocupados = nuevosOcupados;
+            pool.capacidadSlabs = nuevaCapacidad;
+        }
+
+        // ::operator new garantiza alineación suficiente para cualquier sensor
+        pool.slabs[pool.numSlabs] = static_cast<char *>(::operator new(SENSORES_POR_SLAB * pool.tamano));
+        pool.ocupados[pool.numSlabs] = 0;
+        pool.numSlabs++;
+    }
+
+    slab = pool.primerLibre;
+    casilla = 0;
+    while ((pool.ocupados[slab] & (1u << casilla)) != 0)
+    {
+        casilla++;
+    }
+    return pool.slabs[slab] + casilla * pool.tamano;
+}
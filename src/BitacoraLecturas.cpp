@@ -0,0 +1,816 @@
+/**
+ * @file BitacoraLecturas.cpp
+ * @brief Implementación de la bitácora de escritura anticipada
+ * @author FabiRamiro
+ * @date 2026-10-18
+ */
+
+#include "BitacoraLecturas.h"
+#include <iostream>
+#include <cstring>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <chrono>
+#include <fcntl.h>
+#include "ListaGeneral.h"
+#include "SensorTemperatura.h"
+#include "SensorPresion.h"
+#include "SensorVibracion.h"
+
+#ifdef _WIN32
+#include <io.h>
+#include <sys/stat.h>
+#include <windows.h>
+#define write _write
+#define read _read
+#define close _close
+#define lseek _lseeki64
+#define O_CLOEXEC 0
+#define fdatasync _commit
+#else
+#include <unistd.h>
+#endif
+
+namespace
+{
+    const int TAM_CABECERA = 8;   ///< crc + longitud
+    const int TAM_TIPO = 16;      ///< Tipo corto del sensor en el registro de alta
+    const int TAM_NOMBRE = 50;    ///< Nombre del sensor en el registro de alta
+
+    /**
+     * @brief Tabla del CRC-32 (polinomio reflejado 0xEDB88320)
+     */
+    struct TablaCRC
+    {
+        std::uint32_t valores[256];
+
+        TablaCRC()
+        {
+            for (std::uint32_t i = 0; i < 256; i++)
+            {
+                std::uint32_t c = i;
+                for (int b = 0; b < 8; b++)
+                {
+                    c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+                }
+                valores[i] = c;
+            }
+        }
+    };
+
+    const TablaCRC tablaCRC;
+
+    std::uint32_t crc32(const char *datos, int longitud)
+    {
+        std::uint32_t c = 0xFFFFFFFFu;
+        for (int i = 0; i < longitud; i++)
+        {
+            c = tablaCRC.valores[(c ^ static_cast<unsigned char>(datos[i])) & 0xFF] ^ (c >> 8);
+        }
+        return c ^ 0xFFFFFFFFu;
+    }
+
+    long long ahoraMs()
+    {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch())
+            .count();
+    }
+
+    /**
+     * @brief Aplica una lectura reproducida con el tipo concreto del sensor
+     */
+    bool aplicarLectura(SensorBase *sensor, double valor)
+    {
+        SensorTemperatura *tempSensor = dynamic_cast<SensorTemperatura *>(sensor);
+        SensorPresion *presSensor = dynamic_cast<SensorPresion *>(sensor);
+        SensorVibracion *vibSensor = dynamic_cast<SensorVibracion *>(sensor);
+
+        if (tempSensor != nullptr)
+        {
+            tempSensor->registrarLectura(static_cast<float>(valor));
+        }
+        else if (presSensor != nullptr)
+        {
+            presSensor->registrarLectura(static_cast<int>(valor));
+        }
+        else if (vibSensor != nullptr)
+        {
+            vibSensor->registrarLectura(static_cast<int>(valor));
+        }
+        else
+        {
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Crea un sensor a partir del tipo corto guardado en la bitácora
+     */
+    SensorBase *crearPorTipo(ListaGeneral &lista, const char *tipo, const char *nombre)
+    {
+        if (std::strcmp(tipo, "TEMP") == 0)
+        {
+            return lista.crearSensor<SensorTemperatura>(nombre);
+        }
+        if (std::strcmp(tipo, "PRES") == 0)
+        {
+            return lista.crearSensor<SensorPresion>(nombre);
+        }
+        if (std::strcmp(tipo, "VIB") == 0)
+        {
+            return lista.crearSensor<SensorVibracion>(nombre);
+        }
+        return nullptr;
+    }
+
+    /**
+     * @brief Abre un archivo para escritura (sin truncar salvo que se pida)
+     */
+    int abrirEscritura(const char *ruta, bool truncar)
+    {
+        int banderas = O_WRONLY | O_CREAT | O_CLOEXEC | (truncar ? O_TRUNC : 0);
+#ifdef _WIN32
+        return _open(ruta, banderas | _O_BINARY, _S_IREAD | _S_IWRITE);
+#else
+        return open(ruta, banderas, 0644);
+#endif
+    }
+
+    /**
+     * @brief Recorta el archivo y deja la posición al final
+     */
+    bool truncarArchivo(int fd, long tamano)
+    {
+#ifdef _WIN32
+        if (_chsize_s(fd, tamano) != 0)
+#else
+        if (ftruncate(fd, tamano) < 0)
+#endif
+        {
+            return false;
+        }
+        return lseek(fd, 0, SEEK_END) >= 0;
+    }
+
+    /**
+     * @brief Reemplaza destino por origen de forma atómica y persistente
+     */
+    bool reemplazarArchivo(const char *origen, const char *destino)
+    {
+#ifdef _WIN32
+        return MoveFileExA(origen, destino, MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+        if (std::rename(origen, destino) != 0)
+        {
+            return false;
+        }
+
+        // Persistir el renombrado en el directorio
+        char directorio[256];
+        std::strncpy(directorio, destino, sizeof(directorio) - 1);
+        directorio[sizeof(directorio) - 1] = '\0';
+        char *barra = std::strrchr(directorio, '/');
+        if (barra == nullptr)
+        {
+            std::strcpy(directorio, ".");
+        }
+        else
+        {
+            barra[barra == directorio ? 1 : 0] = '\0';
+        }
+        int fdDirectorio = open(directorio, O_RDONLY | O_CLOEXEC);
+        if (fdDirectorio >= 0)
+        {
+            fsync(fdDirectorio);
+            close(fdDirectorio);
+        }
+        return true;
+#endif
+    }
+
+    /**
+     * @brief Escribe todo el bloque en el descriptor, reintentando escrituras parciales
+     */
+    bool escribirTodo(int fd, const char *datos, int longitud)
+    {
+        while (longitud > 0)
+        {
+            long n = write(fd, datos, longitud);
+            if (n < 0 && errno == EINTR)
+            {
+                continue;
+            }
+            if (n <= 0)
+            {
+                return false;
+            }
+            datos += n;
+            longitud -= static_cast<int>(n);
+        }
+        return true;
+    }
+}
+
+BitacoraLecturas::BitacoraLecturas(int lecturasGrupo, int intervaloGrupoMs)
+    : descriptor(-1), sistema(nullptr), buffer(new char[TAM_BUFFER]), usados(0), indiceRegistro(0),
+      lecturasPorGrupo(lecturasGrupo), intervaloMs(intervaloGrupoMs), limiteArchivo(LIMITE_ARCHIVO),
+      pendientes(0), primeraPendienteMs(0), tamanoArchivo(0), tamanoPuntoControl(0), grupos(0),
+      puntosControl(0)
+{
+    ruta[0] = '\0';
+}
+
+BitacoraLecturas::~BitacoraLecturas()
+{
+    if (descriptor >= 0)
+    {
+        confirmar();
+        close(descriptor);
+    }
+    delete[] buffer;
+}
+
+bool BitacoraLecturas::abrir(const char *rutaArchivo, ListaGeneral &lista, ResultadoReproduccion *resultado)
+{
+    if (descriptor >= 0 || rutaArchivo == nullptr)
+    {
+        return false;
+    }
+
+    std::strncpy(ruta, rutaArchivo, sizeof(ruta) - 1);
+    ruta[sizeof(ruta) - 1] = '\0';
+    sistema = &lista;
+
+    ResultadoReproduccion r;
+    std::memset(&r, 0, sizeof(r));
+    long validos = reproducir(r);
+    if (resultado != nullptr)
+    {
+        *resultado = r;
+    }
+    if (validos < 0)
+    {
+        return false;
+    }
+
+    descriptor = abrirEscritura(ruta, false);
+    if (descriptor < 0)
+    {
+        std::cout << "[Bitacora] Error: no se pudo abrir '" << ruta << "' ("
+                  << std::strerror(errno) << ")." << std::endl;
+        return false;
+    }
+
+    // La cola inválida se descarta aunque falle el punto de control
+    if (!truncarArchivo(descriptor, validos))
+    {
+        close(descriptor);
+        descriptor = -1;
+        return false;
+    }
+    tamanoArchivo = validos;
+
+    // agregarObservador() reenvía el alta de los sensores existentes; el punto
+    // de control ya las incluye, así que esos registros se descartan
+    lista.agregarObservador(this);
+    usados = 0;
+    pendientes = 0;
+
+    // Compactar: la bitácora queda con el estado reconstruido y numeración actual
+    if (!puntoControl())
+    {
+        std::cout << "[Bitacora] Advertencia: no se pudo compactar; se sigue anexando." << std::endl;
+    }
+    return true;
+}
+
+void BitacoraLecturas::configurar(int lecturasGrupo, int intervaloGrupoMs, long long limiteBytes)
+{
+    lecturasPorGrupo = (lecturasGrupo < 1) ? 1 : lecturasGrupo;
+    intervaloMs = (intervaloGrupoMs < 0) ? 0 : intervaloGrupoMs;
+    limiteArchivo = (limiteBytes < 0) ? 0 : limiteBytes;
+}
+
+char *BitacoraLecturas::abrirRegistro(TipoRegistroBitacora tipo, int longitudCuerpo)
+{
+    int total = TAM_CABECERA + 1 + longitudCuerpo;
+    if (usados + total > TAM_BUFFER)
+    {
+        escribirBuffer();
+    }
+
+    indiceRegistro = usados;
+    std::uint32_t longitud = static_cast<std::uint32_t>(1 + longitudCuerpo);
+    std::memcpy(buffer + usados + 4, &longitud, 4);
+    buffer[usados + TAM_CABECERA] = static_cast<char>(tipo);
+    usados += total;
+    return buffer + indiceRegistro + TAM_CABECERA + 1;
+}
+
+void BitacoraLecturas::cerrarRegistro()
+{
+    std::uint32_t longitud;
+    std::memcpy(&longitud, buffer + indiceRegistro + 4, 4);
+    std::uint32_t crc = crc32(buffer + indiceRegistro + 4, 4 + static_cast<int>(longitud));
+    std::memcpy(buffer + indiceRegistro, &crc, 4);
+}
+
+bool BitacoraLecturas::escribirBuffer()
+{
+    if (usados == 0)
+    {
+        return true;
+    }
+
+    bool ok = escribirTodo(descriptor, buffer, usados);
+    if (ok)
+    {
+        tamanoArchivo += usados;
+    }
+    else
+    {
+        std::cout << "[Bitacora] Error de escritura (" << std::strerror(errno)
+                  << "); se pierden " << usados << " bytes." << std::endl;
+    }
+    usados = 0;
+    return ok;
+}
+
+bool BitacoraLecturas::confirmar()
+{
+    if (descriptor < 0 || (usados == 0 && pendientes == 0))
+    {
+        return true;
+    }
+
+    bool ok = escribirBuffer() && fdatasync(descriptor) == 0;
+    grupos++;
+    pendientes = 0;
+    return ok;
+}
+
+void BitacoraLecturas::contarPendientes(int lecturas)
+{
+    long long ahora = ahoraMs();
+    if (pendientes == 0)
+    {
+        primeraPendienteMs = ahora;
+    }
+    pendientes += lecturas;
+
+    if (pendientes >= lecturasPorGrupo || ahora - primeraPendienteMs >= intervaloMs)
+    {
+        confirmar();
+    }
+}
+
+void BitacoraLecturas::revisar()
+{
+    if (descriptor < 0)
+    {
+        return;
+    }
+
+    if (pendientes > 0 && ahoraMs() - primeraPendienteMs >= intervaloMs)
+    {
+        confirmar();
+    }
+
+    // El límite cuenta lo anexado desde el último punto de control, no el estado base
+    if (limiteArchivo > 0 && tamanoArchivo + usados > tamanoPuntoControl + limiteArchivo)
+    {
+        puntoControl();
+    }
+}
+
+void BitacoraLecturas::sensorRegistrado(SensorBase &sensor, const void *tipo)
+{
+    (void)tipo;
+    if (descriptor < 0)
+    {
+        return;
+    }
+
+    escribirAlta(sensor);
+    contarPendientes(1);
+}
+
+void BitacoraLecturas::sensorEliminado(SensorBase &sensor, int manejador)
+{
+    (void)sensor;
+    if (descriptor < 0)
+    {
+        return;
+    }
+
+    char *cuerpo = abrirRegistro(REGISTRO_BAJA, 4);
+    std::int32_t m = manejador;
+    std::memcpy(cuerpo, &m, 4);
+    cerrarRegistro();
+    contarPendientes(1);
+}
+
+void BitacoraLecturas::escribirAlta(const SensorBase &sensor)
+{
+    char *cuerpo = abrirRegistro(REGISTRO_SENSOR, 4 + TAM_TIPO + TAM_NOMBRE);
+    std::int32_t manejador = sensor.getManejador();
+    std::memcpy(cuerpo, &manejador, 4);
+    std::memset(cuerpo + 4, 0, TAM_TIPO + TAM_NOMBRE);
+    std::strncpy(cuerpo + 4, sensor.getTipo(), TAM_TIPO - 1);
+    std::strncpy(cuerpo + 4 + TAM_TIPO, sensor.getNombre(), TAM_NOMBRE - 1);
+    cerrarRegistro();
+}
+
+void BitacoraLecturas::lecturaRegistrada(SensorBase &sensor, double valor)
+{
+    if (descriptor < 0)
+    {
+        return;
+    }
+
+    std::lock_guard<std::mutex> guardia(escritura);
+    char *cuerpo = abrirRegistro(REGISTRO_LECTURA, 12);
+    std::int32_t manejador = sensor.getManejador();
+    std::memcpy(cuerpo, &manejador, 4);
+    std::memcpy(cuerpo + 4, &valor, 8);
+    cerrarRegistro();
+    contarPendientes(1);
+}
+
+void BitacoraLecturas::bloqueRegistrado(SensorBase &sensor, const int *cuentas, int cantidad)
+{
+    if (descriptor < 0)
+    {
+        return;
+    }
+
+    std::lock_guard<std::mutex> guardia(escritura);
+    escribirBloque(sensor.getManejador(), cuentas, cantidad);
+    contarPendientes(cantidad);
+}
+
+void BitacoraLecturas::escribirBloque(int manejador, const int *cuentas, int cantidad)
+{
+    std::int32_t m = manejador;
+    for (int inicio = 0; inicio < cantidad; inicio += MAX_VALORES_REGISTRO)
+    {
+        std::int32_t n = (cantidad - inicio < MAX_VALORES_REGISTRO) ? cantidad - inicio : MAX_VALORES_REGISTRO;
+        char *cuerpo = abrirRegistro(REGISTRO_BLOQUE, 8 + n * 4);
+        std::memcpy(cuerpo, &m, 4);
+        std::memcpy(cuerpo + 4, &n, 4);
+        std::memcpy(cuerpo + 8, cuentas + inicio, n * 4);
+        cerrarRegistro();
+    }
+}
+
+void BitacoraLecturas::registrarProceso()
+{
+    if (descriptor < 0)
+    {
+        return;
+    }
+
+    abrirRegistro(REGISTRO_PROCESO, 0);
+    cerrarRegistro();
+    confirmar();
+}
+
+void BitacoraLecturas::registrarProceso(const int *manejadores, int cantidad)
+{
+    if (descriptor < 0 || cantidad <= 0)
+    {
+        return;
+    }
+
+    // Cuerpo: n | manejadores; una pasada grande ocupa varios registros
+    for (int inicio = 0; inicio < cantidad; inicio += MAX_VALORES_REGISTRO)
+    {
+        std::int32_t n = (cantidad - inicio < MAX_VALORES_REGISTRO) ? cantidad - inicio : MAX_VALORES_REGISTRO;
+        char *cuerpo = abrirRegistro(REGISTRO_PROCESO, 4 + n * 4);
+        std::memcpy(cuerpo, &n, 4);
+        for (int i = 0; i < n; i++)
+        {
+            std::int32_t m = manejadores[inicio + i];
+            std::memcpy(cuerpo + 4 + i * 4, &m, 4);
+        }
+        cerrarRegistro();
+    }
+    confirmar();
+}
+
+void BitacoraLecturas::escribirEstado()
+{
+    int *muestras = new int[SensorVibracion::MAX_MUESTRAS_PENDIENTES];
+
+    for (int v = 0; v < sistema->getContador(); v++)
+    {
+        SensorBase *sensor = sistema->obtenerVivo(v);
+        escribirAlta(*sensor);
+
+        std::int32_t manejador = sensor->getManejador();
+        int total = sensor->getNumLecturas();
+        if (total > 0)
+        {
+            double *historial = new double[total];
+            total = sensor->copiarLecturas(historial, total);
+
+            for (int inicio = 0; inicio < total; inicio += MAX_VALORES_REGISTRO)
+            {
+                std::int32_t n = (total - inicio < MAX_VALORES_REGISTRO) ? total - inicio : MAX_VALORES_REGISTRO;
+                char *cuerpo = abrirRegistro(REGISTRO_HISTORIAL, 8 + n * 8);
+                std::memcpy(cuerpo, &manejador, 4);
+                std::memcpy(cuerpo + 4, &n, 4);
+                std::memcpy(cuerpo + 8, historial + inicio, n * 8);
+                cerrarRegistro();
+            }
+            delete[] historial;
+        }
+
+        int pendientesSensor = sensor->copiarMuestrasPendientes(muestras, SensorVibracion::MAX_MUESTRAS_PENDIENTES);
+        escribirBloque(manejador, muestras, pendientesSensor);
+    }
+
+    delete[] muestras;
+}
+
+bool BitacoraLecturas::puntoControl()
+{
+    if (descriptor < 0 || sistema == nullptr)
+    {
+        return false;
+    }
+
+    confirmar();
+
+    char rutaTemporal[sizeof(ruta) + 8];
+    std::snprintf(rutaTemporal, sizeof(rutaTemporal), "%s.tmp", ruta);
+    int temporal = abrirEscritura(rutaTemporal, true);
+    if (temporal < 0)
+    {
+        return false;
+    }
+
+    // El estado se escribe con la misma maquinaria de registros, hacia el archivo nuevo
+    int anterior = descriptor;
+    long long tamanoAnterior = tamanoArchivo;
+    descriptor = temporal;
+    tamanoArchivo = 0;
+
+    escribirEstado();
+    pendientes = 0;
+
+    bool ok = escribirBuffer() && fdatasync(temporal) == 0;
+    close(temporal);
+    if (ok)
+    {
+        close(anterior); // Windows no reemplaza un archivo abierto
+        anterior = -1;
+        ok = reemplazarArchivo(rutaTemporal, ruta);
+    }
+    if (!ok)
+    {
+        std::remove(rutaTemporal);
+        tamanoArchivo = tamanoAnterior;
+    }
+
+    // Se sigue anexando a la bitácora: la nueva o, si algo falló, la anterior
+    descriptor = (anterior >= 0) ? anterior : abrirEscritura(ruta, false);
+    if (descriptor < 0 || lseek(descriptor, 0, SEEK_END) < 0)
+    {
+        std::cout << "[Bitacora] Error: no se pudo reabrir '" << ruta << "'; bitacora cerrada." << std::endl;
+        if (descriptor >= 0)
+        {
+            close(descriptor);
+        }
+        descriptor = -1;
+        return false;
+    }
+    if (!ok)
+    {
+        return false;
+    }
+
+    tamanoPuntoControl = tamanoArchivo;
+    grupos++;
+    puntosControl++;
+    return true;
+}
+
+long BitacoraLecturas::reproducir(ResultadoReproduccion &resultado)
+{
+    long long inicioMs = ahoraMs();
+
+#ifdef _WIN32
+    int fd = _open(ruta, _O_RDONLY | _O_BINARY);
+#else
+    int fd = open(ruta, O_RDONLY | O_CLOEXEC);
+#endif
+    if (fd < 0)
+    {
+        return (errno == ENOENT) ? 0 : -1;
+    }
+
+    long tamano = static_cast<long>(lseek(fd, 0, SEEK_END));
+    if (tamano < 0 || lseek(fd, 0, SEEK_SET) < 0)
+    {
+        close(fd);
+        return -1;
+    }
+
+    char *datos = new char[tamano > 0 ? tamano : 1];
+    long leidos = 0;
+    while (leidos < tamano)
+    {
+        long n = read(fd, datos + leidos, static_cast<unsigned>(tamano - leidos));
+        if (n < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (n <= 0)
+        {
+            break;
+        }
+        leidos += n;
+    }
+    close(fd);
+
+    SensorBase **mapa = nullptr; // Manejador en la bitácora -> sensor reconstruido
+    int capacidadMapa = 0;
+    double *valores = new double[MAX_VALORES_REGISTRO];
+    int *cuentas = new int[MAX_VALORES_REGISTRO];
+
+    // Sin el eco de cada lectura y procesamiento; las advertencias y los rechazos se ven
+    sistema->setSilencioso(true);
+
+    long pos = 0;
+    while (pos + TAM_CABECERA < leidos)
+    {
+        std::uint32_t crc;
+        std::uint32_t longitud;
+        std::memcpy(&crc, datos + pos, 4);
+        std::memcpy(&longitud, datos + pos + 4, 4);
+
+        if (longitud == 0 || longitud > static_cast<std::uint32_t>(TAM_BUFFER) ||
+            pos + TAM_CABECERA + static_cast<long>(longitud) > leidos ||
+            crc32(datos + pos + 4, 4 + static_cast<int>(longitud)) != crc)
+        {
+            break; // Registro incompleto o corrupto: fin de la parte válida
+        }
+
+        const char *cuerpo = datos + pos + TAM_CABECERA + 1;
+        int tipo = static_cast<unsigned char>(datos[pos + TAM_CABECERA]);
+        std::int32_t manejador = -1;
+        std::int32_t n = 0;
+        if (longitud >= 5)
+        {
+            std::memcpy(&manejador, cuerpo, 4);
+        }
+        if (longitud >= 5 && tipo == REGISTRO_PROCESO)
+        {
+            n = manejador; // Pasada incremental: el cuerpo empieza con la cantidad
+            manejador = -1;
+            if (n < 0 || n > MAX_VALORES_REGISTRO)
+            {
+                n = 0;
+            }
+        }
+        if (longitud >= 9 && (tipo == REGISTRO_BLOQUE || tipo == REGISTRO_HISTORIAL))
+        {
+            std::memcpy(&n, cuerpo + 4, 4);
+            if (n < 0 || n > MAX_VALORES_REGISTRO)
+            {
+                n = 0;
+            }
+        }
+        SensorBase *sensor = (manejador >= 0 && manejador < capacidadMapa) ? mapa[manejador] : nullptr;
+
+        if (tipo == REGISTRO_SENSOR && manejador >= 0 && longitud == 1 + 4 + TAM_TIPO + TAM_NOMBRE)
+        {
+            char tipoSensor[TAM_TIPO];
+            char nombre[TAM_NOMBRE];
+            std::memcpy(tipoSensor, cuerpo + 4, TAM_TIPO);
+            std::memcpy(nombre, cuerpo + 4 + TAM_TIPO, TAM_NOMBRE);
+            tipoSensor[TAM_TIPO - 1] = '\0';
+            nombre[TAM_NOMBRE - 1] = '\0';
+
+            if (manejador >= capacidadMapa)
+            {
+                int nuevaCapacidad = (capacidadMapa == 0) ? 16 : capacidadMapa;
+                while (nuevaCapacidad <= manejador)
+                {
+                    nuevaCapacidad *= 2;
+                }
+                SensorBase **nuevo = new SensorBase *[nuevaCapacidad];
+                for (int i = 0; i < nuevaCapacidad; i++)
+                {
+                    nuevo[i] = (i < capacidadMapa) ? mapa[i] : nullptr;
+                }
+                delete[] mapa;
+                mapa = nuevo;
+                capacidadMapa = nuevaCapacidad;
+            }
+
+            sensor = sistema->buscarSensor(nombre);
+            if (sensor == nullptr)
+            {
+                sensor = crearPorTipo(*sistema, tipoSensor, nombre);
+            }
+            if (sensor != nullptr && mapa[manejador] != sensor)
+            {
+                resultado.sensores++;
+            }
+            mapa[manejador] = sensor;
+        }
+        else if (tipo == REGISTRO_LECTURA && sensor != nullptr && longitud == 1 + 12)
+        {
+            double valor;
+            std::memcpy(&valor, cuerpo + 4, 8);
+            if (aplicarLectura(sensor, valor))
+            {
+                resultado.lecturas++;
+            }
+        }
+        else if (tipo == REGISTRO_BLOQUE && sensor != nullptr && longitud == 1 + 8 + 4u * n)
+        {
+            SensorVibracion *vibSensor = dynamic_cast<SensorVibracion *>(sensor);
+            if (vibSensor != nullptr)
+            {
+                std::memcpy(cuentas, cuerpo + 8, n * 4);
+                vibSensor->registrarBloque(cuentas, n);
+                resultado.lecturas += n;
+            }
+        }
+        else if (tipo == REGISTRO_HISTORIAL && sensor != nullptr && longitud == 1 + 8 + 8u * n)
+        {
+            std::memcpy(valores, cuerpo + 8, n * 8);
+            if (sensor->restaurarLecturas(valores, n))
+            {
+                resultado.lecturas += n;
+            }
+        }
+        else if (tipo == REGISTRO_BAJA && manejador >= 0 && longitud == 1 + 4)
+        {
+            if (sensor != nullptr)
+            {
+                sistema->eliminarSensor(sensor->getNombre());
+                mapa[manejador] = nullptr;
+            }
+        }
+        else if (tipo == REGISTRO_PROCESO && longitud == 1)
+        {
+            sistema->procesarPorLotes();
+        }
+        else if (tipo == REGISTRO_PROCESO && longitud == 1 + 4 + 4u * n)
+        {
+            // Manejadores de la bitácora -> manejadores de los sensores reconstruidos
+            int procesar = 0;
+            for (int i = 0; i < n; i++)
+            {
+                std::int32_t m;
+                std::memcpy(&m, cuerpo + 4 + i * 4, 4);
+                if (m >= 0 && m < capacidadMapa && mapa[m] != nullptr)
+                {
+                    cuentas[procesar++] = mapa[m]->getManejador();
+                }
+            }
+            sistema->procesarSensores(cuentas, procesar);
+        }
+
+        resultado.registros++;
+        pos += TAM_CABECERA + static_cast<long>(longitud);
+    }
+
+    sistema->setSilencioso(false);
+
+    resultado.bytesDescartados = leidos - pos;
+    resultado.milisegundos = ahoraMs() - inicioMs;
+
+    delete[] cuentas;
+    delete[] valores;
+    delete[] mapa;
+    delete[] datos;
+    return pos;
+}
+
+bool BitacoraLecturas::estaAbierta() const
+{
+    return descriptor >= 0;
+}
+
+void BitacoraLecturas::imprimirEstado() const
+{
+    std::cout << "\n--- Bitacora de Lecturas ---" << std::endl;
+    if (descriptor < 0)
+    {
+        std::cout << "Bitacora cerrada." << std::endl;
+        return;
+    }
+
+    std::cout << "Archivo: " << ruta << " (" << (tamanoArchivo + usados) << " bytes)" << std::endl;
+    std::cout << "Grupo: " << lecturasPorGrupo << " lecturas o " << intervaloMs << " ms"
+              << " | Sin confirmar: " << pendientes << std::endl;
+    std::cout << "Confirmaciones: " << grupos << " | Puntos de control: " << puntosControl << std::endl;
+}
@@ -0,0 +1,210 @@
+/**
+ * @file BufferReordenamiento.cpp
+ * @brief Implementación del buffer de reordenamiento por número de secuencia
+ * @author FabiRamiro
+ * @date 2026-10-18
+ */
+
+#include "BufferReordenamiento.h"
+#include <cstring>
+
+BufferReordenamiento::BufferReordenamiento()
+    : ocupadas(0), siguiente(0), mayor(-1), iniciado(false), pendientes(0),
+      candidato(0), valorCandidato(0.0), hayCandidato(false),
+      enOrden(0), reordenadas(0), duplicadas(0), tardias(0), huecos(0), reinicios(0)
+{
+    std::memset(vistas, 0, sizeof(vistas));
+}
+
+bool BufferReordenamiento::fueVista(long long secuencia) const
+{
+    int bit = static_cast<int>(secuencia & (HISTORIA - 1));
+    return (vistas[bit >> 6] >> (bit & 63)) & 1ULL;
+}
+
+void BufferReordenamiento::avanzar(double *listas, int &numListas)
+{
+    int ranura = static_cast<int>(siguiente & (VENTANA - 1));
+    unsigned long long mascara = 1ULL << ranura;
+    bool presente = (ocupadas & mascara) != 0;
+
+    if (presente)
+    {
+        listas[numListas++] = valores[ranura];
+        ocupadas &= ~mascara;
+        pendientes--;
+    }
+    else
+    {
+        huecos++;
+    }
+
+    // El bit de esta secuencia pisa el de la que sale de la historia
+    int bit = static_cast<int>(siguiente & (HISTORIA - 1));
+    unsigned long long mascaraVista = 1ULL << (bit & 63);
+    if (presente)
+    {
+        vistas[bit >> 6] |= mascaraVista;
+    }
+    else
+    {
+        vistas[bit >> 6] &= ~mascaraVista;
+    }
+
+    siguiente++;
+}
+
+ResultadoSecuencia BufferReordenamiento::insertar(long long secuencia, double valor, double *listas, int &numListas)
+{
+    numListas = 0;
+
+    if (!iniciado)
+    {
+        iniciado = true;
+        siguiente = secuencia;
+        mayor = secuencia - 1;
+    }
+
+    bool confirmaReinicio = hayCandidato && secuencia > candidato && secuencia - candidato < HISTORIA;
+    hayCandidato = false;
+
+    if (secuencia < siguiente)
+    {
+        if (siguiente - secuencia <= HISTORIA)
+        {
+            if (fueVista(secuencia))
+            {
+                duplicadas++;
+                return SECUENCIA_DUPLICADA;
+            }
+            tardias++;
+            return SECUENCIA_TARDIA;
+        }
+
+        if (secuencia >= MARGEN_REINICIO && !confirmaReinicio)
+        {
+            // Puede ser una trama vieja: se descarta salvo que la próxima la confirme
+            hayCandidato = true;
+            candidato = secuencia;
+            valorCandidato = valor;
+            tardias++;
+            return SECUENCIA_TARDIA;
+        }
+
+        // El contador del dispositivo volvió a empezar
+        numListas = vaciar(listas);
+        std::memset(vistas, 0, sizeof(vistas));
+        siguiente = secuencia;
+        mayor = secuencia - 1;
+        reinicios++;
+
+        if (confirmaReinicio)
+        {
+            // La secuencia baja anterior deja de ser tardía: abre la ventana del reinicio
+            int ranura = static_cast<int>(candidato & (VENTANA - 1));
+            valores[ranura] = valorCandidato;
+            ocupadas |= 1ULL << ranura;
+            pendientes++;
+            siguiente = candidato;
+            mayor = candidato;
+            tardias--;
+            enOrden++;
+        }
+    }
+    else if (secuencia - siguiente >= VENTANA + HISTORIA)
+    {
+        // Salto mayor que todo lo recordado: no vale la pena recorrer el hueco
+        numListas = vaciar(listas);
+        huecos += secuencia - siguiente;
+        std::memset(vistas, 0, sizeof(vistas));
+        siguiente = secuencia;
+    }
+
+    // Hacer lugar en la ventana: lo que queda fuera sale tal cual, sin esperar sus huecos
+    while (secuencia - siguiente >= VENTANA)
+    {
+        avanzar(listas, numListas);
+    }
+
+    int ranura = static_cast<int>(secuencia & (VENTANA - 1));
+    unsigned long long mascara = 1ULL << ranura;
+    if (ocupadas & mascara)
+    {
+        duplicadas++;
+        return SECUENCIA_DUPLICADA;
+    }
+
+    valores[ranura] = valor;
+    ocupadas |= mascara;
+    pendientes++;
+
+    ResultadoSecuencia resultado = SECUENCIA_EN_ORDEN;
+    if (secuencia > mayor)
+    {
+        mayor = secuencia;
+        enOrden++;
+    }
+    else
+    {
+        resultado = SECUENCIA_REORDENADA;
+        reordenadas++;
+    }
+
+    // Emitir lo contiguo desde el principio de la ventana
+    while (ocupadas & (1ULL << (siguiente & (VENTANA - 1))))
+    {
+        avanzar(listas, numListas);
+    }
+
+    return resultado;
+}
+
+int BufferReordenamiento::vaciar(double *listas)
+{
+    int numListas = 0;
+    while (pendientes > 0)
+    {
+        avanzar(listas, numListas);
+    }
+    return numListas;
+}
+
+int BufferReordenamiento::getPendientes() const
+{
+    return pendientes;
+}
+
+long long BufferReordenamiento::getSiguiente() const
+{
+    return siguiente;
+}
+
+long long BufferReordenamiento::getEnOrden() const
+{
+    return enOrden;
+}
+
+long long BufferReordenamiento::getReordenadas() const
+{
+    return reordenadas;
+}
+
+long long BufferReordenamiento::getDuplicadas() const
+{
+    return duplicadas;
+}
+
+long long BufferReordenamiento::getTardias() const
+{
+    return tardias;
+}
+
+long long BufferReordenamiento::getHuecos() const
+{
+    return huecos;
+}
+
+unsigned long BufferReordenamiento::getReinicios() const
+{
+    return reinicios;
+}
@@ -0,0 +1,426 @@
+/**
+ * @file ConsultasFlota.cpp
+ * @brief Implementación de las consultas sobre la flota
+ * @author FabiRamiro
+ * @date 2026-10-18
+ */
+
+#include "ConsultasFlota.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+namespace
+{
+    /**
+     * @brief Entrada del montículo del top-k
+     */
+    struct EntradaMonticulo
+    {
+        double clave;  ///< Valor orientado (negado si se piden los menores)
+        int manejador; ///< Sensor de la entrada
+    };
+
+    /**
+     * @brief Restaura la propiedad de montículo mínimo desde la raíz
+     */
+    void hundir(EntradaMonticulo *monticulo, int tamano, int i)
+    {
+        while (true)
+        {
+            int menor = i;
+            int izq = 2 * i + 1;
+            int der = izq + 1;
+            if (izq < tamano && monticulo[izq].clave < monticulo[menor].clave)
+            {
+                menor = izq;
+            }
+            if (der < tamano && monticulo[der].clave < monticulo[menor].clave)
+            {
+                menor = der;
+            }
+            if (menor == i)
+            {
+                return;
+            }
+            EntradaMonticulo tmp = monticulo[i];
+            monticulo[i] = monticulo[menor];
+            monticulo[menor] = tmp;
+            i = menor;
+        }
+    }
+
+    /**
+     * @brief Sube el último elemento hasta su lugar
+     */
+    void flotar(EntradaMonticulo *monticulo, int i)
+    {
+        while (i > 0)
+        {
+            int padre = (i - 1) / 2;
+            if (!(monticulo[i].clave < monticulo[padre].clave))
+            {
+                return;
+            }
+            EntradaMonticulo tmp = monticulo[i];
+            monticulo[i] = monticulo[padre];
+            monticulo[padre] = tmp;
+            i = padre;
+        }
+    }
+}
+
+double ResumenSensor::campo(CampoConsulta campo) const
+{
+    switch (campo)
+    {
+    case CAMPO_PROMEDIO:
+        return promedio();
+    case CAMPO_MAXIMO:
+        return maximo;
+    case CAMPO_MINIMO:
+        return minimo;
+    case CAMPO_ULTIMO:
+    default:
+        return ultimo;
+    }
+}
+
+ConsultasFlota::ConsultasFlota()
+    : resumenes(nullptr), numSensores(0), capacidad(0),
+      indiceNombres(nullptr), numIndexados(0), indiceValido(true)
+{
+}
+
+ConsultasFlota::~ConsultasFlota()
+{
+    delete[] resumenes;
+    delete[] indiceNombres;
+}
+
+long long ConsultasFlota::ahoraMs()
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+ResumenSensor *ConsultasFlota::resumenDe(const SensorBase &sensor)
+{
+    int m = sensor.getManejador();
+    if (m < 0 || m >= numSensores || resumenes[m].sensor != &sensor)
+    {
+        return nullptr;
+    }
+    return &resumenes[m];
+}
+
+void ConsultasFlota::sensorRegistrado(SensorBase &sensor, const void *tipo)
+{
+    (void)tipo;
+    int m = sensor.getManejador();
+    if (m < 0)
+    {
+        return;
+    }
+
+    if (m >= capacidad)
+    {
+        int nuevaCapacidad = (capacidad == 0) ? 64 : capacidad;
+        while (nuevaCapacidad <= m)
+        {
+            nuevaCapacidad *= 2;
+        }
+
+        ResumenSensor *nuevos = new ResumenSensor[nuevaCapacidad];
+        for (int i = 0; i < numSensores; i++)
+        {
+            nuevos[i] = resumenes[i];
+        }
+        for (int i = numSensores; i < nuevaCapacidad; i++)
+        {
+            nuevos[i].sensor = nullptr;
+        }
+        delete[] resumenes;
+        resumenes = nuevos;
+        capacidad = nuevaCapacidad;
+    }
+
+    ResumenSensor &r = resumenes[m];
+    r.sensor = &sensor;
+    r.lecturas = 0;
+    r.suma = 0.0;
+    r.minimo = 0.0;
+    r.maximo = 0.0;
+    r.ultimo = 0.0;
+    r.ultimaMs = ahoraMs(); // Sin datos desde que se registró
+
+    if (m >= numSensores)
+    {
+        numSensores = m + 1;
+    }
+    indiceValido = false;
+}
+
+void ConsultasFlota::sensorEliminado(SensorBase &sensor, int manejador)
+{
+    if (manejador < 0 || manejador >= numSensores || resumenes[manejador].sensor != &sensor)
+    {
+        return;
+    }
+
+    resumenes[manejador].sensor = nullptr;
+    indiceValido = false;
+}
+
+void ConsultasFlota::lecturaRegistrada(SensorBase &sensor, double valor)
+{
+    ResumenSensor *r = resumenDe(sensor);
+    if (r == nullptr)
+    {
+        return;
+    }
+
+    if (r->lecturas == 0)
+    {
+        r->minimo = valor;
+        r->maximo = valor;
+    }
+    else
+    {
+        r->minimo = (valor < r->minimo) ? valor : r->minimo;
+        r->maximo = (valor > r->maximo) ? valor : r->maximo;
+    }
+    r->lecturas++;
+    r->suma += valor;
+    r->ultimo = valor;
+    r->ultimaMs = ahoraMs();
+}
+
+void ConsultasFlota::bloqueRegistrado(SensorBase &sensor, const int *cuentas, int cantidad)
+{
+    ResumenSensor *r = resumenDe(sensor);
+    if (r == nullptr || cantidad <= 0)
+    {
+        return;
+    }
+
+    int minimo = cuentas[0];
+    int maximo = cuentas[0];
+    long long suma = 0;
+    for (int i = 0; i < cantidad; i++)
+    {
+        minimo = (cuentas[i] < minimo) ? cuentas[i] : minimo;
+        maximo = (cuentas[i] > maximo) ? cuentas[i] : maximo;
+        suma += cuentas[i];
+    }
+
+    if (r->lecturas == 0)
+    {
+        r->minimo = minimo;
+        r->maximo = maximo;
+    }
+    else
+    {
+        r->minimo = (minimo < r->minimo) ? minimo : r->minimo;
+        r->maximo = (maximo > r->maximo) ? maximo : r->maximo;
+    }
+    r->lecturas += cantidad;
+    r->suma += static_cast<double>(suma);
+    r->ultimo = cuentas[cantidad - 1];
+    r->ultimaMs = ahoraMs();
+}
+
+void ConsultasFlota::actualizarIndice()
+{
+    if (indiceValido)
+    {
+        return;
+    }
+
+    delete[] indiceNombres;
+    indiceNombres = new int[numSensores > 0 ? numSensores : 1];
+    numIndexados = 0;
+    for (int m = 0; m < numSensores; m++)
+    {
+        if (resumenes[m].sensor != nullptr)
+        {
+            indiceNombres[numIndexados++] = m;
+        }
+    }
+
+    const ResumenSensor *r = resumenes;
+    std::sort(indiceNombres, indiceNombres + numIndexados,
+              [r](int a, int b)
+              { return std::strcmp(r[a].sensor->getNombre(), r[b].sensor->getNombre()) < 0; });
+    indiceValido = true;
+}
+
+void ConsultasFlota::rangoPrefijo(const char *prefijo, int &desde, int &hasta)
+{
+    actualizarIndice();
+
+    if (prefijo == nullptr || prefijo[0] == '\0')
+    {
+        desde = 0;
+        hasta = numIndexados;
+        return;
+    }
+
+    const ResumenSensor *r = resumenes;
+    std::size_t largo = std::strlen(prefijo);
+
+    // Primer nombre >= prefijo
+    const int *inicio = std::lower_bound(indiceNombres, indiceNombres + numIndexados, prefijo,
+                                         [r](int m, const char *p)
+                                         { return std::strcmp(r[m].sensor->getNombre(), p) < 0; });
+
+    // Primer nombre que ya no empieza con el prefijo
+    const int *fin = std::upper_bound(inicio, static_cast<const int *>(indiceNombres + numIndexados), prefijo,
+                                      [r, largo](const char *p, int m)
+                                      { return std::strncmp(r[m].sensor->getNombre(), p, largo) > 0; });
+
+    desde = static_cast<int>(inicio - indiceNombres);
+    hasta = static_cast<int>(fin - indiceNombres);
+}
+
+int ConsultasFlota::topK(const char *prefijo, int k, CampoConsulta campo, bool mayores, ResultadoTopK *salida)
+{
+    if (k <= 0 || salida == nullptr)
+    {
+        return 0;
+    }
+
+    int desde;
+    int hasta;
+    rangoPrefijo(prefijo, desde, hasta);
+
+    EntradaMonticulo *monticulo = new EntradaMonticulo[k];
+    int tamano = 0;
+
+    // Montículo mínimo de los k mejores: la raíz es el peor de los elegidos
+    for (int i = desde; i < hasta; i++)
+    {
+        int m = indiceNombres[i];
+        const ResumenSensor &r = resumenes[m];
+        if (r.lecturas == 0)
+        {
+            continue;
+        }
+
+        double valor = r.campo(campo);
+        double clave = mayores ? valor : -valor;
+
+        if (tamano < k)
+        {
+            monticulo[tamano].clave = clave;
+            monticulo[tamano].manejador = m;
+            flotar(monticulo, tamano);
+            tamano++;
+        }
+        else if (clave > monticulo[0].clave)
+        {
+            monticulo[0].clave = clave;
+            monticulo[0].manejador = m;
+            hundir(monticulo, tamano, 0);
+        }
+    }
+
+    // Extraer del peor al mejor, llenando la salida desde el final
+    int llenados = tamano;
+    for (int pos = tamano - 1; pos >= 0; pos--)
+    {
+        int m = monticulo[0].manejador;
+        salida[pos].manejador = m;
+        salida[pos].nombre = resumenes[m].sensor->getNombre();
+        salida[pos].valor = resumenes[m].campo(campo);
+
+        monticulo[0] = monticulo[pos];
+        hundir(monticulo, pos, 0);
+    }
+
+    delete[] monticulo;
+    return llenados;
+}
+
+AgregadoFlota ConsultasFlota::agregar(const char *prefijo)
+{
+    AgregadoFlota a;
+    a.sensores = 0;
+    a.sensoresConDatos = 0;
+    a.lecturas = 0;
+    a.suma = 0.0;
+    a.minimo = 0.0;
+    a.maximo = 0.0;
+    a.sumaUltimos = 0.0;
+
+    int desde;
+    int hasta;
+    rangoPrefijo(prefijo, desde, hasta);
+
+    for (int i = desde; i < hasta; i++)
+    {
+        const ResumenSensor &r = resumenes[indiceNombres[i]];
+        a.sensores++;
+        if (r.lecturas == 0)
+        {
+            continue;
+        }
+
+        if (a.sensoresConDatos == 0)
+        {
+            a.minimo = r.minimo;
+            a.maximo = r.maximo;
+        }
+        else
+        {
+            a.minimo = (r.minimo < a.minimo) ? r.minimo : a.minimo;
+            a.maximo = (r.maximo > a.maximo) ? r.maximo : a.maximo;
+        }
+        a.sensoresConDatos++;
+        a.lecturas += r.lecturas;
+        a.suma += r.suma;
+        a.sumaUltimos += r.ultimo;
+    }
+
+    return a;
+}
+
+int ConsultasFlota::inactivos(const char *prefijo, long long sinDatosMs, int *salida, int maximo)
+{
+    int desde;
+    int hasta;
+    rangoPrefijo(prefijo, desde, hasta);
+
+    long long limite = ahoraMs() - sinDatosMs;
+    int encontrados = 0;
+
+    for (int i = desde; i < hasta; i++)
+    {
+        int m = indiceNombres[i];
+        if (resumenes[m].ultimaMs <= limite)
+        {
+            if (salida != nullptr && encontrados < maximo)
+            {
+                salida[encontrados] = m;
+            }
+            encontrados++;
+        }
+    }
+
+    return encontrados;
+}
+
+const ResumenSensor *ConsultasFlota::getResumen(int manejador) const
+{
+    if (manejador < 0 || manejador >= numSensores || resumenes[manejador].sensor == nullptr)
+    {
+        return nullptr;
+    }
+    return &resumenes[manejador];
+}
+
+int ConsultasFlota::getNumSensores() const
+{
+    return numSensores;
+}
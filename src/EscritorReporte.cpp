@@ -0,0 +1,250 @@
+/**
+ * @file EscritorReporte.cpp
+ * @brief Implementación del escritor de reportes con buffer
+ * @author FabiRamiro
+ * @date 2026-10-18
+ */
+
+#include "EscritorReporte.h"
+#include <iostream>
+#include <cstdio>
+#include <cstring>
+#include <cerrno>
+#include <charconv>
+#include <fcntl.h>
+
+#ifdef _WIN32
+#include <io.h>
+#define escribirDescriptor _write
+#define cerrarDescriptor _close
+#else
+#include <unistd.h>
+#define escribirDescriptor write
+#define cerrarDescriptor close
+#endif
+
+namespace
+{
+    /**
+     * @brief Formatea un flotante en su representación más corta
+     * @return Caracteres escritos
+     */
+    template <typename F>
+    int formatearReal(char *destino, int capacidad, F valor)
+    {
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+        std::to_chars_result r = std::to_chars(destino, destino + capacidad, valor);
+        return static_cast<int>(r.ptr - destino);
+#else
+        return std::snprintf(destino, capacidad, "%g", static_cast<double>(valor));
+#endif
+    }
+}
+
+EscritorReporte::EscritorReporte(int destino)
+    : buffer(new char[TAM_BUFFER]), usados(0), descriptor(destino), propio(false),
+      escritos(0), vaciados(0)
+{
+}
+
+EscritorReporte::~EscritorReporte()
+{
+    cerrarArchivo();
+    vaciar();
+    delete[] buffer;
+}
+
+EscritorReporte &EscritorReporte::salidaEstandar()
+{
+    static EscritorReporte estandar(1);
+    return estandar;
+}
+
+bool EscritorReporte::abrirArchivo(const char *ruta)
+{
+    cerrarArchivo();
+
+#ifdef _WIN32
+    int fd = _open(ruta, _O_WRONLY | _O_CREAT | _O_TRUNC | _O_BINARY, 0644);
+#else
+    int fd = open(ruta, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+#endif
+    if (fd < 0)
+    {
+        return false;
+    }
+
+    vaciar();
+    descriptor = fd;
+    propio = true;
+    return true;
+}
+
+void EscritorReporte::cerrarArchivo()
+{
+    if (!propio)
+    {
+        return;
+    }
+
+    vaciar();
+    cerrarDescriptor(descriptor);
+    descriptor = 1;
+    propio = false;
+}
+
+void EscritorReporte::vaciar()
+{
+    if (usados == 0)
+    {
+        return;
+    }
+
+    if (descriptor == 1)
+    {
+        // Lo que ya está en std::cout debe salir antes que el reporte
+        std::cout.flush();
+        std::fflush(stdout);
+    }
+
+    int enviados = 0;
+    while (enviados < usados)
+    {
+        long n = escribirDescriptor(descriptor, buffer + enviados, static_cast<unsigned>(usados - enviados));
+        if (n < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (n <= 0)
+        {
+            break; // Destino cerrado o con error: se descarta lo pendiente
+        }
+        enviados += static_cast<int>(n);
+    }
+
+    escritos += enviados;
+    vaciados++;
+    usados = 0;
+}
+
+EscritorReporte &EscritorReporte::operator<<(const char *texto)
+{
+    if (texto == nullptr)
+    {
+        return *this;
+    }
+
+    int largo = static_cast<int>(std::strlen(texto));
+    while (largo > 0)
+    {
+        if (usados == TAM_BUFFER)
+        {
+            vaciar();
+        }
+        int bloque = (largo < TAM_BUFFER - usados) ? largo : TAM_BUFFER - usados;
+        std::memcpy(buffer + usados, texto, bloque);
+        usados += bloque;
+        texto += bloque;
+        largo -= bloque;
+    }
+    return *this;
+}
+
+EscritorReporte &EscritorReporte::operator<<(char c)
+{
+    reservar(1);
+    buffer[usados++] = c;
+    return *this;
+}
+
+EscritorReporte &EscritorReporte::operator<<(int valor)
+{
+    return *this << static_cast<long long>(valor);
+}
+
+EscritorReporte &EscritorReporte::operator<<(long valor)
+{
+    return *this << static_cast<long long>(valor);
+}
+
+EscritorReporte &EscritorReporte::operator<<(long long valor)
+{
+    reservar(24);
+    std::to_chars_result r = std::to_chars(buffer + usados, buffer + TAM_BUFFER, valor);
+    usados = static_cast<int>(r.ptr - buffer);
+    return *this;
+}
+
+EscritorReporte &EscritorReporte::operator<<(unsigned long valor)
+{
+    return *this << static_cast<unsigned long long>(valor);
+}
+
+EscritorReporte &EscritorReporte::operator<<(unsigned long long valor)
+{
+    reservar(24);
+    std::to_chars_result r = std::to_chars(buffer + usados, buffer + TAM_BUFFER, valor);
+    usados = static_cast<int>(r.ptr - buffer);
+    return *this;
+}
+
+EscritorReporte &EscritorReporte::operator<<(float valor)
+{
+    reservar(32);
+    usados += formatearReal(buffer + usados, TAM_BUFFER - usados, valor);
+    return *this;
+}
+
+EscritorReporte &EscritorReporte::operator<<(double valor)
+{
+    reservar(32);
+    usados += formatearReal(buffer + usados, TAM_BUFFER - usados, valor);
+    return *this;
+}
+
+EscritorReporte &EscritorReporte::real(double valor, int cifras)
+{
+    reservar(32);
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+    std::to_chars_result r = std::to_chars(buffer + usados, buffer + TAM_BUFFER, valor,
+                                           std::chars_format::general, cifras);
+    usados = static_cast<int>(r.ptr - buffer);
+#else
+    usados += std::snprintf(buffer + usados, TAM_BUFFER - usados, "%.*g", cifras, valor);
+#endif
+    return *this;
+}
+
+EscritorReporte &EscritorReporte::cadenaJSON(const char *texto)
+{
+    *this << '"';
+    for (const char *p = texto; p != nullptr && *p != '\0'; p++)
+    {
+        unsigned char c = static_cast<unsigned char>(*p);
+        if (c == '"' || c == '\\')
+        {
+            *this << '\\' << static_cast<char>(c);
+        }
+        else if (c < 0x20)
+        {
+            char escape[8];
+            std::snprintf(escape, sizeof(escape), "\\u%04x", c);
+            *this << escape;
+        }
+        else
+        {
+            *this << static_cast<char>(c);
+        }
+    }
+    return *this << '"';
+}
+
+unsigned long long EscritorReporte::getBytesEscritos() const
+{
+    return escritos;
+}
+
+unsigned long EscritorReporte::getVaciados() const
+{
+    return vaciados;
+}
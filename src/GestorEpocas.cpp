@@ -0,0 +1,132 @@
+/**
+ * @file GestorEpocas.cpp
+ * @brief Implementación de la reclamación basada en épocas
+ * @author FabiRamiro
+ * @date 2026-10-18
+ */
+
+#include "GestorEpocas.h"
+
+GestorEpocas::GestorEpocas()
+    : epocaGlobal(1), retirados(nullptr), numRetirados(0), capacidadRetirados(0), liberados(0)
+{
+    for (int i = 0; i < MAX_LECTORES; i++)
+    {
+        ranuras[i].epoca.store(0);
+        ranuras[i].ocupada.store(false);
+    }
+}
+
+GestorEpocas::~GestorEpocas()
+{
+    for (int i = 0; i < numRetirados; i++)
+    {
+        retirados[i].liberar(retirados[i].objeto);
+    }
+    delete[] retirados;
+}
+
+int GestorEpocas::registrarLector()
+{
+    for (int i = 0; i < MAX_LECTORES; i++)
+    {
+        bool libre = false;
+        if (ranuras[i].ocupada.compare_exchange_strong(libre, true))
+        {
+            ranuras[i].epoca.store(0);
+            return i;
+        }
+    }
+    return -1;
+}
+
+void GestorEpocas::liberarLector(int ranura)
+{
+    if (ranura < 0 || ranura >= MAX_LECTORES)
+    {
+        return;
+    }
+    ranuras[ranura].epoca.store(0);
+    ranuras[ranura].ocupada.store(false);
+}
+
+void GestorEpocas::fijar(int ranura)
+{
+    // seq_cst: la publicación de la época debe ser visible antes de leer el puntero
+    ranuras[ranura].epoca.store(epocaGlobal.load());
+}
+
+void GestorEpocas::soltar(int ranura)
+{
+    ranuras[ranura].epoca.store(0, std::memory_order_release);
+}
+
+void GestorEpocas::retirar(void *objeto, void (*liberar)(void *))
+{
+    if (objeto == nullptr)
+    {
+        return;
+    }
+
+    if (numRetirados == capacidadRetirados)
+    {
+        int nuevaCapacidad = (capacidadRetirados == 0) ? 64 : capacidadRetirados * 2;
+        Retirado *nuevos = new Retirado[nuevaCapacidad];
+        for (int i = 0; i < numRetirados; i++)
+        {
+            nuevos[i] = retirados[i];
+        }
+        delete[] retirados;
+        retirados = nuevos;
+        capacidadRetirados = nuevaCapacidad;
+    }
+
+    // El objeto ya no es alcanzable; se etiqueta con la época actual y se avanza
+    Retirado &r = retirados[numRetirados++];
+    r.objeto = objeto;
+    r.liberar = liberar;
+    r.epoca = epocaGlobal.fetch_add(1);
+}
+
+int GestorEpocas::reclamar()
+{
+    // Época mínima fijada por algún lector activo
+    unsigned long long minima = epocaGlobal.load();
+    for (int i = 0; i < MAX_LECTORES; i++)
+    {
+        unsigned long long e = ranuras[i].epoca.load();
+        if (e != 0 && e < minima)
+        {
+            minima = e;
+        }
+    }
+
+    int liberadosAhora = 0;
+    int conservados = 0;
+    for (int i = 0; i < numRetirados; i++)
+    {
+        if (retirados[i].epoca < minima)
+        {
+            retirados[i].liberar(retirados[i].objeto);
+            liberadosAhora++;
+        }
+        else
+        {
+            retirados[conservados++] = retirados[i];
+        }
+    }
+
+    numRetirados = conservados;
+    liberados += liberadosAhora;
+    return liberadosAhora;
+}
+
+int GestorEpocas::getPendientes() const
+{
+    return numRetirados;
+}
+
+unsigned long GestorEpocas::getLiberados() const
+{
+    return liberados;
+}
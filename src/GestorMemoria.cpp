@@ -0,0 +1,487 @@
+/**
+ * @file GestorMemoria.cpp
+ * @brief Implementación de la contabilidad de memoria y el desalojo por presupuesto
+ * @author FabiRamiro
+ * @date 2026-10-18
+ */
+
+#include "GestorMemoria.h"
+#include <iostream>
+#include <climits>
+#include <thread>
+
+GestorMemoria::GestorMemoria(std::size_t presupuestoBytes, PoliticaDesalojo politicaDesalojo)
+    : sensores(nullptr), bytes(nullptr), anterior(nullptr), siguiente(nullptr), enLRU(nullptr),
+      numSensores(0), capacidad(0), masReciente(-1), menosReciente(-1),
+      colaSegmentos(nullptr), capacidadCola(0), inicioCola(0), tamanoCola(0),
+      presupuesto(presupuestoBytes), politica(politicaDesalojo), total(0), pico(0),
+      desalojos(0), lecturasDescartadas(0), altasRechazadas(0), huboDesalojo(false),
+      ocupado(false)
+{
+}
+
+GestorMemoria::~GestorMemoria()
+{
+    delete[] sensores;
+    delete[] bytes;
+    delete[] anterior;
+    delete[] siguiente;
+    delete[] enLRU;
+    delete[] colaSegmentos;
+}
+
+void GestorMemoria::configurar(std::size_t presupuestoBytes, PoliticaDesalojo politicaDesalojo)
+{
+    presupuesto = presupuestoBytes;
+    politica = politicaDesalojo;
+
+    // Los segmentos que ya existían entran a la FIFO como semillas (manejador
+    // negativo): se desalojan por turnos hasta que el sensor no tenga más
+    tamanoCola = 0;
+    inicioCola = 0;
+    if (presupuesto > 0 && politica == DESALOJO_LECTURAS_ANTIGUAS)
+    {
+        for (int m = 0; m < numSensores; m++)
+        {
+            if (sensores[m] != nullptr)
+            {
+                encolarSegmento(-(m + 1));
+            }
+        }
+    }
+
+    // La ingesta solo mueve la lista LRU con esta política activa: los
+    // sensores que salieron de ella vuelven por el final
+    if (presupuesto > 0 && politica == DESALOJO_SENSORES_INACTIVOS)
+    {
+        for (int m = 0; m < numSensores; m++)
+        {
+            if (sensores[m] != nullptr && !enLRU[m])
+            {
+                enLRU[m] = true;
+                anterior[m] = menosReciente;
+                siguiente[m] = -1;
+                if (menosReciente >= 0)
+                {
+                    siguiente[menosReciente] = m;
+                }
+                else
+                {
+                    masReciente = m;
+                }
+                menosReciente = m;
+            }
+        }
+    }
+
+    aplicarPresupuesto();
+}
+
+void GestorMemoria::asegurarCapacidad(int m)
+{
+    if (m < capacidad)
+    {
+        return;
+    }
+
+    int nuevaCapacidad = (capacidad == 0) ? 8 : capacidad;
+    while (nuevaCapacidad <= m)
+    {
+        nuevaCapacidad *= 2;
+    }
+
+    SensorBase **nuevosSensores = new SensorBase *[nuevaCapacidad];
+    std::size_t *nuevosBytes = new std::size_t[nuevaCapacidad];
+    int *nuevosAnteriores = new int[nuevaCapacidad];
+    int *nuevosSiguientes = new int[nuevaCapacidad];
+    bool *nuevosEnLRU = new bool[nuevaCapacidad];
+
+    for (int i = 0; i < nuevaCapacidad; i++)
+    {
+        nuevosSensores[i] = (i < capacidad) ? sensores[i] : nullptr;
+        nuevosBytes[i] = (i < capacidad) ? bytes[i] : 0;
+        nuevosAnteriores[i] = (i < capacidad) ? anterior[i] : -1;
+        nuevosSiguientes[i] = (i < capacidad) ? siguiente[i] : -1;
+        nuevosEnLRU[i] = (i < capacidad) ? enLRU[i] : false;
+    }
+
+    delete[] sensores;
+    delete[] bytes;
+    delete[] anterior;
+    delete[] siguiente;
+    delete[] enLRU;
+    sensores = nuevosSensores;
+    bytes = nuevosBytes;
+    anterior = nuevosAnteriores;
+    siguiente = nuevosSiguientes;
+    enLRU = nuevosEnLRU;
+    capacidad = nuevaCapacidad;
+}
+
+long long GestorMemoria::medir(int m)
+{
+    std::size_t nuevo = sensores[m]->getBytesMemoria();
+    std::size_t previo = bytes[m];
+    if (nuevo == previo)
+    {
+        return 0; // Caso común: la lectura cupo en el segmento abierto
+    }
+
+    bytes[m] = nuevo;
+    bloquear();
+    total = total + nuevo - previo;
+    pico = (total > pico) ? total : pico;
+    desbloquear();
+    return static_cast<long long>(nuevo) - static_cast<long long>(previo);
+}
+
+void GestorMemoria::bloquear()
+{
+    while (ocupado.exchange(true, std::memory_order_acquire))
+    {
+        while (ocupado.load(std::memory_order_relaxed))
+        {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void GestorMemoria::desbloquear()
+{
+    ocupado.store(false, std::memory_order_release);
+}
+
+void GestorMemoria::desenlazar(int m)
+{
+    if (!enLRU[m])
+    {
+        return;
+    }
+
+    if (anterior[m] >= 0)
+    {
+        siguiente[anterior[m]] = siguiente[m];
+    }
+    else
+    {
+        masReciente = siguiente[m];
+    }
+
+    if (siguiente[m] >= 0)
+    {
+        anterior[siguiente[m]] = anterior[m];
+    }
+    else
+    {
+        menosReciente = anterior[m];
+    }
+
+    anterior[m] = -1;
+    siguiente[m] = -1;
+    enLRU[m] = false;
+}
+
+void GestorMemoria::tocar(int m)
+{
+    if (masReciente == m)
+    {
+        return;
+    }
+
+    desenlazar(m);
+    anterior[m] = -1;
+    siguiente[m] = masReciente;
+    if (masReciente >= 0)
+    {
+        anterior[masReciente] = m;
+    }
+    masReciente = m;
+    if (menosReciente < 0)
+    {
+        menosReciente = m;
+    }
+    enLRU[m] = true;
+}
+
+void GestorMemoria::encolarSegmento(int m)
+{
+    if (tamanoCola == capacidadCola)
+    {
+        int nuevaCapacidad = (capacidadCola == 0) ? 64 : capacidadCola * 2;
+        int *nueva = new int[nuevaCapacidad];
+        for (int i = 0; i < tamanoCola; i++)
+        {
+            nueva[i] = colaSegmentos[(inicioCola + i) & (capacidadCola - 1)];
+        }
+        delete[] colaSegmentos;
+        colaSegmentos = nueva;
+        capacidadCola = nuevaCapacidad;
+        inicioCola = 0;
+    }
+
+    colaSegmentos[(inicioCola + tamanoCola) & (capacidadCola - 1)] = m;
+    tamanoCola++;
+}
+
+void GestorMemoria::aplicarPresupuesto()
+{
+    if (presupuesto == 0)
+    {
+        return;
+    }
+
+    while (total > presupuesto)
+    {
+        int victima;
+        int segmentos;
+
+        if (politica == DESALOJO_LECTURAS_ANTIGUAS)
+        {
+            if (tamanoCola == 0)
+            {
+                return;
+            }
+            victima = colaSegmentos[inicioCola];
+            inicioCola = (inicioCola + 1) & (capacidadCola - 1);
+            tamanoCola--;
+            segmentos = 1;
+        }
+        else
+        {
+            if (menosReciente < 0)
+            {
+                return;
+            }
+            victima = menosReciente;
+            segmentos = INT_MAX;
+        }
+
+        bool semilla = victima < 0;
+        int m = semilla ? -victima - 1 : victima;
+        if (sensores[m] == nullptr)
+        {
+            continue; // Segmento de un sensor dado de baja
+        }
+
+        int descartadas = sensores[m]->descartarLecturasAntiguas(segmentos);
+        if (descartadas > 0)
+        {
+            medir(m);
+            desalojos++;
+            lecturasDescartadas += descartadas;
+            huboDesalojo = true;
+
+            // Una semilla vuelve al final mientras el sensor tenga segmentos viejos
+            if (semilla)
+            {
+                encolarSegmento(victima);
+            }
+        }
+
+        // Un sensor LRU sin nada que desalojar sale de la lista hasta su próxima lectura
+        if (politica == DESALOJO_SENSORES_INACTIVOS)
+        {
+            desenlazar(m);
+        }
+    }
+}
+
+void GestorMemoria::lecturaRegistrada(SensorBase &sensor, double valor)
+{
+    (void)valor;
+    bloqueRegistrado(sensor, nullptr, 1);
+}
+
+void GestorMemoria::bloqueRegistrado(SensorBase &sensor, const int *cuentas, int cantidad)
+{
+    (void)cuentas;
+    (void)cantidad;
+
+    int m = sensor.getManejador();
+    if (m < 0 || m >= numSensores)
+    {
+        return;
+    }
+
+    if (presupuesto > 0 && politica == DESALOJO_SENSORES_INACTIVOS)
+    {
+        bloquear();
+        tocar(m);
+        desbloquear();
+    }
+
+    if (medir(m) > 0 && presupuesto > 0 && politica == DESALOJO_LECTURAS_ANTIGUAS)
+    {
+        bloquear();
+        encolarSegmento(m); // El sensor abrió un segmento nuevo: el anterior quedó cerrado
+        desbloquear();
+    }
+}
+
+void GestorMemoria::historialModificado(SensorBase &sensor)
+{
+    // Sin aplicar el presupuesto: el aviso puede venir del propio desalojo
+    int m = sensor.getManejador();
+    if (m >= 0 && m < numSensores && sensores[m] == &sensor)
+    {
+        medir(m);
+    }
+}
+
+void GestorMemoria::sensorRegistrado(SensorBase &sensor, const void *tipo)
+{
+    (void)tipo;
+
+    int m = sensor.getManejador();
+    if (m < 0)
+    {
+        return;
+    }
+
+    asegurarCapacidad(m);
+    sensores[m] = &sensor;
+    bytes[m] = 0;
+    if (m >= numSensores)
+    {
+        numSensores = m + 1;
+    }
+
+    medir(m);
+    tocar(m);
+    aplicarPresupuesto();
+}
+
+void GestorMemoria::sensorEliminado(SensorBase &sensor, int manejador)
+{
+    int m = manejador;
+    if (m < 0 || m >= numSensores || sensores[m] != &sensor)
+    {
+        return;
+    }
+
+    desenlazar(m);
+    total -= bytes[m];
+    bytes[m] = 0;
+    sensores[m] = nullptr;
+}
+
+bool GestorMemoria::admiteSensorNuevo(const char *nombre)
+{
+    if (presupuesto == 0)
+    {
+        return true;
+    }
+
+    aplicarPresupuesto();
+    if (total < presupuesto)
+    {
+        return true;
+    }
+
+    altasRechazadas++;
+    std::cout << "[Memoria] Sensor '" << nombre << "' rechazado: presupuesto agotado ("
+              << total << "/" << presupuesto << " bytes)." << std::endl;
+    return false;
+}
+
+void GestorMemoria::recalcular()
+{
+    for (int m = 0; m < numSensores; m++)
+    {
+        if (sensores[m] != nullptr)
+        {
+            medir(m);
+        }
+    }
+    aplicarPresupuesto();
+}
+
+bool GestorMemoria::tomarDesalojos()
+{
+    aplicarPresupuesto();
+    bool hubo = huboDesalojo;
+    huboDesalojo = false;
+    return hubo;
+}
+
+std::size_t GestorMemoria::getBytesTotales() const
+{
+    return total;
+}
+
+std::size_t GestorMemoria::getPico() const
+{
+    return pico;
+}
+
+std::size_t GestorMemoria::getPresupuesto() const
+{
+    return presupuesto;
+}
+
+unsigned long GestorMemoria::getDesalojos() const
+{
+    return desalojos;
+}
+
+long long GestorMemoria::getLecturasDescartadas() const
+{
+    return lecturasDescartadas;
+}
+
+unsigned long GestorMemoria::getAltasRechazadas() const
+{
+    return altasRechazadas;
+}
+
+std::size_t GestorMemoria::getBytesSensor(int manejador) const
+{
+    return (manejador >= 0 && manejador < numSensores) ? bytes[manejador] : 0;
+}
+
+void GestorMemoria::imprimirEstadisticas(int maxSensores) const
+{
+    std::cout << "\n--- Memoria de la Flota ---" << std::endl;
+    std::cout << "Total: " << total << " bytes | Pico: " << pico << " bytes | Presupuesto: ";
+    if (presupuesto == 0)
+    {
+        std::cout << "sin limite" << std::endl;
+    }
+    else
+    {
+        std::cout << presupuesto << " bytes ("
+                  << (politica == DESALOJO_LECTURAS_ANTIGUAS ? "lecturas antiguas" : "sensores inactivos")
+                  << ")" << std::endl;
+    }
+    std::cout << "Sensores: " << numSensores << " | Desalojos: " << desalojos
+              << " | Lecturas descartadas: " << lecturasDescartadas
+              << " | Altas rechazadas: " << altasRechazadas << std::endl;
+
+    // Los que más ocupan: selección parcial sobre una copia de los manejadores
+    int n = (maxSensores < numSensores) ? maxSensores : numSensores;
+    int *orden = new int[numSensores > 0 ? numSensores : 1];
+    for (int m = 0; m < numSensores; m++)
+    {
+        orden[m] = m;
+    }
+    for (int i = 0; i < n; i++)
+    {
+        int mayor = i;
+        for (int j = i + 1; j < numSensores; j++)
+        {
+            if (bytes[orden[j]] > bytes[orden[mayor]])
+            {
+                mayor = j;
+            }
+        }
+        int t = orden[i];
+        orden[i] = orden[mayor];
+        orden[mayor] = t;
+
+        SensorBase *s = sensores[orden[i]];
+        std::cout << "  " << (i + 1) << ". " << (s != nullptr ? s->getNombre() : "?") << " ("
+                  << (s != nullptr ? s->getTipo() : "?") << "): " << bytes[orden[i]] << " bytes, "
+                  << (s != nullptr ? s->getNumLecturas() : 0) << " lectura(s)" << std::endl;
+    }
+    delete[] orden;
+}
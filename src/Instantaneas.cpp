@@ -0,0 +1,322 @@
+/**
+ * @file Instantaneas.cpp
+ * @brief Implementación de las instantáneas copy-on-write
+ * @author FabiRamiro
+ * @date 2026-10-18
+ */
+
+#include "Instantaneas.h"
+#include <cstring>
+#include <chrono>
+
+void InstantaneaSensor::imprimir() const
+{
+    std::cout << "  [" << tipo << "] " << nombre
+              << " | Lecturas: " << numLecturas;
+    if (numLecturas > 0)
+    {
+        std::cout << " | Promedio: " << promedio
+                  << " | Min: " << minimo
+                  << " | Max: " << maximo;
+    }
+    std::cout << std::endl;
+}
+
+void InstantaneaFlota::imprimir() const
+{
+    std::cout << "\n--- Instantanea #" << numero << " (" << numSensores
+              << " sensor(es), " << lecturasTotales << " lectura(s)) ---" << std::endl;
+    for (int i = 0; i < numSensores; i++)
+    {
+        if (sensores[i] != nullptr)
+        {
+            sensores[i]->imprimir();
+        }
+    }
+}
+
+PublicadorInstantaneas::PublicadorInstantaneas()
+    : actual(nullptr), sensores(nullptr), ultimas(nullptr), versiones(nullptr), lecturas(nullptr),
+      numSensores(0), capacidad(0), publicaciones(0), lecturasRetiradas(0),
+      ultimaPublicacionMs(0)
+{
+    publicar();
+}
+
+PublicadorInstantaneas::~PublicadorInstantaneas()
+{
+    liberarFlota(const_cast<InstantaneaFlota *>(actual.load()));
+    for (int i = 0; i < numSensores; i++)
+    {
+        liberarSensor(const_cast<InstantaneaSensor *>(ultimas[i]));
+    }
+    delete[] sensores;
+    delete[] ultimas;
+    delete[] versiones;
+    delete[] lecturas;
+    // Las versiones retiradas las libera el destructor de epocas
+}
+
+void PublicadorInstantaneas::liberarSensor(void *objeto)
+{
+    InstantaneaSensor *s = static_cast<InstantaneaSensor *>(objeto);
+    if (s != nullptr)
+    {
+        delete[] s->valores;
+        delete s;
+    }
+}
+
+void PublicadorInstantaneas::liberarFlota(void *objeto)
+{
+    InstantaneaFlota *f = static_cast<InstantaneaFlota *>(objeto);
+    if (f != nullptr)
+    {
+        delete[] f->sensores; // Los resúmenes se retiran por separado
+        delete f;
+    }
+}
+
+void PublicadorInstantaneas::asegurarCapacidad(int m)
+{
+    if (m < capacidad)
+    {
+        return;
+    }
+
+    int nuevaCapacidad = (capacidad == 0) ? 8 : capacidad;
+    while (nuevaCapacidad <= m)
+    {
+        nuevaCapacidad *= 2;
+    }
+
+    SensorBase **nuevosSensores = new SensorBase *[nuevaCapacidad];
+    const InstantaneaSensor **nuevasUltimas = new const InstantaneaSensor *[nuevaCapacidad];
+    unsigned long *nuevasVersiones = new unsigned long[nuevaCapacidad];
+    long long *nuevasLecturas = new long long[nuevaCapacidad];
+
+    for (int i = 0; i < nuevaCapacidad; i++)
+    {
+        nuevosSensores[i] = (i < capacidad) ? sensores[i] : nullptr;
+        nuevasUltimas[i] = (i < capacidad) ? ultimas[i] : nullptr;
+        nuevasVersiones[i] = (i < capacidad) ? versiones[i] : 0;
+        nuevasLecturas[i] = (i < capacidad) ? lecturas[i] : 0;
+    }
+
+    delete[] sensores;
+    delete[] ultimas;
+    delete[] versiones;
+    delete[] lecturas;
+    sensores = nuevosSensores;
+    ultimas = nuevasUltimas;
+    versiones = nuevasVersiones;
+    lecturas = nuevasLecturas;
+    capacidad = nuevaCapacidad;
+}
+
+void PublicadorInstantaneas::lecturaRegistrada(SensorBase &sensor, double valor)
+{
+    (void)valor;
+    int m = sensor.getManejador();
+    if (m >= 0 && m < numSensores)
+    {
+        versiones[m]++;
+        lecturas[m]++;
+    }
+}
+
+void PublicadorInstantaneas::bloqueRegistrado(SensorBase &sensor, const int *cuentas, int cantidad)
+{
+    (void)cuentas;
+    int m = sensor.getManejador();
+    if (m >= 0 && m < numSensores)
+    {
+        versiones[m]++;
+        lecturas[m] += cantidad;
+    }
+}
+
+void PublicadorInstantaneas::sensorRegistrado(SensorBase &sensor, const void *tipo)
+{
+    (void)tipo;
+    int m = sensor.getManejador();
+    if (m < 0)
+    {
+        return;
+    }
+
+    asegurarCapacidad(m);
+    sensores[m] = &sensor;
+    versiones[m]++;
+    if (m >= numSensores)
+    {
+        numSensores = m + 1;
+    }
+}
+
+void PublicadorInstantaneas::sensorEliminado(SensorBase &sensor, int manejador)
+{
+    int m = manejador;
+    if (m < 0 || m >= numSensores || sensores[m] != &sensor)
+    {
+        return;
+    }
+
+    sensores[m] = nullptr;
+    versiones[m]++;
+    lecturasRetiradas += lecturas[m];
+    lecturas[m] = 0;
+}
+
+void PublicadorInstantaneas::historialModificado(SensorBase &sensor)
+{
+    int m = sensor.getManejador();
+    if (m >= 0 && m < numSensores)
+    {
+        versiones[m]++;
+    }
+}
+
+void PublicadorInstantaneas::invalidarTodo()
+{
+    for (int i = 0; i < numSensores; i++)
+    {
+        versiones[i]++;
+    }
+}
+
+const InstantaneaSensor *PublicadorInstantaneas::construir(int m) const
+{
+    const SensorBase *sensor = sensores[m];
+
+    InstantaneaSensor *s = new InstantaneaSensor;
+    std::strncpy(s->nombre, sensor->getNombre(), sizeof(s->nombre) - 1);
+    s->nombre[sizeof(s->nombre) - 1] = '\0';
+    s->tipo = sensor->getTipo();
+    s->manejador = m;
+    s->version = versiones[m];
+
+    int total = sensor->getNumLecturas();
+    s->valores = new double[total > 0 ? total : 1];
+    s->numLecturas = sensor->copiarLecturas(s->valores, total);
+
+    s->promedio = 0.0;
+    s->minimo = 0.0;
+    s->maximo = 0.0;
+    if (s->numLecturas > 0)
+    {
+        double suma = 0.0;
+        s->minimo = s->valores[0];
+        s->maximo = s->valores[0];
+        for (int i = 0; i < s->numLecturas; i++)
+        {
+            double v = s->valores[i];
+            suma += v;
+            s->minimo = (v < s->minimo) ? v : s->minimo;
+            s->maximo = (v > s->maximo) ? v : s->maximo;
+        }
+        s->promedio = suma / s->numLecturas;
+    }
+
+    return s;
+}
+
+int PublicadorInstantaneas::publicar()
+{
+    int reconstruidos = 0;
+
+    InstantaneaFlota *nueva = new InstantaneaFlota;
+    nueva->numero = ++publicaciones;
+    nueva->numSensores = numSensores;
+    nueva->sensores = new const InstantaneaSensor *[numSensores > 0 ? numSensores : 1];
+    nueva->lecturasTotales = lecturasRetiradas;
+    for (int m = 0; m < numSensores; m++)
+    {
+        nueva->lecturasTotales += lecturas[m];
+    }
+
+    // Los resúmenes reemplazados siguen alcanzables desde la vista vieja hasta el intercambio
+    const InstantaneaSensor **reemplazados = new const InstantaneaSensor *[numSensores > 0 ? numSensores : 1];
+    int numReemplazados = 0;
+
+    for (int m = 0; m < numSensores; m++)
+    {
+        if (sensores[m] == nullptr)
+        {
+            // Dado de baja: la vista nueva ya no lo muestra y su último resumen se retira
+            nueva->sensores[m] = nullptr;
+            reemplazados[numReemplazados++] = ultimas[m];
+            ultimas[m] = nullptr;
+            continue;
+        }
+
+        // Copy-on-write: solo se copian los sensores modificados
+        if (ultimas[m] == nullptr || ultimas[m]->version != versiones[m])
+        {
+            reemplazados[numReemplazados++] = ultimas[m];
+            ultimas[m] = construir(m);
+            reconstruidos++;
+        }
+        nueva->sensores[m] = ultimas[m];
+    }
+
+    const InstantaneaFlota *vieja = actual.exchange(nueva);
+    for (int i = 0; i < numReemplazados; i++)
+    {
+        epocas.retirar(const_cast<InstantaneaSensor *>(reemplazados[i]), liberarSensor);
+    }
+    epocas.retirar(const_cast<InstantaneaFlota *>(vieja), liberarFlota);
+    epocas.reclamar();
+    delete[] reemplazados;
+
+    ultimaPublicacionMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+                              std::chrono::steady_clock::now().time_since_epoch())
+                              .count();
+    return reconstruidos;
+}
+
+bool PublicadorInstantaneas::publicarPeriodico(int intervaloMs)
+{
+    long long ahora = std::chrono::duration_cast<std::chrono::milliseconds>(
+                          std::chrono::steady_clock::now().time_since_epoch())
+                          .count();
+    if (ahora - ultimaPublicacionMs < intervaloMs)
+    {
+        return false;
+    }
+
+    publicar();
+    return true;
+}
+
+int PublicadorInstantaneas::registrarLector()
+{
+    return epocas.registrarLector();
+}
+
+void PublicadorInstantaneas::liberarLector(int ranura)
+{
+    epocas.liberarLector(ranura);
+}
+
+unsigned long PublicadorInstantaneas::getPublicaciones() const
+{
+    return publicaciones;
+}
+
+int PublicadorInstantaneas::getPendientes() const
+{
+    return epocas.getPendientes();
+}
+
+LectorInstantaneas::LectorInstantaneas(PublicadorInstantaneas &origen, int ranuraLector)
+    : publicador(origen), ranura(ranuraLector)
+{
+    publicador.epocas.fijar(ranura);
+    vista = publicador.actual.load();
+}
+
+LectorInstantaneas::~LectorInstantaneas()
+{
+    publicador.epocas.soltar(ranura);
+}
@@ -0,0 +1,178 @@
+/**
+ * @file LectorAnillo.cpp
+ * @brief Implementación del lector del anillo de memoria compartida
+ * @author FabiRamiro
+ * @date 2026-10-18
+ */
+
+#include "LectorAnillo.h"
+#include <cstdio>
+#include <cstring>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+LectorAnillo::LectorAnillo()
+    : cabecera(nullptr), ranuras(nullptr), mascara(0), capacidad(0), tamano(0), posicion(0), perdidos(0)
+{
+}
+
+LectorAnillo::~LectorAnillo()
+{
+    cerrar();
+}
+
+bool LectorAnillo::abrir(const char *nombre, bool desdeElPrincipio)
+{
+    cerrar();
+
+    if (nombre == nullptr || nombre[0] == '\0')
+    {
+        return false;
+    }
+
+#ifdef _WIN32
+    (void)desdeElPrincipio;
+    return false;
+#else
+    char nombreSegmento[64];
+    std::snprintf(nombreSegmento, sizeof(nombreSegmento), "%s%s", nombre[0] == '/' ? "" : "/", nombre);
+
+    int fd = shm_open(nombreSegmento, O_RDONLY | O_CLOEXEC, 0);
+    if (fd < 0)
+    {
+        return false;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) < 0 || static_cast<std::uint64_t>(info.st_size) < sizeof(CabeceraAnillo))
+    {
+        close(fd);
+        return false;
+    }
+
+    void *mapa = mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (mapa == MAP_FAILED)
+    {
+        return false;
+    }
+
+    // Validar antes de usar: el escritor publica la magia después de inicializar
+    const CabeceraAnillo *candidata = static_cast<const CabeceraAnillo *>(mapa);
+    if (candidata->magia.load(std::memory_order_acquire) != MAGIA_ANILLO ||
+        candidata->version != VERSION_ANILLO || candidata->tamRanura != sizeof(RanuraAnillo) ||
+        candidata->capacidad == 0 || (candidata->capacidad & (candidata->capacidad - 1)) != 0 ||
+        tamanoSegmentoAnillo(candidata->capacidad) > static_cast<std::uint64_t>(info.st_size))
+    {
+        munmap(mapa, static_cast<std::size_t>(info.st_size));
+        return false;
+    }
+
+    cabecera = candidata;
+    ranuras = reinterpret_cast<const RanuraAnillo *>(cabecera + 1);
+    capacidad = cabecera->capacidad;
+    mascara = capacidad - 1;
+    tamano = static_cast<std::uint64_t>(info.st_size);
+    perdidos = 0;
+
+    std::uint64_t publicados = cabecera->publicados.load(std::memory_order_acquire);
+    if (!desdeElPrincipio)
+    {
+        posicion = publicados;
+    }
+    else
+    {
+        posicion = (publicados > capacidad) ? publicados - capacidad : 0;
+    }
+    return true;
+#endif
+}
+
+void LectorAnillo::cerrar()
+{
+    if (cabecera == nullptr)
+    {
+        return;
+    }
+
+#ifndef _WIN32
+    munmap(const_cast<CabeceraAnillo *>(cabecera), static_cast<std::size_t>(tamano));
+#endif
+    cabecera = nullptr;
+    ranuras = nullptr;
+}
+
+ResultadoLectorAnillo LectorAnillo::siguiente(RegistroAnillo &destino)
+{
+    if (cabecera == nullptr)
+    {
+        return LECTOR_ANILLO_VACIO;
+    }
+
+    std::uint64_t publicados = cabecera->publicados.load(std::memory_order_acquire);
+    if (posicion >= publicados)
+    {
+        return LECTOR_ANILLO_VACIO;
+    }
+
+    const RanuraAnillo &ranura = ranuras[posicion & mascara];
+    std::uint64_t esperado = 2 * posicion + 2;
+    std::uint64_t antes = ranura.sello.load(std::memory_order_acquire);
+    if (antes == esperado)
+    {
+        std::memcpy(&destino, &ranura.registro, sizeof(RegistroAnillo));
+        std::atomic_thread_fence(std::memory_order_acquire); // La copia antes de releer el sello
+        if (ranura.sello.load(std::memory_order_relaxed) == esperado)
+        {
+            posicion++;
+            return LECTOR_ANILLO_REGISTRO;
+        }
+    }
+
+    // El escritor dio la vuelta: saltar al más viejo que se conserva, con un
+    // margen para no volver a quedar pisado de inmediato
+    publicados = cabecera->publicados.load(std::memory_order_acquire);
+    std::uint64_t nueva = (publicados > capacidad) ? publicados - capacidad + capacidad / 4 : 0;
+    if (nueva <= posicion)
+    {
+        nueva = posicion + 1;
+    }
+    perdidos += nueva - posicion;
+    posicion = nueva;
+    return LECTOR_ANILLO_PERDIDOS;
+}
+
+bool LectorAnillo::escritorActivo() const
+{
+    return cabecera != nullptr && cabecera->activo.load(std::memory_order_acquire) != 0;
+}
+
+std::uint64_t LectorAnillo::getPendientes() const
+{
+    if (cabecera == nullptr)
+    {
+        return 0;
+    }
+    std::uint64_t publicados = cabecera->publicados.load(std::memory_order_acquire);
+    return (publicados > posicion) ? publicados - posicion : 0;
+}
+
+std::uint64_t LectorAnillo::getPosicion() const
+{
+    return posicion;
+}
+
+std::uint64_t LectorAnillo::getPerdidos() const
+{
+    return perdidos;
+}
+
+std::uint64_t LectorAnillo::getCapacidad() const
+{
+    return capacidad;
+}
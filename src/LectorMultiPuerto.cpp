@@ -0,0 +1,339 @@
+/**
+ * @file LectorMultiPuerto.cpp
+ * @brief Implementación del lector multi-dispositivo basado en epoll
+ * @author FabiRamiro
+ * @date 2026-10-18
+ */
+
+#include "LectorMultiPuerto.h"
+
+#ifdef __linux__
+
+#include <iostream>
+#include <cstring>
+#include <cerrno>
+#include <ctime>
+#include <fcntl.h>
+#include <termios.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+
+LectorMultiPuerto::LectorMultiPuerto() : numDispositivos(0)
+{
+    epollFd = epoll_create1(EPOLL_CLOEXEC);
+    if (epollFd < 0)
+    {
+        std::cout << "[LectorMultiPuerto] Error: no se pudo crear epoll ("
+                  << std::strerror(errno) << ")." << std::endl;
+    }
+}
+
+LectorMultiPuerto::~LectorMultiPuerto()
+{
+    for (int i = 0; i < numDispositivos; i++)
+    {
+        if (dispositivos[i].fd >= 0)
+        {
+            close(dispositivos[i].fd);
+        }
+    }
+
+    if (epollFd >= 0)
+    {
+        close(epollFd);
+    }
+}
+
+long long LectorMultiPuerto::ahoraMilisegundos()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<long long>(ts.tv_sec) * 1000 + ts.tv_nsec / 1000000;
+}
+
+int LectorMultiPuerto::agregarPuerto(const char *ruta, bool binario)
+{
+    if (ruta == nullptr || numDispositivos == MAX_DISPOSITIVOS)
+    {
+        return -1;
+    }
+
+    int indice = numDispositivos++;
+    Dispositivo &d = dispositivos[indice];
+    std::strncpy(d.ruta, ruta, sizeof(d.ruta) - 1);
+    d.ruta[sizeof(d.ruta) - 1] = '\0';
+    d.fd = -1;
+    d.binario = binario;
+    d.longitudLinea = 0;
+    d.descartandoLinea = false;
+    d.decodificador.reiniciar();
+    d.proximoIntentoMs = 0;
+    d.esperaMs = ESPERA_INICIAL_MS;
+    d.mensajes = 0;
+    d.reconexiones = 0;
+
+    if (abrir(indice, ahoraMilisegundos()))
+    {
+        std::cout << "[LectorMultiPuerto] " << d.ruta << " conectado ("
+                  << (binario ? "binario" : "texto") << ")." << std::endl;
+    }
+    else
+    {
+        std::cout << "[LectorMultiPuerto] " << d.ruta
+                  << " no disponible; se reintentara en segundo plano." << std::endl;
+    }
+
+    return indice;
+}
+
+bool LectorMultiPuerto::abrir(int indice, long long ahoraMs)
+{
+    Dispositivo &d = dispositivos[indice];
+
+    int fd = open(d.ruta, O_RDONLY | O_NOCTTY | O_NONBLOCK | O_CLOEXEC);
+    if (fd < 0)
+    {
+        d.proximoIntentoMs = ahoraMs + d.esperaMs;
+        d.esperaMs = (d.esperaMs * 2 > ESPERA_MAXIMA_MS) ? ESPERA_MAXIMA_MS : d.esperaMs * 2;
+        return false;
+    }
+
+    // Puerto serie real: modo raw a 115200 baudios (igual que el sketch)
+    if (isatty(fd))
+    {
+        struct termios tty;
+        if (tcgetattr(fd, &tty) == 0)
+        {
+            cfmakeraw(&tty);
+            cfsetispeed(&tty, B115200);
+            cfsetospeed(&tty, B115200);
+            tty.c_cflag |= (CLOCAL | CREAD);
+            tcsetattr(fd, TCSANOW, &tty);
+        }
+    }
+
+    struct epoll_event evento;
+    std::memset(&evento, 0, sizeof(evento));
+    evento.events = EPOLLIN | EPOLLRDHUP;
+    evento.data.u32 = static_cast<unsigned int>(indice);
+
+    if (epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &evento) < 0)
+    {
+        close(fd);
+        d.proximoIntentoMs = ahoraMs + d.esperaMs;
+        return false;
+    }
+
+    d.fd = fd;
+    d.esperaMs = ESPERA_INICIAL_MS;
+    d.longitudLinea = 0;
+    d.descartandoLinea = false;
+    return true;
+}
+
+void LectorMultiPuerto::desconectar(int indice, long long ahoraMs)
+{
+    Dispositivo &d = dispositivos[indice];
+    if (d.fd < 0)
+    {
+        return;
+    }
+
+    epoll_ctl(epollFd, EPOLL_CTL_DEL, d.fd, nullptr);
+    close(d.fd);
+    d.fd = -1;
+    d.proximoIntentoMs = ahoraMs + d.esperaMs;
+
+    std::cout << "[LectorMultiPuerto] " << d.ruta << " desconectado; reintento en "
+              << d.esperaMs << " ms." << std::endl;
+}
+
+int LectorMultiPuerto::reintentarConexiones(long long ahoraMs)
+{
+    long long proximo = -1;
+
+    for (int i = 0; i < numDispositivos; i++)
+    {
+        Dispositivo &d = dispositivos[i];
+        if (d.fd >= 0)
+        {
+            continue;
+        }
+
+        if (d.proximoIntentoMs <= ahoraMs)
+        {
+            if (abrir(i, ahoraMs))
+            {
+                d.reconexiones++;
+                std::cout << "[LectorMultiPuerto] " << d.ruta << " reconectado." << std::endl;
+                continue;
+            }
+        }
+
+        if (proximo < 0 || d.proximoIntentoMs < proximo)
+        {
+            proximo = d.proximoIntentoMs;
+        }
+    }
+
+    return (proximo < 0) ? -1 : static_cast<int>(proximo - ahoraMs);
+}
+
+int LectorMultiPuerto::leerDispositivo(int indice, long long ahoraMs, ReceptorLecturas &receptor)
+{
+    Dispositivo &d = dispositivos[indice];
+    int entregados = 0;
+    unsigned char bytes[4096];
+
+    while (d.fd >= 0)
+    {
+        ssize_t n = read(d.fd, bytes, sizeof(bytes));
+
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+        {
+            break; // No hay más datos por ahora
+        }
+        if (n < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (n <= 0)
+        {
+            desconectar(indice, ahoraMs); // EOF, EIO (pty cerrado) u otro error
+            break;
+        }
+
+        if (d.binario)
+        {
+            int pos = 0;
+            while (pos < n)
+            {
+                pos += d.decodificador.alimentar(bytes + pos, static_cast<int>(n) - pos);
+
+                LecturaBinaria lectura;
+                while (d.decodificador.siguienteLectura(lectura))
+                {
+                    receptor.lecturaRecibida(indice, d.ruta, lectura);
+                    d.mensajes++;
+                    entregados++;
+                }
+            }
+            continue;
+        }
+
+        for (ssize_t i = 0; i < n; i++)
+        {
+            char c = static_cast<char>(bytes[i]);
+
+            if (c == '\n')
+            {
+                if (!d.descartandoLinea && d.longitudLinea > 0)
+                {
+                    d.linea[d.longitudLinea] = '\0';
+                    receptor.lineaRecibida(indice, d.ruta, d.linea);
+                    d.mensajes++;
+                    entregados++;
+                }
+                d.longitudLinea = 0;
+                d.descartandoLinea = false;
+            }
+            else if (c != '\r' && !d.descartandoLinea)
+            {
+                if (d.longitudLinea < TAM_LINEA - 1)
+                {
+                    d.linea[d.longitudLinea++] = c;
+                }
+                else
+                {
+                    d.descartandoLinea = true; // Línea demasiado larga: se ignora completa
+                }
+            }
+        }
+    }
+
+    return entregados;
+}
+
+int LectorMultiPuerto::ejecutarCiclo(int timeoutMs, ReceptorLecturas &receptor)
+{
+    if (epollFd < 0)
+    {
+        return -1;
+    }
+
+    long long ahora = ahoraMilisegundos();
+    int hastaReintento = reintentarConexiones(ahora);
+
+    // No dormir más allá del siguiente reintento de conexión
+    int espera = timeoutMs;
+    if (hastaReintento >= 0 && (espera < 0 || hastaReintento < espera))
+    {
+        espera = hastaReintento;
+    }
+
+    struct epoll_event eventos[MAX_DISPOSITIVOS];
+    int n = epoll_wait(epollFd, eventos, MAX_DISPOSITIVOS, espera);
+    if (n < 0)
+    {
+        return (errno == EINTR) ? 0 : -1;
+    }
+
+    ahora = ahoraMilisegundos();
+    int entregados = 0;
+
+    for (int i = 0; i < n; i++)
+    {
+        int indice = static_cast<int>(eventos[i].data.u32);
+
+        // Leer primero: puede haber datos pendientes junto con el HUP
+        entregados += leerDispositivo(indice, ahora, receptor);
+
+        if (eventos[i].events & (EPOLLHUP | EPOLLERR | EPOLLRDHUP))
+        {
+            desconectar(indice, ahora);
+        }
+    }
+
+    return entregados;
+}
+
+int LectorMultiPuerto::getNumDispositivos() const
+{
+    return numDispositivos;
+}
+
+int LectorMultiPuerto::getConectados() const
+{
+    int conectados = 0;
+    for (int i = 0; i < numDispositivos; i++)
+    {
+        if (dispositivos[i].fd >= 0)
+        {
+            conectados++;
+        }
+    }
+    return conectados;
+}
+
+void LectorMultiPuerto::imprimirEstado() const
+{
+    std::cout << "\n--- Dispositivos (" << getConectados() << "/" << numDispositivos
+              << " conectados) ---" << std::endl;
+
+    for (int i = 0; i < numDispositivos; i++)
+    {
+        const Dispositivo &d = dispositivos[i];
+        std::cout << "[" << i << "] " << d.ruta
+                  << (d.fd >= 0 ? " [CONECTADO]" : " [DESCONECTADO]")
+                  << " | Mensajes: " << d.mensajes
+                  << " | Reconexiones: " << d.reconexiones << std::endl;
+
+        if (d.binario)
+        {
+            std::cout << "    ";
+            d.decodificador.imprimirEstadisticas();
+        }
+    }
+}
+
+#endif // __linux__
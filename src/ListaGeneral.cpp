@@ -1,109 +1,1098 @@
 /**
  * @file ListaGeneral.cpp
- * @brief Implementación de la lista de gestión polimórfica
+ * @brief Implementación del registro de gestión polimórfica
  * @author FabiRamiro
  * @date 2025-10-31
  */
 
 #include "ListaGeneral.h"
+#include "RegistroTipos.h"
+#include "Trazas.h"
 #include <cstring>
+#include <climits>
+#include <algorithm>
+#include <chrono>
+#include <thread>
 
-ListaGeneral::ListaGeneral() : cabeza(nullptr), contador(0)
+ListaGeneral::ListaGeneral(int fragmentos)
+    : sensores(nullptr), tipos(nullptr), numManejadores(0), capacidad(0), vivos(nullptr), numVivos(0),
+      libres(nullptr), numLibres(0), bajas(0), numRetirados(0), fragmentos(nullptr), numFragmentos(1),
+      altaOcupada(false), numObservadores(0), modificados(nullptr), ultimaLectura(nullptr),
+      listaModificados(nullptr), capacidadLista(0), silencioso(false)
 {
+    while (numFragmentos < fragmentos && numFragmentos < MAX_FRAGMENTOS)
+    {
+        numFragmentos *= 2;
+    }
+
+    this->fragmentos = new Fragmento[numFragmentos];
+    for (int f = 0; f < numFragmentos; f++)
+    {
+        Fragmento &fragmento = this->fragmentos[f];
+        fragmento.ocupado.store(false, std::memory_order_relaxed);
+        fragmento.tabla = nullptr;
+        fragmento.capacidadTabla = 0;
+        fragmento.numEntradas = 0;
+        fragmento.modificados = nullptr;
+        fragmento.numModificados = 0;
+        fragmento.capacidadModificados = 0;
+    }
+
     std::cout << "[Log] ListaGeneral de sensores creada." << std::endl;
 }
 
 ListaGeneral::~ListaGeneral()
 {
-    std::cout << "\n--- Liberacion de Memoria en Cascada ---" << std::endl;
+    std::cout << "\n--- Liberacion de Memoria en Bloque ---" << std::endl;
 
-    NodoSensor *actual = cabeza;
-    while (actual != nullptr)
-    {
-        NodoSensor *siguiente = actual->siguiente;
+    // Las bajas pendientes se liberan antes que la arena (no debe haber lectores activos)
+    epocas.reclamar();
 
-        std::cout << "[Destructor General] Liberando Nodo: "
-                  << actual->sensor->getNombre() << std::endl;
+    // Sensores externos (creados con new): se liberan uno a uno
+    for (int v = 0; v < numVivos; v++)
+    {
+        int i = vivos[v];
+        if (tipos[i] == nullptr)
+        {
+            std::cout << "[Destructor General] Liberando sensor externo: "
+                      << sensorEn(i)->getNombre() << std::endl;
+            delete sensorEn(i); // Llama al destructor virtual apropiado
+        }
+    }
 
-        delete actual->sensor; // Llama al destructor virtual apropiado
-        delete actual;
+    // Sensores de la arena: destructores por slab y un free por slab
+    arena.liberarTodo();
 
-        actual = siguiente;
+    delete[] sensores.load();
+    delete[] tipos.load();
+    for (int r = 0; r < numRetirados; r++)
+    {
+        delete[] sensoresRetirados[r];
+        delete[] tiposRetirados[r];
+    }
+    for (int f = 0; f < numFragmentos; f++)
+    {
+        delete[] fragmentos[f].tabla;
+        delete[] fragmentos[f].modificados;
     }
+    delete[] fragmentos;
+    delete[] modificados;
+    delete[] ultimaLectura;
+    delete[] listaModificados;
+    delete[] vivos;
+    delete[] libres;
 
     std::cout << "Sistema cerrado. Memoria limpia." << std::endl;
 }
 
-void ListaGeneral::insertarSensor(SensorBase *sensor)
+unsigned ListaGeneral::hashNombre(const char *nombre)
+{
+    unsigned hash = 2166136261u;
+    for (const char *c = nombre; *c != '\0'; c++)
+    {
+        hash ^= static_cast<unsigned char>(*c);
+        hash *= 16777619u;
+    }
+
+    // Mezcla final: los bits altos (fragmento) dependen de todo el nombre
+    hash ^= hash >> 16;
+    hash *= 0x85ebca6bu;
+    hash ^= hash >> 13;
+    hash *= 0xc2b2ae35u;
+    hash ^= hash >> 16;
+    return hash;
+}
+
+ListaGeneral::Fragmento &ListaGeneral::fragmentoDe(unsigned hash) const
+{
+    return fragmentos[(hash >> 24) & static_cast<unsigned>(numFragmentos - 1)];
+}
+
+void ListaGeneral::bloquear(Fragmento &fragmento)
+{
+    while (fragmento.ocupado.exchange(true, std::memory_order_acquire))
+    {
+        while (fragmento.ocupado.load(std::memory_order_relaxed))
+        {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void ListaGeneral::desbloquear(Fragmento &fragmento)
+{
+    fragmento.ocupado.store(false, std::memory_order_release);
+}
+
+void ListaGeneral::bloquearAlta()
+{
+    while (altaOcupada.exchange(true, std::memory_order_acquire))
+    {
+        while (altaOcupada.load(std::memory_order_relaxed))
+        {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void ListaGeneral::desbloquearAlta()
 {
-    NodoSensor *nuevoNodo = new NodoSensor(sensor);
+    altaOcupada.store(false, std::memory_order_release);
+}
 
-    if (cabeza == nullptr)
+void ListaGeneral::pausarAvisos() const
+{
+    for (int f = 0; f < numFragmentos; f++)
     {
-        cabeza = nuevoNodo;
+        fragmentos[f].despacho.lock();
+    }
+}
+
+void ListaGeneral::reanudarAvisos() const
+{
+    for (int f = numFragmentos - 1; f >= 0; f--)
+    {
+        fragmentos[f].despacho.unlock();
+    }
+}
+
+const ListaGeneral::EntradaIndice *ListaGeneral::buscarEntrada(const Fragmento &fragmento, unsigned hash,
+                                                               const char *nombre)
+{
+    if (fragmento.capacidadTabla == 0)
+    {
+        return nullptr;
+    }
+
+    unsigned mascara = static_cast<unsigned>(fragmento.capacidadTabla - 1);
+    for (unsigned i = hash & mascara;; i = (i + 1) & mascara)
+    {
+        const EntradaIndice &entrada = fragmento.tabla[i];
+        if (entrada.sensor == nullptr)
+        {
+            return nullptr;
+        }
+        if (entrada.hash == hash && std::strcmp(entrada.sensor->getNombre(), nombre) == 0)
+        {
+            return &entrada;
+        }
+    }
+}
+
+void ListaGeneral::desindexar(Fragmento &fragmento, unsigned hash, int manejador)
+{
+    if (fragmento.capacidadTabla == 0)
+    {
+        return;
+    }
+
+    unsigned mascara = static_cast<unsigned>(fragmento.capacidadTabla - 1);
+    unsigned hueco = hash & mascara;
+    while (fragmento.tabla[hueco].sensor != nullptr && fragmento.tabla[hueco].manejador != manejador)
+    {
+        hueco = (hueco + 1) & mascara;
+    }
+    if (fragmento.tabla[hueco].sensor == nullptr)
+    {
+        return; // Un nombre repetido nunca se indexó
+    }
+
+    // Se adelantan las casillas del mismo racimo que el hueco dejaría inalcanzables
+    for (unsigned j = (hueco + 1) & mascara; fragmento.tabla[j].sensor != nullptr; j = (j + 1) & mascara)
+    {
+        unsigned inicial = fragmento.tabla[j].hash & mascara;
+        bool alcanzable = (hueco <= j) ? (hueco < inicial && inicial <= j) : (hueco < inicial || inicial <= j);
+        if (!alcanzable)
+        {
+            fragmento.tabla[hueco] = fragmento.tabla[j];
+            hueco = j;
+        }
+    }
+    fragmento.tabla[hueco].sensor = nullptr;
+    fragmento.numEntradas--;
+}
+
+void ListaGeneral::indexar(Fragmento &fragmento, unsigned hash, int manejador, SensorBase *sensor)
+{
+    // Con un nombre repetido queda indexado el primero, como en la búsqueda lineal
+    if (buscarEntrada(fragmento, hash, sensor->getNombre()) != nullptr)
+    {
+        return;
+    }
+
+    // Factor de carga máximo 1/2: las búsquedas fallidas terminan pronto
+    if ((fragmento.numEntradas + 1) * 2 > fragmento.capacidadTabla)
+    {
+        int nuevaCapacidad = (fragmento.capacidadTabla == 0) ? 16 : fragmento.capacidadTabla * 2;
+        EntradaIndice *nuevaTabla = new EntradaIndice[nuevaCapacidad];
+        for (int i = 0; i < nuevaCapacidad; i++)
+        {
+            nuevaTabla[i].sensor = nullptr;
+        }
+
+        unsigned mascara = static_cast<unsigned>(nuevaCapacidad - 1);
+        for (int i = 0; i < fragmento.capacidadTabla; i++)
+        {
+            const EntradaIndice &entrada = fragmento.tabla[i];
+            if (entrada.sensor != nullptr)
+            {
+                unsigned j = entrada.hash & mascara;
+                while (nuevaTabla[j].sensor != nullptr)
+                {
+                    j = (j + 1) & mascara;
+                }
+                nuevaTabla[j] = entrada;
+            }
+        }
+
+        delete[] fragmento.tabla;
+        fragmento.tabla = nuevaTabla;
+        fragmento.capacidadTabla = nuevaCapacidad;
+    }
+
+    unsigned mascara = static_cast<unsigned>(fragmento.capacidadTabla - 1);
+    unsigned i = hash & mascara;
+    while (fragmento.tabla[i].sensor != nullptr)
+    {
+        i = (i + 1) & mascara;
+    }
+    fragmento.tabla[i].hash = hash;
+    fragmento.tabla[i].manejador = manejador;
+    fragmento.tabla[i].sensor = sensor;
+    fragmento.numEntradas++;
+}
+
+void ListaGeneral::crecer()
+{
+    int nuevaCapacidad = (capacidad == 0) ? 16 : capacidad * 2;
+    std::atomic<SensorBase *> *nuevosSensores = new std::atomic<SensorBase *>[nuevaCapacidad];
+    const void **nuevosTipos = new const void *[nuevaCapacidad];
+    bool *nuevosModificados = new bool[nuevaCapacidad];
+    long long *nuevasUltimas = new long long[nuevaCapacidad];
+    int *nuevosVivos = new int[nuevaCapacidad];
+    int *nuevosLibres = new int[nuevaCapacidad];
+
+    std::atomic<SensorBase *> *viejosSensores = sensores.load(std::memory_order_relaxed);
+    const void **viejosTipos = tipos.load(std::memory_order_relaxed);
+    int n = numManejadores.load(std::memory_order_relaxed);
+    for (int i = 0; i < n; i++)
+    {
+        nuevosSensores[i].store(viejosSensores[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+        nuevosTipos[i] = viejosTipos[i];
+    }
+    for (int i = n; i < nuevaCapacidad; i++)
+    {
+        nuevosSensores[i].store(nullptr, std::memory_order_relaxed);
+    }
+    for (int v = 0; v < numVivos; v++)
+    {
+        nuevosVivos[v] = vivos[v];
+    }
+    for (int l = 0; l < numLibres; l++)
+    {
+        nuevosLibres[l] = libres[l];
+    }
+    delete[] vivos;
+    delete[] libres;
+    vivos = nuevosVivos;
+    libres = nuevosLibres;
+
+    // Las marcas se escriben con el cerrojo de cada fragmento: se copian con todos tomados
+    for (int f = 0; f < numFragmentos; f++)
+    {
+        bloquear(fragmentos[f]);
+    }
+    for (int i = 0; i < n; i++)
+    {
+        nuevosModificados[i] = modificados[i];
+        nuevasUltimas[i] = ultimaLectura[i];
+    }
+    delete[] modificados;
+    delete[] ultimaLectura;
+    modificados = nuevosModificados;
+    ultimaLectura = nuevasUltimas;
+    for (int f = numFragmentos - 1; f >= 0; f--)
+    {
+        desbloquear(fragmentos[f]);
+    }
+
+    sensores.store(nuevosSensores, std::memory_order_release);
+    tipos.store(nuevosTipos, std::memory_order_release);
+    if (viejosSensores != nullptr)
+    {
+        sensoresRetirados[numRetirados] = viejosSensores;
+        tiposRetirados[numRetirados] = viejosTipos;
+        numRetirados++;
+    }
+    capacidad = nuevaCapacidad;
+}
+
+void ListaGeneral::registrar(SensorBase *sensor, const void *tipo)
+{
+    // Primero los manejadores que dejaron las bajas: la cota no crece con la rotación
+    int limite = numManejadores.load(std::memory_order_relaxed);
+    int n = (numLibres > 0) ? libres[--numLibres] : limite;
+    if (n == capacidad)
+    {
+        crecer();
+    }
+
+    sensores.load(std::memory_order_relaxed)[n].store(sensor, std::memory_order_release);
+    tipos[n] = tipo;
+    modificados[n] = false; // Una baja lo dejó desmarcado; un manejador nuevo, nadie lo marcó aún
+    ultimaLectura[n] = ahoraMs();
+    vivos[numVivos++] = n;
+    sensor->setManejador(n);
+    sensor->setObservador(this);
+    if (silencioso)
+    {
+        sensor->setSilencioso(true);
+    }
+    if (n == limite)
+    {
+        numManejadores.store(n + 1, std::memory_order_release); // obtenerSensor(n) ya es válido
+    }
+
+    if (!silencioso)
+    {
+        std::cout << "[Log] Sensor '" << sensor->getNombre()
+                  << "' insertado en la lista de gestion." << std::endl;
+    }
+
+    if (numObservadores > 0)
+    {
+        pausarAvisos();
+        for (int o = 0; o < numObservadores; o++)
+        {
+            observadores[o]->sensorRegistrado(*sensor, tipo);
+        }
+        reanudarAvisos();
+    }
+
+    // Recién ahora se lo puede encontrar por nombre y recibir lecturas de otros hilos
+    unsigned hash = hashNombre(sensor->getNombre());
+    Fragmento &fragmento = fragmentoDe(hash);
+    bloquear(fragmento);
+    indexar(fragmento, hash, n, sensor);
+    desbloquear(fragmento);
+    marcarModificado(fragmento, *sensor, false); // Un sensor nuevo nunca se procesó
+}
+
+long long ListaGeneral::ahoraMs()
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+bool ListaGeneral::darDeBaja(int manejador, long long vistoAntesDe)
+{
+    SensorBase *sensor = sensorEn(manejador);
+    unsigned hash = hashNombre(sensor->getNombre());
+    Fragmento &fragmento = fragmentoDe(hash);
+
+    // Con los despachos tomados ningún observador está a mitad de un aviso,
+    // y con el cerrojo del fragmento: desde aquí ni se encuentra ni acepta marcas
+    pausarAvisos();
+    bloquear(fragmento);
+    if (ultimaLectura[manejador] >= vistoAntesDe)
+    {
+        desbloquear(fragmento); // Llegó una lectura mientras se barría
+        reanudarAvisos();
+        return false;
+    }
+    desindexar(fragmento, hash, manejador);
+    if (modificados[manejador])
+    {
+        modificados[manejador] = false;
+        int quedan = 0;
+        for (int i = 0; i < fragmento.numModificados; i++)
+        {
+            if (fragmento.modificados[i] != manejador)
+            {
+                fragmento.modificados[quedan++] = fragmento.modificados[i];
+            }
+        }
+        fragmento.numModificados = quedan;
+    }
+    sensores.load(std::memory_order_relaxed)[manejador].store(nullptr, std::memory_order_release);
+    sensor->setManejador(-1);
+    desbloquear(fragmento);
+
+    if (!silencioso)
+    {
+        std::cout << "[Log] Sensor '" << sensor->getNombre() << "' dado de baja (manejador " << manejador
+                  << " libre)." << std::endl;
+    }
+
+    for (int o = 0; o < numObservadores; o++)
+    {
+        observadores[o]->sensorEliminado(*sensor, manejador);
+    }
+    reanudarAvisos();
+
+    Baja *baja = new Baja;
+    baja->lista = this;
+    baja->sensor = sensor;
+    baja->tipo = tipos[manejador];
+    epocas.retirar(baja, liberarBaja);
+    libres[numLibres++] = manejador;
+    bajas++;
+    return true;
+}
+
+void ListaGeneral::compactarVivos()
+{
+    int quedan = 0;
+    for (int v = 0; v < numVivos; v++)
+    {
+        if (sensorEn(vivos[v]) != nullptr)
+        {
+            vivos[quedan++] = vivos[v];
+        }
+    }
+    numVivos = quedan;
+}
+
+void ListaGeneral::liberarBaja(void *objeto)
+{
+    Baja *baja = static_cast<Baja *>(objeto);
+    if (baja->tipo == nullptr)
+    {
+        delete baja->sensor;
     }
     else
     {
-        NodoSensor *actual = cabeza;
-        while (actual->siguiente != nullptr)
+        baja->lista->arena.liberar(baja->sensor, baja->tipo);
+    }
+    delete baja;
+}
+
+bool ListaGeneral::eliminarSensor(const char *nombre)
+{
+    bloquearAlta();
+    epocas.reclamar(); // Las bajas anteriores ya tuvieron su margen
+
+    int manejador = buscarIndice(nombre);
+    bool eliminado = manejador >= 0 && darDeBaja(manejador, LLONG_MAX);
+    if (eliminado)
+    {
+        compactarVivos();
+    }
+    desbloquearAlta();
+    return eliminado;
+}
+
+int ListaGeneral::expirarInactivos(long long ttlMs)
+{
+    if (ttlMs < 0)
+    {
+        return 0;
+    }
+
+    bloquearAlta();
+    epocas.reclamar();
+
+    long long limite = ahoraMs() - ttlMs;
+    int expirados = 0;
+    for (int v = 0; v < numVivos; v++)
+    {
+        // Lectura sin cerrojo como filtro; darDeBaja() lo confirma con el cerrojo tomado
+        int m = vivos[v];
+        if (ultimaLectura[m] < limite && darDeBaja(m, limite))
         {
-            actual = actual->siguiente;
+            expirados++;
         }
-        actual->siguiente = nuevoNodo;
     }
+    if (expirados > 0)
+    {
+        compactarVivos();
+        std::cout << "[Log] " << expirados << " sensor(es) sin lecturas en " << ttlMs
+                  << " ms dados de baja; quedan " << numVivos << "." << std::endl;
+    }
+    desbloquearAlta();
+    return expirados;
+}
 
-    contador++;
-    std::cout << "[Log] Sensor '" << sensor->getNombre()
-              << "' insertado en la lista de gestion." << std::endl;
+int ListaGeneral::reclamarEliminados()
+{
+    bloquearAlta();
+    int liberados = epocas.reclamar();
+    desbloquearAlta();
+    return liberados;
 }
 
-SensorBase *ListaGeneral::buscarSensor(const char *nombre) const
+int ListaGeneral::getBajasPendientes() const
+{
+    return epocas.getPendientes();
+}
+
+int ListaGeneral::registrarLector()
+{
+    return epocas.registrarLector();
+}
+
+void ListaGeneral::liberarLector(int ranura)
+{
+    epocas.liberarLector(ranura);
+}
+
+bool ListaGeneral::admiteSensorNuevo(const char *nombre) const
+{
+    bool admite = true;
+    pausarAvisos();
+    for (int o = 0; o < numObservadores && admite; o++)
+    {
+        admite = observadores[o]->admiteSensorNuevo(nombre);
+    }
+    reanudarAvisos();
+    return admite;
+}
+
+bool ListaGeneral::agregarObservador(ObservadorLecturas *observador)
+{
+    if (observador == nullptr || numObservadores == MAX_OBSERVADORES)
+    {
+        return false;
+    }
+
+    pausarAvisos();
+    observadores[numObservadores++] = observador;
+
+    for (int v = 0; v < numVivos; v++)
+    {
+        observador->sensorRegistrado(*sensorEn(vivos[v]), tipos[vivos[v]]);
+    }
+    reanudarAvisos();
+    return true;
+}
+
+void ListaGeneral::setSilencioso(bool activo)
 {
-    NodoSensor *actual = cabeza;
+    silencioso = activo;
+    for (int v = 0; v < numVivos; v++)
+    {
+        sensorEn(vivos[v])->setSilencioso(activo);
+    }
+}
+
+bool ListaGeneral::marcarModificado(Fragmento &fragmento, const SensorBase &sensor, bool lectura)
+{
+    long long ahora = lectura ? ahoraMs() : 0;
+
+    bloquear(fragmento);
+    int indice = sensor.getManejador(); // -1 desde la baja, que se hace con este mismo cerrojo
+    if (indice < 0)
+    {
+        desbloquear(fragmento);
+        return false;
+    }
+    if (lectura)
+    {
+        ultimaLectura[indice] = ahora;
+    }
+    if (!modificados[indice])
+    {
+        modificados[indice] = true;
+        if (fragmento.numModificados == fragmento.capacidadModificados)
+        {
+            int nuevaCapacidad = (fragmento.capacidadModificados == 0) ? 16 : fragmento.capacidadModificados * 2;
+            int *nuevos = new int[nuevaCapacidad];
+            for (int i = 0; i < fragmento.numModificados; i++)
+            {
+                nuevos[i] = fragmento.modificados[i];
+            }
+            delete[] fragmento.modificados;
+            fragmento.modificados = nuevos;
+            fragmento.capacidadModificados = nuevaCapacidad;
+        }
+        fragmento.modificados[fragmento.numModificados++] = indice;
+    }
+    desbloquear(fragmento);
+    return true;
+}
 
-    while (actual != nullptr)
+void ListaGeneral::limpiarModificados()
+{
+    for (int f = 0; f < numFragmentos; f++)
     {
-        if (std::strcmp(actual->sensor->getNombre(), nombre) == 0)
+        Fragmento &fragmento = fragmentos[f];
+        bloquear(fragmento);
+        for (int i = 0; i < fragmento.numModificados; i++)
         {
-            return actual->sensor;
+            modificados[fragmento.modificados[i]] = false;
         }
-        actual = actual->siguiente;
+        fragmento.numModificados = 0;
+        desbloquear(fragmento);
+    }
+}
+
+void ListaGeneral::notificarProcesado(int indice)
+{
+    if (numObservadores == 0)
+    {
+        return;
+    }
+
+    SensorBase *sensor = sensorEn(indice);
+    Fragmento &fragmento = fragmentoDe(hashNombre(sensor->getNombre()));
+    std::lock_guard<std::recursive_mutex> guardia(fragmento.despacho);
+    for (int o = 0; o < numObservadores; o++)
+    {
+        observadores[o]->historialModificado(*sensor);
+    }
+}
+
+void ListaGeneral::lecturaRegistrada(SensorBase &sensor, double valor)
+{
+    TramoTraza tramo(ETAPA_DESPACHO);
+    Fragmento &fragmento = fragmentoDe(hashNombre(sensor.getNombre()));
+    if (numObservadores == 0)
+    {
+        marcarModificado(fragmento, sensor, true);
+        return;
+    }
+
+    // Marca y aviso con el despacho del fragmento: una baja avisa antes o después, nunca en medio
+    std::lock_guard<std::recursive_mutex> guardia(fragmento.despacho);
+    if (!marcarModificado(fragmento, sensor, true))
+    {
+        return; // Lectura tardía de un sensor dado de baja
+    }
+    for (int o = 0; o < numObservadores; o++)
+    {
+        observadores[o]->lecturaRegistrada(sensor, valor);
+    }
+}
+
+void ListaGeneral::bloqueRegistrado(SensorBase &sensor, const int *cuentas, int cantidad)
+{
+    TramoTraza tramo(ETAPA_DESPACHO);
+    Fragmento &fragmento = fragmentoDe(hashNombre(sensor.getNombre()));
+    if (numObservadores == 0)
+    {
+        marcarModificado(fragmento, sensor, true);
+        return;
     }
 
-    return nullptr; // No encontrado
+    std::lock_guard<std::recursive_mutex> guardia(fragmento.despacho);
+    if (!marcarModificado(fragmento, sensor, true))
+    {
+        return;
+    }
+    for (int o = 0; o < numObservadores; o++)
+    {
+        observadores[o]->bloqueRegistrado(sensor, cuentas, cantidad);
+    }
+}
+
+void ListaGeneral::historialModificado(SensorBase &sensor)
+{
+    Fragmento &fragmento = fragmentoDe(hashNombre(sensor.getNombre()));
+    if (numObservadores == 0)
+    {
+        marcarModificado(fragmento, sensor, false);
+        return;
+    }
+
+    std::lock_guard<std::recursive_mutex> guardia(fragmento.despacho);
+    if (!marcarModificado(fragmento, sensor, false))
+    {
+        return;
+    }
+    for (int o = 0; o < numObservadores; o++)
+    {
+        observadores[o]->historialModificado(sensor);
+    }
+}
+
+void ListaGeneral::insertarSensor(SensorBase *sensor)
+{
+    if (sensor == nullptr)
+    {
+        return;
+    }
+    bloquearAlta();
+    registrar(sensor, nullptr);
+    desbloquearAlta();
+}
+
+int ListaGeneral::buscarIndice(const char *nombre) const
+{
+    unsigned hash = hashNombre(nombre);
+    Fragmento &fragmento = fragmentoDe(hash);
+
+    bloquear(fragmento);
+    const EntradaIndice *entrada = buscarEntrada(fragmento, hash, nombre);
+    int indice = (entrada != nullptr) ? entrada->manejador : -1; // -1: no encontrado
+    desbloquear(fragmento);
+    return indice;
+}
+
+SensorBase *ListaGeneral::buscarSensor(const char *nombre) const
+{
+    unsigned hash = hashNombre(nombre);
+    Fragmento &fragmento = fragmentoDe(hash);
+
+    bloquear(fragmento);
+    const EntradaIndice *entrada = buscarEntrada(fragmento, hash, nombre);
+    SensorBase *sensor = (entrada != nullptr) ? entrada->sensor : nullptr;
+    desbloquear(fragmento);
+    return sensor;
+}
+
+SensorBase *ListaGeneral::obtenerSensor(int indice) const
+{
+    if (indice < 0 || indice >= numManejadores)
+    {
+        return nullptr;
+    }
+    return sensorEn(indice);
+}
+
+SensorBase *ListaGeneral::obtenerVivo(int posicion) const
+{
+    if (posicion < 0 || posicion >= numVivos)
+    {
+        return nullptr;
+    }
+    return sensorEn(vivos[posicion]);
+}
+
+long long ListaGeneral::getUltimaLectura(int indice) const
+{
+    SensorBase *sensor = (indice >= 0 && indice < numManejadores) ? sensorEn(indice) : nullptr;
+    if (sensor == nullptr)
+    {
+        return -1;
+    }
+
+    Fragmento &fragmento = fragmentoDe(hashNombre(sensor->getNombre()));
+    bloquear(fragmento);
+    long long ultima = ultimaLectura[indice];
+    desbloquear(fragmento);
+    return ultima;
 }
 
 void ListaGeneral::procesarTodosSensores()
 {
     std::cout << "\n--- Ejecutando Polimorfismo ---" << std::endl;
 
-    NodoSensor *actual = cabeza;
+    for (int v = 0; v < numVivos; v++)
+    {
+        int i = vivos[v];
+        {
+            MuestraTraza muestra(ETAPA_PROCESO);
+            sensorEn(i)->procesarLectura(); // Llamada polimórfica
+        }
+        notificarProcesado(i);
+    }
+    limpiarModificados();
+}
+
+void ListaGeneral::procesarPorLotes()
+{
+    if (!silencioso)
+    {
+        std::cout << "\n--- Procesamiento por Lotes (por tipo) ---" << std::endl;
+    }
+
+    // Camino rápido: un bucle monomórfico por cada tipo registrado
+    int procesados = TiposRegistrados::procesar(arena);
 
-    while (actual != nullptr)
+    // Resto: sensores externos o de tipos no registrados (llamada virtual)
+    for (int v = 0; v < numVivos; v++)
     {
-        actual->sensor->procesarLectura(); // Llamada polimórfica
-        actual = actual->siguiente;
+        int i = vivos[v];
+        if (tipos[i] == nullptr || !TiposRegistrados::contieneTipo(tipos[i]))
+        {
+            MuestraTraza muestra(ETAPA_PROCESO);
+            sensorEn(i)->procesarLectura();
+            procesados++;
+        }
+    }
+
+    for (int v = 0; v < numVivos; v++)
+    {
+        notificarProcesado(vivos[v]);
+    }
+    limpiarModificados();
+
+    if (!silencioso)
+    {
+        std::cout << "\n[Lotes] " << procesados << " sensor(es) procesados en "
+                  << TiposRegistrados::cantidad << " lote(s) tipados." << std::endl;
+    }
+}
+
+int ListaGeneral::procesarModificados()
+{
+    std::cout << "\n--- Procesamiento Incremental ---" << std::endl;
+
+    int procesados = procesarSensores(listaModificados, juntarModificados());
+
+    std::cout << "\n[Incremental] " << procesados << " de " << numVivos << " sensor(es) procesados; "
+              << (numVivos - procesados) << " sin cambios conservan su resultado." << std::endl;
+    return procesados;
+}
+
+int ListaGeneral::procesarSensores(const int *manejadores, int cantidad)
+{
+    int procesados = 0;
+    for (int i = 0; i < cantidad; i++)
+    {
+        int m = manejadores[i];
+        if (m < 0 || m >= numManejadores || sensorEn(m) == nullptr)
+        {
+            continue;
+        }
+        {
+            MuestraTraza muestra(ETAPA_PROCESO);
+            sensorEn(m)->procesarLectura();
+        }
+
+        Fragmento &fragmento = fragmentoDe(hashNombre(sensorEn(m)->getNombre()));
+        bloquear(fragmento);
+        modificados[m] = false;
+        desbloquear(fragmento);
+        notificarProcesado(m);
+        procesados++;
+    }
+
+    // Compactar cada fragmento: quedan los que siguen marcados, una vez cada uno
+    // (un sensor desmarcado y vuelto a marcar aparece dos veces en su lista)
+    for (int f = 0; f < numFragmentos; f++)
+    {
+        Fragmento &fragmento = fragmentos[f];
+        bloquear(fragmento);
+        int quedan = 0;
+        for (int i = 0; i < fragmento.numModificados; i++)
+        {
+            int m = fragmento.modificados[i];
+            if (modificados[m])
+            {
+                modificados[m] = false; // Se restaura abajo; evita repetirlo
+                fragmento.modificados[quedan++] = m;
+            }
+        }
+        for (int i = 0; i < quedan; i++)
+        {
+            modificados[fragmento.modificados[i]] = true;
+        }
+        fragmento.numModificados = quedan;
+        desbloquear(fragmento);
+    }
+    return procesados;
+}
+
+int ListaGeneral::juntarModificados()
+{
+    int juntados = 0;
+    for (int f = 0; f < numFragmentos; f++)
+    {
+        Fragmento &fragmento = fragmentos[f];
+        bloquear(fragmento);
+        if (juntados + fragmento.numModificados > capacidadLista)
+        {
+            int nuevaCapacidad = (capacidadLista == 0) ? 16 : capacidadLista;
+            while (nuevaCapacidad < juntados + fragmento.numModificados)
+            {
+                nuevaCapacidad *= 2;
+            }
+            int *nuevaLista = new int[nuevaCapacidad];
+            for (int i = 0; i < juntados; i++)
+            {
+                nuevaLista[i] = listaModificados[i];
+            }
+            delete[] listaModificados;
+            listaModificados = nuevaLista;
+            capacidadLista = nuevaCapacidad;
+        }
+        for (int i = 0; i < fragmento.numModificados; i++)
+        {
+            listaModificados[juntados++] = fragmento.modificados[i];
+        }
+        desbloquear(fragmento);
+    }
+
+    // Orden de manejadores: no depende de qué hilo marcó primero
+    std::sort(listaModificados, listaModificados + juntados);
+    return juntados;
+}
+
+const int *ListaGeneral::getModificados()
+{
+    juntarModificados();
+    return listaModificados;
+}
+
+int ListaGeneral::getNumModificados() const
+{
+    int total = 0;
+    for (int f = 0; f < numFragmentos; f++)
+    {
+        bloquear(fragmentos[f]);
+        total += fragmentos[f].numModificados;
+        desbloquear(fragmentos[f]);
+    }
+    return total;
+}
+
+void ListaGeneral::imprimirResultados() const
+{
+    std::cout << "\n--- Ultimo Resultado por Sensor ---" << std::endl;
+
+    for (int v = 0; v < numVivos; v++)
+    {
+        int i = vivos[v];
+        const ResultadoProceso &r = sensorEn(i)->getResultado();
+        std::cout << sensorEn(i)->getNombre() << " (" << sensorEn(i)->getTipo() << "): ";
+        if (r.valido)
+        {
+            std::cout << "valor " << r.valor << ", dispersion " << r.dispersion
+                      << " sobre " << r.lecturas << " lectura(s)";
+        }
+        else
+        {
+            std::cout << "sin resultado";
+        }
+        Fragmento &fragmento = fragmentoDe(hashNombre(sensorEn(i)->getNombre()));
+        bloquear(fragmento);
+        bool pendiente = modificados[i];
+        desbloquear(fragmento);
+        std::cout << (pendiente ? " [modificado, pendiente de procesar]" : "") << std::endl;
     }
 }
 
 void ListaGeneral::imprimirTodosSensores() const
 {
-    std::cout << "\n--- Lista de Sensores Registrados ---" << std::endl;
-    std::cout << "Total de sensores: " << contador << std::endl;
+    EscritorReporte &salida = EscritorReporte::salidaEstandar();
+    escribirReporte(salida, REPORTE_TEXTO, 0);
+    salida.vaciar();
+}
 
-    NodoSensor *actual = cabeza;
-    int index = 1;
+void ListaGeneral::escribirReporte(EscritorReporte &escritor, FormatoReporte formato, int limite) const
+{
+    if (formato == REPORTE_TEXTO)
+    {
+        escritor << "\n--- Lista de Sensores Registrados ---\n"
+                 << "Total de sensores: " << numVivos << '\n';
+    }
+    else if (formato == REPORTE_CSV)
+    {
+        escritor << "sensor,tipo,indice,valor\n";
+    }
+
+    for (int v = 0; v < numVivos; v++)
+    {
+        if (formato == REPORTE_TEXTO)
+        {
+            escritor << "\n[" << (v + 1) << "] ";
+        }
+        sensorEn(vivos[v])->escribirReporte(escritor, formato, limite);
+    }
+}
 
-    while (actual != nullptr)
+int ListaGeneral::vaciarReordenamientos()
+{
+    int registradas = 0;
+    for (int v = 0; v < numVivos; v++)
     {
-        std::cout << "\n[" << index << "] ";
-        actual->sensor->imprimirInfo();
-        actual = actual->siguiente;
-        index++;
+        registradas += sensorEn(vivos[v])->vaciarReordenamiento();
     }
+    return registradas;
+}
+
+void ListaGeneral::imprimirReordenamiento() const
+{
+    std::cout << "\n--- Secuencias por Sensor ---" << std::endl;
+
+    int numerados = 0;
+    for (int v = 0; v < numVivos; v++)
+    {
+        int i = vivos[v];
+        const BufferReordenamiento *reorden = sensorEn(i)->getReordenamiento();
+        if (reorden == nullptr)
+        {
+            continue;
+        }
+
+        std::cout << sensorEn(i)->getNombre() << ": siguiente #" << reorden->getSiguiente()
+                  << " | en orden " << reorden->getEnOrden()
+                  << " | reordenadas " << reorden->getReordenadas()
+                  << " | duplicadas " << reorden->getDuplicadas()
+                  << " | tardias " << reorden->getTardias()
+                  << " | huecos " << reorden->getHuecos()
+                  << " | en espera " << reorden->getPendientes();
+        if (reorden->getReinicios() > 0)
+        {
+            std::cout << " | reinicios " << reorden->getReinicios();
+        }
+        std::cout << std::endl;
+        numerados++;
+    }
+
+    if (numerados == 0)
+    {
+        std::cout << "Ningun sensor recibio lecturas numeradas (TIPO:ID:VALOR:SECUENCIA)." << std::endl;
+    }
+}
+
+int ListaGeneral::getNumFragmentos() const
+{
+    return numFragmentos;
+}
+
+void ListaGeneral::imprimirFragmentos() const
+{
+    std::cout << "\n--- Fragmentos del Registro ---" << std::endl;
+
+    int minimo = numVivos;
+    int maximo = 0;
+    for (int f = 0; f < numFragmentos; f++)
+    {
+        bloquear(fragmentos[f]);
+        int sensoresFragmento = fragmentos[f].numEntradas;
+        int modificadosFragmento = fragmentos[f].numModificados;
+        int casillas = fragmentos[f].capacidadTabla;
+        desbloquear(fragmentos[f]);
+
+        std::cout << "Fragmento " << f << ": " << sensoresFragmento << " sensor(es), " << modificadosFragmento
+                  << " modificado(s), " << casillas << " casilla(s)" << std::endl;
+        minimo = (sensoresFragmento < minimo) ? sensoresFragmento : minimo;
+        maximo = (sensoresFragmento > maximo) ? sensoresFragmento : maximo;
+    }
+    std::cout << numFragmentos << " fragmento(s) para " << numVivos << " sensor(es); entre " << minimo
+              << " y " << maximo << " por fragmento." << std::endl;
 }
 
 int ListaGeneral::getContador() const
 {
-    return contador;
-}
\ No newline at end of file
+    return numVivos;
+}
+
+int ListaGeneral::getNumManejadores() const
+{
+    return numManejadores;
+}
+
+void ListaGeneral::imprimirBajas() const
+{
+    std::cout << "\n--- Bajas del Registro ---" << std::endl;
+    std::cout << "Sensores vivos: " << numVivos << " | Manejadores asignados: " << numManejadores
+              << " (" << numLibres << " libre(s) para reutilizar)" << std::endl;
+    std::cout << "Bajas: " << bajas << " | Pendientes de liberar: " << epocas.getPendientes()
+              << " | Liberadas: " << epocas.getLiberados() << std::endl;
+    std::cout << "Arena: " << arena.getNumObjetos() << " objeto(s) en " << arena.getBytesReservados()
+              << " bytes de slabs" << std::endl;
+}
+
+LectorRegistro::LectorRegistro(ListaGeneral &registro, int ranuraLector) : lista(registro), ranura(ranuraLector)
+{
+    lista.epocas.fijar(ranura);
+}
+
+LectorRegistro::~LectorRegistro()
+{
+    lista.epocas.soltar(ranura);
+}
@@ -0,0 +1,421 @@
+/**
+ * @file MotorAlertas.cpp
+ * @brief Implementación del motor de reglas de alerta
+ * @author FabiRamiro
+ * @date 2026-10-18
+ */
+
+#include "MotorAlertas.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <thread>
+
+namespace
+{
+    const char *nombreRegla(int tipoRegla)
+    {
+        switch (tipoRegla)
+        {
+        case REGLA_MAXIMO:
+            return "maximo";
+        case REGLA_MINIMO:
+            return "minimo";
+        default:
+            return "tasa";
+        }
+    }
+
+    long long ahoraNs()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch())
+            .count();
+    }
+}
+
+MotorAlertas::MotorAlertas()
+    : reglas(nullptr), numReglas(0), capacidadReglas(0),
+      tabla(nullptr), numPredicados(0), numHuecos(0), capacidadTabla(0),
+      sensores(nullptr), tipos(nullptr), inicio(nullptr), cantidad(nullptr),
+      ultimo(nullptr), tieneUltimo(nullptr), evaluadas(nullptr), numSensores(0), capacidadSensores(0),
+      productorOcupado(false), evaluacionesRetiradas(0), disparos(0)
+{
+}
+
+MotorAlertas::~MotorAlertas()
+{
+    delete[] reglas;
+    delete[] tabla;
+    delete[] sensores;
+    delete[] tipos;
+    delete[] inicio;
+    delete[] cantidad;
+    delete[] ultimo;
+    delete[] tieneUltimo;
+    delete[] evaluadas;
+}
+
+int MotorAlertas::agregarReglaSensor(const char *nombreSensor, TipoRegla tipoRegla,
+                                     float umbral, float histeresis)
+{
+    return agregarRegla(nombreSensor, nullptr, tipoRegla, umbral, histeresis);
+}
+
+int MotorAlertas::agregarRegla(const char *nombreSensor, const void *tipo, TipoRegla tipoRegla,
+                               float umbral, float histeresis)
+{
+    if (numReglas == capacidadReglas)
+    {
+        int nuevaCapacidad = (capacidadReglas == 0) ? 8 : capacidadReglas * 2;
+        Regla *nuevas = new Regla[nuevaCapacidad];
+        for (int i = 0; i < numReglas; i++)
+        {
+            nuevas[i] = reglas[i];
+        }
+        delete[] reglas;
+        reglas = nuevas;
+        capacidadReglas = nuevaCapacidad;
+    }
+
+    Regla &regla = reglas[numReglas];
+    std::strncpy(regla.sensor, nombreSensor != nullptr ? nombreSensor : "", 49);
+    regla.sensor[49] = '\0';
+    regla.tipo = tipo;
+    regla.tipoRegla = tipoRegla;
+    regla.umbral = umbral;
+    regla.histeresis = histeresis < 0.0f ? 0.0f : histeresis;
+
+    std::cout << "[Alertas] Regla #" << numReglas << " (" << nombreRegla(tipoRegla)
+              << ", umbral " << umbral << ", histeresis " << regla.histeresis << ") agregada para "
+              << (tipo != nullptr ? "un tipo de sensor" : regla.sensor) << "." << std::endl;
+
+    numReglas++;
+    recompilar();
+    return numReglas - 1;
+}
+
+void MotorAlertas::recompilar()
+{
+    numPredicados = 0;
+    numHuecos = 0;
+    for (int m = 0; m < numSensores; m++)
+    {
+        compilarSensor(m);
+    }
+}
+
+void MotorAlertas::compilarSensor(int manejador)
+{
+    inicio[manejador] = numPredicados;
+    cantidad[manejador] = 0;
+
+    SensorBase *sensor = sensores[manejador];
+    if (sensor == nullptr)
+    {
+        return;
+    }
+
+    for (int r = 0; r < numReglas; r++)
+    {
+        const Regla &regla = reglas[r];
+        bool aplica = (regla.tipo != nullptr) ? (regla.tipo == tipos[manejador])
+                                              : (std::strcmp(regla.sensor, sensor->getNombre()) == 0);
+        if (!aplica)
+        {
+            continue;
+        }
+
+        if (numPredicados == capacidadTabla)
+        {
+            int nuevaCapacidad = (capacidadTabla == 0) ? 64 : capacidadTabla * 2;
+            Predicado *nueva = new Predicado[nuevaCapacidad];
+            for (int i = 0; i < numPredicados; i++)
+            {
+                nueva[i] = tabla[i];
+            }
+            delete[] tabla;
+            tabla = nueva;
+            capacidadTabla = nuevaCapacidad;
+        }
+
+        Predicado &p = tabla[numPredicados++];
+        p.umbral = regla.umbral;
+        p.histeresis = regla.histeresis;
+        p.idRegla = static_cast<unsigned short>(r);
+        p.tipoRegla = static_cast<unsigned char>(regla.tipoRegla);
+        p.activa = 0;
+        cantidad[manejador]++;
+    }
+}
+
+void MotorAlertas::sensorRegistrado(SensorBase &sensor, const void *tipo)
+{
+    int manejador = sensor.getManejador();
+    if (manejador < 0)
+    {
+        return;
+    }
+
+    if (manejador >= capacidadSensores)
+    {
+        int nuevaCapacidad = (capacidadSensores == 0) ? 16 : capacidadSensores;
+        while (nuevaCapacidad <= manejador)
+        {
+            nuevaCapacidad *= 2;
+        }
+
+        SensorBase **nuevosSensores = new SensorBase *[nuevaCapacidad];
+        const void **nuevosTipos = new const void *[nuevaCapacidad];
+        int *nuevosInicio = new int[nuevaCapacidad];
+        int *nuevasCantidades = new int[nuevaCapacidad];
+        float *nuevosUltimos = new float[nuevaCapacidad];
+        bool *nuevosTieneUltimo = new bool[nuevaCapacidad];
+        unsigned long *nuevasEvaluadas = new unsigned long[nuevaCapacidad];
+
+        for (int i = 0; i < nuevaCapacidad; i++)
+        {
+            bool existe = i < numSensores;
+            nuevosSensores[i] = existe ? sensores[i] : nullptr;
+            nuevosTipos[i] = existe ? tipos[i] : nullptr;
+            nuevosInicio[i] = existe ? inicio[i] : 0;
+            nuevasCantidades[i] = existe ? cantidad[i] : 0;
+            nuevosUltimos[i] = existe ? ultimo[i] : 0.0f;
+            nuevosTieneUltimo[i] = existe ? tieneUltimo[i] : false;
+            nuevasEvaluadas[i] = existe ? evaluadas[i] : 0;
+        }
+
+        delete[] sensores;
+        delete[] tipos;
+        delete[] inicio;
+        delete[] cantidad;
+        delete[] ultimo;
+        delete[] tieneUltimo;
+        delete[] evaluadas;
+        sensores = nuevosSensores;
+        tipos = nuevosTipos;
+        inicio = nuevosInicio;
+        cantidad = nuevasCantidades;
+        ultimo = nuevosUltimos;
+        tieneUltimo = nuevosTieneUltimo;
+        evaluadas = nuevasEvaluadas;
+        capacidadSensores = nuevaCapacidad;
+    }
+
+    for (int i = numSensores; i <= manejador; i++)
+    {
+        sensores[i] = nullptr;
+        cantidad[i] = 0;
+    }
+    if (manejador >= numSensores)
+    {
+        numSensores = manejador + 1;
+    }
+
+    sensores[manejador] = &sensor;
+    tipos[manejador] = tipo;
+    tieneUltimo[manejador] = false;
+
+    // El tramo del sensor nuevo se agrega al final de la tabla
+    compilarSensor(manejador);
+}
+
+void MotorAlertas::sensorEliminado(SensorBase &sensor, int manejador)
+{
+    if (manejador < 0 || manejador >= numSensores || sensores[manejador] != &sensor)
+    {
+        return;
+    }
+
+    sensores[manejador] = nullptr;
+    tieneUltimo[manejador] = false;
+    evaluacionesRetiradas += evaluadas[manejador];
+    evaluadas[manejador] = 0;
+    numHuecos += cantidad[manejador];
+    cantidad[manejador] = 0;
+
+    if (numHuecos * 2 > numPredicados)
+    {
+        compactarTabla();
+    }
+}
+
+void MotorAlertas::compactarTabla()
+{
+    // Los tramos no están en orden de manejador: se ordenan los vivos por inicio
+    int *orden = new int[numSensores > 0 ? numSensores : 1];
+    int vivos = 0;
+    for (int m = 0; m < numSensores; m++)
+    {
+        if (cantidad[m] > 0)
+        {
+            orden[vivos++] = m;
+        }
+    }
+    std::sort(orden, orden + vivos, [this](int a, int b)
+              { return inicio[a] < inicio[b]; });
+
+    // Cada tramo se mueve hacia atrás: nunca pisa uno que falte mover
+    int destino = 0;
+    for (int i = 0; i < vivos; i++)
+    {
+        int m = orden[i];
+        for (int k = 0; k < cantidad[m]; k++)
+        {
+            tabla[destino + k] = tabla[inicio[m] + k];
+        }
+        inicio[m] = destino;
+        destino += cantidad[m];
+    }
+    numPredicados = destino;
+    numHuecos = 0;
+    delete[] orden;
+}
+
+void MotorAlertas::evaluar(SensorBase &sensor, int manejador, float valor, float cambio, bool hayCambio)
+{
+    evaluadas[manejador]++;
+
+    Predicado *p = tabla + inicio[manejador];
+    Predicado *fin = p + cantidad[manejador];
+
+    for (; p != fin; ++p)
+    {
+        float medida = valor;
+        bool disparo;
+        bool rearme;
+
+        switch (p->tipoRegla)
+        {
+        case REGLA_MAXIMO:
+            disparo = medida > p->umbral;
+            rearme = medida < p->umbral - p->histeresis;
+            break;
+        case REGLA_MINIMO:
+            disparo = medida < p->umbral;
+            rearme = medida > p->umbral + p->histeresis;
+            break;
+        default:
+            medida = cambio;
+            disparo = hayCambio && cambio > p->umbral;
+            rearme = hayCambio && cambio < p->umbral - p->histeresis;
+            break;
+        }
+
+        if (!p->activa && disparo)
+        {
+            p->activa = 1;
+            disparos.fetch_add(1, std::memory_order_relaxed);
+
+            Alerta alerta;
+            std::strncpy(alerta.sensor, sensor.getNombre(), 49);
+            alerta.sensor[49] = '\0';
+            alerta.manejador = manejador;
+            alerta.idRegla = p->idRegla;
+            alerta.tipoRegla = p->tipoRegla;
+            alerta.valor = medida;
+            alerta.umbral = p->umbral;
+            alerta.marcaNs = ahoraNs();
+
+            // La cola es de un solo productor: los fragmentos que disparan a la vez se turnan
+            while (productorOcupado.exchange(true, std::memory_order_acquire))
+            {
+                std::this_thread::yield();
+            }
+            cola.insertar(alerta);
+            productorOcupado.store(false, std::memory_order_release);
+        }
+        else if (p->activa && rearme)
+        {
+            p->activa = 0;
+        }
+    }
+}
+
+void MotorAlertas::lecturaRegistrada(SensorBase &sensor, double valor)
+{
+    int manejador = sensor.getManejador();
+    if (manejador < 0 || manejador >= numSensores || sensores[manejador] != &sensor)
+    {
+        return;
+    }
+
+    float v = static_cast<float>(valor);
+    bool hayCambio = tieneUltimo[manejador];
+    float cambio = hayCambio ? std::fabs(v - ultimo[manejador]) : 0.0f;
+
+    if (cantidad[manejador] > 0)
+    {
+        evaluar(sensor, manejador, v, cambio, hayCambio);
+    }
+
+    ultimo[manejador] = v;
+    tieneUltimo[manejador] = true;
+}
+
+void MotorAlertas::bloqueRegistrado(SensorBase &sensor, const int *cuentas, int cantidadMuestras)
+{
+    if (cantidadMuestras <= 0)
+    {
+        return;
+    }
+
+    // Para bloques de alta frecuencia se evalúa el pico absoluto del bloque
+    int pico = 0;
+    for (int i = 0; i < cantidadMuestras; i++)
+    {
+        int a = cuentas[i] < 0 ? -cuentas[i] : cuentas[i];
+        pico = a > pico ? a : pico;
+    }
+
+    lecturaRegistrada(sensor, pico);
+}
+
+bool MotorAlertas::extraerAlerta(Alerta &alerta)
+{
+    return cola.extraer(alerta);
+}
+
+int MotorAlertas::imprimirAlertas()
+{
+    int impresas = 0;
+    Alerta alerta;
+
+    while (cola.extraer(alerta))
+    {
+        const char *comparacion = (alerta.tipoRegla == REGLA_MINIMO) ? " < " : " > ";
+        std::cout << "[ALERTA] " << alerta.sensor << ": "
+                  << (alerta.tipoRegla == REGLA_TASA ? "cambio " : "valor ")
+                  << alerta.valor << comparacion << alerta.umbral
+                  << " (regla #" << alerta.idRegla << ", " << nombreRegla(alerta.tipoRegla) << ")"
+                  << std::endl;
+        impresas++;
+    }
+
+    return impresas;
+}
+
+void MotorAlertas::imprimirReglas() const
+{
+    std::cout << "\n--- Reglas de Alerta (" << numReglas << ") ---" << std::endl;
+
+    for (int r = 0; r < numReglas; r++)
+    {
+        std::cout << "#" << r << " " << nombreRegla(reglas[r].tipoRegla)
+                  << " | umbral " << reglas[r].umbral
+                  << " | histeresis " << reglas[r].histeresis
+                  << " | " << (reglas[r].tipo != nullptr ? "por tipo" : reglas[r].sensor) << std::endl;
+    }
+
+    unsigned long evaluaciones = evaluacionesRetiradas;
+    for (int m = 0; m < numSensores; m++)
+    {
+        evaluaciones += evaluadas[m];
+    }
+
+    std::cout << "Predicados compilados: " << numPredicados
+              << " | Lecturas evaluadas: " << evaluaciones
+              << " | Alertas: " << disparos.load(std::memory_order_relaxed)
+              << " | Descartadas (cola llena): " << cola.getDescartados() << std::endl;
+}
@@ -0,0 +1,769 @@
+/**
+ * @file MotorCorrelacion.cpp
+ * @brief Implementación de las ventanas de covarianza y del motor de correlación
+ * @author FabiRamiro
+ * @date 2026-10-18
+ */
+
+#include "MotorCorrelacion.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <iomanip>
+#include <limits>
+#include <thread>
+
+namespace
+{
+    const double HISTERESIS_ACOPLE = 0.05; ///< Un par acoplado se rearma bajo umbral - histéresis
+
+    const double SIN_DATOS = std::numeric_limits<double>::quiet_NaN();
+
+    /**
+     * @brief Producto punto con cuatro acumuladores (kernel vectorizable)
+     *
+     * n debe ser múltiplo de 4. Los acumuladores independientes permiten
+     * vectorizar sin reasociar sumas de punto flotante y cortan la cadena
+     * de dependencias de una sola suma.
+     */
+    double productoPunto(const double *__restrict a, const double *__restrict b, int n)
+    {
+        double s0 = 0.0, s1 = 0.0, s2 = 0.0, s3 = 0.0;
+        for (int i = 0; i < n; i += 4)
+        {
+            s0 += a[i] * b[i];
+            s1 += a[i + 1] * b[i + 1];
+            s2 += a[i + 2] * b[i + 2];
+            s3 += a[i + 3] * b[i + 3];
+        }
+        return (s0 + s1) + (s2 + s3);
+    }
+
+    /**
+     * @brief Centra y normaliza una serie: fila = (v - media) / ||v - media|| (kernel vectorizable)
+     * @return false si la serie es constante (correlación indefinida)
+     */
+    bool estandarizar(const double *__restrict v, double *__restrict fila, int n)
+    {
+        double suma = 0.0;
+        for (int i = 0; i < n; i++)
+        {
+            suma += v[i];
+        }
+        double media = suma / n;
+
+        double cuadrados = 0.0;
+        for (int i = 0; i < n; i++)
+        {
+            double d = v[i] - media;
+            cuadrados += d * d;
+        }
+        if (!(cuadrados > 0.0))
+        {
+            return false;
+        }
+
+        double escala = 1.0 / std::sqrt(cuadrados);
+        for (int i = 0; i < n; i++)
+        {
+            fila[i] = (v[i] - media) * escala;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Correlaciona las filas primera, primera + salto... con las siguientes (triángulo superior)
+     *
+     * Cada hilo escribe solo las filas que le tocan; repartirlas
+     * intercaladas equilibra el triángulo (las primeras tienen más pares).
+     */
+    void correlacionarFilas(const double *filas, const bool *validas, int n, int paso,
+                            double *matriz, int primera, int salto)
+    {
+        for (int i = primera; i < n; i += salto)
+        {
+            double *salida = matriz + static_cast<std::size_t>(i) * n;
+            salida[i] = validas[i] ? 1.0 : SIN_DATOS;
+            if (!validas[i])
+            {
+                for (int j = i + 1; j < n; j++)
+                {
+                    salida[j] = SIN_DATOS;
+                }
+                continue;
+            }
+
+            const double *fi = filas + static_cast<std::size_t>(i) * paso;
+            for (int j = i + 1; j < n; j++)
+            {
+                if (!validas[j])
+                {
+                    salida[j] = SIN_DATOS;
+                    continue;
+                }
+                double r = productoPunto(fi, filas + static_cast<std::size_t>(j) * paso, paso);
+                salida[j] = (r > 1.0) ? 1.0 : ((r < -1.0) ? -1.0 : r);
+            }
+        }
+    }
+
+    /**
+     * @brief Par de la matriz para el reporte
+     */
+    struct ParMatriz
+    {
+        int i;
+        int j;
+        double r;
+    };
+
+    bool masCorrelacionado(const ParMatriz &a, const ParMatriz &b)
+    {
+        return std::fabs(a.r) > std::fabs(b.r);
+    }
+}
+
+VentanaCovarianza::VentanaCovarianza(int ventana)
+    : x(nullptr), y(nullptr), capacidad(ventana < 2 ? 2 : ventana), cantidad(0), inicio(0),
+      desdeRecalculo(0), mediaX(0.0), mediaY(0.0), m2X(0.0), m2Y(0.0), coMomento(0.0)
+{
+    x = new double[capacidad];
+    y = new double[capacidad];
+}
+
+VentanaCovarianza::~VentanaCovarianza()
+{
+    delete[] x;
+    delete[] y;
+}
+
+void VentanaCovarianza::agregar(double vx, double vy)
+{
+    if (cantidad == capacidad)
+    {
+        // Retirar el más antiguo: Welford al revés, con las medias sin él
+        double viejoX = x[inicio];
+        double viejoY = y[inicio];
+        inicio = (inicio + 1 == capacidad) ? 0 : inicio + 1;
+        cantidad--;
+
+        double mediaXAntes = mediaX;
+        double mediaYAntes = mediaY;
+        mediaX -= (viejoX - mediaX) / cantidad;
+        mediaY -= (viejoY - mediaY) / cantidad;
+        m2X -= (viejoX - mediaX) * (viejoX - mediaXAntes);
+        m2Y -= (viejoY - mediaY) * (viejoY - mediaYAntes);
+        coMomento -= (viejoX - mediaX) * (viejoY - mediaYAntes);
+    }
+
+    int posicion = inicio + cantidad;
+    if (posicion >= capacidad)
+    {
+        posicion -= capacidad;
+    }
+    x[posicion] = vx;
+    y[posicion] = vy;
+    cantidad++;
+
+    double dx = vx - mediaX;
+    double dy = vy - mediaY;
+    mediaX += dx / cantidad;
+    mediaY += dy / cantidad;
+    m2X += dx * (vx - mediaX);
+    m2Y += dy * (vy - mediaY);
+    coMomento += dx * (vy - mediaY);
+
+    if (++desdeRecalculo >= capacidad)
+    {
+        recalcular();
+    }
+}
+
+void VentanaCovarianza::reiniciar()
+{
+    cantidad = 0;
+    inicio = 0;
+    desdeRecalculo = 0;
+    mediaX = mediaY = 0.0;
+    m2X = m2Y = coMomento = 0.0;
+}
+
+void VentanaCovarianza::recalcular()
+{
+    double sumaX = 0.0;
+    double sumaY = 0.0;
+    for (int k = 0, i = inicio; k < cantidad; k++, i = (i + 1 == capacidad) ? 0 : i + 1)
+    {
+        sumaX += x[i];
+        sumaY += y[i];
+    }
+    mediaX = sumaX / cantidad;
+    mediaY = sumaY / cantidad;
+
+    m2X = m2Y = coMomento = 0.0;
+    for (int k = 0, i = inicio; k < cantidad; k++, i = (i + 1 == capacidad) ? 0 : i + 1)
+    {
+        double dx = x[i] - mediaX;
+        double dy = y[i] - mediaY;
+        m2X += dx * dx;
+        m2Y += dy * dy;
+        coMomento += dx * dy;
+    }
+    desdeRecalculo = 0;
+}
+
+double VentanaCovarianza::covarianza() const
+{
+    return (cantidad < 2) ? 0.0 : coMomento / (cantidad - 1);
+}
+
+double VentanaCovarianza::correlacion() const
+{
+    if (cantidad < 2 || !(m2X > 0.0) || !(m2Y > 0.0))
+    {
+        return SIN_DATOS;
+    }
+
+    double r = coMomento / std::sqrt(m2X * m2Y);
+    return (r > 1.0) ? 1.0 : ((r < -1.0) ? -1.0 : r);
+}
+
+int VentanaCovarianza::getCantidad() const
+{
+    return cantidad;
+}
+
+int VentanaCovarianza::getCapacidad() const
+{
+    return capacidad;
+}
+
+MotorCorrelacion::MotorCorrelacion()
+    : pares(nullptr), numPares(0), capacidadPares(0),
+      sensores(nullptr), primerPar(nullptr), numSensores(0), capacidadSensores(0),
+      nombresMatriz(nullptr), matriz(nullptr), dimension(0), ventanaMatriz(0), hilosMatriz(0),
+      milisegundosMatriz(0.0)
+{
+}
+
+MotorCorrelacion::~MotorCorrelacion()
+{
+    for (int p = 0; p < numPares; p++)
+    {
+        delete[] pares[p]->pendientes;
+        delete pares[p]->ventana;
+        delete pares[p];
+    }
+    delete[] pares;
+    delete[] sensores;
+    delete[] primerPar;
+    delete[] nombresMatriz;
+    delete[] matriz;
+}
+
+int MotorCorrelacion::agregarPar(const char *nombreA, const char *nombreB, int ventana,
+                                 ModoAlineacion modo, int retardo, double umbral)
+{
+    if (nombreA == nullptr || nombreB == nullptr || nombreA[0] == '\0' || nombreB[0] == '\0' ||
+        std::strlen(nombreA) >= static_cast<std::size_t>(TAM_NOMBRE) ||
+        std::strlen(nombreB) >= static_cast<std::size_t>(TAM_NOMBRE) ||
+        std::strcmp(nombreA, nombreB) == 0)
+    {
+        return -1;
+    }
+
+    if (numPares == capacidadPares)
+    {
+        int nuevaCapacidad = (capacidadPares == 0) ? 8 : capacidadPares * 2;
+        ParVigilado **nuevos = new ParVigilado *[nuevaCapacidad];
+        for (int p = 0; p < numPares; p++)
+        {
+            nuevos[p] = pares[p];
+        }
+        delete[] pares;
+        pares = nuevos;
+        capacidadPares = nuevaCapacidad;
+    }
+
+    ParVigilado *par = new ParVigilado;
+    std::strcpy(par->nombreA, nombreA);
+    std::strcpy(par->nombreB, nombreB);
+    par->manejadorA = -1;
+    par->manejadorB = -1;
+    par->siguienteA = -1;
+    par->siguienteB = -1;
+    par->modo = modo;
+    par->retardo = (modo == ALINEAR_POR_INDICE) ? retardo : 0;
+    par->umbral = std::fabs(umbral);
+    par->ventana = new VentanaCovarianza(ventana);
+    par->pendientes = new double[par->ventana->getCapacidad()];
+    par->emparejadas = 0;
+    par->descartadas = 0;
+    par->episodios = 0;
+    par->ocupado.store(false, std::memory_order_relaxed);
+    reiniciarPar(*par);
+
+    int idPar = numPares++;
+    pares[idPar] = par;
+
+    // Los sensores que ya existen se resuelven de inmediato
+    for (int m = 0; m < numSensores; m++)
+    {
+        if (sensores[m] != nullptr)
+        {
+            resolver(idPar, *sensores[m]);
+        }
+    }
+
+    return idPar;
+}
+
+void MotorCorrelacion::reiniciarPar(ParVigilado &par)
+{
+    par.saltarA = (par.retardo < 0) ? -par.retardo : 0;
+    par.saltarB = (par.retardo > 0) ? par.retardo : 0;
+    par.inicioPendientes = 0;
+    par.numPendientes = 0;
+    par.pendientesDeA = false;
+    par.ultimoB = 0.0;
+    par.hayUltimoB = false;
+    par.acoplado = false;
+    par.ventana->reiniciar();
+}
+
+void MotorCorrelacion::resolver(int idPar, SensorBase &sensor)
+{
+    ParVigilado &par = *pares[idPar];
+    int manejador = sensor.getManejador();
+
+    if (par.manejadorA < 0 && std::strcmp(par.nombreA, sensor.getNombre()) == 0)
+    {
+        par.manejadorA = manejador;
+        par.siguienteA = primerPar[manejador];
+        primerPar[manejador] = idPar;
+        reiniciarPar(par);
+    }
+    else if (par.manejadorB < 0 && std::strcmp(par.nombreB, sensor.getNombre()) == 0)
+    {
+        par.manejadorB = manejador;
+        par.siguienteB = primerPar[manejador];
+        primerPar[manejador] = idPar;
+        reiniciarPar(par);
+    }
+}
+
+void MotorCorrelacion::alimentar(ParVigilado &par, bool esA, double valor)
+{
+    if (par.modo == ALINEAR_POR_TIEMPO)
+    {
+        // B solo actualiza el valor vigente; cada lectura de A se empareja con él
+        if (!esA)
+        {
+            par.ultimoB = valor;
+            par.hayUltimoB = true;
+        }
+        else if (par.hayUltimoB)
+        {
+            emparejar(par, valor, par.ultimoB);
+        }
+        return;
+    }
+
+    int &saltar = esA ? par.saltarA : par.saltarB;
+    if (saltar > 0)
+    {
+        saltar--;
+        return;
+    }
+
+    int capacidad = par.ventana->getCapacidad();
+    if (par.numPendientes > 0 && par.pendientesDeA != esA)
+    {
+        // La otra serie va adelantada: su lectura más antigua es la pareja de esta
+        double pareja = par.pendientes[par.inicioPendientes];
+        par.inicioPendientes = (par.inicioPendientes + 1 == capacidad) ? 0 : par.inicioPendientes + 1;
+        par.numPendientes--;
+        if (esA)
+        {
+            emparejar(par, valor, pareja);
+        }
+        else
+        {
+            emparejar(par, pareja, valor);
+        }
+        return;
+    }
+
+    if (par.numPendientes == capacidad)
+    {
+        // Desfase mayor que la ventana: se descarta la más antigua y, para no
+        // correr la alineación, también la lectura de la otra serie que le tocaba
+        par.inicioPendientes = (par.inicioPendientes + 1 == capacidad) ? 0 : par.inicioPendientes + 1;
+        par.numPendientes--;
+        par.descartadas++;
+        if (esA)
+        {
+            par.saltarB++;
+        }
+        else
+        {
+            par.saltarA++;
+        }
+    }
+
+    int posicion = par.inicioPendientes + par.numPendientes;
+    if (posicion >= capacidad)
+    {
+        posicion -= capacidad;
+    }
+    par.pendientes[posicion] = valor;
+    par.numPendientes++;
+    par.pendientesDeA = esA;
+}
+
+void MotorCorrelacion::emparejar(ParVigilado &par, double vx, double vy)
+{
+    par.ventana->agregar(vx, vy);
+    par.emparejadas++;
+
+    if (par.umbral <= 0.0 || par.ventana->getCantidad() < par.ventana->getCapacidad())
+    {
+        return;
+    }
+
+    double r = std::fabs(par.ventana->correlacion());
+    if (!par.acoplado && r >= par.umbral)
+    {
+        par.acoplado = true;
+        par.episodios++;
+    }
+    else if (par.acoplado && !(r >= par.umbral - HISTERESIS_ACOPLE)) // También NaN
+    {
+        par.acoplado = false;
+    }
+}
+
+int MotorCorrelacion::calcularMatriz(SensorBase *const *lista, int cantidad, int ventana, int hilos)
+{
+    std::chrono::steady_clock::time_point inicioCalculo = std::chrono::steady_clock::now();
+
+    cantidad = (cantidad > 0) ? cantidad : 0;
+    ventana = (ventana < 2) ? 2 : ventana;
+    if (hilos <= 0)
+    {
+        hilos = static_cast<int>(std::thread::hardware_concurrency());
+    }
+    hilos = (hilos > cantidad) ? cantidad : hilos;
+    hilos = (hilos < 1) ? 1 : hilos;
+
+    delete[] nombresMatriz;
+    delete[] matriz;
+    nombresMatriz = new char[cantidad > 0 ? cantidad : 1][TAM_NOMBRE];
+    matriz = new double[cantidad > 0 ? static_cast<std::size_t>(cantidad) * cantidad : 1];
+    dimension = cantidad;
+    ventanaMatriz = ventana;
+    hilosMatriz = hilos;
+
+    // Filas contiguas, rellenas con ceros hasta múltiplo de 4 para el kernel
+    int paso = (ventana + 3) & ~3;
+    double *filas = new double[cantidad > 0 ? static_cast<std::size_t>(cantidad) * paso : 1];
+    bool *validas = new bool[cantidad > 0 ? cantidad : 1];
+    double *historial = nullptr;
+    int capacidadHistorial = 0;
+    int numValidas = 0;
+
+    for (int i = 0; i < cantidad; i++)
+    {
+        const SensorBase *sensor = lista[i];
+        double *fila = filas + static_cast<std::size_t>(i) * paso;
+        std::strncpy(nombresMatriz[i], sensor->getNombre(), TAM_NOMBRE - 1);
+        nombresMatriz[i][TAM_NOMBRE - 1] = '\0';
+        validas[i] = false;
+
+        int total = sensor->getNumLecturas();
+        if (total >= ventana)
+        {
+            if (total > capacidadHistorial)
+            {
+                delete[] historial;
+                historial = new double[total];
+                capacidadHistorial = total;
+            }
+
+            // Las últimas 'ventana' lecturas, alineadas desde la más reciente
+            int copiadas = sensor->copiarLecturas(historial, total);
+            validas[i] = copiadas >= ventana && estandarizar(historial + copiadas - ventana, fila, ventana);
+        }
+
+        for (int k = validas[i] ? ventana : 0; k < paso; k++)
+        {
+            fila[k] = 0.0;
+        }
+        numValidas += validas[i] ? 1 : 0;
+    }
+    delete[] historial;
+
+    // Los pares se reparten por filas intercaladas; el hilo actual toma la primera
+    std::thread *trabajadores = (hilos > 1) ? new std::thread[hilos - 1] : nullptr;
+    for (int h = 1; h < hilos; h++)
+    {
+        trabajadores[h - 1] = std::thread(correlacionarFilas, filas, validas, cantidad, paso, matriz, h, hilos);
+    }
+    correlacionarFilas(filas, validas, cantidad, paso, matriz, 0, hilos);
+    for (int h = 1; h < hilos; h++)
+    {
+        trabajadores[h - 1].join();
+    }
+    delete[] trabajadores;
+
+    // Triángulo inferior por simetría
+    for (int i = 1; i < cantidad; i++)
+    {
+        for (int j = 0; j < i; j++)
+        {
+            matriz[static_cast<std::size_t>(i) * cantidad + j] = matriz[static_cast<std::size_t>(j) * cantidad + i];
+        }
+    }
+
+    delete[] filas;
+    delete[] validas;
+
+    milisegundosMatriz = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - inicioCalculo)
+                             .count();
+    return numValidas;
+}
+
+double MotorCorrelacion::getCorrelacion(int i, int j) const
+{
+    if (i < 0 || j < 0 || i >= dimension || j >= dimension)
+    {
+        return SIN_DATOS;
+    }
+    return matriz[static_cast<std::size_t>(i) * dimension + j];
+}
+
+double MotorCorrelacion::getCorrelacionPar(int idPar) const
+{
+    return (idPar >= 0 && idPar < numPares) ? pares[idPar]->ventana->correlacion() : SIN_DATOS;
+}
+
+double MotorCorrelacion::getCovarianzaPar(int idPar) const
+{
+    return (idPar >= 0 && idPar < numPares) ? pares[idPar]->ventana->covarianza() : 0.0;
+}
+
+int MotorCorrelacion::getNumPares() const
+{
+    return numPares;
+}
+
+int MotorCorrelacion::getDimension() const
+{
+    return dimension;
+}
+
+void MotorCorrelacion::lecturaRegistrada(SensorBase &sensor, double valor)
+{
+    int manejador = sensor.getManejador();
+    if (manejador < 0 || manejador >= numSensores || sensores[manejador] != &sensor)
+    {
+        return;
+    }
+
+    int p = primerPar[manejador];
+    while (p >= 0)
+    {
+        ParVigilado &par = *pares[p];
+        bool esA = par.manejadorA == manejador;
+        int siguiente = esA ? par.siguienteA : par.siguienteB;
+        if (par.manejadorA >= 0 && par.manejadorB >= 0)
+        {
+            while (par.ocupado.exchange(true, std::memory_order_acquire))
+            {
+                std::this_thread::yield();
+            }
+            alimentar(par, esA, valor);
+            par.ocupado.store(false, std::memory_order_release);
+        }
+        p = siguiente;
+    }
+}
+
+void MotorCorrelacion::sensorRegistrado(SensorBase &sensor, const void *tipo)
+{
+    (void)tipo;
+    int manejador = sensor.getManejador();
+    if (manejador < 0)
+    {
+        return;
+    }
+
+    if (manejador >= capacidadSensores)
+    {
+        int nuevaCapacidad = (capacidadSensores == 0) ? 16 : capacidadSensores;
+        while (nuevaCapacidad <= manejador)
+        {
+            nuevaCapacidad *= 2;
+        }
+
+        SensorBase **nuevosSensores = new SensorBase *[nuevaCapacidad];
+        int *nuevosPrimeros = new int[nuevaCapacidad];
+        for (int i = 0; i < nuevaCapacidad; i++)
+        {
+            bool existe = i < numSensores;
+            nuevosSensores[i] = existe ? sensores[i] : nullptr;
+            nuevosPrimeros[i] = existe ? primerPar[i] : -1;
+        }
+
+        delete[] sensores;
+        delete[] primerPar;
+        sensores = nuevosSensores;
+        primerPar = nuevosPrimeros;
+        capacidadSensores = nuevaCapacidad;
+    }
+
+    for (int i = numSensores; i <= manejador; i++)
+    {
+        sensores[i] = nullptr;
+        primerPar[i] = -1;
+    }
+    if (manejador >= numSensores)
+    {
+        numSensores = manejador + 1;
+    }
+
+    sensores[manejador] = &sensor;
+    primerPar[manejador] = -1;
+    for (int p = 0; p < numPares; p++)
+    {
+        resolver(p, sensor);
+    }
+}
+
+void MotorCorrelacion::sensorEliminado(SensorBase &sensor, int manejador)
+{
+    if (manejador < 0 || manejador >= numSensores || sensores[manejador] != &sensor)
+    {
+        return;
+    }
+
+    // La cadena del otro sensor conserva el par, que queda sin resolver por este lado
+    int p = primerPar[manejador];
+    while (p >= 0)
+    {
+        ParVigilado &par = *pares[p];
+        bool esA = par.manejadorA == manejador;
+        int siguiente = esA ? par.siguienteA : par.siguienteB;
+        if (esA)
+        {
+            par.manejadorA = -1;
+        }
+        else
+        {
+            par.manejadorB = -1;
+        }
+        reiniciarPar(par);
+        p = siguiente;
+    }
+
+    primerPar[manejador] = -1;
+    sensores[manejador] = nullptr;
+}
+
+void MotorCorrelacion::imprimirPares() const
+{
+    std::cout << "\n--- Pares de Correlacion (" << numPares << ") ---" << std::endl;
+
+    for (int p = 0; p < numPares; p++)
+    {
+        const ParVigilado &par = *pares[p];
+        std::cout << "#" << p << " " << par.nombreA << " ~ " << par.nombreB << " | ";
+        if (par.modo == ALINEAR_POR_TIEMPO)
+        {
+            std::cout << "por llegada";
+        }
+        else
+        {
+            std::cout << "por indice (retardo " << par.retardo << ")";
+        }
+
+        if (par.manejadorA < 0 || par.manejadorB < 0)
+        {
+            std::cout << " | sin resolver" << std::endl;
+            continue;
+        }
+
+        double r = par.ventana->correlacion();
+        std::cout << " | ventana " << par.ventana->getCantidad() << "/" << par.ventana->getCapacidad()
+                  << std::fixed << std::setprecision(3);
+        if (std::isnan(r))
+        {
+            std::cout << " | r indefinida";
+        }
+        else
+        {
+            std::cout << " | r = " << r;
+        }
+        std::cout << " | cov = " << par.ventana->covarianza();
+        if (par.umbral > 0.0)
+        {
+            std::cout << " | umbral " << par.umbral << (par.acoplado ? " [ACOPLADOS]" : "")
+                      << " | episodios " << par.episodios;
+        }
+        std::cout.unsetf(std::ios::fixed);
+        std::cout << std::setprecision(6) << " | emparejadas " << par.emparejadas
+                  << " | descartadas " << par.descartadas << std::endl;
+    }
+}
+
+void MotorCorrelacion::imprimirMatriz(double umbral, int maximo) const
+{
+    if (dimension == 0)
+    {
+        std::cout << "No hay matriz calculada." << std::endl;
+        return;
+    }
+
+    int validas = 0;
+    for (int i = 0; i < dimension; i++)
+    {
+        validas += std::isnan(matriz[static_cast<std::size_t>(i) * dimension + i]) ? 0 : 1;
+    }
+
+    std::cout << "\n--- Matriz de Correlacion: " << dimension << " sensor(es), " << validas
+              << " con datos, ventana " << ventanaMatriz << ", " << hilosMatriz << " hilo(s), "
+              << milisegundosMatriz << " ms ---" << std::endl;
+
+    std::size_t posibles = static_cast<std::size_t>(dimension) * (dimension - 1) / 2;
+    ParMatriz *seleccion = new ParMatriz[posibles > 0 ? posibles : 1];
+    int encontrados = 0;
+    for (int i = 0; i < dimension; i++)
+    {
+        for (int j = i + 1; j < dimension; j++)
+        {
+            double r = matriz[static_cast<std::size_t>(i) * dimension + j];
+            if (!std::isnan(r) && std::fabs(r) >= umbral)
+            {
+                seleccion[encontrados].i = i;
+                seleccion[encontrados].j = j;
+                seleccion[encontrados].r = r;
+                encontrados++;
+            }
+        }
+    }
+    std::sort(seleccion, seleccion + encontrados, masCorrelacionado);
+
+    std::cout << encontrados << " par(es) con |r| >= " << umbral << ":" << std::endl;
+    std::cout << std::fixed << std::setprecision(3);
+    for (int k = 0; k < encontrados && k < maximo; k++)
+    {
+        std::cout << "  " << nombresMatriz[seleccion[k].i] << " ~ " << nombresMatriz[seleccion[k].j]
+                  << " : r = " << seleccion[k].r << std::endl;
+    }
+    std::cout.unsetf(std::ios::fixed);
+    std::cout << std::setprecision(6);
+
+    delete[] seleccion;
+}
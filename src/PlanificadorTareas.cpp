@@ -0,0 +1,270 @@
+/**
+ * @file PlanificadorTareas.cpp
+ * @brief Implementación del planificador de tareas periódicas
+ * @author FabiRamiro
+ * @date 2026-10-18
+ */
+
+#include "PlanificadorTareas.h"
+#include <iostream>
+#include <cstring>
+#include <chrono>
+#include <thread>
+
+PlanificadorTareas::PlanificadorTareas() : numTareas(0), tickActual(0), detenido(false)
+{
+    for (int i = 0; i < NUM_RANURAS; i++)
+    {
+        ranuras[i] = -1;
+    }
+    origenUs = 0;
+    origenUs = ahoraUs();
+}
+
+long long PlanificadorTareas::ahoraUs() const
+{
+    return static_cast<long long>(std::chrono::duration_cast<std::chrono::microseconds>(
+                                      std::chrono::steady_clock::now().time_since_epoch())
+                                      .count()) -
+           origenUs;
+}
+
+int PlanificadorTareas::agregarTarea(const char *nombre, TareaPeriodica *trabajo, int periodoMs, int primeraMs)
+{
+    if (numTareas == MAX_TAREAS || trabajo == nullptr || periodoMs < 1)
+    {
+        return -1;
+    }
+
+    int id = numTareas++;
+    Tarea &t = tareas[id];
+    std::strncpy(t.nombre, nombre, TAM_NOMBRE - 1);
+    t.nombre[TAM_NOMBRE - 1] = '\0';
+    t.trabajo = trabajo;
+    t.periodoMs = periodoMs;
+    t.vencimientoMs = tickActual + (primeraMs > 0 ? primeraMs : 1);
+    t.activa = true;
+    std::memset(&t.estadisticas, 0, sizeof(t.estadisticas));
+
+    programar(id);
+    return id;
+}
+
+void PlanificadorTareas::quitarTarea(int id)
+{
+    if (id >= 0 && id < numTareas)
+    {
+        tareas[id].activa = false; // Se desenlaza al pasar por su ranura
+    }
+}
+
+void PlanificadorTareas::programar(int id)
+{
+    Tarea &t = tareas[id];
+    long long delta = t.vencimientoMs - tickActual; // >= 1
+    int ranura = static_cast<int>(t.vencimientoMs & (NUM_RANURAS - 1));
+
+    t.vueltas = static_cast<int>((delta - 1) / NUM_RANURAS);
+    t.siguiente = ranuras[ranura];
+    ranuras[ranura] = id;
+}
+
+void PlanificadorTareas::reanudar()
+{
+    long long ahoraMs = ahoraUs() / 1000;
+    if (ahoraMs <= tickActual)
+    {
+        return;
+    }
+
+    for (int i = 0; i < NUM_RANURAS; i++)
+    {
+        ranuras[i] = -1;
+    }
+
+    long long anterior = tickActual;
+    tickActual = ahoraMs;
+    for (int id = 0; id < numTareas; id++)
+    {
+        Tarea &t = tareas[id];
+        if (t.activa)
+        {
+            long long desfase = t.vencimientoMs - anterior;
+            t.vencimientoMs = tickActual + (desfase > 0 ? desfase : 1);
+            programar(id);
+        }
+    }
+}
+
+void PlanificadorTareas::ejecutarTarea(int id)
+{
+    Tarea &t = tareas[id];
+    EstadisticasTarea &e = t.estadisticas;
+
+    long long inicio = ahoraUs();
+    long long retraso = inicio - t.vencimientoMs * 1000;
+    if (retraso < 0)
+    {
+        retraso = 0;
+    }
+
+    t.trabajo->ejecutar();
+
+    long long duracion = ahoraUs() - inicio;
+    e.ejecuciones++;
+    e.jitterTotalUs += retraso;
+    e.jitterMaxUs = (retraso > e.jitterMaxUs) ? retraso : e.jitterMaxUs;
+    e.duracionTotalUs += duracion;
+    e.duracionMaxUs = (duracion > e.duracionMaxUs) ? duracion : e.duracionMaxUs;
+    if (duracion > static_cast<long long>(t.periodoMs) * 1000)
+    {
+        e.desbordes++;
+    }
+
+    if (!t.activa)
+    {
+        return;
+    }
+
+    // Sobre la grilla; si ya pasaron varios vencimientos, solo se conserva el último
+    long long proximo = t.vencimientoMs + t.periodoMs;
+    long long ahoraMs = ahoraUs() / 1000;
+    if (proximo + t.periodoMs <= ahoraMs)
+    {
+        long long perdidos = (ahoraMs - proximo) / t.periodoMs;
+        e.omitidas += static_cast<unsigned long>(perdidos);
+        proximo += perdidos * t.periodoMs;
+    }
+    if (proximo <= tickActual)
+    {
+        long long perdidos = (tickActual - proximo) / t.periodoMs + 1;
+        e.omitidas += static_cast<unsigned long>(perdidos);
+        proximo += perdidos * t.periodoMs;
+    }
+
+    t.vencimientoMs = proximo;
+    programar(id);
+}
+
+int PlanificadorTareas::ejecutarPendientes()
+{
+    long long ahoraMs = ahoraUs() / 1000;
+    int ejecutadas = 0;
+
+    while (tickActual < ahoraMs && !detenido)
+    {
+        tickActual++;
+        int ranura = static_cast<int>(tickActual & (NUM_RANURAS - 1));
+
+        // Se desenlaza la ranura entera: las que aún tienen vueltas vuelven a ella
+        int id = ranuras[ranura];
+        ranuras[ranura] = -1;
+        int vencidas[MAX_TAREAS];
+        int numVencidas = 0;
+        while (id >= 0)
+        {
+            int siguiente = tareas[id].siguiente;
+            if (tareas[id].activa && tareas[id].vueltas > 0)
+            {
+                tareas[id].vueltas--;
+                tareas[id].siguiente = ranuras[ranura];
+                ranuras[ranura] = id;
+            }
+            else if (tareas[id].activa)
+            {
+                vencidas[numVencidas++] = id;
+            }
+            id = siguiente;
+        }
+
+        for (int i = 0; i < numVencidas; i++)
+        {
+            ejecutarTarea(vencidas[i]);
+            ejecutadas++;
+        }
+    }
+
+    return ejecutadas;
+}
+
+int PlanificadorTareas::msHastaProxima() const
+{
+    long long ahoraMs = ahoraUs() / 1000;
+    long long proxima = -1;
+
+    for (int id = 0; id < numTareas; id++)
+    {
+        if (tareas[id].activa && (proxima < 0 || tareas[id].vencimientoMs < proxima))
+        {
+            proxima = tareas[id].vencimientoMs;
+        }
+    }
+
+    if (proxima < 0)
+    {
+        return -1;
+    }
+    return (proxima > ahoraMs) ? static_cast<int>(proxima - ahoraMs) : 0;
+}
+
+void PlanificadorTareas::correr(long long duracionMs)
+{
+    reanudar();
+    detenido = false;
+    long long finMs = (duracionMs > 0) ? ahoraUs() / 1000 + duracionMs : -1;
+
+    while (!detenido)
+    {
+        ejecutarPendientes();
+
+        long long ahoraMs = ahoraUs() / 1000;
+        if (finMs >= 0 && ahoraMs >= finMs)
+        {
+            break;
+        }
+
+        int espera = msHastaProxima();
+        if (espera < 0)
+        {
+            break; // Sin tareas activas
+        }
+        if (finMs >= 0 && ahoraMs + espera > finMs)
+        {
+            espera = static_cast<int>(finMs - ahoraMs);
+        }
+        if (espera > 0 && !detenido)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(espera));
+        }
+    }
+}
+
+void PlanificadorTareas::detener()
+{
+    detenido = true;
+}
+
+const EstadisticasTarea *PlanificadorTareas::getEstadisticas(int id) const
+{
+    return (id >= 0 && id < numTareas) ? &tareas[id].estadisticas : nullptr;
+}
+
+void PlanificadorTareas::imprimirEstadisticas() const
+{
+    std::cout << "\n--- Tareas Programadas ---" << std::endl;
+
+    for (int id = 0; id < numTareas; id++)
+    {
+        const Tarea &t = tareas[id];
+        const EstadisticasTarea &e = t.estadisticas;
+        double n = (e.ejecuciones > 0) ? static_cast<double>(e.ejecuciones) : 1.0;
+
+        std::cout << t.nombre << ": cada " << t.periodoMs << " ms | " << e.ejecuciones << " ejecucion(es)"
+                  << " | jitter medio " << (e.jitterTotalUs / n) / 1000.0 << " ms (max "
+                  << e.jitterMaxUs / 1000.0 << ")"
+                  << " | duracion media " << (e.duracionTotalUs / n) / 1000.0 << " ms (max "
+                  << e.duracionMaxUs / 1000.0 << ")"
+                  << " | desbordes " << e.desbordes << " | omitidas " << e.omitidas
+                  << (t.activa ? "" : " [inactiva]") << std::endl;
+    }
+}
@@ -0,0 +1,289 @@
+/**
+ * @file ProtocoloBinario.cpp
+ * @brief Implementación del protocolo binario de tramas y su decodificador
+ * @author FabiRamiro
+ * @date 2026-10-18
+ */
+
+#include "ProtocoloBinario.h"
+#include "Trazas.h"
+#include <iostream>
+#include <cstdio>
+#include <cstring>
+
+namespace
+{
+    /**
+     * @brief Tabla del CRC-16/CCITT generada una sola vez
+     */
+    struct TablaCRC16
+    {
+        unsigned short valores[256];
+
+        TablaCRC16()
+        {
+            for (int i = 0; i < 256; i++)
+            {
+                unsigned short crc = static_cast<unsigned short>(i << 8);
+                for (int bit = 0; bit < 8; bit++)
+                {
+                    crc = (crc & 0x8000) ? static_cast<unsigned short>((crc << 1) ^ 0x1021)
+                                         : static_cast<unsigned short>(crc << 1);
+                }
+                valores[i] = crc;
+            }
+        }
+    };
+
+    const TablaCRC16 tablaCRC;
+
+    int leerEntero32(const unsigned char *p)
+    {
+        unsigned int v = static_cast<unsigned int>(p[0]) |
+                         (static_cast<unsigned int>(p[1]) << 8) |
+                         (static_cast<unsigned int>(p[2]) << 16) |
+                         (static_cast<unsigned int>(p[3]) << 24);
+        return static_cast<int>(v);
+    }
+
+    unsigned short leerEntero16(const unsigned char *p)
+    {
+        return static_cast<unsigned short>(p[0] | (p[1] << 8));
+    }
+}
+
+double LecturaBinaria::valor() const
+{
+    if (tipo == TRAMA_TEMP)
+    {
+        return static_cast<double>(valorCrudo) / ESCALA_TEMPERATURA;
+    }
+    return static_cast<double>(valorCrudo);
+}
+
+const char *LecturaBinaria::nombreTipo() const
+{
+    switch (tipo)
+    {
+    case TRAMA_TEMP:
+        return "TEMP";
+    case TRAMA_PRES:
+        return "PRES";
+    case TRAMA_VIB:
+        return "VIB";
+    default:
+        return "????";
+    }
+}
+
+void LecturaBinaria::formatearId(char *destino, int tamano) const
+{
+    char prefijo = (tipo == TRAMA_TEMP) ? 'T' : (tipo == TRAMA_PRES) ? 'P' : (tipo == TRAMA_VIB) ? 'V' : 'X';
+    std::snprintf(destino, tamano, "%c-%03u", prefijo, static_cast<unsigned int>(id));
+}
+
+unsigned short calcularCRC16(const unsigned char *datos, int longitud)
+{
+    unsigned short crc = 0xFFFF;
+    for (int i = 0; i < longitud; i++)
+    {
+        crc = static_cast<unsigned short>((crc << 8) ^ tablaCRC.valores[((crc >> 8) ^ datos[i]) & 0xFF]);
+    }
+    return crc;
+}
+
+int codificarTrama(const LecturaBinaria *lecturas, int cantidad,
+                   unsigned short secuencia, unsigned char *destino)
+{
+    if (lecturas == nullptr || cantidad < 1 || cantidad > MAX_LECTURAS_TRAMA)
+    {
+        return 0;
+    }
+
+    int pos = 0;
+    destino[pos++] = SYNC_TRAMA;
+    destino[pos++] = static_cast<unsigned char>(cantidad);
+    destino[pos++] = static_cast<unsigned char>(secuencia & 0xFF);
+    destino[pos++] = static_cast<unsigned char>(secuencia >> 8);
+
+    for (int i = 0; i < cantidad; i++)
+    {
+        unsigned int v = static_cast<unsigned int>(lecturas[i].valorCrudo);
+        destino[pos++] = lecturas[i].tipo;
+        destino[pos++] = static_cast<unsigned char>(lecturas[i].id & 0xFF);
+        destino[pos++] = static_cast<unsigned char>(lecturas[i].id >> 8);
+        destino[pos++] = static_cast<unsigned char>(v & 0xFF);
+        destino[pos++] = static_cast<unsigned char>((v >> 8) & 0xFF);
+        destino[pos++] = static_cast<unsigned char>((v >> 16) & 0xFF);
+        destino[pos++] = static_cast<unsigned char>((v >> 24) & 0xFF);
+    }
+
+    // El CRC cubre desde N hasta la última lectura (sin el byte SYNC)
+    unsigned short crc = calcularCRC16(destino + 1, pos - 1);
+    destino[pos++] = static_cast<unsigned char>(crc & 0xFF);
+    destino[pos++] = static_cast<unsigned char>(crc >> 8);
+
+    return pos;
+}
+
+DecodificadorTramas::DecodificadorTramas()
+{
+    reiniciar();
+}
+
+void DecodificadorTramas::reiniciar()
+{
+    ocupados = 0;
+    numPendientes = 0;
+    posPendiente = 0;
+    haySecuencia = false;
+    secuenciaEsperada = 0;
+    tramasValidas = 0;
+    erroresCRC = 0;
+    bytesDescartados = 0;
+    tramasPerdidas = 0;
+}
+
+int DecodificadorTramas::alimentar(const unsigned char *datos, int n)
+{
+    if (datos == nullptr || n <= 0)
+    {
+        return 0;
+    }
+
+    int libres = TAM_BUFFER - ocupados;
+    int aceptados = (n < libres) ? n : libres;
+    std::memcpy(buffer + ocupados, datos, aceptados);
+    ocupados += aceptados;
+    return aceptados;
+}
+
+bool DecodificadorTramas::siguienteLectura(LecturaBinaria &lectura)
+{
+    if (posPendiente >= numPendientes)
+    {
+        numPendientes = 0;
+        posPendiente = 0;
+        TramoTraza tramo(ETAPA_TRAMA);
+        if (!decodificarTrama())
+        {
+            return false;
+        }
+    }
+
+    lectura = pendientes[posPendiente++];
+    return true;
+}
+
+bool DecodificadorTramas::decodificarTrama()
+{
+    while (ocupados > 0)
+    {
+        // Resincronización: descartar todo lo que preceda al siguiente SYNC
+        if (buffer[0] != SYNC_TRAMA)
+        {
+            const void *sync = std::memchr(buffer, SYNC_TRAMA, ocupados);
+            int salto = (sync == nullptr) ? ocupados
+                                          : static_cast<int>(static_cast<const unsigned char *>(sync) - buffer);
+            bytesDescartados += salto;
+            consumir(salto);
+            continue;
+        }
+
+        if (ocupados < 2)
+        {
+            return false; // Falta el byte N
+        }
+
+        int cantidad = buffer[1];
+        if (cantidad < 1 || cantidad > MAX_LECTURAS_TRAMA)
+        {
+            // Falso SYNC: la longitud es imposible
+            erroresCRC++;
+            bytesDescartados++;
+            consumir(1);
+            continue;
+        }
+
+        int longitud = TAM_CABECERA_TRAMA + cantidad * TAM_LECTURA_TRAMA + TAM_CRC_TRAMA;
+        if (ocupados < longitud)
+        {
+            return false; // Trama incompleta: esperar más bytes
+        }
+
+        unsigned short crcRecibido = leerEntero16(buffer + longitud - TAM_CRC_TRAMA);
+        unsigned short crcCalculado = calcularCRC16(buffer + 1, longitud - 1 - TAM_CRC_TRAMA);
+        if (crcRecibido != crcCalculado)
+        {
+            // Trama corrupta: descartar solo el SYNC y buscar el siguiente
+            erroresCRC++;
+            bytesDescartados++;
+            consumir(1);
+            continue;
+        }
+
+        unsigned short secuencia = leerEntero16(buffer + 2);
+        if (haySecuencia && secuencia != secuenciaEsperada)
+        {
+            tramasPerdidas += static_cast<unsigned short>(secuencia - secuenciaEsperada);
+        }
+        haySecuencia = true;
+        secuenciaEsperada = static_cast<unsigned short>(secuencia + 1);
+
+        const unsigned char *p = buffer + TAM_CABECERA_TRAMA;
+        for (int i = 0; i < cantidad; i++, p += TAM_LECTURA_TRAMA)
+        {
+            pendientes[i].tipo = p[0];
+            pendientes[i].id = leerEntero16(p + 1);
+            pendientes[i].valorCrudo = leerEntero32(p + 3);
+            pendientes[i].secuencia = secuencia;
+        }
+        numPendientes = cantidad;
+        posPendiente = 0;
+        tramasValidas++;
+
+        consumir(longitud);
+        return true;
+    }
+
+    return false;
+}
+
+void DecodificadorTramas::consumir(int n)
+{
+    if (n >= ocupados)
+    {
+        ocupados = 0;
+        return;
+    }
+    std::memmove(buffer, buffer + n, ocupados - n);
+    ocupados -= n;
+}
+
+void DecodificadorTramas::imprimirEstadisticas() const
+{
+    std::cout << "[Decodificador] Tramas validas: " << tramasValidas
+              << " | Descartadas: " << erroresCRC
+              << " | Bytes descartados: " << bytesDescartados
+              << " | Tramas perdidas: " << tramasPerdidas << std::endl;
+}
+
+unsigned long DecodificadorTramas::getTramasValidas() const
+{
+    return tramasValidas;
+}
+
+unsigned long DecodificadorTramas::getErroresCRC() const
+{
+    return erroresCRC;
+}
+
+unsigned long DecodificadorTramas::getBytesDescartados() const
+{
+    return bytesDescartados;
+}
+
+unsigned long DecodificadorTramas::getTramasPerdidas() const
+{
+    return tramasPerdidas;
+}
@@ -0,0 +1,306 @@
+/**
+ * @file PublicadorAnillo.cpp
+ * @brief Implementación del escritor del anillo en memoria compartida
+ * @author FabiRamiro
+ * @date 2026-10-18
+ */
+
+#include "PublicadorAnillo.h"
+#include "Instantaneas.h"
+#include <iostream>
+#include <cstdio>
+#include <cstring>
+#include <chrono>
+#include <new>
+#include <thread>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+    /**
+     * @brief Hora actual en nanosegundos desde la época Unix (comparable entre procesos)
+     */
+    std::int64_t horaNs()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::system_clock::now().time_since_epoch())
+            .count();
+    }
+}
+
+PublicadorAnillo::PublicadorAnillo()
+    : cabecera(nullptr), ranuras(nullptr), mascara(0), publicados(0), escribiendo(false), tamano(0),
+      versionesPublicadas(nullptr), capacidadVersiones(0)
+{
+    nombreSegmento[0] = '\0';
+}
+
+PublicadorAnillo::~PublicadorAnillo()
+{
+    cerrar();
+    delete[] versionesPublicadas;
+}
+
+bool PublicadorAnillo::abrir(const char *nombre, int capacidad)
+{
+    cerrar();
+
+    if (nombre == nullptr || nombre[0] == '\0' || capacidad <= 0)
+    {
+        return false;
+    }
+
+#ifdef _WIN32
+    std::cout << "[Anillo] La memoria compartida POSIX no esta disponible en esta plataforma." << std::endl;
+    return false;
+#else
+    // shm_open necesita un nombre con una sola barra inicial
+    std::snprintf(nombreSegmento, TAM_NOMBRE_SEGMENTO, "%s%s", nombre[0] == '/' ? "" : "/", nombre);
+
+    std::uint32_t ranurasTotales = 1;
+    while (ranurasTotales < static_cast<std::uint32_t>(capacidad) && ranurasTotales < (1u << 24))
+    {
+        ranurasTotales <<= 1;
+    }
+    std::uint64_t bytes = tamanoSegmentoAnillo(ranurasTotales);
+
+    // Un segmento viejo se reemplaza: sus lectores lo conservan mapeado y lo ven inactivo
+    shm_unlink(nombreSegmento);
+    int fd = shm_open(nombreSegmento, O_CREAT | O_EXCL | O_RDWR | O_CLOEXEC, 0644);
+    if (fd < 0)
+    {
+        std::cout << "[Anillo] No se pudo crear '" << nombreSegmento << "'." << std::endl;
+        return false;
+    }
+    if (ftruncate(fd, static_cast<off_t>(bytes)) < 0)
+    {
+        close(fd);
+        shm_unlink(nombreSegmento);
+        return false;
+    }
+
+    void *mapa = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (mapa == MAP_FAILED)
+    {
+        shm_unlink(nombreSegmento);
+        return false;
+    }
+
+    // ftruncate deja el segmento en ceros: sellos en 0 = ninguna ranura escrita
+    cabecera = new (mapa) CabeceraAnillo;
+    cabecera->version = VERSION_ANILLO;
+    cabecera->capacidad = ranurasTotales;
+    cabecera->tamRanura = sizeof(RanuraAnillo);
+    cabecera->pidEscritor = static_cast<std::int64_t>(getpid());
+    cabecera->activo.store(1, std::memory_order_relaxed);
+    cabecera->publicados.store(0, std::memory_order_relaxed);
+    cabecera->magia.store(MAGIA_ANILLO, std::memory_order_release);
+
+    ranuras = ranurasAnillo(cabecera);
+    mascara = ranurasTotales - 1;
+    publicados = 0;
+    tamano = bytes;
+
+    // Un anillo nuevo empieza sin agregados: el primer llamado publica toda la flota
+    for (int m = 0; m < capacidadVersiones; m++)
+    {
+        versionesPublicadas[m] = 0;
+    }
+    return true;
+#endif
+}
+
+void PublicadorAnillo::cerrar()
+{
+    if (cabecera == nullptr)
+    {
+        return;
+    }
+
+#ifndef _WIN32
+    cabecera->activo.store(0, std::memory_order_release);
+    munmap(cabecera, tamano);
+    shm_unlink(nombreSegmento);
+#endif
+    cabecera = nullptr;
+    ranuras = nullptr;
+}
+
+bool PublicadorAnillo::estaAbierto() const
+{
+    return cabecera != nullptr;
+}
+
+RegistroAnillo &PublicadorAnillo::reservar()
+{
+    RanuraAnillo &ranura = ranuras[publicados & mascara];
+    ranura.sello.store(2 * publicados + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release); // El sello impar antes que los datos
+    return ranura.registro;
+}
+
+void PublicadorAnillo::bloquear()
+{
+    while (escribiendo.exchange(true, std::memory_order_acquire))
+    {
+        while (escribiendo.load(std::memory_order_relaxed))
+        {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void PublicadorAnillo::desbloquear()
+{
+    escribiendo.store(false, std::memory_order_release);
+}
+
+void PublicadorAnillo::confirmar()
+{
+    RanuraAnillo &ranura = ranuras[publicados & mascara];
+    ranura.registro.secuencia = publicados;
+    ranura.sello.store(2 * publicados + 2, std::memory_order_release);
+    publicados++;
+    cabecera->publicados.store(publicados, std::memory_order_release);
+}
+
+void PublicadorAnillo::completar(RegistroAnillo &registro, TipoRegistroAnillo tipo, int manejador,
+                                 const char *tipoSensor, const char *nombre)
+{
+    registro.tipo = static_cast<std::uint32_t>(tipo);
+    registro.manejador = manejador;
+    std::strncpy(registro.tipoSensor, tipoSensor, TAM_TIPO_ANILLO - 1);
+    registro.tipoSensor[TAM_TIPO_ANILLO - 1] = '\0';
+    std::strncpy(registro.nombre, nombre, TAM_NOMBRE_ANILLO - 1);
+    registro.nombre[TAM_NOMBRE_ANILLO - 1] = '\0';
+}
+
+void PublicadorAnillo::lecturaRegistrada(SensorBase &sensor, double valor)
+{
+    if (cabecera == nullptr)
+    {
+        return;
+    }
+
+    std::int64_t marca = horaNs();
+    bloquear();
+    RegistroAnillo &registro = reservar();
+    completar(registro, REGISTRO_ANILLO_LECTURA, sensor.getManejador(), sensor.getTipo(), sensor.getNombre());
+    registro.marcaNs = marca;
+    registro.valor = valor;
+    registro.minimo = valor;
+    registro.maximo = valor;
+    registro.numLecturas = 1;
+    confirmar();
+    desbloquear();
+}
+
+void PublicadorAnillo::bloqueRegistrado(SensorBase &sensor, const int *cuentas, int cantidad)
+{
+    if (cabecera == nullptr || cuentas == nullptr)
+    {
+        return;
+    }
+
+    std::int64_t marca = horaNs();
+    bloquear(); // El bloque queda contiguo en el anillo
+    for (int i = 0; i < cantidad; i++)
+    {
+        RegistroAnillo &registro = reservar();
+        completar(registro, REGISTRO_ANILLO_LECTURA, sensor.getManejador(), sensor.getTipo(), sensor.getNombre());
+        registro.marcaNs = marca;
+        registro.valor = cuentas[i];
+        registro.minimo = cuentas[i];
+        registro.maximo = cuentas[i];
+        registro.numLecturas = 1;
+        confirmar();
+    }
+    desbloquear();
+}
+
+int PublicadorAnillo::publicarAgregados(PublicadorInstantaneas &origen)
+{
+    if (cabecera == nullptr)
+    {
+        return 0;
+    }
+
+    int ranura = origen.registrarLector();
+    if (ranura < 0)
+    {
+        return 0;
+    }
+
+    int escritos = 0;
+    {
+        LectorInstantaneas vista(origen, ranura);
+
+        if (vista->numSensores > capacidadVersiones)
+        {
+            int nuevaCapacidad = (capacidadVersiones == 0) ? 16 : capacidadVersiones;
+            while (nuevaCapacidad < vista->numSensores)
+            {
+                nuevaCapacidad *= 2;
+            }
+            unsigned long *nuevas = new unsigned long[nuevaCapacidad];
+            for (int m = 0; m < nuevaCapacidad; m++)
+            {
+                nuevas[m] = (m < capacidadVersiones) ? versionesPublicadas[m] : 0;
+            }
+            delete[] versionesPublicadas;
+            versionesPublicadas = nuevas;
+            capacidadVersiones = nuevaCapacidad;
+        }
+
+        std::int64_t marca = horaNs();
+        for (int m = 0; m < vista->numSensores; m++)
+        {
+            const InstantaneaSensor *s = vista->sensores[m];
+            if (s == nullptr || versionesPublicadas[m] == s->version + 1)
+            {
+                continue;
+            }
+
+            bloquear();
+            RegistroAnillo &registro = reservar();
+            completar(registro, REGISTRO_ANILLO_AGREGADO, s->manejador, s->tipo, s->nombre);
+            registro.marcaNs = marca;
+            registro.valor = s->promedio;
+            registro.minimo = s->minimo;
+            registro.maximo = s->maximo;
+            registro.numLecturas = s->numLecturas;
+            confirmar();
+            desbloquear();
+
+            versionesPublicadas[m] = s->version + 1;
+            escritos++;
+        }
+    }
+    origen.liberarLector(ranura);
+    return escritos;
+}
+
+unsigned long long PublicadorAnillo::getPublicados() const
+{
+    return publicados;
+}
+
+void PublicadorAnillo::imprimirEstado() const
+{
+    std::cout << "\n--- Anillo en Memoria Compartida ---" << std::endl;
+    if (cabecera == nullptr)
+    {
+        std::cout << "Cerrado." << std::endl;
+        return;
+    }
+
+    std::cout << "Segmento: /dev/shm" << nombreSegmento << " (" << tamano << " bytes)" << std::endl;
+    std::cout << "Ranuras: " << cabecera->capacidad << " de " << sizeof(RanuraAnillo)
+              << " bytes | Registros publicados: " << publicados << std::endl;
+}
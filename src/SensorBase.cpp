@@ -8,21 +8,75 @@
 #include "SensorBase.h"
 #include <cstring>
 
-SensorBase::SensorBase()
+namespace
+{
+    /**
+     * @brief Copia contigua del historial de un sensor, recorrible por escribirLecturas()
+     */
+    class ArregloLecturas
+    {
+    private:
+        double *valores;
+        int cantidad;
+
+    public:
+        typedef const double *const_iterator;
+
+        explicit ArregloLecturas(const SensorBase &sensor)
+            : valores(nullptr), cantidad(sensor.getNumLecturas())
+        {
+            if (cantidad > 0)
+            {
+                valores = new double[cantidad];
+                cantidad = sensor.copiarLecturas(valores, cantidad);
+            }
+        }
+
+        ~ArregloLecturas()
+        {
+            delete[] valores;
+        }
+
+        const_iterator begin() const { return valores; }
+        const_iterator end() const { return valores + cantidad; }
+        int getContador() const { return cantidad; }
+
+    private:
+        ArregloLecturas(const ArregloLecturas &);            // No copiable
+        ArregloLecturas &operator=(const ArregloLecturas &); // No asignable
+    };
+}
+
+SensorBase::SensorBase() : observador(nullptr), manejador(-1), reorden(nullptr), silencioso(false)
 {
     nombre[0] = '\0';
+    resultado.valido = false;
+    resultado.lecturas = 0;
+    resultado.valor = 0.0;
+    resultado.dispersion = 0.0;
 }
 
 SensorBase::SensorBase(const char *nombreSensor)
+    : observador(nullptr), manejador(-1), reorden(nullptr), silencioso(false)
 {
     setNombre(nombreSensor);
+    resultado.valido = false;
+    resultado.lecturas = 0;
+    resultado.valor = 0.0;
+    resultado.dispersion = 0.0;
 }
 
 SensorBase::~SensorBase()
 {
+    delete reorden;
     std::cout << "[Destructor SensorBase] Sensor " << nombre << " liberado." << std::endl;
 }
 
+const ResultadoProceso &SensorBase::getResultado() const
+{
+    return resultado;
+}
+
 const char *SensorBase::getNombre() const
 {
     return nombre;
@@ -35,4 +89,108 @@ void SensorBase::setNombre(const char *nombreSensor)
         std::strncpy(nombre, nombreSensor, 49);
         nombre[49] = '\0'; // Asegurar terminación
     }
-}
\ No newline at end of file
+}
+
+void SensorBase::setObservador(ObservadorLecturas *nuevoObservador)
+{
+    observador = nuevoObservador;
+}
+
+void SensorBase::setSilencioso(bool activo)
+{
+    silencioso = activo;
+}
+
+bool SensorBase::esSilencioso() const
+{
+    return silencioso;
+}
+
+int SensorBase::getManejador() const
+{
+    return manejador;
+}
+
+void SensorBase::setManejador(int nuevoManejador)
+{
+    manejador = nuevoManejador;
+}
+
+ResultadoSecuencia SensorBase::registrarLecturaSecuencia(double valor, long long secuencia)
+{
+    if (reorden == nullptr)
+    {
+        reorden = new BufferReordenamiento();
+    }
+
+    double listas[BufferReordenamiento::MAX_LISTAS];
+    int numListas;
+    ResultadoSecuencia estado = reorden->insertar(secuencia, valor, listas, numListas);
+
+    for (int i = 0; i < numListas; i++)
+    {
+        registrarValor(listas[i]);
+    }
+
+    if (estado == SECUENCIA_DUPLICADA || estado == SECUENCIA_TARDIA)
+    {
+        std::cout << "[" << nombre << "] Lectura #" << secuencia << " descartada ("
+                  << (estado == SECUENCIA_DUPLICADA ? "duplicada" : "tardia") << ")." << std::endl;
+    }
+    return estado;
+}
+
+int SensorBase::vaciarReordenamiento()
+{
+    if (reorden == nullptr || reorden->getPendientes() == 0)
+    {
+        return 0;
+    }
+
+    double listas[BufferReordenamiento::VENTANA];
+    int numListas = reorden->vaciar(listas);
+    for (int i = 0; i < numListas; i++)
+    {
+        registrarValor(listas[i]);
+    }
+    return numListas;
+}
+
+const BufferReordenamiento *SensorBase::getReordenamiento() const
+{
+    return reorden;
+}
+
+void SensorBase::escribirReporte(EscritorReporte &escritor, FormatoReporte formato, int limite) const
+{
+    ArregloLecturas lecturas(*this);
+
+    if (formato == REPORTE_TEXTO)
+    {
+        escritor << "\n=== Sensor " << getTipo() << " ===\n"
+                 << "ID: " << nombre << '\n'
+                 << "Lecturas almacenadas: " << lecturas.getContador() << '\n';
+        escribirLecturas(escritor, lecturas, formato, nombre, getTipo(), limite);
+    }
+    else if (formato == REPORTE_JSON)
+    {
+        abrirReporteJSON(escritor);
+        cerrarReporteJSON(escritor, escribirLecturas(escritor, lecturas, formato, nombre, getTipo(), limite));
+    }
+    else
+    {
+        escribirLecturas(escritor, lecturas, formato, nombre, getTipo(), limite);
+    }
+}
+
+void SensorBase::abrirReporteJSON(EscritorReporte &escritor) const
+{
+    escritor << "{\"sensor\":";
+    escritor.cadenaJSON(nombre) << ",\"tipo\":";
+    escritor.cadenaJSON(getTipo()) << ",\"lecturas\":";
+}
+
+void SensorBase::cerrarReporteJSON(EscritorReporte &escritor, int omitidas) const
+{
+    escritor << ",\"omitidas\":" << omitidas << "}\n";
+}
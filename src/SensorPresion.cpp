@@ -6,9 +6,10 @@
  */
 
 #include "SensorPresion.h"
+#include "Trazas.h"
 
 SensorPresion::SensorPresion(const char *nombreSensor)
-    : SensorBase(nombreSensor)
+    : SensorBase(nombreSensor), saturadas(0)
 {
     std::cout << "[Log] SensorPresion '" << nombre << "' creado." << std::endl;
 }
@@ -21,14 +22,35 @@ SensorPresion::~SensorPresion()
 
 void SensorPresion::registrarLectura(int presion)
 {
-    historial.insertar(presion);
-    std::cout << "[" << nombre << "] Lectura registrada: "
-              << presion << " PSI" << std::endl;
+    if (PuntoFijo16<1>::satura(presion))
+    {
+        saturadas++;
+        std::cout << "  [Advertencia] [" << nombre << "] Lectura " << presion
+                  << " PSI fuera del rango del historial; se guarda "
+                  << static_cast<double>(PuntoFijo16<1>(presion)) << " PSI." << std::endl;
+    }
+    {
+        TramoTraza tramo(ETAPA_INSERCION);
+        historial.insertar(presion);
+        ventana.agregar(presion);
+    }
+    if (!silencioso)
+    {
+        std::cout << "[" << nombre << "] Lectura registrada: "
+                  << presion << " PSI" << std::endl;
+    }
+    notificarLectura(presion);
 }
 
 void SensorPresion::procesarLectura()
 {
-    std::cout << "\n-> Procesando Sensor " << nombre << " (Presion)..." << std::endl;
+    if (!silencioso)
+    {
+        std::cout << "\n-> Procesando Sensor " << nombre << " (Presion)..." << std::endl;
+        ventana.imprimir("[Sensor Presion]", "PSI");
+    }
+    resultado.valido = false;
+    resultado.lecturas = 0;
 
     if (historial.estaVacia())
     {
@@ -37,17 +59,106 @@ void SensorPresion::procesarLectura()
     }
 
     // Calcular promedio de todas las lecturas
-    float promedio = historial.calcularPromedio();
-    std::cout << "  [Sensor Presion] Promedio calculado sobre "
-              << historial.getContador() << " lectura(s): "
-              << promedio << " PSI" << std::endl;
+    double promedio = historial.calcularPromedio();
+    if (!silencioso)
+    {
+        std::cout << "  [Sensor Presion] Promedio calculado sobre "
+                  << historial.getContador() << " lectura(s): "
+                  << promedio << " PSI" << std::endl;
+        std::cout << "  [Sensor Presion] Rango: " << historial.getMinimo()
+                  << " - " << historial.getMaximo() << " PSI" << std::endl;
+        if (saturadas > 0)
+        {
+            std::cout << "  [Sensor Presion] Lecturas saturadas en el historial: "
+                      << saturadas << std::endl;
+        }
+    }
+    resultado.valido = true;
+    resultado.lecturas = historial.getContador();
+    resultado.valor = promedio;
+    resultado.dispersion = historial.getMaximo() - historial.getMinimo();
 }
 
 void SensorPresion::imprimirInfo() const
 {
-    std::cout << "\n=== Sensor de Presion ===" << std::endl;
-    std::cout << "ID: " << nombre << std::endl;
-    std::cout << "Tipo: Presion (int)" << std::endl;
-    std::cout << "Lecturas almacenadas: " << historial.getContador() << std::endl;
-    historial.imprimir();
-}
\ No newline at end of file
+    EscritorReporte &salida = EscritorReporte::salidaEstandar();
+    escribirReporte(salida, REPORTE_TEXTO, 0);
+    salida.vaciar();
+}
+
+void SensorPresion::escribirReporte(EscritorReporte &escritor, FormatoReporte formato, int limite) const
+{
+    if (formato == REPORTE_JSON)
+    {
+        abrirReporteJSON(escritor);
+        cerrarReporteJSON(escritor, escribirLecturas(escritor, historial, formato, nombre, getTipo(), limite));
+        return;
+    }
+
+    if (formato == REPORTE_TEXTO)
+    {
+        escritor << "\n=== Sensor de Presion ===\n"
+                 << "ID: " << nombre << '\n'
+                 << "Tipo: Presion (PSI enteros, 16 bits)\n"
+                 << "Lecturas almacenadas: " << historial.getContador() << '\n';
+        if (saturadas > 0)
+        {
+            escritor << "Lecturas saturadas: " << saturadas << '\n';
+        }
+    }
+    escribirLecturas(escritor, historial, formato, nombre, getTipo(), limite);
+}
+
+const char *SensorPresion::getTipo() const
+{
+    return "PRES";
+}
+
+int SensorPresion::getNumLecturas() const
+{
+    return historial.getContador();
+}
+
+int SensorPresion::getLecturasSaturadas() const
+{
+    return saturadas;
+}
+
+int SensorPresion::copiarLecturas(double *destino, int maximo) const
+{
+    return historial.copiarEn(destino, maximo);
+}
+
+bool SensorPresion::configurarVentana(int tamano, double alfa)
+{
+    ventana.configurar(tamano, alfa);
+    return true;
+}
+
+bool SensorPresion::restaurarLecturas(const double *valores, int cantidad)
+{
+    restaurarEn(historial, ventana, valores, cantidad);
+    return true;
+}
+
+std::size_t SensorPresion::getBytesMemoria() const
+{
+    return sizeof(*this) + getBytesReordenamiento() + historial.getBytesReservados() + ventana.getBytesReservados();
+}
+
+int SensorPresion::descartarLecturasAntiguas(int segmentos)
+{
+    return descartarSegmentos(historial, segmentos);
+}
+
+bool SensorPresion::registrarValor(double valor)
+{
+    registrarLectura(static_cast<int>(valor));
+    return true;
+}
+
+void SensorPresion::setSilencioso(bool activo)
+{
+    SensorBase::setSilencioso(activo);
+    historial.setSilenciosa(activo);
+}
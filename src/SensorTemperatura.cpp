@@ -6,9 +6,12 @@
  */
 
 #include "SensorTemperatura.h"
+#include "Trazas.h"
+#include "AlgoritmosLista.h"
+#include <cmath>
 
 SensorTemperatura::SensorTemperatura(const char *nombreSensor)
-    : SensorBase(nombreSensor)
+    : SensorBase(nombreSensor), saturadas(0)
 {
     std::cout << "[Log] SensorTemperatura '" << nombre << "' creado." << std::endl;
 }
@@ -21,14 +24,35 @@ SensorTemperatura::~SensorTemperatura()
 
 void SensorTemperatura::registrarLectura(float temperatura)
 {
-    historial.insertar(temperatura);
-    std::cout << "[" << nombre << "] Lectura registrada: "
-              << temperatura << " °C" << std::endl;
+    if (PuntoFijo16<10>::satura(temperatura))
+    {
+        saturadas++;
+        std::cout << "  [Advertencia] [" << nombre << "] Lectura " << temperatura
+                  << " °C fuera del rango del historial; se guarda "
+                  << static_cast<double>(PuntoFijo16<10>(temperatura)) << " °C." << std::endl;
+    }
+    {
+        TramoTraza tramo(ETAPA_INSERCION);
+        historial.insertar(temperatura);
+        ventana.agregar(temperatura);
+    }
+    if (!silencioso)
+    {
+        std::cout << "[" << nombre << "] Lectura registrada: "
+                  << temperatura << " °C" << std::endl;
+    }
+    notificarLectura(temperatura);
 }
 
 void SensorTemperatura::procesarLectura()
 {
-    std::cout << "\n-> Procesando Sensor " << nombre << " (Temperatura)..." << std::endl;
+    if (!silencioso)
+    {
+        std::cout << "\n-> Procesando Sensor " << nombre << " (Temperatura)..." << std::endl;
+        ventana.imprimir("[Sensor Temp]", "°C");
+    }
+    resultado.valido = false;
+    resultado.lecturas = 0;
 
     if (historial.estaVacia())
     {
@@ -38,18 +62,33 @@ void SensorTemperatura::procesarLectura()
 
     // Eliminar el valor más bajo
     float minimo = historial.eliminarMinimo();
-    std::cout << "  [Sensor Temp] Lectura mas baja (" << minimo
-              << " °C) eliminada." << std::endl;
+    if (!silencioso)
+    {
+        std::cout << "  [Sensor Temp] Lectura mas baja (" << minimo
+                  << " °C) eliminada." << std::endl;
+    }
 
     // Calcular promedio de los valores restantes
     if (!historial.estaVacia())
     {
-        float promedio = historial.calcularPromedio();
-        std::cout << "  [Sensor Temp] Promedio calculado sobre "
-                  << historial.getContador() << " lectura(s): "
-                  << promedio << " °C" << std::endl;
+        double promedio = historial.calcularPromedio();
+        if (!silencioso)
+        {
+            std::cout << "  [Sensor Temp] Promedio calculado sobre "
+                      << historial.getContador() << " lectura(s): "
+                      << promedio << " °C" << std::endl;
+            if (saturadas > 0)
+            {
+                std::cout << "  [Sensor Temp] Lecturas saturadas en el historial: "
+                          << saturadas << std::endl;
+            }
+        }
+        resultado.valido = true;
+        resultado.lecturas = historial.getContador();
+        resultado.valor = promedio;
+        resultado.dispersion = 0.0; // La desviación estándar va en el reporte
     }
-    else
+    else if (!silencioso)
     {
         std::cout << "  [Sensor Temp] No quedan lecturas despues de eliminar el minimo."
                   << std::endl;
@@ -58,9 +97,102 @@ void SensorTemperatura::procesarLectura()
 
 void SensorTemperatura::imprimirInfo() const
 {
-    std::cout << "\n=== Sensor de Temperatura ===" << std::endl;
-    std::cout << "ID: " << nombre << std::endl;
-    std::cout << "Tipo: Temperatura (float)" << std::endl;
-    std::cout << "Lecturas almacenadas: " << historial.getContador() << std::endl;
-    historial.imprimir();
-}
\ No newline at end of file
+    EscritorReporte &salida = EscritorReporte::salidaEstandar();
+    escribirReporte(salida, REPORTE_TEXTO, 0);
+    salida.vaciar();
+}
+
+void SensorTemperatura::escribirReporte(EscritorReporte &escritor, FormatoReporte formato, int limite) const
+{
+    if (formato == REPORTE_JSON)
+    {
+        abrirReporteJSON(escritor);
+        cerrarReporteJSON(escritor, escribirLecturas(escritor, historial, formato, nombre, getTipo(), limite));
+        return;
+    }
+
+    if (formato == REPORTE_TEXTO)
+    {
+        escritor << "\n=== Sensor de Temperatura ===\n"
+                 << "ID: " << nombre << '\n'
+                 << "Tipo: Temperatura (decimas de grado, 16 bits)\n"
+                 << "Lecturas almacenadas: " << historial.getContador() << '\n';
+        if (saturadas > 0)
+        {
+            escritor << "Lecturas saturadas: " << saturadas << '\n';
+        }
+        if (historial.getContador() > 1)
+        {
+            escritor << "Desviacion estandar: ";
+            escritor.real(calcularDesviacion(), 6) << " °C\n";
+        }
+    }
+    escribirLecturas(escritor, historial, formato, nombre, getTipo(), limite);
+}
+
+const char *SensorTemperatura::getTipo() const
+{
+    return "TEMP";
+}
+
+int SensorTemperatura::getNumLecturas() const
+{
+    return historial.getContador();
+}
+
+double SensorTemperatura::calcularDesviacion() const
+{
+    if (historial.getContador() < 2)
+    {
+        return 0.0;
+    }
+
+    // Recorrido por segmentos: en historiales largos se reparte entre hilos
+    double media = sumarSegmentos(politicaHistorial(), historial) / historial.getContador();
+    double cuadrados = sumaCuadradosSegmentos(politicaHistorial(), historial, media);
+    return std::sqrt(cuadrados / (historial.getContador() - 1));
+}
+
+int SensorTemperatura::getLecturasSaturadas() const
+{
+    return saturadas;
+}
+
+int SensorTemperatura::copiarLecturas(double *destino, int maximo) const
+{
+    return historial.copiarEn(destino, maximo);
+}
+
+bool SensorTemperatura::configurarVentana(int tamano, double alfa)
+{
+    ventana.configurar(tamano, alfa);
+    return true;
+}
+
+bool SensorTemperatura::restaurarLecturas(const double *valores, int cantidad)
+{
+    restaurarEn(historial, ventana, valores, cantidad);
+    return true;
+}
+
+std::size_t SensorTemperatura::getBytesMemoria() const
+{
+    return sizeof(*this) + getBytesReordenamiento() + historial.getBytesReservados() + ventana.getBytesReservados();
+}
+
+int SensorTemperatura::descartarLecturasAntiguas(int segmentos)
+{
+    return descartarSegmentos(historial, segmentos);
+}
+
+bool SensorTemperatura::registrarValor(double valor)
+{
+    registrarLectura(static_cast<float>(valor));
+    return true;
+}
+
+void SensorTemperatura::setSilencioso(bool activo)
+{
+    SensorBase::setSilencioso(activo);
+    historial.setSilenciosa(activo);
+}
@@ -0,0 +1,414 @@
+/**
+ * @file SensorVibracion.cpp
+ * @brief Implementación del sensor de vibración y sus kernels de señal
+ * @author FabiRamiro
+ * @date 2026-10-18
+ */
+
+#include "SensorVibracion.h"
+#include "Trazas.h"
+#include <cmath>
+#include <cstring>
+
+namespace
+{
+    const int N = SensorVibracion::TAM_VENTANA;
+
+    /**
+     * @brief Tablas precalculadas de la FFT (ventana de Hann, bit-reverso y giros)
+     *
+     * Los factores de giro se guardan por etapa y de forma contigua, para
+     * que el bucle de mariposas recorra todo con paso unitario y el
+     * compilador lo pueda vectorizar.
+     */
+    struct TablasFFT
+    {
+        float hann[N];       ///< Ventana de Hann
+        int bitReverso[N];   ///< Permutación de entrada
+        float girosRe[N];    ///< cos de cada etapa (etapa de longitud L en [L/2-1, L-1))
+        float girosIm[N];    ///< -sin de cada etapa
+
+        TablasFFT()
+        {
+            const double PI = 3.14159265358979323846;
+            int bits = 0;
+            while ((1 << bits) < N)
+            {
+                bits++;
+            }
+
+            for (int i = 0; i < N; i++)
+            {
+                hann[i] = static_cast<float>(0.5 - 0.5 * std::cos(2.0 * PI * i / (N - 1)));
+
+                int r = 0;
+                for (int b = 0; b < bits; b++)
+                {
+                    r |= ((i >> b) & 1) << (bits - 1 - b);
+                }
+                bitReverso[i] = r;
+            }
+
+            for (int longitud = 2; longitud <= N; longitud <<= 1)
+            {
+                int mitad = longitud / 2;
+                for (int k = 0; k < mitad; k++)
+                {
+                    double angulo = -2.0 * PI * k / longitud;
+                    girosRe[mitad - 1 + k] = static_cast<float>(std::cos(angulo));
+                    girosIm[mitad - 1 + k] = static_cast<float>(std::sin(angulo));
+                }
+            }
+        }
+    };
+
+    const TablasFFT tablas;
+
+    /**
+     * @brief Suma de cuadrados (kernel vectorizable)
+     */
+    float sumaCuadrados(const float *__restrict x, int n)
+    {
+        float suma = 0.0f;
+        for (int i = 0; i < n; i++)
+        {
+            suma += x[i] * x[i];
+        }
+        return suma;
+    }
+
+    /**
+     * @brief Máximo valor absoluto de enteros (kernel vectorizable)
+     */
+    int picoAbsoluto(const int *__restrict x, int n)
+    {
+        int pico = 0;
+        for (int i = 0; i < n; i++)
+        {
+            int a = x[i] < 0 ? -x[i] : x[i];
+            pico = a > pico ? a : pico;
+        }
+        return pico;
+    }
+
+    /**
+     * @brief FFT radix-2 iterativa en formato SoA (partes real e imaginaria separadas)
+     */
+    void fftRadix2(float *__restrict re, float *__restrict im)
+    {
+        for (int longitud = 2; longitud <= N; longitud <<= 1)
+        {
+            int mitad = longitud / 2;
+            const float *wRe = tablas.girosRe + mitad - 1;
+            const float *wIm = tablas.girosIm + mitad - 1;
+
+            for (int inicio = 0; inicio < N; inicio += longitud)
+            {
+                float *aRe = re + inicio;
+                float *aIm = im + inicio;
+                float *bRe = re + inicio + mitad;
+                float *bIm = im + inicio + mitad;
+
+                for (int k = 0; k < mitad; k++)
+                {
+                    float tRe = bRe[k] * wRe[k] - bIm[k] * wIm[k];
+                    float tIm = bRe[k] * wIm[k] + bIm[k] * wRe[k];
+                    bRe[k] = aRe[k] - tRe;
+                    bIm[k] = aIm[k] - tIm;
+                    aRe[k] = aRe[k] + tRe;
+                    aIm[k] = aIm[k] + tIm;
+                }
+            }
+        }
+    }
+}
+
+SensorVibracion::SensorVibracion(const char *nombreSensor)
+    : SensorBase(nombreSensor), muestras(nullptr), numMuestras(0), capacidadMuestras(0),
+      descartadas(0), ultimoRMS(0.0f), ultimoPico(0), ventanasProcesadas(0)
+{
+    for (int b = 0; b < NUM_BANDAS; b++)
+    {
+        ultimasBandas[b] = 0.0f;
+    }
+    std::cout << "[Log] SensorVibracion '" << nombre << "' creado." << std::endl;
+}
+
+SensorVibracion::~SensorVibracion()
+{
+    std::cout << "[Destructor SensorVibracion] Liberando buffer y lista interna de '"
+              << nombre << "'..." << std::endl;
+    delete[] muestras;
+}
+
+void SensorVibracion::registrarLectura(int cuenta)
+{
+    registrarBloque(&cuenta, 1);
+}
+
+void SensorVibracion::registrarBloque(const int *cuentas, int cantidad)
+{
+    if (cuentas == nullptr || cantidad <= 0)
+    {
+        return;
+    }
+
+    {
+        TramoTraza tramo(ETAPA_INSERCION);
+
+        // Si el bloque no cabe bajo el tope, se descartan las muestras más antiguas
+        if (numMuestras + cantidad > MAX_MUESTRAS_PENDIENTES)
+        {
+            int exceso = numMuestras + cantidad - MAX_MUESTRAS_PENDIENTES;
+            if (exceso >= numMuestras)
+            {
+                descartadas += numMuestras;
+                numMuestras = 0;
+                if (cantidad > MAX_MUESTRAS_PENDIENTES)
+                {
+                    descartadas += cantidad - MAX_MUESTRAS_PENDIENTES;
+                    cuentas += cantidad - MAX_MUESTRAS_PENDIENTES;
+                    cantidad = MAX_MUESTRAS_PENDIENTES;
+                }
+            }
+            else
+            {
+                std::memmove(muestras, muestras + exceso, (numMuestras - exceso) * sizeof(int));
+                numMuestras -= exceso;
+                descartadas += exceso;
+            }
+        }
+
+        if (numMuestras + cantidad > capacidadMuestras)
+        {
+            int nuevaCapacidad = (capacidadMuestras == 0) ? TAM_VENTANA : capacidadMuestras;
+            while (nuevaCapacidad < numMuestras + cantidad)
+            {
+                nuevaCapacidad *= 2;
+            }
+
+            int *nuevas = new int[nuevaCapacidad];
+            if (numMuestras > 0)
+            {
+                std::memcpy(nuevas, muestras, numMuestras * sizeof(int));
+            }
+            delete[] muestras;
+            muestras = nuevas;
+            capacidadMuestras = nuevaCapacidad;
+        }
+
+        std::memcpy(muestras + numMuestras, cuentas, cantidad * sizeof(int));
+        numMuestras += cantidad;
+    }
+
+    if (!silencioso)
+    {
+        std::cout << "[" << nombre << "] Bloque registrado: " << cantidad
+                  << " muestra(s), " << numMuestras << " pendiente(s)" << std::endl;
+    }
+    notificarBloque(cuentas, cantidad);
+}
+
+void SensorVibracion::analizarVentana(const int *ventana)
+{
+    float re[N];
+    float im[N];
+    float crudo[N];
+
+    // Conversión a float y eliminación de la componente continua
+    float media = 0.0f;
+    for (int i = 0; i < N; i++)
+    {
+        crudo[i] = static_cast<float>(ventana[i]);
+        media += crudo[i];
+    }
+    media /= N;
+    for (int i = 0; i < N; i++)
+    {
+        crudo[i] -= media;
+    }
+
+    ultimoRMS = std::sqrt(sumaCuadrados(crudo, N) / N);
+    ultimoPico = picoAbsoluto(ventana, N);
+
+    // Ventana de Hann + permutación bit-reverso hacia el formato SoA
+    for (int i = 0; i < N; i++)
+    {
+        int j = tablas.bitReverso[i];
+        re[j] = crudo[i] * tablas.hann[i];
+        im[j] = 0.0f;
+    }
+
+    fftRadix2(re, im);
+
+    // Energía por bandas iguales sobre los bins 1..N/2-1
+    float potencia[N / 2];
+    for (int k = 0; k < N / 2; k++)
+    {
+        potencia[k] = (re[k] * re[k] + im[k] * im[k]) / N;
+    }
+
+    const int binsPorBanda = (N / 2) / NUM_BANDAS;
+    for (int b = 0; b < NUM_BANDAS; b++)
+    {
+        float energia = 0.0f;
+        const float *p = potencia + b * binsPorBanda;
+        for (int k = 0; k < binsPorBanda; k++)
+        {
+            energia += p[k];
+        }
+        ultimasBandas[b] = energia;
+    }
+    ultimasBandas[0] -= potencia[0]; // El bin 0 (continua) no cuenta como vibración
+
+    historial.insertar(ultimoRMS);
+    ventanaRMS.agregar(ultimoRMS);
+    ventanasProcesadas++;
+}
+
+void SensorVibracion::procesarLectura()
+{
+    if (!silencioso)
+    {
+        std::cout << "\n-> Procesando Sensor " << nombre << " (Vibracion)..." << std::endl;
+    }
+
+    if (numMuestras < TAM_VENTANA)
+    {
+        std::cout << "  [Advertencia] Muestras insuficientes para una ventana ("
+                  << numMuestras << "/" << TAM_VENTANA << ")." << std::endl;
+        return;
+    }
+
+    int ventanas = numMuestras / TAM_VENTANA;
+    for (int v = 0; v < ventanas; v++)
+    {
+        analizarVentana(muestras + v * TAM_VENTANA);
+    }
+
+    // Las muestras sobrantes pasan al inicio del buffer
+    int usadas = ventanas * TAM_VENTANA;
+    std::memmove(muestras, muestras + usadas, (numMuestras - usadas) * sizeof(int));
+    numMuestras -= usadas;
+
+    resultado.valido = true;
+    resultado.lecturas = historial.getContador();
+    resultado.valor = ultimoRMS;
+    resultado.dispersion = ultimoPico;
+    if (silencioso)
+    {
+        return;
+    }
+
+    std::cout << "  [Sensor Vib] " << ventanas << " ventana(s) de " << TAM_VENTANA
+              << " muestras. Ultima: RMS = " << ultimoRMS
+              << ", Pico = " << ultimoPico << std::endl;
+    std::cout << "  [Sensor Vib] Energia por banda:";
+    for (int b = 0; b < NUM_BANDAS; b++)
+    {
+        std::cout << " " << ultimasBandas[b];
+    }
+    std::cout << std::endl;
+    ventanaRMS.imprimir("[Sensor Vib] RMS", "cuentas");
+}
+
+void SensorVibracion::imprimirInfo() const
+{
+    EscritorReporte &salida = EscritorReporte::salidaEstandar();
+    escribirReporte(salida, REPORTE_TEXTO, 0);
+    salida.vaciar();
+}
+
+void SensorVibracion::escribirReporte(EscritorReporte &escritor, FormatoReporte formato, int limite) const
+{
+    if (formato == REPORTE_JSON)
+    {
+        abrirReporteJSON(escritor);
+        cerrarReporteJSON(escritor, escribirLecturas(escritor, historial, formato, nombre, getTipo(), limite));
+        return;
+    }
+
+    if (formato == REPORTE_TEXTO)
+    {
+        escritor << "\n=== Sensor de Vibracion ===\n"
+                 << "ID: " << nombre << '\n'
+                 << "Tipo: Vibracion (int, por bloques)\n"
+                 << "Muestras pendientes: " << numMuestras
+                 << " | Ventanas procesadas: " << ventanasProcesadas
+                 << " | Descartadas: " << descartadas << '\n'
+                 << "RMS por ventana (" << historial.getContador() << "):\n";
+        if (!historial.estaVacia())
+        {
+            escritor << "  RMS medio: ";
+            escritor.real(historial.calcularPromedio(), 6) << " | Desviacion: ";
+            escritor.real(historial.getDesviacion(), 6) << '\n';
+        }
+    }
+    escribirLecturas(escritor, historial, formato, nombre, getTipo(), limite);
+}
+
+const char *SensorVibracion::getTipo() const
+{
+    return "VIB";
+}
+
+int SensorVibracion::getNumLecturas() const
+{
+    return historial.getContador();
+}
+
+int SensorVibracion::copiarLecturas(double *destino, int maximo) const
+{
+    return historial.copiarEn(destino, maximo);
+}
+
+int SensorVibracion::getMuestrasPendientes() const
+{
+    return numMuestras;
+}
+
+bool SensorVibracion::configurarVentana(int tamano, double alfa)
+{
+    ventanaRMS.configurar(tamano, alfa);
+    return true;
+}
+
+bool SensorVibracion::restaurarLecturas(const double *valores, int cantidad)
+{
+    ventanasProcesadas += cantidad;
+    restaurarEn(historial, ventanaRMS, valores, cantidad);
+    return true;
+}
+
+int SensorVibracion::copiarMuestrasPendientes(int *destino, int maximo) const
+{
+    int n = (numMuestras < maximo) ? numMuestras : maximo;
+    if (n > 0)
+    {
+        std::memcpy(destino, muestras, n * sizeof(int));
+    }
+    return n;
+}
+
+std::size_t SensorVibracion::getBytesMemoria() const
+{
+    return sizeof(*this) + getBytesReordenamiento() + historial.getBytesReservados() + ventanaRMS.getBytesReservados() +
+           static_cast<std::size_t>(capacidadMuestras) * sizeof(int);
+}
+
+int SensorVibracion::descartarLecturasAntiguas(int segmentos)
+{
+    return descartarSegmentos(historial, segmentos);
+}
+
+bool SensorVibracion::registrarValor(double valor)
+{
+    registrarLectura(static_cast<int>(valor));
+    return true;
+}
+
+void SensorVibracion::setSilencioso(bool activo)
+{
+    SensorBase::setSilencioso(activo);
+    historial.setSilenciosa(activo);
+}
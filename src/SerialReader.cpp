@@ -6,12 +6,13 @@
  */
 
 #include "SerialReader.h"
+#include "Trazas.h"
 #include <iostream>
 #include <cstdlib>
 #include <ctime>
 #include <cstring>
 
-SerialReader::SerialReader() : conectado(false)
+SerialReader::SerialReader() : conectado(false), modoBinario(false), secuenciaSimulada(0), fase(0)
 {
     // Inicializar generador de números aleatorios
     std::srand(static_cast<unsigned int>(std::time(nullptr)));
@@ -31,6 +32,7 @@ bool SerialReader::conectar(const char *puerto)
 
     // Simulación de conexión
     conectado = true;
+    decodificador.reiniciar();
 
     std::cout << "[SerialReader] Conectado exitosamente." << std::endl;
     return true;
@@ -47,6 +49,8 @@ void SerialReader::desconectar()
 
 bool SerialReader::leerLinea(char *buffer, int tamano)
 {
+    TramoTraza tramo(ETAPA_LECTURA);
+
     if (!conectado || buffer == nullptr || tamano <= 0)
     {
         return false;
@@ -54,9 +58,9 @@ bool SerialReader::leerLinea(char *buffer, int tamano)
 
     // Simulación de lectura de datos del ESP32
     // Formato esperado: "TIPO:ID:VALOR"
-    // Ejemplo: "TEMP:T-001:23.5" o "PRES:P-105:85"
+    // Ejemplo: "TEMP:T-001:23.5", "PRES:P-105:85" o "VIB:V-002:12,-40,..."
 
-    int tipoSensor = std::rand() % 2; // 0 = Temperatura, 1 = Presión
+    int tipoSensor = std::rand() % 3; // 0 = Temperatura, 1 = Presión, 2 = Vibración
 
     if (tipoSensor == 0)
     {
@@ -65,13 +69,24 @@ bool SerialReader::leerLinea(char *buffer, int tamano)
         std::snprintf(buffer, tamano, "TEMP:T-%03d:%.1f",
                       std::rand() % 100, temperatura);
     }
-    else
+    else if (tipoSensor == 1)
     {
         // Sensor de presión
         int presion = 50 + (std::rand() % 100); // 50 a 150 PSI
         std::snprintf(buffer, tamano, "PRES:P-%03d:%d",
                       std::rand() % 100, presion);
     }
+    else
+    {
+        // Sensor de vibración: bloque de muestras separadas por comas
+        int escritos = std::snprintf(buffer, tamano, "VIB:V-%03d:", std::rand() % 4);
+        for (int i = 0; i < 32 && escritos < tamano - 8; i++)
+        {
+            int cuenta = simularMuestraVibracion();
+            escritos += std::snprintf(buffer + escritos, tamano - escritos,
+                                      (i == 0) ? "%d" : ",%d", cuenta);
+        }
+    }
 
     return true;
 }
@@ -81,4 +96,116 @@ bool SerialReader::hayDatos() const
     // En una implementación real, verificaría si hay bytes disponibles
     // Para simulación, siempre retorna true si está conectado
     return conectado;
-}
\ No newline at end of file
+}
+
+void SerialReader::setModoBinario(bool binario)
+{
+    modoBinario = binario;
+    decodificador.reiniciar();
+}
+
+bool SerialReader::esModoBinario() const
+{
+    return modoBinario;
+}
+
+const DecodificadorTramas &SerialReader::getDecodificador() const
+{
+    return decodificador;
+}
+
+bool SerialReader::leerLectura(LecturaBinaria &lectura)
+{
+    TramoTraza tramo(ETAPA_LECTURA);
+
+    if (!conectado || !modoBinario)
+    {
+        return false;
+    }
+
+    // Intentar primero con lo que ya está en el buffer del decodificador
+    while (!decodificador.siguienteLectura(lectura))
+    {
+        unsigned char bytes[TAM_MAX_TRAMA + 8];
+        int total = simularBytes(bytes);
+
+        // Entregar los bytes en trozos irregulares, como llegan por el puerto
+        int pos = 0;
+        while (pos < total)
+        {
+            int trozo = 1 + std::rand() % 64;
+            if (trozo > total - pos)
+            {
+                trozo = total - pos;
+            }
+            int aceptados = decodificador.alimentar(bytes + pos, trozo);
+            if (aceptados == 0)
+            {
+                break; // Buffer lleno: el resto se pierde como en un UART saturado
+            }
+            pos += aceptados;
+        }
+    }
+
+    return true;
+}
+
+int SerialReader::simularMuestraVibracion()
+{
+    // Senoidal de 1/16 de la frecuencia de muestreo más ruido
+    static const int tabla[16] = {0, 383, 707, 924, 1000, 924, 707, 383,
+                                  0, -383, -707, -924, -1000, -924, -707, -383};
+    fase = (fase + 1) & 15;
+    return tabla[fase] + (std::rand() % 201) - 100;
+}
+
+int SerialReader::simularBytes(unsigned char *destino)
+{
+    int pos = 0;
+
+    // Ruido ocasional entre tramas (1 de cada 8)
+    if (std::rand() % 8 == 0)
+    {
+        int ruido = 1 + std::rand() % 8;
+        for (int i = 0; i < ruido; i++)
+        {
+            destino[pos++] = static_cast<unsigned char>(std::rand() & 0xFF);
+        }
+    }
+
+    // Lote de 1 a 8 lecturas por trama
+    LecturaBinaria lote[8];
+    int cantidad = 1 + std::rand() % 8;
+    for (int i = 0; i < cantidad; i++)
+    {
+        int tipoSensor = std::rand() % 3;
+        lote[i].id = static_cast<unsigned short>(std::rand() % 100);
+        if (tipoSensor == 0)
+        {
+            lote[i].tipo = TRAMA_TEMP;
+            lote[i].valorCrudo = 150 + std::rand() % 300; // 15.0 a 45.0 °C en décimas
+        }
+        else if (tipoSensor == 1)
+        {
+            lote[i].tipo = TRAMA_PRES;
+            lote[i].valorCrudo = 50 + std::rand() % 100; // 50 a 150 PSI
+        }
+        else
+        {
+            lote[i].tipo = TRAMA_VIB;
+            lote[i].valorCrudo = simularMuestraVibracion();
+            lote[i].id = static_cast<unsigned short>(std::rand() % 4);
+        }
+        lote[i].secuencia = 0;
+    }
+
+    int longitud = codificarTrama(lote, cantidad, secuenciaSimulada++, destino + pos);
+
+    // Corrupción ocasional de un byte de la trama (1 de cada 16)
+    if (std::rand() % 16 == 0)
+    {
+        destino[pos + 1 + std::rand() % (longitud - 1)] ^= 0x5A;
+    }
+
+    return pos + longitud;
+}
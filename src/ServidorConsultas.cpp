@@ -0,0 +1,771 @@
+/**
+ * @file ServidorConsultas.cpp
+ * @brief Implementación del servidor de consultas sobre socket Unix
+ * @author FabiRamiro
+ * @date 2026-10-18
+ */
+
+#include "ServidorConsultas.h"
+#include "Instantaneas.h"
+#include <iostream>
+#include <algorithm>
+#include <cstring>
+#include <cerrno>
+
+#ifdef __linux__
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#endif
+
+namespace
+{
+    const unsigned int ID_ESCUCHA = ServidorConsultas::MAX_CLIENTES;         ///< Evento del socket de escucha
+    const unsigned int ID_DESPERTADOR = ServidorConsultas::MAX_CLIENTES + 1; ///< Evento de parada
+
+    /**
+     * @brief Compara un nombre terminado en nulo con uno de largo fijo
+     * @return <0, 0 o >0 como strcmp
+     */
+    int compararNombre(const char *nombre, const char *otro, int largo)
+    {
+        int r = std::strncmp(nombre, otro, largo);
+        if (r != 0)
+        {
+            return r;
+        }
+        return (nombre[largo] == '\0') ? 0 : 1;
+    }
+
+    /**
+     * @brief Valor de un sensor según el campo de top-k
+     */
+    double valorCampo(const InstantaneaSensor &s, int campo)
+    {
+        switch (campo)
+        {
+        case TOPK_MINIMO:
+            return s.minimo;
+        case TOPK_MAXIMO:
+            return s.maximo;
+        case TOPK_ULTIMA:
+            return s.valores[s.numLecturas - 1];
+        case TOPK_LECTURAS:
+            return s.numLecturas;
+        default:
+            return s.promedio;
+        }
+    }
+}
+
+ServidorConsultas::ServidorConsultas(PublicadorInstantaneas &origen)
+    : publicador(origen), escucha(-1), epollFd(-1), despertador(-1), activo(false), ranuraLector(-1),
+      indiceNombres(nullptr), capacidadIndice(0), numIndexados(0), numeroIndexado(0), hayIndice(false),
+      auxiliar(nullptr), capacidadAuxiliar(0), peticiones(0), lotes(0), conectados(0)
+{
+    ruta[0] = '\0';
+    for (int c = 0; c < MAX_CLIENTES; c++)
+    {
+        clientes[c].fd = -1;
+        clientes[c].entrada = nullptr;
+        clientes[c].salida = nullptr;
+    }
+}
+
+ServidorConsultas::~ServidorConsultas()
+{
+    detener();
+    delete[] indiceNombres;
+    delete[] auxiliar;
+}
+
+bool ServidorConsultas::iniciar(const char *rutaSocket)
+{
+    detener();
+
+#ifndef __linux__
+    (void)rutaSocket;
+    std::cout << "[Consultas] El servidor requiere Linux (epoll y sockets Unix)." << std::endl;
+    return false;
+#else
+    if (rutaSocket == nullptr || rutaSocket[0] == '\0' || std::strlen(rutaSocket) >= TAM_RUTA)
+    {
+        return false;
+    }
+    std::strcpy(ruta, rutaSocket);
+
+    escucha = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (escucha < 0)
+    {
+        return false;
+    }
+
+    struct sockaddr_un direccion;
+    std::memset(&direccion, 0, sizeof(direccion));
+    direccion.sun_family = AF_UNIX;
+    std::memcpy(direccion.sun_path, ruta, std::strlen(ruta));
+
+    unlink(ruta); // Socket de una ejecución anterior
+    if (bind(escucha, reinterpret_cast<struct sockaddr *>(&direccion), sizeof(direccion)) < 0 ||
+        listen(escucha, MAX_CLIENTES) < 0)
+    {
+        std::cout << "[Consultas] No se pudo escuchar en " << ruta << " (" << std::strerror(errno) << ")."
+                  << std::endl;
+        close(escucha);
+        escucha = -1;
+        return false;
+    }
+
+    epollFd = epoll_create1(EPOLL_CLOEXEC);
+    despertador = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    struct epoll_event evento;
+    std::memset(&evento, 0, sizeof(evento));
+    evento.events = EPOLLIN;
+    evento.data.u32 = ID_ESCUCHA;
+    bool registrado = epollFd >= 0 && despertador >= 0 && epoll_ctl(epollFd, EPOLL_CTL_ADD, escucha, &evento) == 0;
+    evento.data.u32 = ID_DESPERTADOR;
+    registrado = registrado && epoll_ctl(epollFd, EPOLL_CTL_ADD, despertador, &evento) == 0;
+
+    ranuraLector = publicador.registrarLector();
+    if (!registrado || ranuraLector < 0)
+    {
+        detener();
+        return false;
+    }
+
+    activo.store(true);
+    hilo = std::thread(&ServidorConsultas::ejecutar, this);
+    return true;
+#endif
+}
+
+void ServidorConsultas::detener()
+{
+#ifdef __linux__
+    if (hilo.joinable())
+    {
+        activo.store(false);
+        unsigned long long uno = 1;
+        if (write(despertador, &uno, sizeof(uno)) < 0)
+        {
+            // El hilo igual sale en la próxima vuelta del bucle
+        }
+        hilo.join();
+    }
+
+    for (int c = 0; c < MAX_CLIENTES; c++)
+    {
+        if (clientes[c].fd >= 0)
+        {
+            cerrarCliente(c);
+        }
+    }
+    if (escucha >= 0)
+    {
+        close(escucha);
+        escucha = -1;
+        unlink(ruta);
+    }
+    if (epollFd >= 0)
+    {
+        close(epollFd);
+        epollFd = -1;
+    }
+    if (despertador >= 0)
+    {
+        close(despertador);
+        despertador = -1;
+    }
+#endif
+    if (ranuraLector >= 0)
+    {
+        publicador.liberarLector(ranuraLector);
+        ranuraLector = -1;
+    }
+    hayIndice = false;
+}
+
+bool ServidorConsultas::estaActivo() const
+{
+    return activo.load();
+}
+
+void ServidorConsultas::imprimirEstado() const
+{
+    std::cout << "\n--- Servidor de Consultas ---" << std::endl;
+    if (!activo.load())
+    {
+        std::cout << "Detenido." << std::endl;
+        return;
+    }
+    unsigned long long n = peticiones.load();
+    unsigned long long l = lotes.load();
+    std::cout << "Socket: " << ruta << " | Clientes: " << conectados.load() << " | Peticiones: " << n
+              << " | Lotes: " << l;
+    if (l > 0)
+    {
+        std::cout << " (" << static_cast<double>(n) / l << " peticion(es) por lote)";
+    }
+    std::cout << std::endl;
+}
+
+#ifdef __linux__
+
+void ServidorConsultas::ejecutar()
+{
+    struct epoll_event eventos[MAX_CLIENTES + 2];
+
+    while (activo.load())
+    {
+        int n = epoll_wait(epollFd, eventos, MAX_CLIENTES + 2, -1);
+        if (n < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            break;
+        }
+
+        for (int i = 0; i < n; i++)
+        {
+            unsigned int id = eventos[i].data.u32;
+            if (id == ID_DESPERTADOR)
+            {
+                continue;
+            }
+            if (id == ID_ESCUCHA)
+            {
+                aceptar();
+                continue;
+            }
+
+            int c = static_cast<int>(id);
+            if (clientes[c].fd < 0)
+            {
+                continue;
+            }
+
+            bool sigue = true;
+            if (eventos[i].events & EPOLLOUT)
+            {
+                // Salida drenada: retomar las peticiones que quedaron esperando
+                sigue = enviar(c);
+                if (sigue && !clientes[c].esperandoEscritura && clientes[c].usadosEntrada > 0)
+                {
+                    sigue = procesarLote(c) && enviar(c);
+                }
+            }
+            if (sigue && (eventos[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR)))
+            {
+                sigue = atenderLectura(c);
+            }
+            if (!sigue)
+            {
+                cerrarCliente(c);
+            }
+        }
+    }
+}
+
+void ServidorConsultas::aceptar()
+{
+    while (true)
+    {
+        int fd = accept4(escucha, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0)
+        {
+            return; // EAGAIN: no quedan conexiones pendientes
+        }
+
+        int c = 0;
+        while (c < MAX_CLIENTES && clientes[c].fd >= 0)
+        {
+            c++;
+        }
+        if (c == MAX_CLIENTES)
+        {
+            close(fd);
+            continue;
+        }
+
+        Cliente &cliente = clientes[c];
+        cliente.fd = fd;
+        cliente.entrada = new unsigned char[TAM_ENTRADA];
+        cliente.salida = new unsigned char[TAM_SALIDA];
+        cliente.usadosEntrada = 0;
+        cliente.usadosSalida = 0;
+        cliente.enviadosSalida = 0;
+        cliente.esperandoEscritura = false;
+        cliente.finEntrada = false;
+
+        struct epoll_event evento;
+        std::memset(&evento, 0, sizeof(evento));
+        evento.events = EPOLLIN | EPOLLRDHUP;
+        evento.data.u32 = static_cast<unsigned int>(c);
+        if (epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &evento) < 0)
+        {
+            cerrarCliente(c);
+            continue;
+        }
+        conectados++;
+    }
+}
+
+void ServidorConsultas::cerrarCliente(int c)
+{
+    Cliente &cliente = clientes[c];
+    if (cliente.fd < 0)
+    {
+        return;
+    }
+
+    epoll_ctl(epollFd, EPOLL_CTL_DEL, cliente.fd, nullptr);
+    close(cliente.fd);
+    cliente.fd = -1;
+    delete[] cliente.entrada;
+    delete[] cliente.salida;
+    cliente.entrada = nullptr;
+    cliente.salida = nullptr;
+    conectados--;
+}
+
+bool ServidorConsultas::atenderLectura(int c)
+{
+    Cliente &cliente = clientes[c];
+
+    while (cliente.usadosEntrada < TAM_ENTRADA)
+    {
+        ssize_t leidos = read(cliente.fd, cliente.entrada + cliente.usadosEntrada,
+                              TAM_ENTRADA - cliente.usadosEntrada);
+        if (leidos > 0)
+        {
+            cliente.usadosEntrada += static_cast<int>(leidos);
+            continue;
+        }
+        if (leidos == 0)
+        {
+            cliente.finEntrada = true; // Se responde lo que ya llegó antes de cerrar
+            break;
+        }
+        if (errno == EAGAIN || errno == EWOULDBLOCK)
+        {
+            break;
+        }
+        if (errno != EINTR)
+        {
+            return false;
+        }
+    }
+
+    return procesarLote(c) && enviar(c);
+}
+
+bool ServidorConsultas::procesarLote(int c)
+{
+    Cliente &cliente = clientes[c];
+    int pos = 0;
+    int respondidas = 0;
+
+    if (cliente.usadosEntrada >= TAM_CABECERA_PETICION)
+    {
+        // Una sola instantánea para todo el lote: respuestas coherentes entre sí
+        LectorInstantaneas vista(publicador, ranuraLector);
+
+        while (cliente.usadosEntrada - pos >= 4)
+        {
+            const unsigned char *p = cliente.entrada + pos;
+            std::uint32_t longitud = leerCampo<std::uint32_t>(p);
+            if (longitud < TAM_CABECERA_PETICION - 4 || longitud > MAX_PETICION - 4)
+            {
+                return false; // Desincronizado: no hay forma segura de seguir
+            }
+            int total = 4 + static_cast<int>(longitud);
+            if (cliente.usadosEntrada - pos < total)
+            {
+                break; // Petición incompleta: esperar el resto
+            }
+            if (TAM_SALIDA - cliente.usadosSalida < MAX_RESPUESTA)
+            {
+                break; // Salida llena: se sigue cuando el cliente lea
+            }
+
+            cliente.usadosSalida += responder(*vista, cliente.entrada + pos, total,
+                                              cliente.salida + cliente.usadosSalida);
+            pos += total;
+            respondidas++;
+        }
+    }
+
+    if (pos > 0)
+    {
+        std::memmove(cliente.entrada, cliente.entrada + pos, cliente.usadosEntrada - pos);
+        cliente.usadosEntrada -= pos;
+    }
+    if (respondidas > 0)
+    {
+        peticiones += respondidas;
+        lotes++;
+    }
+    return true;
+}
+
+bool ServidorConsultas::enviar(int c)
+{
+    Cliente &cliente = clientes[c];
+
+    while (cliente.enviadosSalida < cliente.usadosSalida)
+    {
+        ssize_t escritos = send(cliente.fd, cliente.salida + cliente.enviadosSalida,
+                                cliente.usadosSalida - cliente.enviadosSalida, MSG_NOSIGNAL);
+        if (escritos > 0)
+        {
+            cliente.enviadosSalida += static_cast<int>(escritos);
+            continue;
+        }
+        if (escritos < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+        {
+            break;
+        }
+        if (escritos < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        return false;
+    }
+
+    if (cliente.enviadosSalida == cliente.usadosSalida)
+    {
+        cliente.usadosSalida = 0;
+        cliente.enviadosSalida = 0;
+    }
+    else if (cliente.enviadosSalida > 0)
+    {
+        std::memmove(cliente.salida, cliente.salida + cliente.enviadosSalida,
+                     cliente.usadosSalida - cliente.enviadosSalida);
+        cliente.usadosSalida -= cliente.enviadosSalida;
+        cliente.enviadosSalida = 0;
+    }
+
+    // Con salida pendiente no se lee más entrada: así el cliente que no lee se frena solo
+    bool pendiente = cliente.usadosSalida > 0;
+    if (pendiente != cliente.esperandoEscritura)
+    {
+        struct epoll_event evento;
+        std::memset(&evento, 0, sizeof(evento));
+        evento.events = pendiente ? EPOLLOUT : (EPOLLIN | EPOLLRDHUP);
+        evento.data.u32 = static_cast<unsigned int>(c);
+        epoll_ctl(epollFd, EPOLL_CTL_MOD, cliente.fd, &evento);
+        cliente.esperandoEscritura = pendiente;
+    }
+
+    if (pendiente || !cliente.finEntrada)
+    {
+        return true;
+    }
+
+    // El cliente ya no envía: seguir solo si queda una petición completa por responder
+    if (cliente.usadosEntrada < 4)
+    {
+        return false;
+    }
+    const unsigned char *p = cliente.entrada;
+    return 4 + static_cast<long long>(leerCampo<std::uint32_t>(p)) <= cliente.usadosEntrada;
+}
+
+#endif // __linux__
+
+void ServidorConsultas::normalizarRango(int total, int &desde, int &hasta)
+{
+    desde = (desde < 0) ? total + desde : desde;
+    hasta = (hasta <= 0) ? total + hasta : hasta;
+    desde = (desde < 0) ? 0 : (desde > total ? total : desde);
+    hasta = (hasta < desde) ? desde : (hasta > total ? total : hasta);
+}
+
+void ServidorConsultas::actualizarIndice(const InstantaneaFlota &vista)
+{
+    if (hayIndice && numeroIndexado == vista.numero)
+    {
+        return;
+    }
+
+    if (vista.numSensores > capacidadIndice)
+    {
+        delete[] indiceNombres;
+        capacidadIndice = vista.numSensores * 2;
+        indiceNombres = new int[capacidadIndice];
+    }
+
+    numIndexados = 0;
+    for (int m = 0; m < vista.numSensores; m++)
+    {
+        if (vista.sensores[m] != nullptr)
+        {
+            indiceNombres[numIndexados++] = m;
+        }
+    }
+    std::sort(indiceNombres, indiceNombres + numIndexados,
+              [&vista](int a, int b)
+              {
+                  return std::strcmp(vista.sensores[a]->nombre, vista.sensores[b]->nombre) < 0;
+              });
+
+    numeroIndexado = vista.numero;
+    hayIndice = true;
+}
+
+const InstantaneaSensor *ServidorConsultas::buscar(const InstantaneaFlota &vista, const char *nombre, int largo)
+{
+    actualizarIndice(vista);
+
+    int izquierda = 0;
+    int derecha = numIndexados;
+    while (izquierda < derecha)
+    {
+        int medio = (izquierda + derecha) / 2;
+        const InstantaneaSensor *s = vista.sensores[indiceNombres[medio]];
+        int r = compararNombre(s->nombre, nombre, largo);
+        if (r == 0)
+        {
+            return s;
+        }
+        if (r < 0)
+        {
+            izquierda = medio + 1;
+        }
+        else
+        {
+            derecha = medio;
+        }
+    }
+    return nullptr;
+}
+
+void ServidorConsultas::rangoPrefijo(const InstantaneaFlota &vista, const char *prefijo, int largo, int &desde,
+                                     int &hasta)
+{
+    actualizarIndice(vista);
+
+    // Primer nombre >= prefijo
+    int izquierda = 0;
+    int derecha = numIndexados;
+    while (izquierda < derecha)
+    {
+        int medio = (izquierda + derecha) / 2;
+        if (std::strncmp(vista.sensores[indiceNombres[medio]]->nombre, prefijo, largo) < 0)
+        {
+            izquierda = medio + 1;
+        }
+        else
+        {
+            derecha = medio;
+        }
+    }
+    desde = izquierda;
+
+    hasta = desde;
+    while (hasta < numIndexados && std::strncmp(vista.sensores[indiceNombres[hasta]]->nombre, prefijo, largo) == 0)
+    {
+        hasta++;
+    }
+}
+
+int ServidorConsultas::responder(const InstantaneaFlota &vista, const unsigned char *peticion, int longitud,
+                                 unsigned char *destino)
+{
+    const unsigned char *p = peticion + 4;
+    const unsigned char *fin = peticion + longitud;
+    std::uint8_t operacion = leerCampo<std::uint8_t>(p);
+    std::uint32_t id = leerCampo<std::uint32_t>(p);
+
+    unsigned char *q = destino + TAM_CABECERA_RESPUESTA;
+    EstadoConsulta estado = CONSULTA_OK;
+
+    switch (operacion)
+    {
+    case CONSULTA_ESTADO:
+    {
+        escribirCampo<std::uint64_t>(q, vista.numero);
+        escribirCampo<std::int32_t>(q, vista.numSensores);
+        escribirCampo<std::int64_t>(q, vista.lecturasTotales);
+        break;
+    }
+
+    case CONSULTA_SENSOR:
+    {
+        const InstantaneaSensor *s = buscar(vista, reinterpret_cast<const char *>(p), static_cast<int>(fin - p));
+        if (s == nullptr)
+        {
+            estado = CONSULTA_NO_ENCONTRADO;
+            break;
+        }
+        char tipo[TAM_TIPO_CONSULTA];
+        std::memset(tipo, 0, sizeof(tipo));
+        std::strncpy(tipo, s->tipo, TAM_TIPO_CONSULTA - 1);
+        std::memcpy(q, tipo, TAM_TIPO_CONSULTA);
+        q += TAM_TIPO_CONSULTA;
+        escribirCampo<std::int32_t>(q, s->manejador);
+        escribirCampo<std::int32_t>(q, s->numLecturas);
+        escribirCampo<double>(q, s->numLecturas > 0 ? s->valores[s->numLecturas - 1] : 0.0);
+        escribirCampo<double>(q, s->promedio);
+        escribirCampo<double>(q, s->minimo);
+        escribirCampo<double>(q, s->maximo);
+        break;
+    }
+
+    case CONSULTA_ESTADISTICAS:
+    case CONSULTA_RANGO:
+    {
+        if (fin - p < 8)
+        {
+            estado = CONSULTA_INVALIDA;
+            break;
+        }
+        int desde = leerCampo<std::int32_t>(p);
+        int hasta = leerCampo<std::int32_t>(p);
+        const InstantaneaSensor *s = buscar(vista, reinterpret_cast<const char *>(p), static_cast<int>(fin - p));
+        if (s == nullptr)
+        {
+            estado = CONSULTA_NO_ENCONTRADO;
+            break;
+        }
+        normalizarRango(s->numLecturas, desde, hasta);
+        int cantidad = hasta - desde;
+
+        if (operacion == CONSULTA_RANGO)
+        {
+            cantidad = (cantidad > MAX_VALORES_RANGO) ? MAX_VALORES_RANGO : cantidad;
+            escribirCampo<std::int32_t>(q, desde);
+            escribirCampo<std::int32_t>(q, cantidad);
+            std::memcpy(q, s->valores + desde, cantidad * sizeof(double));
+            q += cantidad * sizeof(double);
+            break;
+        }
+
+        double suma = 0.0;
+        double minimo = 0.0;
+        double maximo = 0.0;
+        double cuantiles[3] = {0.0, 0.0, 0.0};
+        if (cantidad > 0)
+        {
+            if (cantidad > capacidadAuxiliar)
+            {
+                delete[] auxiliar;
+                capacidadAuxiliar = cantidad * 2;
+                auxiliar = new double[capacidadAuxiliar];
+            }
+
+            minimo = maximo = s->valores[desde];
+            for (int i = 0; i < cantidad; i++)
+            {
+                double v = s->valores[desde + i];
+                auxiliar[i] = v;
+                suma += v;
+                minimo = (v < minimo) ? v : minimo;
+                maximo = (v > maximo) ? v : maximo;
+            }
+
+            // Selección parcial creciente: cada cuantil solo mira lo que quedó a su derecha
+            static const double fracciones[3] = {0.50, 0.90, 0.99};
+            int anterior = 0;
+            for (int k = 0; k < 3; k++)
+            {
+                int posicion = static_cast<int>(fracciones[k] * (cantidad - 1) + 0.5);
+                std::nth_element(auxiliar + anterior, auxiliar + posicion, auxiliar + cantidad);
+                cuantiles[k] = auxiliar[posicion];
+                anterior = posicion;
+            }
+        }
+
+        escribirCampo<std::int32_t>(q, cantidad);
+        escribirCampo<double>(q, cantidad > 0 ? suma / cantidad : 0.0);
+        escribirCampo<double>(q, minimo);
+        escribirCampo<double>(q, maximo);
+        for (int k = 0; k < 3; k++)
+        {
+            escribirCampo<double>(q, cuantiles[k]);
+        }
+        break;
+    }
+
+    case CONSULTA_TOPK:
+    {
+        if (fin - p < 4)
+        {
+            estado = CONSULTA_INVALIDA;
+            break;
+        }
+        int campo = leerCampo<std::uint8_t>(p);
+        bool mayores = leerCampo<std::uint8_t>(p) != 0;
+        int k = leerCampo<std::uint16_t>(p);
+        if (campo > TOPK_LECTURAS)
+        {
+            estado = CONSULTA_INVALIDA;
+            break;
+        }
+        k = (k > MAX_TOPK) ? MAX_TOPK : k;
+
+        int desde;
+        int hasta;
+        rangoPrefijo(vista, reinterpret_cast<const char *>(p), static_cast<int>(fin - p), desde, hasta);
+
+        // Inserción acotada: los k mejores quedan ordenados en 'elegidos'
+        const InstantaneaSensor *elegidos[MAX_TOPK];
+        double valores[MAX_TOPK];
+        int n = 0;
+        for (int i = desde; i < hasta && k > 0; i++)
+        {
+            const InstantaneaSensor *s = vista.sensores[indiceNombres[i]];
+            if (s->numLecturas == 0 && campo != TOPK_LECTURAS)
+            {
+                continue;
+            }
+            double v = valorCampo(*s, campo);
+            if (n == k && (mayores ? v <= valores[n - 1] : v >= valores[n - 1]))
+            {
+                continue;
+            }
+
+            int j = (n < k) ? n++ : n - 1;
+            while (j > 0 && (mayores ? v > valores[j - 1] : v < valores[j - 1]))
+            {
+                elegidos[j] = elegidos[j - 1];
+                valores[j] = valores[j - 1];
+                j--;
+            }
+            elegidos[j] = s;
+            valores[j] = v;
+        }
+
+        escribirCampo<std::int32_t>(q, n);
+        for (int i = 0; i < n; i++)
+        {
+            std::uint8_t largo = static_cast<std::uint8_t>(std::strlen(elegidos[i]->nombre));
+            escribirCampo<double>(q, valores[i]);
+            escribirCampo<std::uint8_t>(q, largo);
+            std::memcpy(q, elegidos[i]->nombre, largo);
+            q += largo;
+        }
+        break;
+    }
+
+    default:
+        estado = CONSULTA_INVALIDA;
+        break;
+    }
+
+    if (estado != CONSULTA_OK)
+    {
+        q = destino + TAM_CABECERA_RESPUESTA;
+    }
+
+    unsigned char *cabecera = destino;
+    escribirCampo<std::uint32_t>(cabecera, static_cast<std::uint32_t>(q - destino - 4));
+    escribirCampo<std::uint8_t>(cabecera, operacion);
+    escribirCampo<std::uint8_t>(cabecera, static_cast<std::uint8_t>(estado));
+    escribirCampo<std::uint32_t>(cabecera, id);
+    return static_cast<int>(q - destino);
+}
@@ -0,0 +1,249 @@
+/**
+ * @file Trazas.cpp
+ * @brief Implementación del registro de tramos por hilo y la exportación Chrome Trace
+ * @author FabiRamiro
+ * @date 2026-10-18
+ */
+
+#include "Trazas.h"
+#include "EscritorReporte.h"
+#include <iostream>
+
+namespace
+{
+    /**
+     * @brief Buffer circular de eventos de un hilo
+     */
+    struct BufferHilo
+    {
+        EventoTraza eventos[Trazas::CAPACIDAD_HILO]; ///< Eventos, indexados por escritos & (CAPACIDAD_HILO - 1)
+        unsigned long long escritos;                 ///< Eventos registrados desde el último limpiar()
+        int numeroHilo;                              ///< Identificador para el "tid" del JSON
+    };
+
+    /**
+     * @brief Buffers de todos los hilos que registraron tramos
+     *
+     * Los buffers no se liberan mientras el programa corre: un hilo que
+     * terminó deja sus eventos disponibles para la exportación.
+     */
+    struct RegistroHilos
+    {
+        BufferHilo *buffers[Trazas::MAX_HILOS];
+        std::atomic<int> numBuffers;
+        std::atomic<unsigned long> perdidos; ///< Eventos de hilos que ya no entraron en el registro
+
+        RegistroHilos() : numBuffers(0), perdidos(0)
+        {
+            for (int i = 0; i < Trazas::MAX_HILOS; i++)
+            {
+                buffers[i] = nullptr;
+            }
+        }
+
+        ~RegistroHilos()
+        {
+            for (int i = 0; i < Trazas::MAX_HILOS; i++)
+            {
+                delete buffers[i];
+            }
+        }
+    };
+
+    RegistroHilos registro;
+    std::atomic<unsigned int> contadorMuestras(0);
+    thread_local BufferHilo *bufferHilo = nullptr;
+    thread_local bool sinLugar = false;
+
+    /**
+     * @brief Crea y registra el buffer del hilo actual
+     * @return Buffer, nullptr si ya hay MAX_HILOS registrados
+     */
+    BufferHilo *crearBufferHilo()
+    {
+        int indice = registro.numBuffers.load(std::memory_order_relaxed);
+        do
+        {
+            if (indice >= Trazas::MAX_HILOS)
+            {
+                sinLugar = true;
+                return nullptr;
+            }
+        } while (!registro.numBuffers.compare_exchange_weak(indice, indice + 1, std::memory_order_acq_rel));
+
+        BufferHilo *buffer = new BufferHilo;
+        buffer->escritos = 0;
+        buffer->numeroHilo = indice + 1;
+        registro.buffers[indice] = buffer;
+        return buffer;
+    }
+}
+
+void Trazas::configurar(int cadaN)
+{
+    periodo.store(cadaN > 0 ? cadaN : 0, std::memory_order_relaxed);
+}
+
+int Trazas::getPeriodo()
+{
+    return periodo.load(std::memory_order_relaxed);
+}
+
+unsigned int Trazas::nuevaMuestra()
+{
+    unsigned int muestra = contadorMuestras.fetch_add(1, std::memory_order_relaxed) + 1;
+    return (muestra == 0) ? 1 : muestra;
+}
+
+void Trazas::registrar(EtapaTraza etapa, long long inicioNs, long long duracionNs)
+{
+    BufferHilo *buffer = bufferHilo;
+    if (buffer == nullptr)
+    {
+        if (sinLugar || (buffer = crearBufferHilo()) == nullptr)
+        {
+            registro.perdidos.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        bufferHilo = buffer;
+    }
+
+    EventoTraza &evento = buffer->eventos[buffer->escritos & (CAPACIDAD_HILO - 1)];
+    evento.inicioNs = inicioNs;
+    evento.duracionNs = duracionNs;
+    evento.muestra = muestraActual;
+    evento.etapa = static_cast<unsigned char>(etapa);
+    buffer->escritos++;
+}
+
+const char *Trazas::nombreEtapa(int etapa)
+{
+    static const char *const nombres[NUM_ETAPAS] = {
+        "ciclo", "lectura", "trama", "parseo", "busqueda", "despacho", "insercion", "proceso"};
+    return (etapa >= 0 && etapa < NUM_ETAPAS) ? nombres[etapa] : "?";
+}
+
+long Trazas::exportarChrome(const char *ruta)
+{
+    int numBuffers = registro.numBuffers.load(std::memory_order_acquire);
+
+    // Los tiempos del JSON son relativos al tramo más viejo que se conserva
+    long long origen = 0;
+    bool hayEventos = false;
+    for (int b = 0; b < numBuffers; b++)
+    {
+        const BufferHilo *buffer = registro.buffers[b];
+        unsigned long long n = buffer->escritos;
+        unsigned long long desde = (n > CAPACIDAD_HILO) ? n - CAPACIDAD_HILO : 0;
+        for (unsigned long long i = desde; i < n; i++)
+        {
+            long long inicio = buffer->eventos[i & (CAPACIDAD_HILO - 1)].inicioNs;
+            if (!hayEventos || inicio < origen)
+            {
+                origen = inicio;
+                hayEventos = true;
+            }
+        }
+    }
+
+    EscritorReporte escritor;
+    if (!escritor.abrirArchivo(ruta))
+    {
+        return -1;
+    }
+
+    long escritos = 0;
+    escritor << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    for (int b = 0; b < numBuffers; b++)
+    {
+        const BufferHilo *buffer = registro.buffers[b];
+        if (b > 0)
+        {
+            escritor << ',';
+        }
+        escritor << "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->numeroHilo
+                 << ",\"args\":{\"name\":\"hilo " << buffer->numeroHilo << "\"}}";
+
+        unsigned long long n = buffer->escritos;
+        unsigned long long desde = (n > CAPACIDAD_HILO) ? n - CAPACIDAD_HILO : 0;
+        for (unsigned long long i = desde; i < n; i++)
+        {
+            const EventoTraza &evento = buffer->eventos[i & (CAPACIDAD_HILO - 1)];
+            escritor << ",\n{\"name\":\"" << nombreEtapa(evento.etapa) << "\",\"cat\":\"ingesta\",\"ph\":\"X\",\"ts\":"
+                     << static_cast<double>(evento.inicioNs - origen) / 1000.0
+                     << ",\"dur\":" << static_cast<double>(evento.duracionNs) / 1000.0
+                     << ",\"pid\":1,\"tid\":" << buffer->numeroHilo
+                     << ",\"args\":{\"lectura\":" << static_cast<unsigned long>(evento.muestra) << "}}";
+            escritos++;
+        }
+    }
+    escritor << "\n]}\n";
+    escritor.cerrarArchivo();
+    return escritos;
+}
+
+void Trazas::imprimirResumen()
+{
+    unsigned long cantidades[NUM_ETAPAS] = {0};
+    long long totales[NUM_ETAPAS] = {0};
+    long long maximos[NUM_ETAPAS] = {0};
+    unsigned long long sobrescritos = 0;
+
+    int numBuffers = registro.numBuffers.load(std::memory_order_acquire);
+    for (int b = 0; b < numBuffers; b++)
+    {
+        const BufferHilo *buffer = registro.buffers[b];
+        unsigned long long n = buffer->escritos;
+        unsigned long long desde = (n > CAPACIDAD_HILO) ? n - CAPACIDAD_HILO : 0;
+        sobrescritos += desde;
+        for (unsigned long long i = desde; i < n; i++)
+        {
+            const EventoTraza &evento = buffer->eventos[i & (CAPACIDAD_HILO - 1)];
+            if (evento.etapa >= NUM_ETAPAS)
+            {
+                continue;
+            }
+            cantidades[evento.etapa]++;
+            totales[evento.etapa] += evento.duracionNs;
+            if (evento.duracionNs > maximos[evento.etapa])
+            {
+                maximos[evento.etapa] = evento.duracionNs;
+            }
+        }
+    }
+
+    int cadaN = getPeriodo();
+    std::cout << "\n--- Trazas de Ingesta ---" << std::endl;
+    std::cout << "Muestreo: ";
+    if (cadaN == 0)
+    {
+        std::cout << "desactivado";
+    }
+    else
+    {
+        std::cout << "1 de cada " << cadaN << " lectura(s)";
+    }
+    std::cout << " | Hilos: " << numBuffers << " | Sobrescritos: " << sobrescritos
+              << " | Perdidos: " << registro.perdidos.load(std::memory_order_relaxed) << std::endl;
+
+    for (int e = 0; e < NUM_ETAPAS; e++)
+    {
+        if (cantidades[e] == 0)
+        {
+            continue;
+        }
+        std::cout << "  " << nombreEtapa(e) << ": " << cantidades[e] << " tramo(s), media "
+                  << (static_cast<double>(totales[e]) / cantidades[e]) / 1000.0 << " us, max "
+                  << maximos[e] / 1000.0 << " us" << std::endl;
+    }
+}
+
+void Trazas::limpiar()
+{
+    int numBuffers = registro.numBuffers.load(std::memory_order_acquire);
+    for (int b = 0; b < numBuffers; b++)
+    {
+        registro.buffers[b]->escritos = 0;
+    }
+    registro.perdidos.store(0, std::memory_order_relaxed);
+}
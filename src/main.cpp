@@ -6,20 +6,39 @@
  */
 
 #include <iostream>
+#include <cstdio>
 #include <cstdlib>
 #include <cstring>
 #include <limits>
+#include <atomic>
+#include <chrono>
+#include <thread>
 #include "SensorTemperatura.h"
 #include "SensorPresion.h"
+#include "SensorVibracion.h"
 #include "ListaGeneral.h"
 #include "SerialReader.h"
 
+#include "LectorMultiPuerto.h"
+#include "MotorAlertas.h"
+#include "Instantaneas.h"
+#include "ConsultasFlota.h"
+#include "BitacoraLecturas.h"
+#include "GestorMemoria.h"
+#include "PlanificadorTareas.h"
+#include "Trazas.h"
+#include "PublicadorAnillo.h"
+#include "ServidorConsultas.h"
+#include "MotorCorrelacion.h"
+
 #ifdef _WIN32
 #include <windows.h>
+#else
+#include <unistd.h>
 #endif
 
 /**
- * @brief Detecta y muestra los puertos COM disponibles en Windows
+ * @brief Detecta y muestra los puertos serie disponibles (COM en Windows, /dev/tty* en Linux)
  */
 void detectarPuertosCOM()
 {
@@ -27,6 +46,7 @@ void detectarPuertosCOM()
 
     bool encontrado = false;
 
+#ifdef _WIN32
     for (int i = 1; i <= 20; i++)
     {
         char puerto[10];
@@ -56,6 +76,25 @@ void detectarPuertosCOM()
             }
         }
     }
+#else
+    // Linux: adaptadores USB-serie (CH340/CP210x -> ttyUSB, CDC -> ttyACM)
+    const char *prefijos[] = {"/dev/ttyUSB", "/dev/ttyACM"};
+    for (int p = 0; p < 2; p++)
+    {
+        for (int i = 0; i < 20; i++)
+        {
+            char puerto[32];
+            std::snprintf(puerto, sizeof(puerto), "%s%d", prefijos[p], i);
+
+            if (access(puerto, F_OK) == 0)
+            {
+                bool libre = access(puerto, R_OK | W_OK) == 0;
+                std::cout << "  [" << (libre ? "OK" : "SIN PERMISO") << "] " << puerto << std::endl;
+                encontrado = true;
+            }
+        }
+    }
+#endif
 
     if (!encontrado)
     {
@@ -83,19 +122,36 @@ void imprimirMenu()
     std::cout << "5. Procesar Todos los Sensores" << std::endl;
     std::cout << "6. Mostrar Informacion de Sensores" << std::endl;
     std::cout << "7. Detectar Puertos COM Disponibles" << std::endl;
-    std::cout << "8. Salir (Liberar Memoria)" << std::endl;
+    std::cout << "8. Captura Multi-Dispositivo (Linux)" << std::endl;
+    std::cout << "9. Crear Sensor de Vibracion" << std::endl;
+    std::cout << "10. Configurar Reglas de Alerta" << std::endl;
+    std::cout << "11. Resumen desde Instantanea (sin bloqueo)" << std::endl;
+    std::cout << "12. Configurar Ventana Deslizante y EWMA" << std::endl;
+    std::cout << "13. Consultas de Flota (top-k, agregados, inactivos)" << std::endl;
+    std::cout << "14. Exportar Reporte (texto/CSV/JSON lines)" << std::endl;
+    std::cout << "15. Bitacora: Estado y Punto de Control" << std::endl;
+    std::cout << "16. Memoria: Estadisticas y Presupuesto" << std::endl;
+    std::cout << "17. Secuencias: Reordenamiento y Duplicados" << std::endl;
+    std::cout << "18. Modo Automatico (captura, proceso y reporte programados)" << std::endl;
+    std::cout << "19. Trazas: Muestreo y Exportacion (Chrome Trace)" << std::endl;
+    std::cout << "20. Anillo Compartido: Publicar en /dev/shm" << std::endl;
+    std::cout << "21. Servidor de Consultas (socket Unix)" << std::endl;
+    std::cout << "22. Bajas de Sensores (eliminar, expirar inactivos)" << std::endl;
+    std::cout << "23. Correlacion entre Sensores (pares vigilados, matriz)" << std::endl;
+    std::cout << "0. Salir (Liberar Memoria)" << std::endl;
     std::cout << "========================================" << std::endl;
     std::cout << "Opcion: ";
 }
 
 /**
  * @brief Parsea una linea de datos del formato serial
- * @param linea Linea a parsear (formato: "TIPO:ID:VALOR")
+ * @param linea Linea a parsear (formato: "TIPO:ID:VALOR" o "TIPO:ID:VALOR:SECUENCIA")
  * @param tipo Buffer para almacenar el tipo de sensor
  * @param id Buffer para almacenar el ID del sensor
  * @param valor Buffer para almacenar el valor como cadena
+ * @param secuencia Buffer para la secuencia como cadena (vacio si la linea no la trae)
  */
-void parsearLinea(const char *linea, char *tipo, char *id, char *valor)
+void parsearLinea(const char *linea, char *tipo, char *id, char *valor, char *secuencia)
 {
     char lineaCopia[256];
     std::strncpy(lineaCopia, linea, 255);
@@ -118,19 +174,532 @@ void parsearLinea(const char *linea, char *tipo, char *id, char *valor)
     {
         std::strcpy(valor, token);
     }
+
+    token = std::strtok(nullptr, ":");
+    if (token != nullptr)
+    {
+        std::strcpy(secuencia, token);
+    }
+}
+
+/**
+ * @brief Registra una lectura recibida del ESP32 en el sistema
+ *
+ * Si el sensor no existe se crea automaticamente segun su tipo. Las
+ * lecturas numeradas pasan por la ventana de secuencias del sensor, que
+ * las reordena y descarta las repetidas.
+ *
+ * @param sistema Lista de gestion de sensores
+ * @param tipo Tipo de sensor ("TEMP" o "PRES")
+ * @param id Identificador del sensor
+ * @param valor Valor de la lectura
+ * @param secuencia Numero de secuencia de la lectura (-1 = sin numerar)
+ */
+void registrarLecturaRecibida(ListaGeneral &sistema, const char *tipo, const char *id, double valor,
+                              long long secuencia = -1)
+{
+    SensorBase *sensor;
+    {
+        TramoTraza tramo(ETAPA_BUSQUEDA);
+        sensor = sistema.buscarSensor(id);
+
+        if (sensor == nullptr)
+        {
+            if (std::strcmp(tipo, "TEMP") == 0)
+            {
+                sensor = sistema.crearSensor<SensorTemperatura>(id);
+            }
+            else if (std::strcmp(tipo, "PRES") == 0)
+            {
+                sensor = sistema.crearSensor<SensorPresion>(id);
+            }
+            else if (std::strcmp(tipo, "VIB") == 0)
+            {
+                sensor = sistema.crearSensor<SensorVibracion>(id);
+            }
+        }
+    }
+
+    if (sensor != nullptr && secuencia >= 0)
+    {
+        sensor->registrarLecturaSecuencia(valor, secuencia);
+    }
+    else if (sensor != nullptr)
+    {
+        SensorTemperatura *tempSensor = dynamic_cast<SensorTemperatura *>(sensor);
+        SensorPresion *presSensor = dynamic_cast<SensorPresion *>(sensor);
+        SensorVibracion *vibSensor = dynamic_cast<SensorVibracion *>(sensor);
+
+        if (tempSensor != nullptr)
+        {
+            tempSensor->registrarLectura(static_cast<float>(valor));
+        }
+        else if (presSensor != nullptr)
+        {
+            presSensor->registrarLectura(static_cast<int>(valor));
+        }
+        else if (vibSensor != nullptr)
+        {
+            vibSensor->registrarLectura(static_cast<int>(valor));
+        }
+    }
+}
+
+/**
+ * @brief Procesa una linea de texto recibida del ESP32
+ *
+ * Las lineas "VIB:ID:c1,c2,...,cn" traen un bloque de muestras y se
+ * registran de una sola vez; el resto usa el formato "TIPO:ID:VALOR".
+ * Ambas admiten un ":SECUENCIA" final (en el bloque, la de la primera
+ * muestra) para reordenar y descartar duplicados.
+ *
+ * @param sistema Lista de gestion de sensores
+ * @param linea Linea recibida
+ */
+void procesarLineaRecibida(ListaGeneral &sistema, const char *linea)
+{
+    if (std::strncmp(linea, "VIB:", 4) != 0)
+    {
+        char tipo[10] = "", id[50] = "", valor[50] = "", secuencia[24] = "";
+        {
+            TramoTraza tramo(ETAPA_PARSEO);
+            parsearLinea(linea, tipo, id, valor, secuencia);
+        }
+        registrarLecturaRecibida(sistema, tipo, id, std::atof(valor),
+                                 secuencia[0] != '\0' ? std::atoll(secuencia) : -1);
+        return;
+    }
+
+    char id[50];
+    int cuentas[128];
+    int cantidad = 0;
+    long long secuencia = -1;
+    {
+        TramoTraza tramo(ETAPA_PARSEO);
+
+        const char *inicioId = linea + 4;
+        const char *finId = std::strchr(inicioId, ':');
+        if (finId == nullptr || finId - inicioId >= 50)
+        {
+            return;
+        }
+
+        std::memcpy(id, inicioId, finId - inicioId);
+        id[finId - inicioId] = '\0';
+
+        // Bloque de muestras separadas por comas
+        const char *p = finId + 1;
+        while (*p != '\0' && cantidad < 128)
+        {
+            char *fin;
+            long v = std::strtol(p, &fin, 10);
+            if (fin == p)
+            {
+                break;
+            }
+            cuentas[cantidad++] = static_cast<int>(v);
+            p = (*fin == ',') ? fin + 1 : fin;
+        }
+
+        if (*p == ':')
+        {
+            secuencia = std::atoll(p + 1);
+        }
+    }
+
+    SensorBase *sensor;
+    {
+        TramoTraza tramo(ETAPA_BUSQUEDA);
+        sensor = sistema.buscarSensor(id);
+        if (sensor == nullptr)
+        {
+            sensor = sistema.crearSensor<SensorVibracion>(id);
+        }
+    }
+
+    SensorVibracion *vibSensor = dynamic_cast<SensorVibracion *>(sensor);
+    if (vibSensor != nullptr && secuencia >= 0)
+    {
+        // Numeradas, las muestras se registran una a una al salir de la ventana
+        for (int i = 0; i < cantidad; i++)
+        {
+            vibSensor->registrarLecturaSecuencia(cuentas[i], secuencia + i);
+        }
+    }
+    else if (vibSensor != nullptr)
+    {
+        vibSensor->registrarBloque(cuentas, cantidad);
+    }
 }
 
+#ifdef __linux__
+/**
+ * @brief Receptor que registra en el sistema las lecturas de cada dispositivo
+ */
+class ReceptorSistema : public ReceptorLecturas
+{
+private:
+    ListaGeneral &sistema; ///< Lista de gestion destino
+    int lecturas;          ///< Lecturas registradas
+
+public:
+    /**
+     * @brief Constructor
+     * @param sistemaGestion Lista de gestion donde se registran las lecturas
+     */
+    ReceptorSistema(ListaGeneral &sistemaGestion) : sistema(sistemaGestion), lecturas(0) {}
+
+    void lineaRecibida(int dispositivo, const char *nombre, const char *linea) override
+    {
+        MuestraTraza muestra;
+        std::cout << "[" << nombre << " #" << dispositivo << "] Recibido: " << linea << std::endl;
+
+        procesarLineaRecibida(sistema, linea);
+        lecturas++;
+    }
+
+    void lecturaRecibida(int dispositivo, const char *nombre, const LecturaBinaria &lectura) override
+    {
+        MuestraTraza muestra;
+        char id[50];
+        lectura.formatearId(id, 50);
+        std::cout << "[" << nombre << " #" << dispositivo << "] Trama #" << lectura.secuencia << ": "
+                  << lectura.nombreTipo() << ":" << id << ":" << lectura.valor() << std::endl;
+
+        registrarLecturaRecibida(sistema, lectura.nombreTipo(), id, lectura.valor(), lectura.secuencia);
+        lecturas++;
+    }
+
+    /**
+     * @brief Obtiene el numero de lecturas registradas
+     * @return Cantidad de lecturas
+     */
+    int getLecturas() const
+    {
+        return lecturas;
+    }
+};
+#endif
+
+/**
+ * @class HiloReporte
+ * @brief Hilo que imprime periódicamente la última instantánea durante la captura
+ *
+ * Lee solo a través de LectorInstantaneas, así que no necesita bloquear
+ * la lista de sensores mientras el hilo principal sigue registrando.
+ */
+class HiloReporte
+{
+private:
+    PublicadorInstantaneas &publicador; ///< Origen de las vistas
+    int periodoMs;                      ///< Periodo entre reportes
+    std::atomic<bool> activo;           ///< Señal de parada
+    std::thread hilo;                   ///< Hilo lector
+
+public:
+    /**
+     * @brief Inicia el hilo de reporte
+     * @param origen Publicador de instantáneas
+     * @param periodo Milisegundos entre reportes (0 = no se inicia)
+     */
+    HiloReporte(PublicadorInstantaneas &origen, int periodo)
+        : publicador(origen), periodoMs(periodo), activo(periodo > 0)
+    {
+        if (periodoMs > 0)
+        {
+            hilo = std::thread(&HiloReporte::ejecutar, this);
+        }
+    }
+
+    /**
+     * @brief Detiene y espera al hilo
+     */
+    ~HiloReporte()
+    {
+        activo.store(false);
+        if (hilo.joinable())
+        {
+            hilo.join();
+        }
+    }
+
+private:
+    /**
+     * @brief Bucle del hilo lector
+     */
+    void ejecutar()
+    {
+        int ranura = publicador.registrarLector();
+        if (ranura < 0)
+        {
+            return;
+        }
+
+        while (activo.load())
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(periodoMs));
+
+            LectorInstantaneas vista(publicador, ranura);
+            vista->imprimir();
+        }
+
+        publicador.liberarLector(ranura);
+    }
+
+    HiloReporte(const HiloReporte &);            // No copiable
+    HiloReporte &operator=(const HiloReporte &); // No asignable
+};
+
+/**
+ * @class TareaCaptura
+ * @brief Lee un lote de lineas del ESP32 en cada turno del planificador
+ */
+class TareaCaptura : public TareaPeriodica
+{
+private:
+    SerialReader &lector;              ///< Puerto ya conectado
+    ListaGeneral &sistema;             ///< Lista de gestion destino
+    PlanificadorTareas &planificador;  ///< Se detiene al llegar al limite
+    int lote;                          ///< Lineas por turno
+    int limite;                        ///< Lecturas a capturar (0 = sin limite)
+    int lecturas;                      ///< Lecturas registradas
+
+public:
+    TareaCaptura(SerialReader &serial, ListaGeneral &sistemaGestion, PlanificadorTareas &plan, int lineasPorTurno,
+                 int lecturasMaximas)
+        : lector(serial), sistema(sistemaGestion), planificador(plan), lote(lineasPorTurno),
+          limite(lecturasMaximas), lecturas(0)
+    {
+    }
+
+    void ejecutar() override
+    {
+        char buffer[256];
+        for (int i = 0; i < lote; i++)
+        {
+            MuestraTraza muestra;
+            if (!lector.leerLinea(buffer, 256))
+            {
+                break;
+            }
+            procesarLineaRecibida(sistema, buffer);
+            lecturas++;
+            if (limite > 0 && lecturas >= limite)
+            {
+                planificador.detener();
+                break;
+            }
+        }
+    }
+
+    /**
+     * @brief Obtiene el numero de lecturas registradas
+     * @return Cantidad de lecturas
+     */
+    int getLecturas() const
+    {
+        return lecturas;
+    }
+};
+
+/**
+ * @class TareaProcesamiento
+ * @brief Procesa solo los sensores que cambiaron desde el turno anterior
+ */
+class TareaProcesamiento : public TareaPeriodica
+{
+private:
+    ListaGeneral &sistema;        ///< Lista de gestion
+    BitacoraLecturas &bitacora;   ///< Registra la pasada para la reproduccion
+
+public:
+    TareaProcesamiento(ListaGeneral &sistemaGestion, BitacoraLecturas &bitacoraLecturas)
+        : sistema(sistemaGestion), bitacora(bitacoraLecturas)
+    {
+    }
+
+    void ejecutar() override
+    {
+        if (sistema.getNumModificados() == 0)
+        {
+            return;
+        }
+        bitacora.registrarProceso(sistema.getModificados(), sistema.getNumModificados());
+        sistema.procesarModificados();
+    }
+};
+
+/**
+ * @class TareaReporte
+ * @brief Publica una instantanea y la imprime
+ */
+class TareaReporte : public TareaPeriodica
+{
+private:
+    PublicadorInstantaneas &publicador; ///< Origen de las vistas
+
+public:
+    TareaReporte(PublicadorInstantaneas &origen) : publicador(origen) {}
+
+    void ejecutar() override
+    {
+        publicador.publicar();
+
+        int ranura = publicador.registrarLector();
+        if (ranura < 0)
+        {
+            return;
+        }
+        {
+            LectorInstantaneas vista(publicador, ranura);
+            vista->imprimir();
+        }
+        publicador.liberarLector(ranura);
+    }
+};
+
+/**
+ * @class MantenimientoLecturas
+ * @brief Trabajo del hilo escritor despues de cada tanda de lecturas
+ *
+ * Lo comparten los bucles de captura, TareaMantenimiento y el regreso al
+ * menu, para que todos muestren las alertas, apliquen el presupuesto de
+ * memoria y alimenten el anillo del mismo modo.
+ */
+class MantenimientoLecturas
+{
+private:
+    MotorAlertas &motorAlertas;         ///< Alertas pendientes de mostrar
+    GestorMemoria &gestorMemoria;       ///< Desalojos desde la tanda anterior
+    PublicadorInstantaneas &publicador; ///< Vistas a invalidar tras un desalojo
+    BitacoraLecturas &bitacora;         ///< Confirmacion por tiempo y punto de control
+    PublicadorAnillo &anillo;           ///< Agregados periodicos para consumidores locales
+
+public:
+    MantenimientoLecturas(MotorAlertas &motor, GestorMemoria &gestor, PublicadorInstantaneas &origen,
+                          BitacoraLecturas &bitacoraLecturas, PublicadorAnillo &anilloCompartido)
+        : motorAlertas(motor), gestorMemoria(gestor), publicador(origen), bitacora(bitacoraLecturas),
+          anillo(anilloCompartido)
+    {
+    }
+
+    /**
+     * @brief Muestra las alertas en cola e invalida las vistas si hubo desalojos
+     */
+    void atenderAvisos()
+    {
+        motorAlertas.imprimirAlertas();
+        if (gestorMemoria.tomarDesalojos())
+        {
+            publicador.invalidarTodo(); // El presupuesto recortó historiales
+        }
+    }
+
+    /**
+     * @brief atenderAvisos(), agregados periodicos en el anillo y revision de la bitacora
+     */
+    void ejecutar()
+    {
+        atenderAvisos();
+        if (publicador.publicarPeriodico(100))
+        {
+            anillo.publicarAgregados(publicador); // Sin anillo abierto no escribe nada
+        }
+        bitacora.revisar();
+    }
+
+private:
+    MantenimientoLecturas(const MantenimientoLecturas &);            // No copiable
+    MantenimientoLecturas &operator=(const MantenimientoLecturas &); // No asignable
+};
+
+/**
+ * @class TareaMantenimiento
+ * @brief Bajas por inactividad y mantenimiento posterior a las lecturas
+ */
+class TareaMantenimiento : public TareaPeriodica
+{
+private:
+    MantenimientoLecturas &mantenimiento; ///< Alertas, desalojos, anillo y bitacora
+    ListaGeneral &sistema;                ///< Registro donde se buscan sensores inactivos
+    long long ttlMs;                      ///< Sin lecturas durante este tiempo se da de baja (0 = nunca)
+
+public:
+    TareaMantenimiento(MantenimientoLecturas &trasLecturas, ListaGeneral &sistemaGestion, long long ttlInactividadMs)
+        : mantenimiento(trasLecturas), sistema(sistemaGestion), ttlMs(ttlInactividadMs)
+    {
+    }
+
+    void ejecutar() override
+    {
+        if (ttlMs > 0)
+        {
+            sistema.expirarInactivos(ttlMs);
+        }
+        mantenimiento.ejecutar();
+    }
+};
+
 /**
  * @brief Funcion principal del programa
+ * @param argc Numero de argumentos
+ * @param argv [1] ruta de la bitacora, [2] lecturas por grupo, [3] ms por grupo
  * @return Codigo de salida del programa
  */
-int main()
+int main(int argc, char *argv[])
 {
+    MotorAlertas motorAlertas;
+    PublicadorInstantaneas publicador;
+    ConsultasFlota consultas;
+    BitacoraLecturas bitacora;
+    GestorMemoria gestorMemoria;
+    PublicadorAnillo anillo;
+    MotorCorrelacion correlacion;
+    ServidorConsultas servidor(publicador); // Responde desde las instantaneas, nunca desde la lista
     ListaGeneral sistemaGestion;
     SerialReader serialReader;
+    MantenimientoLecturas trasLecturas(motorAlertas, gestorMemoria, publicador, bitacora, anillo);
     int opcion;
     bool continuar = true;
 
+    // Reglas por defecto: se evalúan en cada lectura, al momento de la ingesta
+    motorAlertas.agregarReglaTipo<SensorTemperatura>(REGLA_MAXIMO, 40.0f, 1.0f);
+    motorAlertas.agregarReglaTipo<SensorPresion>(REGLA_MAXIMO, 145.0f, 5.0f);
+    motorAlertas.agregarReglaTipo<SensorPresion>(REGLA_MINIMO, 55.0f, 5.0f);
+    sistemaGestion.agregarObservador(&motorAlertas);
+    sistemaGestion.agregarObservador(&publicador);
+    sistemaGestion.agregarObservador(&consultas);
+    sistemaGestion.agregarObservador(&gestorMemoria);
+    sistemaGestion.agregarObservador(&anillo);
+    sistemaGestion.agregarObservador(&correlacion);
+
+    // Bitacora opcional: reconstruye el estado anterior y registra la ingesta
+    if (argc > 1)
+    {
+        if (argc > 3)
+        {
+            bitacora.configurar(std::atoi(argv[2]), std::atoi(argv[3]), BitacoraLecturas::LIMITE_ARCHIVO);
+        }
+
+        ResultadoReproduccion reproduccion;
+        if (bitacora.abrir(argv[1], sistemaGestion, &reproduccion))
+        {
+            std::cout << "[Bitacora] " << argv[1] << ": " << reproduccion.registros << " registros, "
+                      << reproduccion.sensores << " sensor(es), " << reproduccion.lecturas
+                      << " lectura(s) reproducidas en " << reproduccion.milisegundos << " ms";
+            if (reproduccion.bytesDescartados > 0)
+            {
+                std::cout << " (" << reproduccion.bytesDescartados << " bytes de cola descartados)";
+            }
+            std::cout << "." << std::endl;
+            publicador.publicar();
+        }
+        else
+        {
+            std::cout << "[Bitacora] No se pudo abrir '" << argv[1] << "'; se continua sin bitacora." << std::endl;
+        }
+    }
+
     std::cout << "\n*** SISTEMA IOT DE GESTION POLIMORFICA DE SENSORES ***" << std::endl;
     std::cout << "Autor: FabiRamiro" << std::endl;
     std::cout << "Fecha: 2025-10-31" << std::endl;
@@ -149,10 +718,10 @@ int main()
             std::cout << "\nIngrese el ID del sensor de temperatura: ";
             std::cin.getline(nombreSensor, 50);
 
-            SensorTemperatura *nuevoTempSensor = new SensorTemperatura(nombreSensor);
-            sistemaGestion.insertarSensor(nuevoTempSensor);
-
-            std::cout << "Sensor de temperatura creado e insertado." << std::endl;
+            if (sistemaGestion.crearSensor<SensorTemperatura>(nombreSensor) != nullptr)
+            {
+                std::cout << "Sensor de temperatura creado e insertado." << std::endl;
+            }
             break;
         }
 
@@ -162,10 +731,10 @@ int main()
             std::cout << "\nIngrese el ID del sensor de presion: ";
             std::cin.getline(nombreSensor, 50);
 
-            SensorPresion *nuevoPresSensor = new SensorPresion(nombreSensor);
-            sistemaGestion.insertarSensor(nuevoPresSensor);
-
-            std::cout << "Sensor de presion creado e insertado." << std::endl;
+            if (sistemaGestion.crearSensor<SensorPresion>(nombreSensor) != nullptr)
+            {
+                std::cout << "Sensor de presion creado e insertado." << std::endl;
+            }
             break;
         }
 
@@ -185,6 +754,7 @@ int main()
 
             SensorTemperatura *tempSensor = dynamic_cast<SensorTemperatura *>(sensor);
             SensorPresion *presSensor = dynamic_cast<SensorPresion *>(sensor);
+            SensorVibracion *vibSensor = dynamic_cast<SensorVibracion *>(sensor);
 
             if (tempSensor != nullptr)
             {
@@ -200,6 +770,13 @@ int main()
                 std::cin >> presion;
                 presSensor->registrarLectura(presion);
             }
+            else if (vibSensor != nullptr)
+            {
+                int cuenta;
+                std::cout << "Ingrese la muestra de vibracion (conteos): ";
+                std::cin >> cuenta;
+                vibSensor->registrarLectura(cuenta);
+            }
 
             break;
         }
@@ -216,70 +793,95 @@ int main()
                 break;
             }
 
+            std::cout << "Formato de datos (0 = texto, 1 = binario): ";
+            int formato;
+            std::cin >> formato;
+            serialReader.setModoBinario(formato == 1);
+
             std::cout << "\nCuantas lecturas desea capturar? (0 = continuo): ";
             int numLecturas;
             std::cin >> numLecturas;
             std::cin.ignore();
 
+            std::cout << "Reporte concurrente cada cuantos ms? (0 = ninguno): ";
+            int periodoReporte;
+            std::cin >> periodoReporte;
+            std::cin.ignore();
+            HiloReporte reporte(publicador, periodoReporte);
+
             std::cout << "\n--- Capturando datos del ESP32 ---\n"
                       << std::endl;
 
             int lecturasCaptadas = 0;
             while (numLecturas == 0 || lecturasCaptadas < numLecturas)
             {
-                char buffer[256];
-                if (serialReader.leerLinea(buffer, 256))
+                MuestraTraza muestra;
+                if (serialReader.esModoBinario())
                 {
-                    std::cout << "[ESP32] Recibido: " << buffer << std::endl;
-
-                    char tipo[10], id[50], valor[50];
-                    parsearLinea(buffer, tipo, id, valor);
-
-                    SensorBase *sensor = sistemaGestion.buscarSensor(id);
-
-                    if (sensor == nullptr)
+                    LecturaBinaria lectura;
+                    if (serialReader.leerLectura(lectura))
                     {
-                        if (std::strcmp(tipo, "TEMP") == 0)
-                        {
-                            sensor = new SensorTemperatura(id);
-                            sistemaGestion.insertarSensor(sensor);
-                        }
-                        else if (std::strcmp(tipo, "PRES") == 0)
-                        {
-                            sensor = new SensorPresion(id);
-                            sistemaGestion.insertarSensor(sensor);
-                        }
-                    }
+                        char id[50];
+                        lectura.formatearId(id, 50);
+                        std::cout << "[ESP32] Trama #" << lectura.secuencia << ": "
+                                  << lectura.nombreTipo() << ":" << id << ":"
+                                  << lectura.valor() << std::endl;
 
-                    if (sensor != nullptr)
-                    {
-                        SensorTemperatura *tempSensor = dynamic_cast<SensorTemperatura *>(sensor);
-                        SensorPresion *presSensor = dynamic_cast<SensorPresion *>(sensor);
-
-                        if (tempSensor != nullptr)
-                        {
-                            float temp = std::atof(valor);
-                            tempSensor->registrarLectura(temp);
-                        }
-                        else if (presSensor != nullptr)
-                        {
-                            int pres = std::atoi(valor);
-                            presSensor->registrarLectura(pres);
-                        }
+                        registrarLecturaRecibida(sistemaGestion, lectura.nombreTipo(), id, lectura.valor(),
+                                                 lectura.secuencia);
+                        trasLecturas.ejecutar();
+                        lecturasCaptadas++;
                     }
+                    continue;
+                }
+
+                char buffer[256];
+                if (serialReader.leerLinea(buffer, 256))
+                {
+                    std::cout << "[ESP32] Recibido: " << buffer << std::endl;
 
+                    procesarLineaRecibida(sistemaGestion, buffer);
+                    trasLecturas.ejecutar();
                     lecturasCaptadas++;
                 }
             }
 
+            if (serialReader.esModoBinario())
+            {
+                serialReader.getDecodificador().imprimirEstadisticas();
+            }
+
             serialReader.desconectar();
+            sistemaGestion.vaciarReordenamientos(); // Los huecos que faltan ya no llegarán
             std::cout << "\nCaptura completada. " << lecturasCaptadas << " lecturas registradas." << std::endl;
             break;
         }
 
         case 5:
         {
-            sistemaGestion.procesarTodosSensores();
+            std::cout << "\nModo (0 = todos por lotes, 1 = solo modificados, 2 = ver ultimos resultados): ";
+            int modo;
+            std::cin >> modo;
+            std::cin.ignore();
+
+            if (modo == 2)
+            {
+                sistemaGestion.imprimirResultados();
+                break;
+            }
+
+            // Instantaneas y memoria se enteran por historialModificado()
+            sistemaGestion.vaciarReordenamientos();
+            if (modo == 1)
+            {
+                bitacora.registrarProceso(sistemaGestion.getModificados(), sistemaGestion.getNumModificados());
+                sistemaGestion.procesarModificados();
+            }
+            else
+            {
+                sistemaGestion.procesarPorLotes();
+                bitacora.registrarProceso();
+            }
             break;
         }
 
@@ -297,15 +899,672 @@ int main()
 
         case 8:
         {
-            std::cout << "\nCerrando sistema..." << std::endl;
-            continuar = false;
-            break;
-        }
+#ifdef __linux__
+            LectorMultiPuerto lector;
+            ReceptorSistema receptor(sistemaGestion);
 
-        default:
+            int numPuertos;
+            std::cout << "\nCuantos dispositivos desea conectar? ";
+            std::cin >> numPuertos;
+            std::cin.ignore();
+
+            for (int i = 0; i < numPuertos; i++)
+            {
+                char ruta[64];
+                std::cout << "Ruta del dispositivo " << (i + 1) << " (ej: /dev/ttyUSB0): ";
+                std::cin.getline(ruta, 64);
+
+                std::cout << "Formato (0 = texto, 1 = binario): ";
+                int formato;
+                std::cin >> formato;
+                std::cin.ignore();
+
+                lector.agregarPuerto(ruta, formato == 1);
+            }
+
+            std::cout << "\nCuantas lecturas desea capturar? (0 = continuo): ";
+            int numLecturas;
+            std::cin >> numLecturas;
+            std::cin.ignore();
+
+            std::cout << "Reporte concurrente cada cuantos ms? (0 = ninguno): ";
+            int periodoReporte;
+            std::cin >> periodoReporte;
+            std::cin.ignore();
+            HiloReporte reporte(publicador, periodoReporte);
+
+            std::cout << "\n--- Capturando datos de " << lector.getNumDispositivos()
+                      << " dispositivo(s) ---\n"
+                      << std::endl;
+
+            while (numLecturas == 0 || receptor.getLecturas() < numLecturas)
+            {
+                if (lector.ejecutarCiclo(1000, receptor) < 0)
+                {
+                    std::cout << "Error en el bucle de eventos." << std::endl;
+                    break;
+                }
+                trasLecturas.ejecutar();
+            }
+
+            lector.imprimirEstado();
+            sistemaGestion.vaciarReordenamientos(); // Los huecos que faltan ya no llegarán
+            std::cout << "\nCaptura completada. " << receptor.getLecturas()
+                      << " lecturas registradas." << std::endl;
+#else
+            std::cout << "\nLa captura multi-dispositivo requiere Linux (epoll)." << std::endl;
+#endif
+            break;
+        }
+
+        case 9:
+        {
+            char nombreSensor[50];
+            std::cout << "\nIngrese el ID del sensor de vibracion: ";
+            std::cin.getline(nombreSensor, 50);
+
+            if (sistemaGestion.crearSensor<SensorVibracion>(nombreSensor) != nullptr)
+            {
+                std::cout << "Sensor de vibracion creado e insertado." << std::endl;
+            }
+            break;
+        }
+
+        case 10:
+        {
+            motorAlertas.imprimirReglas();
+
+            std::cout << "\nTipo de regla (0 = maximo, 1 = minimo, 2 = tasa de cambio, -1 = cancelar): ";
+            int tipoRegla;
+            std::cin >> tipoRegla;
+            std::cin.ignore();
+            if (tipoRegla < 0 || tipoRegla > 2)
+            {
+                break;
+            }
+
+            std::cout << "Aplicar a (1 = un sensor, 2 = todas las temperaturas, "
+                      << "3 = todas las presiones, 4 = todas las vibraciones): ";
+            int alcance;
+            std::cin >> alcance;
+            std::cin.ignore();
+
+            char idSensor[50] = "";
+            if (alcance == 1)
+            {
+                std::cout << "ID del sensor: ";
+                std::cin.getline(idSensor, 50);
+            }
+
+            float umbral, histeresis;
+            std::cout << "Umbral: ";
+            std::cin >> umbral;
+            std::cout << "Histeresis: ";
+            std::cin >> histeresis;
+            std::cin.ignore();
+
+            TipoRegla regla = static_cast<TipoRegla>(tipoRegla);
+            if (alcance == 1)
+            {
+                motorAlertas.agregarReglaSensor(idSensor, regla, umbral, histeresis);
+            }
+            else if (alcance == 2)
+            {
+                motorAlertas.agregarReglaTipo<SensorTemperatura>(regla, umbral, histeresis);
+            }
+            else if (alcance == 3)
+            {
+                motorAlertas.agregarReglaTipo<SensorPresion>(regla, umbral, histeresis);
+            }
+            else if (alcance == 4)
+            {
+                motorAlertas.agregarReglaTipo<SensorVibracion>(regla, umbral, histeresis);
+            }
+            break;
+        }
+
+        case 11:
+        {
+            int ranura = publicador.registrarLector();
+            if (ranura >= 0)
+            {
+                LectorInstantaneas vista(publicador, ranura);
+                vista->imprimir();
+            }
+            publicador.liberarLector(ranura);
+            break;
+        }
+
+        case 12:
+        {
+            char idSensor[50];
+            std::cout << "\nIngrese el ID del sensor: ";
+            std::cin.getline(idSensor, 50);
+
+            SensorBase *sensor = sistemaGestion.buscarSensor(idSensor);
+            if (sensor == nullptr)
+            {
+                std::cout << "Error: Sensor no encontrado." << std::endl;
+                break;
+            }
+
+            int tamano;
+            double alfa;
+            std::cout << "Lecturas por ventana (ej: 60): ";
+            std::cin >> tamano;
+            std::cout << "Alfa de la EWMA (0 < alfa <= 1): ";
+            std::cin >> alfa;
+            std::cin.ignore();
+
+            if (sensor->configurarVentana(tamano, alfa))
+            {
+                std::cout << "Ventana configurada (los agregados se reinician)." << std::endl;
+            }
+            else
+            {
+                std::cout << "El sensor no mantiene agregados de ventana." << std::endl;
+            }
+            break;
+        }
+
+        case 13:
+        {
+            std::cout << "\n1. Top-k por ultima lectura" << std::endl;
+            std::cout << "2. Agregado por prefijo de ID" << std::endl;
+            std::cout << "3. Sensores sin datos" << std::endl;
+            std::cout << "Consulta: ";
+            int consulta;
+            std::cin >> consulta;
+            std::cin.ignore();
+
+            char prefijo[50];
+            std::cout << "Prefijo del ID (ej: P-, vacio = todos): ";
+            std::cin.getline(prefijo, 50);
+
+            long long inicio = ConsultasFlota::ahoraMs();
+
+            if (consulta == 1)
+            {
+                int k;
+                int orden;
+                std::cout << "Cuantos sensores (k): ";
+                std::cin >> k;
+                std::cout << "Orden (1 = mayores, 0 = menores): ";
+                std::cin >> orden;
+                std::cin.ignore();
+
+                if (k <= 0)
+                {
+                    std::cout << "k debe ser positivo." << std::endl;
+                    break;
+                }
+
+                ResultadoTopK *resultado = new ResultadoTopK[k];
+                int n = consultas.topK(prefijo, k, CAMPO_ULTIMO, orden == 1, resultado);
+                inicio = ConsultasFlota::ahoraMs() - inicio;
+
+                std::cout << "\n--- Top " << n << " (" << inicio << " ms) ---" << std::endl;
+                for (int i = 0; i < n; i++)
+                {
+                    std::cout << (i + 1) << ". " << resultado[i].nombre << ": " << resultado[i].valor << std::endl;
+                }
+                delete[] resultado;
+            }
+            else if (consulta == 2)
+            {
+                AgregadoFlota a = consultas.agregar(prefijo);
+                inicio = ConsultasFlota::ahoraMs() - inicio;
+
+                std::cout << "\n--- Agregado '" << prefijo << "*' (" << inicio << " ms) ---" << std::endl;
+                std::cout << "Sensores: " << a.sensores << " (" << a.sensoresConDatos << " con datos)"
+                          << " | Lecturas: " << a.lecturas << std::endl;
+                if (a.sensoresConDatos > 0)
+                {
+                    std::cout << "Promedio historico: " << a.promedio()
+                              << " | Promedio actual: " << a.promedioUltimos()
+                              << " | Min: " << a.minimo << " | Max: " << a.maximo << std::endl;
+                }
+            }
+            else if (consulta == 3)
+            {
+                long long segundos;
+                std::cout << "Segundos sin datos: ";
+                std::cin >> segundos;
+                std::cin.ignore();
+
+                const int MAX_LISTADOS = 20;
+                int manejadores[MAX_LISTADOS];
+                int n = consultas.inactivos(prefijo, segundos * 1000, manejadores, MAX_LISTADOS);
+                inicio = ConsultasFlota::ahoraMs() - inicio;
+
+                std::cout << "\n--- " << n << " sensor(es) sin datos en " << segundos
+                          << " s (" << inicio << " ms) ---" << std::endl;
+                for (int i = 0; i < n && i < MAX_LISTADOS; i++)
+                {
+                    std::cout << "  " << consultas.getResumen(manejadores[i])->sensor->getNombre() << std::endl;
+                }
+                if (n > MAX_LISTADOS)
+                {
+                    std::cout << "  ... y " << (n - MAX_LISTADOS) << " mas." << std::endl;
+                }
+            }
+            else
+            {
+                std::cout << "Consulta no valida." << std::endl;
+            }
+            break;
+        }
+
+        case 14:
+        {
+            int formato;
+            int limite;
+            char ruta[256];
+            std::cout << "\nFormato (0 = texto, 1 = CSV, 2 = JSON lines): ";
+            std::cin >> formato;
+            std::cout << "Lecturas a mostrar al inicio y al final de cada sensor (0 = todas): ";
+            std::cin >> limite;
+            std::cin.ignore();
+            std::cout << "Archivo de salida (vacio = consola): ";
+            std::cin.getline(ruta, 256);
+
+            if (formato < REPORTE_TEXTO || formato > REPORTE_JSON)
+            {
+                std::cout << "Formato no valido." << std::endl;
+                break;
+            }
+
+            EscritorReporte escritor;
+            if (ruta[0] != '\0' && !escritor.abrirArchivo(ruta))
+            {
+                std::cout << "Error: no se pudo abrir '" << ruta << "'." << std::endl;
+                break;
+            }
+
+            sistemaGestion.escribirReporte(escritor, static_cast<FormatoReporte>(formato), limite);
+            escritor.vaciar();
+
+            std::cout << "\nReporte: " << escritor.getBytesEscritos() << " bytes en "
+                      << escritor.getVaciados() << " escritura(s)." << std::endl;
+            break;
+        }
+
+        case 15:
+        {
+            bitacora.imprimirEstado();
+            if (!bitacora.estaAbierta())
+            {
+                std::cout << "Inicie el programa con la ruta de la bitacora como argumento." << std::endl;
+                break;
+            }
+
+            char respuesta[8];
+            std::cout << "Hacer punto de control y truncar la bitacora? (s/n): ";
+            std::cin.getline(respuesta, 8);
+            if (respuesta[0] == 's' || respuesta[0] == 'S')
+            {
+                std::cout << (bitacora.puntoControl() ? "Punto de control completado." : "Error en el punto de control.")
+                          << std::endl;
+                bitacora.imprimirEstado();
+            }
+            break;
+        }
+
+        case 16:
+        {
+            gestorMemoria.imprimirEstadisticas(5);
+
+            long long presupuestoKB;
+            int politica;
+            std::cout << "\nNuevo presupuesto en KB (0 = sin limite, -1 = no cambiar): ";
+            std::cin >> presupuestoKB;
+            if (presupuestoKB < 0)
+            {
+                std::cin.ignore();
+                break;
+            }
+            std::cout << "Politica (0 = lecturas antiguas, 1 = sensores inactivos): ";
+            std::cin >> politica;
+            std::cin.ignore();
+
+            gestorMemoria.configurar(static_cast<std::size_t>(presupuestoKB) * 1024,
+                                     politica == 1 ? DESALOJO_SENSORES_INACTIVOS : DESALOJO_LECTURAS_ANTIGUAS);
+            gestorMemoria.imprimirEstadisticas(5);
+            break;
+        }
+
+        case 17:
+        {
+            sistemaGestion.imprimirReordenamiento();
+
+            char respuesta[8];
+            std::cout << "\nRegistrar las lecturas en espera sin esperar sus huecos? (s/n): ";
+            std::cin.getline(respuesta, 8);
+            if (respuesta[0] == 's' || respuesta[0] == 'S')
+            {
+                std::cout << sistemaGestion.vaciarReordenamientos() << " lectura(s) registradas." << std::endl;
+            }
+            break;
+        }
+
+        case 18:
+        {
+            char puerto[20];
+            std::cout << "\nIngrese el puerto COM (ej: COM3): ";
+            std::cin.getline(puerto, 20);
+            if (!serialReader.conectar(puerto))
+            {
+                std::cout << "Error al conectar con el puerto serial." << std::endl;
+                break;
+            }
+            serialReader.setModoBinario(false);
+
+            int periodoCaptura, lote, periodoProceso, periodoReporte, periodoMantenimiento, numLecturas, segundos;
+            long long ttlInactividad;
+            std::cout << "Captura: cada cuantos ms y cuantas lineas por turno? ";
+            std::cin >> periodoCaptura >> lote;
+            std::cout << "Procesamiento incremental cada cuantos ms? (0 = ninguno): ";
+            std::cin >> periodoProceso;
+            std::cout << "Reporte de instantanea cada cuantos ms? (0 = ninguno): ";
+            std::cin >> periodoReporte;
+            std::cout << "Mantenimiento (alertas, desalojos, bitacora) cada cuantos ms? ";
+            std::cin >> periodoMantenimiento;
+            std::cout << "Dar de baja sensores sin lecturas tras cuantos ms? (0 = nunca): ";
+            std::cin >> ttlInactividad;
+            std::cout << "Detener tras cuantas lecturas y/o segundos? (0 = sin limite): ";
+            std::cin >> numLecturas >> segundos;
+            std::cin.ignore();
+            if (numLecturas <= 0 && segundos <= 0)
+            {
+                segundos = 10; // Sin ningun limite no se volveria al menu
+            }
+
+            PlanificadorTareas planificador;
+            TareaCaptura captura(serialReader, sistemaGestion, planificador, lote > 0 ? lote : 1, numLecturas);
+            TareaProcesamiento proceso(sistemaGestion, bitacora);
+            TareaReporte reporte(publicador);
+            TareaMantenimiento mantenimiento(trasLecturas, sistemaGestion, ttlInactividad);
+
+            planificador.agregarTarea("captura", &captura, periodoCaptura > 0 ? periodoCaptura : 1, 0);
+            planificador.agregarTarea("mantenimiento", &mantenimiento,
+                                      periodoMantenimiento > 0 ? periodoMantenimiento : 100, 0);
+            if (periodoProceso > 0)
+            {
+                planificador.agregarTarea("procesamiento", &proceso, periodoProceso, periodoProceso);
+            }
+            if (periodoReporte > 0)
+            {
+                planificador.agregarTarea("reporte", &reporte, periodoReporte, periodoReporte);
+            }
+
+            std::cout << "\n--- Modo automatico ---\n"
+                      << std::endl;
+            planificador.correr(segundos > 0 ? segundos * 1000LL : 0);
+
+            serialReader.desconectar();
+            sistemaGestion.vaciarReordenamientos(); // Los huecos que faltan ya no llegaran
+            planificador.imprimirEstadisticas();
+            std::cout << "\nModo automatico finalizado. " << captura.getLecturas() << " lecturas registradas."
+                      << std::endl;
+            break;
+        }
+
+        case 19:
+        {
+            Trazas::imprimirResumen();
+
+            int cadaN;
+            std::cout << "\nTrazar una de cada cuantas lecturas? (0 = desactivar): ";
+            std::cin >> cadaN;
+            std::cin.ignore();
+            Trazas::configurar(cadaN);
+
+            char ruta[256];
+            std::cout << "Exportar las trazas a (archivo .json, vacio = no exportar): ";
+            std::cin.getline(ruta, 256);
+            if (ruta[0] != '\0')
+            {
+                long eventos = Trazas::exportarChrome(ruta);
+                if (eventos < 0)
+                {
+                    std::cout << "Error: no se pudo abrir '" << ruta << "'." << std::endl;
+                }
+                else
+                {
+                    std::cout << eventos << " tramo(s) exportados a " << ruta
+                              << " (abrir en chrome://tracing o ui.perfetto.dev)." << std::endl;
+
+                    char respuesta[8];
+                    std::cout << "Descartar las trazas exportadas? (s/n): ";
+                    std::cin.getline(respuesta, 8);
+                    if (respuesta[0] == 's' || respuesta[0] == 'S')
+                    {
+                        Trazas::limpiar();
+                    }
+                }
+            }
+            break;
+        }
+
+        case 20:
+        {
+            anillo.imprimirEstado();
+
+            if (anillo.estaAbierto())
+            {
+                char respuesta[8];
+                std::cout << "\nDejar de publicar y eliminar el segmento? (s/n): ";
+                std::cin.getline(respuesta, 8);
+                if (respuesta[0] == 's' || respuesta[0] == 'S')
+                {
+                    anillo.cerrar();
+                    std::cout << "Anillo cerrado." << std::endl;
+                }
+                break;
+            }
+
+            char nombre[48];
+            std::cout << "\nNombre del segmento (vacio = sensores): ";
+            std::cin.getline(nombre, 48);
+            std::cout << "Ranuras del anillo (0 = " << PublicadorAnillo::CAPACIDAD_DEFECTO << "): ";
+            int ranuras;
+            std::cin >> ranuras;
+            std::cin.ignore();
+
+            const char *segmento = (nombre[0] != '\0') ? nombre : "sensores";
+            if (anillo.abrir(segmento, ranuras > 0 ? ranuras : PublicadorAnillo::CAPACIDAD_DEFECTO))
+            {
+                publicador.publicar();
+                anillo.publicarAgregados(publicador); // Estado inicial de toda la flota
+                anillo.imprimirEstado();
+                std::cout << "Consumir con: ConsumidorAnillo " << segmento << std::endl;
+            }
+            else
+            {
+                std::cout << "No se pudo crear el anillo." << std::endl;
+            }
+            break;
+        }
+
+        case 21:
+        {
+            servidor.imprimirEstado();
+
+            if (servidor.estaActivo())
+            {
+                char respuesta[8];
+                std::cout << "\nDetener el servidor y cerrar las conexiones? (s/n): ";
+                std::cin.getline(respuesta, 8);
+                if (respuesta[0] == 's' || respuesta[0] == 'S')
+                {
+                    servidor.detener();
+                    std::cout << "Servidor detenido." << std::endl;
+                }
+                break;
+            }
+
+            char ruta[ServidorConsultas::TAM_RUTA];
+            std::cout << "\nRuta del socket (vacio = /tmp/sensores.sock): ";
+            std::cin.getline(ruta, ServidorConsultas::TAM_RUTA);
+
+            const char *socket = (ruta[0] != '\0') ? ruta : "/tmp/sensores.sock";
+            publicador.publicar(); // Que la primera consulta ya vea la flota actual
+            if (servidor.iniciar(socket))
+            {
+                servidor.imprimirEstado();
+                std::cout << "Consultar con: ClienteConsultas " << socket << " estado" << std::endl;
+            }
+            else
+            {
+                std::cout << "No se pudo iniciar el servidor." << std::endl;
+            }
+            break;
+        }
+
+        case 22:
+        {
+            motorAlertas.imprimirAlertas();
+            sistemaGestion.imprimirBajas();
+
+            std::cout << "\n1. Eliminar un sensor por ID" << std::endl;
+            std::cout << "2. Dar de baja los sensores sin lecturas recientes" << std::endl;
+            std::cout << "Accion: ";
+            int accion;
+            std::cin >> accion;
+            std::cin.ignore();
+
+            if (accion == 1)
+            {
+                char idSensor[50];
+                std::cout << "ID del sensor: ";
+                std::cin.getline(idSensor, 50);
+                if (!sistemaGestion.eliminarSensor(idSensor))
+                {
+                    std::cout << "Sensor no encontrado." << std::endl;
+                    break;
+                }
+            }
+            else if (accion == 2)
+            {
+                long long segundos;
+                std::cout << "Segundos sin lecturas: ";
+                std::cin >> segundos;
+                std::cin.ignore();
+
+                long long inicio = ConsultasFlota::ahoraMs();
+                int n = sistemaGestion.expirarInactivos(segundos * 1000);
+                std::cout << n << " sensor(es) dados de baja en " << (ConsultasFlota::ahoraMs() - inicio) << " ms."
+                          << std::endl;
+            }
+            else
+            {
+                std::cout << "Accion no valida." << std::endl;
+                break;
+            }
+
+            publicador.publicar(); // Las vistas dejan de mostrar los sensores dados de baja
+            sistemaGestion.imprimirBajas();
+            break;
+        }
+
+        case 23:
+        {
+            correlacion.imprimirPares();
+
+            std::cout << "\n1. Vigilar un par de sensores (ventana movil)" << std::endl;
+            std::cout << "2. Matriz de correlacion de ventana completa" << std::endl;
+            std::cout << "Accion: ";
+            int accion;
+            std::cin >> accion;
+            std::cin.ignore();
+
+            if (accion == 1)
+            {
+                char idA[50], idB[50];
+                int ventana, modo, retardo = 0;
+                double umbral;
+                std::cout << "ID del primer sensor (ej: temperatura): ";
+                std::cin.getline(idA, 50);
+                std::cout << "ID del segundo sensor (ej: presion): ";
+                std::cin.getline(idB, 50);
+                std::cout << "Lecturas de la ventana: ";
+                std::cin >> ventana;
+                std::cout << "Alineacion (0 = por indice, 1 = por llegada): ";
+                std::cin >> modo;
+                if (modo == ALINEAR_POR_INDICE)
+                {
+                    std::cout << "Retardo del segundo sensor en lecturas (negativo si se adelanta): ";
+                    std::cin >> retardo;
+                }
+                std::cout << "Umbral de acople |r| (0 = sin umbral): ";
+                std::cin >> umbral;
+                std::cin.ignore();
+
+                int idPar = correlacion.agregarPar(idA, idB, ventana,
+                                                   modo == 1 ? ALINEAR_POR_TIEMPO : ALINEAR_POR_INDICE,
+                                                   retardo, umbral);
+                if (idPar < 0)
+                {
+                    std::cout << "Par no valido (IDs vacios o iguales)." << std::endl;
+                    break;
+                }
+                std::cout << "Par #" << idPar << " agregado." << std::endl;
+                correlacion.imprimirPares();
+            }
+            else if (accion == 2)
+            {
+                char prefijo[50];
+                int ventana;
+                double umbral;
+                std::cout << "Prefijo de ID (vacio = todos): ";
+                std::cin.getline(prefijo, 50);
+                std::cout << "Lecturas mas recientes por sensor: ";
+                std::cin >> ventana;
+                std::cout << "Mostrar pares con |r| desde: ";
+                std::cin >> umbral;
+                std::cin.ignore();
+
+                int total = sistemaGestion.getContador();
+                SensorBase **seleccion = new SensorBase *[total > 0 ? total : 1];
+                int cantidad = 0;
+                std::size_t largoPrefijo = std::strlen(prefijo);
+                for (int v = 0; v < total; v++)
+                {
+                    SensorBase *sensor = sistemaGestion.obtenerVivo(v);
+                    if (sensor != nullptr && std::strncmp(sensor->getNombre(), prefijo, largoPrefijo) == 0)
+                    {
+                        seleccion[cantidad++] = sensor;
+                    }
+                }
+
+                correlacion.calcularMatriz(seleccion, cantidad, ventana, 0);
+                correlacion.imprimirMatriz(umbral, 20);
+                delete[] seleccion;
+            }
+            else
+            {
+                std::cout << "Accion no valida." << std::endl;
+            }
+            break;
+        }
+
+        case 0:
+        {
+            sistemaGestion.vaciarReordenamientos(); // Que la bitacora las confirme antes de salir
+            std::cout << "\nCerrando sistema..." << std::endl;
+            continuar = false;
+            break;
+        }
+
+        default:
             std::cout << "Opcion no valida." << std::endl;
             break;
         }
+
+        // Alertas generadas por lecturas manuales u otras opciones
+        trasLecturas.atenderAvisos();
+        publicador.publicar();
+        bitacora.confirmar(); // Lo ingresado desde el menu queda en disco al volver al menu
     }
 
     return 0;
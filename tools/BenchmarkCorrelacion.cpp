@@ -0,0 +1,236 @@
+/**
+ * @file BenchmarkCorrelacion.cpp
+ * @brief Benchmark de la matriz de correlación y verificación de las ventanas móviles
+ * @author FabiRamiro
+ * @date 2026-10-18
+ *
+ * Uso: BenchmarkCorrelacion [sensores] [ventana]
+ *
+ * Crea los sensores de temperatura en un ListaGeneral con un
+ * MotorCorrelacion como observador y les registra 2 * ventana lecturas
+ * sintéticas: ocho factores comunes (un sensor sigue al factor de su
+ * grupo, con signo alterno y ruido propio), de modo que hay pares muy
+ * correlacionados, anticorrelacionados e independientes.
+ *
+ * Mide la matriz de ventana completa contra una referencia escalar (dos
+ * pasadas de Pearson por par, sin estandarizar una sola vez) con 1 hilo
+ * y con todos los núcleos, y reporta el mejor de tres tiempos. Después
+ * verifica que la matriz coincida con la referencia y que la correlación
+ * móvil de dos pares vigilados (uno por índice y otro con retardo)
+ * coincida con la calculada desde el historial.
+ */
+
+#include <iostream>
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <chrono>
+#include <thread>
+#include "ListaGeneral.h"
+#include "MotorCorrelacion.h"
+#include "SensorTemperatura.h"
+
+namespace
+{
+    const int LARGO_NOMBRE = 16;
+    const int GRUPOS = 8;
+    const int RETARDO = 3;
+
+    /**
+     * @brief Pearson en dos pasadas, sin atajos (referencia)
+     */
+    double pearson(const double *a, const double *b, int n)
+    {
+        double mediaA = 0.0, mediaB = 0.0;
+        for (int i = 0; i < n; i++)
+        {
+            mediaA += a[i];
+            mediaB += b[i];
+        }
+        mediaA /= n;
+        mediaB /= n;
+
+        double sab = 0.0, saa = 0.0, sbb = 0.0;
+        for (int i = 0; i < n; i++)
+        {
+            sab += (a[i] - mediaA) * (b[i] - mediaB);
+            saa += (a[i] - mediaA) * (a[i] - mediaA);
+            sbb += (b[i] - mediaB) * (b[i] - mediaB);
+        }
+        return sab / std::sqrt(saa * sbb);
+    }
+
+    /**
+     * @brief Generador congruencial con salida uniforme en [-1, 1)
+     */
+    double aleatorio(unsigned long long &estado)
+    {
+        estado = estado * 6364136223846793005ULL + 1442695040888963407ULL;
+        return static_cast<double>(estado >> 11) / 4503599627370496.0 - 1.0;
+    }
+
+    double segundosDesde(std::chrono::steady_clock::time_point inicio)
+    {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+    }
+}
+
+/**
+ * @brief Punto de entrada del benchmark
+ * @param argc Número de argumentos
+ * @param argv Argumentos (opcionales: sensores y ventana)
+ * @return 0 si todas las verificaciones pasan, 1 en caso contrario
+ */
+int main(int argc, char *argv[])
+{
+    int numSensores = (argc > 1) ? std::atoi(argv[1]) : 256;
+    int ventana = (argc > 2) ? std::atoi(argv[2]) : 1024;
+    const int REPETICIONES = 3;
+    bool correcto = true;
+
+    if (numSensores <= 2 * GRUPOS + 1 || ventana < 2)
+    {
+        std::cerr << "Uso: " << argv[0] << " [sensores >= " << 2 * GRUPOS + 2 << "] [ventana >= 2]" << std::endl;
+        return 1;
+    }
+
+    int lecturas = 2 * ventana;
+    char (*nombres)[LARGO_NOMBRE] = new char[numSensores][LARGO_NOMBRE];
+    SensorTemperatura **sensores = new SensorTemperatura *[numSensores];
+    MotorCorrelacion motor;
+
+    // El registro y los sensores informan cada alta y cada lectura: se silencia la carga
+    std::streambuf *consola = std::cout.rdbuf(nullptr);
+    ListaGeneral *lista = new ListaGeneral();
+    lista->agregarObservador(&motor);
+    for (int i = 0; i < numSensores; i++)
+    {
+        std::snprintf(nombres[i], LARGO_NOMBRE, "T-%04d", i);
+        sensores[i] = lista->crearSensor<SensorTemperatura>(nombres[i]);
+    }
+    // Mismo factor: el primero con signo opuesto, el segundo con el mismo signo
+    int parIndice = motor.agregarPar(nombres[0], nombres[GRUPOS], ventana, ALINEAR_POR_INDICE, 0, 0.0);
+    int parRetardo = motor.agregarPar(nombres[1], nombres[1 + 2 * GRUPOS], ventana, ALINEAR_POR_INDICE, RETARDO, 0.0);
+
+    unsigned long long estado = 12345;
+    double factores[GRUPOS];
+    for (int g = 0; g < GRUPOS; g++)
+    {
+        factores[g] = 0.0;
+    }
+    for (int t = 0; t < lecturas; t++)
+    {
+        for (int g = 0; g < GRUPOS; g++)
+        {
+            factores[g] = 0.95 * factores[g] + aleatorio(estado);
+        }
+        for (int i = 0; i < numSensores; i++)
+        {
+            double senal = ((i / GRUPOS) % 2 == 0 ? 1.0 : -1.0) * factores[i % GRUPOS];
+            double valor = 20.0 + 3.0 * senal + 0.5 * i / numSensores + aleatorio(estado);
+            sensores[i]->registrarLectura(static_cast<float>(std::floor(valor * 10.0 + 0.5) / 10.0));
+        }
+    }
+    std::cout.rdbuf(consola);
+
+    // Copia de los historiales para la referencia (últimas 'ventana' lecturas)
+    double *historiales = new double[static_cast<std::size_t>(numSensores) * lecturas];
+    for (int i = 0; i < numSensores; i++)
+    {
+        sensores[i]->copiarLecturas(historiales + static_cast<std::size_t>(i) * lecturas, lecturas);
+    }
+
+    SensorBase **seleccion = new SensorBase *[numSensores];
+    for (int i = 0; i < numSensores; i++)
+    {
+        seleccion[i] = sensores[i];
+    }
+
+    int nucleos = static_cast<int>(std::thread::hardware_concurrency());
+    nucleos = (nucleos < 1) ? 1 : nucleos;
+    long long numPares = static_cast<long long>(numSensores) * (numSensores - 1) / 2;
+    std::cout << "Sensores: " << numSensores << ", ventana: " << ventana << ", pares: " << numPares
+              << ", nucleos: " << nucleos << std::endl;
+
+    // Referencia escalar
+    double *referencia = new double[static_cast<std::size_t>(numSensores) * numSensores];
+    double segundosReferencia = 0.0;
+    for (int r = 0; r < REPETICIONES; r++)
+    {
+        std::chrono::steady_clock::time_point inicio = std::chrono::steady_clock::now();
+        for (int i = 0; i < numSensores; i++)
+        {
+            const double *a = historiales + static_cast<std::size_t>(i) * lecturas + (lecturas - ventana);
+            for (int j = i + 1; j < numSensores; j++)
+            {
+                const double *b = historiales + static_cast<std::size_t>(j) * lecturas + (lecturas - ventana);
+                referencia[static_cast<std::size_t>(i) * numSensores + j] = pearson(a, b, ventana);
+            }
+        }
+        double s = segundosDesde(inicio);
+        segundosReferencia = (r == 0 || s < segundosReferencia) ? s : segundosReferencia;
+    }
+
+    std::cout << "Metodo              | Hilos | ms      | Mpares/s | Aceleracion" << std::endl;
+    std::printf("Referencia escalar  | %5d | %7.2f | %8.3f | %10.2fx\n", 1, segundosReferencia * 1e3,
+                numPares / segundosReferencia / 1e6, 1.0);
+
+    const int hilosPrueba[] = {1, nucleos};
+    for (int k = 0; k < (nucleos > 1 ? 2 : 1); k++)
+    {
+        double segundos = 0.0;
+        for (int r = 0; r < REPETICIONES; r++)
+        {
+            std::chrono::steady_clock::time_point inicio = std::chrono::steady_clock::now();
+            int validas = motor.calcularMatriz(seleccion, numSensores, ventana, hilosPrueba[k]);
+            double s = segundosDesde(inicio);
+            segundos = (r == 0 || s < segundos) ? s : segundos;
+            correcto = correcto && validas == numSensores;
+        }
+        std::printf("Matriz con kernel   | %5d | %7.2f | %8.3f | %10.2fx\n", hilosPrueba[k], segundos * 1e3,
+                    numPares / segundos / 1e6, segundosReferencia / segundos);
+    }
+
+    double errorMatriz = 0.0;
+    for (int i = 0; i < numSensores; i++)
+    {
+        for (int j = i + 1; j < numSensores; j++)
+        {
+            double error = std::fabs(motor.getCorrelacion(i, j) - referencia[static_cast<std::size_t>(i) * numSensores + j]);
+            double simetria = std::fabs(motor.getCorrelacion(j, i) - motor.getCorrelacion(i, j));
+            errorMatriz = (error > errorMatriz) ? error : errorMatriz;
+            correcto = correcto && simetria == 0.0;
+        }
+    }
+    correcto = correcto && errorMatriz < 1e-9;
+
+    // Ventanas móviles: el observador ve el float registrado; el historial, su décima
+    const double *a = historiales;
+    const double *b = historiales + GRUPOS * static_cast<std::size_t>(lecturas);
+    double esperadoIndice = pearson(a + lecturas - ventana, b + lecturas - ventana, ventana);
+    const double *c = historiales + static_cast<std::size_t>(lecturas);
+    const double *d = historiales + (1 + 2 * GRUPOS) * static_cast<std::size_t>(lecturas);
+    double esperadoRetardo = pearson(c + lecturas - RETARDO - ventana, d + lecturas - ventana, ventana);
+    double errorIndice = std::fabs(motor.getCorrelacionPar(parIndice) - esperadoIndice);
+    double errorRetardo = std::fabs(motor.getCorrelacionPar(parRetardo) - esperadoRetardo);
+    correcto = correcto && errorIndice < 1e-5 && errorRetardo < 1e-5;
+
+    std::printf("Error maximo de la matriz: %.3g\n", errorMatriz);
+    std::printf("Par movil por indice: r = %.6f (historial %.6f)\n", motor.getCorrelacionPar(parIndice),
+                esperadoIndice);
+    std::printf("Par movil con retardo %d: r = %.6f (historial %.6f)\n", RETARDO,
+                motor.getCorrelacionPar(parRetardo), esperadoRetardo);
+
+    std::cout.rdbuf(nullptr);
+    delete lista;
+    std::cout.rdbuf(consola);
+    delete[] referencia;
+    delete[] seleccion;
+    delete[] historiales;
+    delete[] sensores;
+    delete[] nombres;
+
+    std::cout << (correcto ? "Verificacion correcta." : "ERROR: correlaciones inconsistentes con la referencia.")
+              << std::endl;
+    return correcto ? 0 : 1;
+}
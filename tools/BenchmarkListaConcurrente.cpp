@@ -0,0 +1,210 @@
+/**
+ * @file BenchmarkListaConcurrente.cpp
+ * @brief Benchmark de contención: ListaSensorConcurrente contra una lista con mutex
+ * @author FabiRamiro
+ * @date 2026-10-18
+ *
+ * Uso: BenchmarkListaConcurrente [lecturas_totales]
+ *
+ * Para 1, 2, 4 y 8 productores se insertan las mismas lecturas en:
+ *  - ListaSensorConcurrente (inserción wait-free)
+ *  - Una lista enlazada con puntero a la cola protegida por std::mutex
+ * y se reporta el mejor de tres rendimientos en millones de inserciones
+ * por segundo. Con un solo núcleo no hay contención real y ambas listas
+ * rinden parecido; la diferencia aparece con productores en núcleos distintos.
+ * Al final el consumidor verifica el conteo y la suma de cada lista, y
+ * que el promedio de enteros no se trunque ni desborde.
+ */
+
+#include <iostream>
+#include <cstdlib>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include "ListaSensorConcurrente.h"
+
+namespace
+{
+    /**
+     * @brief Lista de referencia: inserción O(1) al final protegida por un mutex
+     */
+    class ListaConMutex
+    {
+    private:
+        struct NodoSimple
+        {
+            long long dato;
+            NodoSimple *siguiente;
+        };
+
+        std::mutex candado;
+        NodoSimple *cabeza;
+        NodoSimple *cola;
+
+    public:
+        ListaConMutex() : cabeza(nullptr), cola(nullptr) {}
+
+        ~ListaConMutex()
+        {
+            while (cabeza != nullptr)
+            {
+                NodoSimple *siguiente = cabeza->siguiente;
+                delete cabeza;
+                cabeza = siguiente;
+            }
+        }
+
+        void insertar(long long valor)
+        {
+            NodoSimple *nuevo = new NodoSimple;
+            nuevo->dato = valor;
+            nuevo->siguiente = nullptr;
+
+            std::lock_guard<std::mutex> guardia(candado);
+            if (cola == nullptr)
+            {
+                cabeza = nuevo;
+            }
+            else
+            {
+                cola->siguiente = nuevo;
+            }
+            cola = nuevo;
+        }
+
+        long long sumar(int &cantidad) const
+        {
+            long long suma = 0;
+            cantidad = 0;
+            for (NodoSimple *n = cabeza; n != nullptr; n = n->siguiente)
+            {
+                suma += n->dato;
+                cantidad++;
+            }
+            return suma;
+        }
+    };
+
+    /**
+     * @brief Ejecuta productores concurrentes sobre una lista y mide el tiempo
+     * @return Segundos transcurridos
+     */
+    template <typename Lista>
+    double medir(Lista &lista, int productores, int porProductor)
+    {
+        std::thread *hilos = new std::thread[productores];
+
+        std::chrono::steady_clock::time_point inicio = std::chrono::steady_clock::now();
+        for (int p = 0; p < productores; p++)
+        {
+            hilos[p] = std::thread([&lista, p, porProductor]()
+                                   {
+                                       long long base = static_cast<long long>(p) * porProductor;
+                                       for (int i = 0; i < porProductor; i++)
+                                       {
+                                           lista.insertar(base + i);
+                                       }
+                                   });
+        }
+        for (int p = 0; p < productores; p++)
+        {
+            hilos[p].join();
+        }
+        std::chrono::steady_clock::time_point fin = std::chrono::steady_clock::now();
+
+        delete[] hilos;
+        return std::chrono::duration<double>(fin - inicio).count();
+    }
+}
+
+/**
+ * @brief Punto de entrada del benchmark
+ * @param argc Número de argumentos
+ * @param argv Argumentos (opcional: lecturas totales)
+ * @return 0 si todas las verificaciones pasan, 1 en caso contrario
+ */
+int main(int argc, char *argv[])
+{
+    int total = (argc > 1) ? std::atoi(argv[1]) : 2000000;
+    const int productoresPrueba[] = {1, 2, 4, 8};
+    const int REPETICIONES = 3;
+    bool correcto = true;
+
+    std::cout << "Lecturas por prueba: " << total << std::endl;
+    std::cout << "Productores | Lock-free (M/s) | Mutex (M/s) | Aceleracion" << std::endl;
+
+    for (int k = 0; k < 4; k++)
+    {
+        int productores = productoresPrueba[k];
+        int porProductor = total / productores;
+        long long n = static_cast<long long>(porProductor) * productores;
+        long long sumaEsperada = n * (n - 1) / 2;
+
+        // Mejor de varias repeticiones alternadas, para que ninguna lista
+        // cargue sola con el costo de estrenar memoria del heap
+        double segundosLibre = 0.0;
+        double segundosMutex = 0.0;
+        for (int r = 0; r < REPETICIONES; r++)
+        {
+            {
+                ListaSensorConcurrente<long long> lista;
+                double s = medir(lista, productores, porProductor);
+                segundosLibre = (r == 0 || s < segundosLibre) ? s : segundosLibre;
+
+                long long *valores = new long long[n];
+                int copiados = lista.copiarEn(valores, static_cast<int>(n));
+                long long suma = 0;
+                for (int i = 0; i < copiados; i++)
+                {
+                    suma += valores[i];
+                }
+                delete[] valores;
+
+                if (copiados != n || lista.getContador() != n || suma != sumaEsperada ||
+                    lista.calcularPromedio() != static_cast<double>(n - 1) / 2.0)
+                {
+                    std::cout << "[Error] Lista lock-free inconsistente con " << productores
+                              << " productor(es)." << std::endl;
+                    correcto = false;
+                }
+            }
+
+            {
+                ListaConMutex lista;
+                double s = medir(lista, productores, porProductor);
+                segundosMutex = (r == 0 || s < segundosMutex) ? s : segundosMutex;
+
+                int cantidad;
+                long long suma = lista.sumar(cantidad);
+                if (cantidad != n || suma != sumaEsperada)
+                {
+                    std::cout << "[Error] Lista con mutex inconsistente con " << productores
+                              << " productor(es)." << std::endl;
+                    correcto = false;
+                }
+            }
+        }
+
+        std::cout << "     " << productores
+                  << "      |      " << (n / segundosLibre) / 1e6
+                  << "     |    " << (n / segundosMutex) / 1e6
+                  << "    |   " << segundosMutex / segundosLibre << "x" << std::endl;
+    }
+
+    // Promedio de enteros: no se trunca ni desborda en T
+    {
+        ListaSensorConcurrente<int> enteros;
+        enteros.insertar(1);
+        enteros.insertar(2);
+        ListaSensorConcurrente<int> grandes;
+        grandes.insertar(2147483647);
+        grandes.insertar(2147483647);
+        if (enteros.calcularPromedio() != 1.5 || grandes.calcularPromedio() != 2147483647.0)
+        {
+            std::cout << "[Error] Promedio de enteros truncado o desbordado." << std::endl;
+            correcto = false;
+        }
+    }
+
+    return correcto ? 0 : 1;
+}
@@ -0,0 +1,233 @@
+/**
+ * @file BenchmarkRegistroFragmentado.cpp
+ * @brief Benchmark de búsquedas y avisos de lectura concurrentes en ListaGeneral
+ * @author FabiRamiro
+ * @date 2026-10-18
+ *
+ * Uso: BenchmarkRegistroFragmentado [sensores] [operaciones_por_hilo]
+ *
+ * Registra los sensores tres veces: con un solo fragmento, con
+ * ListaGeneral::FRAGMENTOS_DEFECTO, y otra vez con FRAGMENTOS_DEFECTO y
+ * los observadores que instala el sistema (alertas, instantáneas,
+ * consultas, memoria, anillo y correlación; la bitácora queda fuera
+ * porque su costo es el del disco). Para 1, 2, 4 y 8 hilos, cada hilo
+ * busca sensores por nombre y avisa una lectura de cada uno (el camino
+ * de una lectura desde otro hilo: LectorRegistro + buscarSensor +
+ * lecturaRegistrada), y se reporta el mejor de tres rendimientos en
+ * millones de operaciones por segundo. Con un solo fragmento todos los
+ * hilos compiten por el mismo cerrojo; con varios, solo los que caen en
+ * el mismo fragmento, también al despachar a los observadores. La
+ * escalabilidad solo se ve con hilos en núcleos distintos.
+ *
+ * Al final se verifica que toda búsqueda haya encontrado su sensor, que
+ * cada sensor quede una sola vez en la lista de modificados y que las
+ * consultas y las instantáneas hayan contado cada lectura.
+ */
+
+#include <iostream>
+#include <cstdio>
+#include <cstdlib>
+#include <chrono>
+#include <atomic>
+#include <thread>
+#include "ListaGeneral.h"
+#include "SensorTemperatura.h"
+#include "MotorAlertas.h"
+#include "Instantaneas.h"
+#include "ConsultasFlota.h"
+#include "GestorMemoria.h"
+#include "PublicadorAnillo.h"
+#include "MotorCorrelacion.h"
+
+namespace
+{
+    const int LARGO_NOMBRE = 16;
+    const int NUM_LISTAS = 3;
+    const int PARES_VIGILADOS = 64;
+
+    /**
+     * @brief Ejecuta los hilos sobre el registro y mide el tiempo
+     * @return Segundos transcurridos
+     */
+    double medir(ListaGeneral &lista, const char (*nombres)[LARGO_NOMBRE], int numSensores, int hilos,
+                 int porHilo, std::atomic<long> &fallidas)
+    {
+        std::thread *trabajadores = new std::thread[hilos];
+
+        std::chrono::steady_clock::time_point inicio = std::chrono::steady_clock::now();
+        for (int h = 0; h < hilos; h++)
+        {
+            trabajadores[h] = std::thread([&lista, nombres, numSensores, h, porHilo, &fallidas]()
+                                          {
+                                              // Recorrido distinto por hilo: saltos de un primo grande
+                                              unsigned posicion = static_cast<unsigned>(h) * 7919u;
+                                              long noEncontradas = 0;
+                                              int ranura = lista.registrarLector();
+                                              for (int i = 0; i < porHilo; i++)
+                                              {
+                                                  posicion = (posicion + 104729u) % numSensores;
+                                                  LectorRegistro lector(lista, ranura);
+                                                  SensorBase *sensor = lista.buscarSensor(nombres[posicion]);
+                                                  if (sensor == nullptr)
+                                                  {
+                                                      noEncontradas++;
+                                                      continue;
+                                                  }
+                                                  lista.lecturaRegistrada(*sensor, 1.0);
+                                              }
+                                              lista.liberarLector(ranura);
+                                              fallidas += noEncontradas;
+                                          });
+        }
+        for (int h = 0; h < hilos; h++)
+        {
+            trabajadores[h].join();
+        }
+        std::chrono::steady_clock::time_point fin = std::chrono::steady_clock::now();
+
+        delete[] trabajadores;
+        return std::chrono::duration<double>(fin - inicio).count();
+    }
+}
+
+/**
+ * @brief Punto de entrada del benchmark
+ * @param argc Número de argumentos
+ * @param argv Argumentos (opcionales: sensores y operaciones por hilo)
+ * @return 0 si todas las verificaciones pasan, 1 en caso contrario
+ */
+int main(int argc, char *argv[])
+{
+    int numSensores = (argc > 1) ? std::atoi(argv[1]) : 4096;
+    int porHilo = (argc > 2) ? std::atoi(argv[2]) : 1000000;
+    const int hilosPrueba[] = {1, 2, 4, 8};
+    const int fragmentosPrueba[] = {1, ListaGeneral::FRAGMENTOS_DEFECTO, ListaGeneral::FRAGMENTOS_DEFECTO};
+    const int REPETICIONES = 3;
+    bool correcto = true;
+
+    if (numSensores <= 0 || porHilo <= 0)
+    {
+        std::cerr << "Uso: " << argv[0] << " [sensores] [operaciones_por_hilo]" << std::endl;
+        return 1;
+    }
+
+    char (*nombres)[LARGO_NOMBRE] = new char[numSensores][LARGO_NOMBRE];
+    for (int i = 0; i < numSensores; i++)
+    {
+        std::snprintf(nombres[i], LARGO_NOMBRE, "S-%06d", i);
+    }
+
+    // Los mismos observadores que main; las alertas disparan una vez por sensor y luego quedan activas
+    MotorAlertas motorAlertas;
+    PublicadorInstantaneas publicador;
+    ConsultasFlota consultas;
+    GestorMemoria gestorMemoria;
+    PublicadorAnillo anillo;
+    MotorCorrelacion correlacion;
+    motorAlertas.agregarReglaTipo<SensorTemperatura>(REGLA_MAXIMO, 0.5f, 0.1f);
+    for (int p = 0; p < PARES_VIGILADOS && p + 1 < numSensores; p++)
+    {
+        correlacion.agregarPar(nombres[p], nombres[p + 1], 64, ALINEAR_POR_TIEMPO, 0, 0.9);
+    }
+    char segmento[PublicadorAnillo::TAM_NOMBRE_SEGMENTO];
+    std::snprintf(segmento, sizeof(segmento), "/BenchmarkRegistro-%lld",
+                  static_cast<long long>(std::chrono::steady_clock::now().time_since_epoch().count()));
+    bool conAnillo = anillo.abrir(segmento);
+
+    // El registro informa cada alta y cada liberación: se silencia fuera de las mediciones
+    std::streambuf *consola = std::cout.rdbuf(nullptr);
+    ListaGeneral *listas[NUM_LISTAS];
+    for (int f = 0; f < NUM_LISTAS; f++)
+    {
+        listas[f] = new ListaGeneral(fragmentosPrueba[f]);
+    }
+    listas[2]->agregarObservador(&motorAlertas);
+    listas[2]->agregarObservador(&publicador);
+    listas[2]->agregarObservador(&consultas);
+    listas[2]->agregarObservador(&gestorMemoria);
+    listas[2]->agregarObservador(&anillo);
+    listas[2]->agregarObservador(&correlacion);
+    for (int f = 0; f < NUM_LISTAS; f++)
+    {
+        for (int i = 0; i < numSensores; i++)
+        {
+            listas[f]->crearSensor<SensorTemperatura>(nombres[i]);
+        }
+    }
+    std::cout.rdbuf(consola);
+
+    std::cout << "Sensores: " << numSensores << ", operaciones por hilo: " << porHilo
+              << ", nucleos: " << std::thread::hardware_concurrency() << std::endl;
+    std::cout << "Observadores: alertas, instantaneas, consultas, memoria, "
+              << (conAnillo ? "anillo" : "anillo (sin segmento, inactivo)") << ", correlacion ("
+              << PARES_VIGILADOS << " pares)" << std::endl;
+    std::cout << "Hilos | 1 fragmento (M/s) | " << listas[1]->getNumFragmentos()
+              << " fragmentos (M/s) | Aceleracion | Con observadores (M/s) | Aceleracion" << std::endl;
+
+    long avisadas = 0;
+    double conObservadoresUnHilo = 0.0;
+    for (int k = 0; k < 4; k++)
+    {
+        int hilos = hilosPrueba[k];
+        double segundos[NUM_LISTAS] = {0.0, 0.0, 0.0};
+        for (int r = 0; r < REPETICIONES; r++)
+        {
+            for (int f = 0; f < NUM_LISTAS; f++)
+            {
+                std::atomic<long> fallidas(0);
+                double s = medir(*listas[f], nombres, numSensores, hilos, porHilo, fallidas);
+                segundos[f] = (r == 0 || s < segundos[f]) ? s : segundos[f];
+                correcto = correcto && fallidas.load() == 0;
+            }
+            avisadas += static_cast<long>(hilos) * porHilo;
+        }
+
+        double operaciones = static_cast<double>(hilos) * porHilo;
+        double unico = operaciones / segundos[0] / 1e6;
+        double fragmentado = operaciones / segundos[1] / 1e6;
+        double conObservadores = operaciones / segundos[2] / 1e6;
+        conObservadoresUnHilo = (k == 0) ? conObservadores : conObservadoresUnHilo;
+        std::printf("%5d | %17.2f | %18.2f | %10.2fx | %22.2f | %10.2fx\n", hilos, unico, fragmentado,
+                    fragmentado / unico, conObservadores, conObservadores / conObservadoresUnHilo);
+    }
+
+    // Los avisos concurrentes de fragmentos distintos no deben perder lecturas en los observadores
+    publicador.publicar();
+    int ranura = publicador.registrarLector();
+    long long enInstantanea;
+    {
+        LectorInstantaneas vista(publicador, ranura);
+        enInstantanea = vista->lecturasTotales;
+    }
+    publicador.liberarLector(ranura);
+    long long enConsultas = consultas.agregar("").lecturas;
+    correcto = correcto && enConsultas == avisadas && enInstantanea == avisadas;
+    std::printf("Lecturas avisadas: %ld | en consultas: %lld | en la instantanea: %lld | en el anillo: %llu\n",
+                avisadas, enConsultas, enInstantanea, anillo.getPublicados());
+
+    // Cada sensor fue marcado muchas veces pero debe figurar una sola vez
+    for (int f = 0; f < NUM_LISTAS; f++)
+    {
+        const int *lista = listas[f]->getModificados();
+        int cantidad = listas[f]->getNumModificados();
+        bool ordenada = cantidad == numSensores;
+        for (int i = 0; ordenada && i < cantidad; i++)
+        {
+            ordenada = lista[i] == i;
+        }
+        correcto = correcto && ordenada;
+    }
+
+    std::cout.rdbuf(nullptr);
+    for (int f = 0; f < NUM_LISTAS; f++)
+    {
+        delete listas[f];
+    }
+    std::cout.rdbuf(consola);
+    anillo.cerrar();
+    delete[] nombres;
+
+    std::cout << (correcto ? "Verificacion correcta." : "ERROR: busquedas fallidas, avisos perdidos o modificados inconsistentes.")
+              << std::endl;
+    return correcto ? 0 : 1;
+}
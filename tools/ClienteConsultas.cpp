@@ -0,0 +1,379 @@
+/**
+ * @file ClienteConsultas.cpp
+ * @brief Cliente local del servidor de consultas (socket Unix)
+ * @author FabiRamiro
+ * @date 2026-10-18
+ *
+ * Uso: ClienteConsultas ruta_socket consulta [consulta ...]
+ *
+ * Consultas:
+ *  - estado
+ *  - sensor ID
+ *  - stats ID desde hasta      (0 0 = todo el historial, -100 0 = últimas cien)
+ *  - rango ID desde hasta
+ *  - topk prefijo k campo mayores|menores   (prefijo '*' = todos;
+ *                                            campo: promedio, minimo, maximo, ultima, lecturas)
+ *  - bench ID n                (n búsquedas, sin pipelining y en ventanas de 256)
+ *
+ * Todas las consultas de la línea se envían juntas con una sola escritura
+ * (pipelining) y las respuestas se imprimen a medida que llegan, en orden.
+ */
+
+#include <iostream>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <cstdint>
+#include <chrono>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "ProtocoloConsultas.h"
+
+namespace
+{
+    const int TAM_BUFFER = 1 << 20;
+
+    unsigned char peticiones[TAM_BUFFER];
+    unsigned char respuestas[TAM_BUFFER];
+
+    /**
+     * @brief Agrega una petición al buffer
+     * @return Bytes que ocupa la petición
+     */
+    int armarPeticion(unsigned char *destino, int operacion, std::uint32_t id, const unsigned char *carga,
+                      int largo)
+    {
+        unsigned char *q = destino;
+        escribirCampo<std::uint32_t>(q, static_cast<std::uint32_t>(TAM_CABECERA_PETICION - 4 + largo));
+        escribirCampo<std::uint8_t>(q, static_cast<std::uint8_t>(operacion));
+        escribirCampo<std::uint32_t>(q, id);
+        std::memcpy(q, carga, largo);
+        return TAM_CABECERA_PETICION + largo;
+    }
+
+    /**
+     * @brief Carga de stats/rango: desde, hasta y nombre
+     */
+    int cargaRango(unsigned char *carga, int desde, int hasta, const char *nombre)
+    {
+        unsigned char *q = carga;
+        escribirCampo<std::int32_t>(q, desde);
+        escribirCampo<std::int32_t>(q, hasta);
+        int largo = static_cast<int>(std::strlen(nombre));
+        std::memcpy(q, nombre, largo);
+        return 8 + largo;
+    }
+
+    int campoPorNombre(const char *nombre)
+    {
+        static const char *const nombres[] = {"promedio", "minimo", "maximo", "ultima", "lecturas"};
+        for (int i = 0; i < 5; i++)
+        {
+            if (std::strcmp(nombre, nombres[i]) == 0)
+            {
+                return i;
+            }
+        }
+        return -1;
+    }
+
+    /**
+     * @brief Escribe todo el buffer
+     */
+    bool enviarTodo(int fd, const unsigned char *datos, int largo)
+    {
+        while (largo > 0)
+        {
+            ssize_t n = write(fd, datos, largo);
+            if (n <= 0)
+            {
+                return false;
+            }
+            datos += n;
+            largo -= static_cast<int>(n);
+        }
+        return true;
+    }
+
+    /**
+     * @brief Imprime una respuesta completa
+     */
+    void imprimirRespuesta(const unsigned char *r)
+    {
+        const unsigned char *p = r;
+        std::uint32_t longitud = leerCampo<std::uint32_t>(p);
+        int operacion = leerCampo<std::uint8_t>(p);
+        int estado = leerCampo<std::uint8_t>(p);
+        std::uint32_t id = leerCampo<std::uint32_t>(p);
+        const unsigned char *fin = r + 4 + longitud;
+
+        std::cout << "#" << id << " ";
+        if (estado == CONSULTA_NO_ENCONTRADO)
+        {
+            std::cout << "no encontrado" << std::endl;
+            return;
+        }
+        if (estado != CONSULTA_OK)
+        {
+            std::cout << "peticion invalida" << std::endl;
+            return;
+        }
+
+        switch (operacion)
+        {
+        case CONSULTA_ESTADO:
+        {
+            std::uint64_t numero = leerCampo<std::uint64_t>(p);
+            std::int32_t sensores = leerCampo<std::int32_t>(p);
+            std::int64_t lecturas = leerCampo<std::int64_t>(p);
+            std::cout << "instantanea " << numero << ": " << sensores << " sensor(es), " << lecturas
+                      << " lectura(s)" << std::endl;
+            break;
+        }
+        case CONSULTA_SENSOR:
+        {
+            char tipo[TAM_TIPO_CONSULTA];
+            std::memcpy(tipo, p, TAM_TIPO_CONSULTA);
+            tipo[TAM_TIPO_CONSULTA - 1] = '\0';
+            p += TAM_TIPO_CONSULTA;
+            std::int32_t manejador = leerCampo<std::int32_t>(p);
+            std::int32_t lecturas = leerCampo<std::int32_t>(p);
+            double ultima = leerCampo<double>(p);
+            double promedio = leerCampo<double>(p);
+            double minimo = leerCampo<double>(p);
+            double maximo = leerCampo<double>(p);
+            std::cout << "[" << tipo << "] manejador " << manejador << ", " << lecturas << " lectura(s), ultima "
+                      << ultima << ", promedio " << promedio << ", rango " << minimo << " - " << maximo
+                      << std::endl;
+            break;
+        }
+        case CONSULTA_ESTADISTICAS:
+        {
+            std::int32_t cantidad = leerCampo<std::int32_t>(p);
+            double promedio = leerCampo<double>(p);
+            double minimo = leerCampo<double>(p);
+            double maximo = leerCampo<double>(p);
+            double p50 = leerCampo<double>(p);
+            double p90 = leerCampo<double>(p);
+            double p99 = leerCampo<double>(p);
+            std::cout << cantidad << " lectura(s): promedio " << promedio << ", min " << minimo << ", max "
+                      << maximo << ", p50 " << p50 << ", p90 " << p90 << ", p99 " << p99 << std::endl;
+            break;
+        }
+        case CONSULTA_RANGO:
+        {
+            std::int32_t desde = leerCampo<std::int32_t>(p);
+            std::int32_t cantidad = leerCampo<std::int32_t>(p);
+            std::cout << cantidad << " valor(es) desde la posicion " << desde << ":";
+            for (int i = 0; i < cantidad; i++)
+            {
+                std::cout << " " << leerCampo<double>(p);
+            }
+            std::cout << std::endl;
+            break;
+        }
+        case CONSULTA_TOPK:
+        {
+            std::int32_t n = leerCampo<std::int32_t>(p);
+            std::cout << n << " sensor(es):" << std::endl;
+            for (int i = 0; i < n && p < fin; i++)
+            {
+                double valor = leerCampo<double>(p);
+                int largo = leerCampo<std::uint8_t>(p);
+                std::cout << "    " << (i + 1) << ". " << std::string(reinterpret_cast<const char *>(p), largo)
+                          << ": " << valor << std::endl;
+                p += largo;
+            }
+            break;
+        }
+        default:
+            std::cout << "operacion desconocida" << std::endl;
+            break;
+        }
+    }
+
+    /**
+     * @brief Lee respuestas completas hasta juntar 'cantidad'
+     * @param fd Socket
+     * @param cantidad Respuestas esperadas
+     * @param imprimir Imprimir cada respuesta
+     * @return Respuestas recibidas
+     */
+    int recibir(int fd, int cantidad, bool imprimir)
+    {
+        static int usados = 0;
+        int recibidas = 0;
+        while (recibidas < cantidad)
+        {
+            // Entregar las respuestas completas que ya están en el buffer
+            int pos = 0;
+            while (recibidas < cantidad && usados - pos >= 4)
+            {
+                const unsigned char *p = respuestas + pos;
+                std::uint32_t longitud = leerCampo<std::uint32_t>(p);
+                if (usados - pos < 4 + static_cast<int>(longitud))
+                {
+                    break;
+                }
+                if (imprimir)
+                {
+                    imprimirRespuesta(respuestas + pos);
+                }
+                pos += 4 + static_cast<int>(longitud);
+                recibidas++;
+            }
+            std::memmove(respuestas, respuestas + pos, usados - pos);
+            usados -= pos;
+
+            if (recibidas == cantidad)
+            {
+                break;
+            }
+            ssize_t n = read(fd, respuestas + usados, TAM_BUFFER - usados);
+            if (n <= 0)
+            {
+                break;
+            }
+            usados += static_cast<int>(n);
+        }
+        return recibidas;
+    }
+
+    /**
+     * @brief Mide búsquedas por segundo enviando 'ventana' peticiones antes de esperar
+     */
+    double medir(int fd, const char *nombre, int total, int ventana)
+    {
+        int largo = static_cast<int>(std::strlen(nombre));
+        auto inicio = std::chrono::steady_clock::now();
+        int hechas = 0;
+        while (hechas < total)
+        {
+            int lote = (total - hechas < ventana) ? total - hechas : ventana;
+            int bytes = 0;
+            for (int i = 0; i < lote; i++)
+            {
+                bytes += armarPeticion(peticiones + bytes, CONSULTA_SENSOR, static_cast<std::uint32_t>(hechas + i),
+                                       reinterpret_cast<const unsigned char *>(nombre), largo);
+            }
+            if (!enviarTodo(fd, peticiones, bytes) || recibir(fd, lote, false) != lote)
+            {
+                return 0.0;
+            }
+            hechas += lote;
+        }
+        double segundos = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+        return total / segundos;
+    }
+
+    /**
+     * @brief Envía las peticiones acumuladas con una sola escritura e imprime las respuestas
+     * @return true si llegaron todas las respuestas
+     */
+    bool despachar(int fd, int &bytes, int &cantidad)
+    {
+        bool completo = (cantidad == 0) ||
+                        (enviarTodo(fd, peticiones, bytes) && recibir(fd, cantidad, true) == cantidad);
+        bytes = 0;
+        cantidad = 0;
+        return completo;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc < 3)
+    {
+        std::cerr << "Uso: " << argv[0] << " ruta_socket consulta [consulta ...]" << std::endl;
+        return 1;
+    }
+
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    struct sockaddr_un direccion;
+    std::memset(&direccion, 0, sizeof(direccion));
+    direccion.sun_family = AF_UNIX;
+    std::strncpy(direccion.sun_path, argv[1], sizeof(direccion.sun_path) - 1);
+    if (fd < 0 || connect(fd, reinterpret_cast<struct sockaddr *>(&direccion), sizeof(direccion)) < 0)
+    {
+        std::cerr << "No se pudo conectar a " << argv[1] << " (active el servidor con la opcion 21)." << std::endl;
+        return 1;
+    }
+
+    int bytes = 0;
+    int cantidad = 0;
+    bool completo = true;
+    unsigned char carga[MAX_PETICION];
+    for (int i = 2; i < argc; i++)
+    {
+        const char *consulta = argv[i];
+        int largo = -1;
+        int operacion = -1;
+
+        if (std::strcmp(consulta, "estado") == 0)
+        {
+            operacion = CONSULTA_ESTADO;
+            largo = 0;
+        }
+        else if (std::strcmp(consulta, "sensor") == 0 && i + 1 < argc)
+        {
+            operacion = CONSULTA_SENSOR;
+            largo = static_cast<int>(std::strlen(argv[i + 1]));
+            std::memcpy(carga, argv[i + 1], largo);
+            i += 1;
+        }
+        else if ((std::strcmp(consulta, "stats") == 0 || std::strcmp(consulta, "rango") == 0) && i + 3 < argc)
+        {
+            operacion = (consulta[0] == 's') ? CONSULTA_ESTADISTICAS : CONSULTA_RANGO;
+            largo = cargaRango(carga, std::atoi(argv[i + 2]), std::atoi(argv[i + 3]), argv[i + 1]);
+            i += 3;
+        }
+        else if (std::strcmp(consulta, "topk") == 0 && i + 4 < argc)
+        {
+            operacion = CONSULTA_TOPK;
+            int campo = campoPorNombre(argv[i + 3]);
+            if (campo < 0)
+            {
+                std::cerr << "Campo desconocido: " << argv[i + 3] << std::endl;
+                return 1;
+            }
+            unsigned char *q = carga;
+            escribirCampo<std::uint8_t>(q, static_cast<std::uint8_t>(campo));
+            escribirCampo<std::uint8_t>(q, std::strcmp(argv[i + 4], "menores") != 0);
+            escribirCampo<std::uint16_t>(q, static_cast<std::uint16_t>(std::atoi(argv[i + 2])));
+            const char *prefijo = (std::strcmp(argv[i + 1], "*") == 0) ? "" : argv[i + 1];
+            int largoPrefijo = static_cast<int>(std::strlen(prefijo));
+            std::memcpy(q, prefijo, largoPrefijo);
+            largo = 4 + largoPrefijo;
+            i += 4;
+        }
+        else if (std::strcmp(consulta, "bench") == 0 && i + 2 < argc)
+        {
+            completo = despachar(fd, bytes, cantidad) && completo; // Lo anterior no se mezcla con la medición
+            int total = std::atoi(argv[i + 2]);
+            double sinPipelining = medir(fd, argv[i + 1], total, 1);
+            double conPipelining = medir(fd, argv[i + 1], total, 256);
+            std::cout << "bench " << argv[i + 1] << ": " << static_cast<long>(sinPipelining)
+                      << " busquedas/s de a una, " << static_cast<long>(conPipelining)
+                      << " busquedas/s en ventanas de 256" << std::endl;
+            i += 2;
+            continue;
+        }
+
+        if (operacion < 0 || largo > MAX_PETICION - TAM_CABECERA_PETICION)
+        {
+            std::cerr << "Consulta no valida: " << consulta << std::endl;
+            return 1;
+        }
+        if (bytes + MAX_PETICION > TAM_BUFFER)
+        {
+            completo = despachar(fd, bytes, cantidad) && completo;
+        }
+        bytes += armarPeticion(peticiones + bytes, operacion, static_cast<std::uint32_t>(cantidad), carga, largo);
+        cantidad++;
+    }
+
+    completo = despachar(fd, bytes, cantidad) && completo;
+    close(fd);
+    return completo ? 0 : 1;
+}
@@ -0,0 +1,105 @@
+/**
+ * @file ConsumidorAnillo.cpp
+ * @brief Consumidor de ejemplo del anillo de memoria compartida
+ * @author FabiRamiro
+ * @date 2026-10-18
+ *
+ * Uso: ConsumidorAnillo [nombre] [todo] [agregados]
+ *
+ *  - nombre: segmento publicado por el sistema (por defecto "sensores",
+ *    es decir /dev/shm/sensores; se activa con la opción 20 del menú).
+ *  - todo: empezar por el registro más viejo que se conserva en lugar de
+ *    solo los nuevos.
+ *  - agregados: mostrar solo los resúmenes periódicos, no cada lectura.
+ *
+ * Imprime cada registro a medida que llega y, al terminar, cuántos leyó
+ * y cuántos se perdió por quedar atrás. Termina cuando el sistema cierra
+ * el anillo y no queda nada por leer (o con Ctrl+C). Cuando no hay datos
+ * duerme un milisegundo: la espera es decisión del consumidor, el
+ * anillo en sí no hace llamadas al sistema.
+ */
+
+#include <iostream>
+#include <cstring>
+#include <csignal>
+#include <chrono>
+#include <thread>
+#include "LectorAnillo.h"
+
+namespace
+{
+    volatile std::sig_atomic_t interrumpido = 0;
+
+    void alInterrumpir(int)
+    {
+        interrumpido = 1;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    const char *nombre = (argc > 1) ? argv[1] : "sensores";
+    bool desdeElPrincipio = false;
+    bool soloAgregados = false;
+    for (int i = 2; i < argc; i++)
+    {
+        desdeElPrincipio = desdeElPrincipio || std::strcmp(argv[i], "todo") == 0;
+        soloAgregados = soloAgregados || std::strcmp(argv[i], "agregados") == 0;
+    }
+
+    LectorAnillo lector;
+    if (!lector.abrir(nombre, desdeElPrincipio))
+    {
+        std::cerr << "No se encontro el anillo '" << nombre
+                  << "' (active la publicacion con la opcion 20 del sistema)." << std::endl;
+        return 1;
+    }
+
+    std::signal(SIGINT, alInterrumpir);
+    std::cout << "Conectado a '" << nombre << "': " << lector.getCapacidad() << " ranuras, desde la secuencia "
+              << lector.getPosicion() << "." << std::endl;
+
+    unsigned long long lecturas = 0;
+    unsigned long long agregados = 0;
+    RegistroAnillo registro;
+    while (!interrumpido)
+    {
+        ResultadoLectorAnillo resultado = lector.siguiente(registro);
+        if (resultado == LECTOR_ANILLO_VACIO)
+        {
+            if (!lector.escritorActivo())
+            {
+                break;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            continue;
+        }
+        if (resultado == LECTOR_ANILLO_PERDIDOS)
+        {
+            std::cout << "[perdidos] el sistema sobrescribio registros; se continua en la secuencia "
+                      << lector.getPosicion() << " (" << lector.getPerdidos() << " en total)" << std::endl;
+            continue;
+        }
+
+        if (registro.tipo == REGISTRO_ANILLO_AGREGADO)
+        {
+            agregados++;
+            std::cout << "#" << registro.secuencia << " [agregado] " << registro.nombre << " ("
+                      << registro.tipoSensor << "): " << registro.numLecturas << " lectura(s), promedio "
+                      << registro.valor << ", rango " << registro.minimo << " - " << registro.maximo << std::endl;
+        }
+        else
+        {
+            lecturas++;
+            if (!soloAgregados)
+            {
+                std::cout << "#" << registro.secuencia << " [lectura] " << registro.nombre << " ("
+                          << registro.tipoSensor << ") = " << registro.valor << std::endl;
+            }
+        }
+    }
+
+    std::cout << "\n" << lecturas << " lectura(s) y " << agregados << " agregado(s) leidos, "
+              << lector.getPerdidos() << " perdido(s)." << std::endl;
+    return 0;
+}
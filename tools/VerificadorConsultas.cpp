@@ -0,0 +1,463 @@
+/**
+ * @file VerificadorConsultas.cpp
+ * @brief Verificación del ServidorConsultas con peticiones encadenadas sobre un socket temporal
+ * @author FabiRamiro
+ * @date 2026-10-18
+ *
+ * Uso: VerificadorConsultas
+ *
+ * Arma una flota pequeña con historiales conocidos, publica una
+ * instantánea y levanta el servidor en un socket de /tmp. Un mismo
+ * cliente envía todas las peticiones con una sola escritura (pipelining)
+ * y después otra vez byte a byte, y se comprueba cada respuesta: orden e
+ * id, estado, longitud declarada, y la carga de estado, sensor,
+ * estadísticas (promedio, extremos y cuantiles), rango y top-k. Una
+ * segunda conexión envía una petición más larga que MAX_PETICION y el
+ * servidor debe cerrarla. Imprime cada caso fallido y termina con 1 si
+ * hubo alguno.
+ */
+
+#include <iostream>
+#include <cstdio>
+#include <cstring>
+#include <cstdint>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "ProtocoloConsultas.h"
+#include "ServidorConsultas.h"
+#include "Instantaneas.h"
+#include "ListaGeneral.h"
+#include "SensorTemperatura.h"
+#include "SensorPresion.h"
+
+namespace
+{
+    const int TAM_BUFFER = 1 << 16;
+    const int NUM_PETICIONES = 12;
+
+    int fallos = 0;
+
+    unsigned char peticiones[TAM_BUFFER];
+    unsigned char respuestas[TAM_BUFFER];
+
+    void verificar(bool condicion, const char *caso, const char *detalle)
+    {
+        if (!condicion)
+        {
+            std::printf("FALLO [%s] %s\n", caso, detalle);
+            fallos++;
+        }
+    }
+
+    /**
+     * @brief Agrega una petición al buffer
+     * @return Bytes que ocupa la petición
+     */
+    int armarPeticion(unsigned char *destino, int operacion, std::uint32_t id, const unsigned char *carga,
+                      int largo)
+    {
+        unsigned char *q = destino;
+        escribirCampo<std::uint32_t>(q, static_cast<std::uint32_t>(TAM_CABECERA_PETICION - 4 + largo));
+        escribirCampo<std::uint8_t>(q, static_cast<std::uint8_t>(operacion));
+        escribirCampo<std::uint32_t>(q, id);
+        std::memcpy(q, carga, largo);
+        return TAM_CABECERA_PETICION + largo;
+    }
+
+    /**
+     * @brief Carga de stats/rango: desde, hasta y nombre
+     */
+    int cargaRango(unsigned char *carga, int desde, int hasta, const char *nombre)
+    {
+        unsigned char *q = carga;
+        escribirCampo<std::int32_t>(q, desde);
+        escribirCampo<std::int32_t>(q, hasta);
+        int largo = static_cast<int>(std::strlen(nombre));
+        std::memcpy(q, nombre, largo);
+        return 8 + largo;
+    }
+
+    /**
+     * @brief Carga de top-k: campo, sentido, k y prefijo
+     */
+    int cargaTopK(unsigned char *carga, int campo, bool mayores, int k, const char *prefijo)
+    {
+        unsigned char *q = carga;
+        escribirCampo<std::uint8_t>(q, static_cast<std::uint8_t>(campo));
+        escribirCampo<std::uint8_t>(q, mayores ? 1 : 0);
+        escribirCampo<std::uint16_t>(q, static_cast<std::uint16_t>(k));
+        int largo = static_cast<int>(std::strlen(prefijo));
+        std::memcpy(q, prefijo, largo);
+        return 4 + largo;
+    }
+
+    /**
+     * @brief Arma el lote completo de peticiones (ids 0..NUM_PETICIONES-1)
+     * @return Bytes del lote
+     */
+    int armarLote(unsigned char *destino)
+    {
+        unsigned char carga[MAX_PETICION];
+        int bytes = 0;
+        int largo;
+
+        bytes += armarPeticion(destino + bytes, CONSULTA_ESTADO, 0, carga, 0);
+        bytes += armarPeticion(destino + bytes, CONSULTA_SENSOR, 1, reinterpret_cast<const unsigned char *>("T-001"), 5);
+        bytes += armarPeticion(destino + bytes, CONSULTA_SENSOR, 2, reinterpret_cast<const unsigned char *>("T-999"), 5);
+        largo = cargaRango(carga, 0, 0, "T-001");
+        bytes += armarPeticion(destino + bytes, CONSULTA_ESTADISTICAS, 3, carga, largo);
+        largo = cargaRango(carga, -10, 0, "T-001");
+        bytes += armarPeticion(destino + bytes, CONSULTA_ESTADISTICAS, 4, carga, largo);
+        largo = cargaRango(carga, -5, 0, "P-001");
+        bytes += armarPeticion(destino + bytes, CONSULTA_RANGO, 5, carga, largo);
+        largo = cargaTopK(carga, TOPK_PROMEDIO, true, 2, "T-");
+        bytes += armarPeticion(destino + bytes, CONSULTA_TOPK, 6, carga, largo);
+        largo = cargaTopK(carga, TOPK_LECTURAS, false, 3, "");
+        bytes += armarPeticion(destino + bytes, CONSULTA_TOPK, 7, carga, largo);
+        largo = cargaTopK(carga, TOPK_MAXIMO, true, 5, "X-");
+        bytes += armarPeticion(destino + bytes, CONSULTA_TOPK, 8, carga, largo);
+        bytes += armarPeticion(destino + bytes, CONSULTA_ESTADISTICAS, 9, carga, 3); // Carga corta
+        bytes += armarPeticion(destino + bytes, 99, 10, carga, 0);                   // Operación desconocida
+        largo = cargaRango(carga, 0, 0, "T-002");
+        bytes += armarPeticion(destino + bytes, CONSULTA_ESTADISTICAS, 11, carga, largo);
+        return bytes;
+    }
+
+    /**
+     * @brief Escribe todo el buffer, de a 'paso' bytes por escritura
+     */
+    bool enviarTodo(int fd, const unsigned char *datos, int largo, int paso)
+    {
+        while (largo > 0)
+        {
+            ssize_t n = write(fd, datos, (largo < paso) ? largo : paso);
+            if (n <= 0)
+            {
+                return false;
+            }
+            datos += n;
+            largo -= static_cast<int>(n);
+        }
+        return true;
+    }
+
+    /**
+     * @brief Lee hasta juntar 'cantidad' respuestas completas
+     * @return Bytes leídos (las respuestas quedan seguidas en 'respuestas')
+     */
+    int recibir(int fd, int cantidad)
+    {
+        int usados = 0;
+        int completas = 0;
+        int pos = 0;
+        while (completas < cantidad)
+        {
+            while (completas < cantidad && usados - pos >= 4)
+            {
+                const unsigned char *p = respuestas + pos;
+                std::uint32_t longitud = leerCampo<std::uint32_t>(p);
+                if (usados - pos < 4 + static_cast<int>(longitud))
+                {
+                    break;
+                }
+                pos += 4 + static_cast<int>(longitud);
+                completas++;
+            }
+            if (completas == cantidad)
+            {
+                break;
+            }
+            ssize_t n = read(fd, respuestas + usados, TAM_BUFFER - usados);
+            if (n <= 0)
+            {
+                break;
+            }
+            usados += static_cast<int>(n);
+        }
+        return (completas == cantidad) ? pos : -1;
+    }
+
+    /**
+     * @brief Conecta al socket con un plazo de lectura para no colgarse
+     * @return Descriptor, -1 si falla
+     */
+    int conectar(const char *ruta)
+    {
+        int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        struct sockaddr_un direccion;
+        std::memset(&direccion, 0, sizeof(direccion));
+        direccion.sun_family = AF_UNIX;
+        std::strncpy(direccion.sun_path, ruta, sizeof(direccion.sun_path) - 1);
+        if (fd < 0 || connect(fd, reinterpret_cast<struct sockaddr *>(&direccion), sizeof(direccion)) < 0)
+        {
+            if (fd >= 0)
+            {
+                close(fd);
+            }
+            return -1;
+        }
+
+        struct timeval plazo;
+        plazo.tv_sec = 5;
+        plazo.tv_usec = 0;
+        setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &plazo, sizeof(plazo));
+        return fd;
+    }
+
+    /**
+     * @brief Lee la cabecera de una respuesta y comprueba operación, estado e id
+     * @return Fin de la respuesta (según su longitud)
+     */
+    const unsigned char *cabecera(const unsigned char *&p, int operacion, int estado, std::uint32_t id,
+                                  const char *caso)
+    {
+        const unsigned char *inicio = p;
+        std::uint32_t longitud = leerCampo<std::uint32_t>(p);
+        int op = leerCampo<std::uint8_t>(p);
+        int est = leerCampo<std::uint8_t>(p);
+        std::uint32_t idRespuesta = leerCampo<std::uint32_t>(p);
+        verificar(op == operacion, caso, "operacion de la respuesta distinta de la pedida");
+        verificar(est == estado, caso, "estado inesperado");
+        verificar(idRespuesta == id, caso, "respuesta fuera de orden (id distinto)");
+        return inicio + 4 + longitud;
+    }
+
+    /**
+     * @brief Comprueba un resultado de estadísticas
+     */
+    void verificarEstadisticas(const unsigned char *&p, int cantidad, double promedio, double minimo, double maximo,
+                               double p50, double p90, double p99, const char *caso)
+    {
+        verificar(leerCampo<std::int32_t>(p) == cantidad, caso, "cantidad distinta");
+        verificar(leerCampo<double>(p) == promedio, caso, "promedio distinto");
+        verificar(leerCampo<double>(p) == minimo, caso, "minimo distinto");
+        verificar(leerCampo<double>(p) == maximo, caso, "maximo distinto");
+        verificar(leerCampo<double>(p) == p50, caso, "p50 distinto");
+        verificar(leerCampo<double>(p) == p90, caso, "p90 distinto");
+        verificar(leerCampo<double>(p) == p99, caso, "p99 distinto");
+    }
+
+    /**
+     * @brief Comprueba una posición de un top-k
+     */
+    void verificarPuesto(const unsigned char *&p, double valor, const char *nombre, const char *caso)
+    {
+        verificar(leerCampo<double>(p) == valor, caso, "valor del puesto distinto");
+        int largo = leerCampo<std::uint8_t>(p);
+        verificar(largo == static_cast<int>(std::strlen(nombre)) && std::memcmp(p, nombre, largo) == 0, caso,
+                  "nombre del puesto distinto");
+        p += largo;
+    }
+
+    /**
+     * @brief Comprueba las NUM_PETICIONES respuestas del lote
+     * @param r Respuestas seguidas
+     * @param bytes Bytes recibidos
+     * @param ultimaT001 Última lectura de T-001
+     */
+    void verificarLote(const unsigned char *r, int bytes, double ultimaT001)
+    {
+        const unsigned char *p = r;
+        const unsigned char *fin;
+
+        fin = cabecera(p, CONSULTA_ESTADO, CONSULTA_OK, 0, "estado");
+        verificar(leerCampo<std::uint64_t>(p) > 0, "estado", "numero de instantanea en cero");
+        verificar(leerCampo<std::int32_t>(p) == 4, "estado", "sensores distinto de 4");
+        verificar(leerCampo<std::int64_t>(p) == 100 + 10 + 11 + 21, "estado", "lecturas totales distintas");
+        verificar(p == fin, "estado", "longitud declarada distinta de la carga");
+
+        p = fin;
+        fin = cabecera(p, CONSULTA_SENSOR, CONSULTA_OK, 1, "sensor");
+        char tipo[TAM_TIPO_CONSULTA];
+        std::memcpy(tipo, p, TAM_TIPO_CONSULTA);
+        p += TAM_TIPO_CONSULTA;
+        verificar(tipo[TAM_TIPO_CONSULTA - 1] == '\0' && std::strcmp(tipo, "TEMP") == 0, "sensor",
+                  "tipo distinto");
+        verificar(leerCampo<std::int32_t>(p) == 0, "sensor", "manejador distinto de 0");
+        verificar(leerCampo<std::int32_t>(p) == 100, "sensor", "lecturas distintas de 100");
+        verificar(leerCampo<double>(p) == ultimaT001, "sensor", "ultima lectura distinta");
+        verificar(leerCampo<double>(p) == 50.5, "sensor", "promedio distinto de 50.5");
+        verificar(leerCampo<double>(p) == 1.0, "sensor", "minimo distinto de 1");
+        verificar(leerCampo<double>(p) == 100.0, "sensor", "maximo distinto de 100");
+        verificar(p == fin, "sensor", "longitud declarada distinta de la carga");
+
+        p = fin;
+        fin = cabecera(p, CONSULTA_SENSOR, CONSULTA_NO_ENCONTRADO, 2, "sensor inexistente");
+        verificar(p == fin, "sensor inexistente", "respuesta de error con carga");
+
+        // 1..100 desordenados: posiciones de los cuantiles 50, 89 y 98 del orden
+        p = fin;
+        fin = cabecera(p, CONSULTA_ESTADISTICAS, CONSULTA_OK, 3, "stats");
+        verificarEstadisticas(p, 100, 50.5, 1.0, 100.0, 51.0, 90.0, 99.0, "stats");
+        verificar(p == fin, "stats", "longitud declarada distinta de la carga");
+
+        // Las diez últimas en orden de llegada (ver main): 91..100
+        p = fin;
+        fin = cabecera(p, CONSULTA_ESTADISTICAS, CONSULTA_OK, 4, "stats ultimas");
+        verificarEstadisticas(p, 10, 95.5, 91.0, 100.0, 96.0, 99.0, 100.0, "stats ultimas");
+        verificar(p == fin, "stats ultimas", "longitud declarada distinta de la carga");
+
+        p = fin;
+        fin = cabecera(p, CONSULTA_RANGO, CONSULTA_OK, 5, "rango");
+        verificar(leerCampo<std::int32_t>(p) == 16, "rango", "desde distinto de 16");
+        verificar(leerCampo<std::int32_t>(p) == 5, "rango", "cantidad distinta de 5");
+        for (int i = 0; i < 5; i++)
+        {
+            verificar(leerCampo<double>(p) == 106.0 + i, "rango", "valor del rango distinto");
+        }
+        verificar(p == fin, "rango", "longitud declarada distinta de la carga");
+
+        p = fin;
+        fin = cabecera(p, CONSULTA_TOPK, CONSULTA_OK, 6, "topk promedio");
+        verificar(leerCampo<std::int32_t>(p) == 2, "topk promedio", "puestos distintos de 2");
+        verificarPuesto(p, 65.0, "T-003", "topk promedio");
+        verificarPuesto(p, 50.5, "T-001", "topk promedio");
+        verificar(p == fin, "topk promedio", "longitud declarada distinta de la carga");
+
+        p = fin;
+        fin = cabecera(p, CONSULTA_TOPK, CONSULTA_OK, 7, "topk lecturas");
+        verificar(leerCampo<std::int32_t>(p) == 3, "topk lecturas", "puestos distintos de 3");
+        verificarPuesto(p, 10.0, "T-002", "topk lecturas");
+        verificarPuesto(p, 11.0, "T-003", "topk lecturas");
+        verificarPuesto(p, 21.0, "P-001", "topk lecturas");
+        verificar(p == fin, "topk lecturas", "longitud declarada distinta de la carga");
+
+        p = fin;
+        fin = cabecera(p, CONSULTA_TOPK, CONSULTA_OK, 8, "topk sin coincidencias");
+        verificar(leerCampo<std::int32_t>(p) == 0, "topk sin coincidencias", "puestos con un prefijo inexistente");
+        verificar(p == fin, "topk sin coincidencias", "longitud declarada distinta de la carga");
+
+        p = fin;
+        fin = cabecera(p, CONSULTA_ESTADISTICAS, CONSULTA_INVALIDA, 9, "carga corta");
+        verificar(p == fin, "carga corta", "respuesta de error con carga");
+
+        p = fin;
+        fin = cabecera(p, 99, CONSULTA_INVALIDA, 10, "operacion desconocida");
+        verificar(p == fin, "operacion desconocida", "respuesta de error con carga");
+
+        // 2, 4, ..., 20: cantidad par, el p50 redondea hacia arriba
+        p = fin;
+        fin = cabecera(p, CONSULTA_ESTADISTICAS, CONSULTA_OK, 11, "stats T-002");
+        verificarEstadisticas(p, 10, 11.0, 2.0, 20.0, 12.0, 18.0, 20.0, "stats T-002");
+        verificar(fin == r + bytes, "lote", "bytes de mas despues de la ultima respuesta");
+    }
+}
+
+/**
+ * @brief Punto de entrada del verificador
+ * @return 0 si todas las verificaciones pasan, 1 en caso contrario
+ */
+int main()
+{
+    // Codificación sin alineación: ida y vuelta desde posiciones impares
+    {
+        unsigned char buffer[64];
+        unsigned char *q = buffer + 1;
+        escribirCampo<std::uint32_t>(q, 0xA1B2C3D4u);
+        escribirCampo<std::uint8_t>(q, 0x7F);
+        escribirCampo<std::int32_t>(q, -123456);
+        escribirCampo<double>(q, -2.75);
+        escribirCampo<std::uint16_t>(q, 65535);
+        escribirCampo<std::int64_t>(q, -9000000000LL);
+        const unsigned char *p = buffer + 1;
+        bool igual = leerCampo<std::uint32_t>(p) == 0xA1B2C3D4u && leerCampo<std::uint8_t>(p) == 0x7F &&
+                     leerCampo<std::int32_t>(p) == -123456 && leerCampo<double>(p) == -2.75 &&
+                     leerCampo<std::uint16_t>(p) == 65535 && leerCampo<std::int64_t>(p) == -9000000000LL;
+        verificar(igual && p == q && q - buffer == 1 + 4 + 1 + 4 + 8 + 2 + 8, "codificacion",
+                  "escribirCampo/leerCampo no hacen ida y vuelta");
+    }
+
+    // Flota con historiales conocidos; el registro y los sensores informan cada paso
+    std::streambuf *consola = std::cout.rdbuf(nullptr);
+    PublicadorInstantaneas publicador;
+    ListaGeneral *lista = new ListaGeneral();
+    lista->agregarObservador(&publicador);
+
+    SensorBase *t1 = lista->crearSensor<SensorTemperatura>("T-001");
+    SensorBase *t2 = lista->crearSensor<SensorTemperatura>("T-002");
+    SensorBase *t3 = lista->crearSensor<SensorTemperatura>("T-003");
+    SensorBase *p1 = lista->crearSensor<SensorPresion>("P-001");
+
+    // T-001: 1..90 desordenados (37 es coprimo con 90) y después 91..100 en orden
+    for (int i = 0; i < 90; i++)
+    {
+        t1->registrarValor((i * 37) % 90 + 1);
+    }
+    for (int v = 91; v <= 100; v++)
+    {
+        t1->registrarValor(v);
+    }
+    for (int v = 2; v <= 20; v += 2)
+    {
+        t2->registrarValor(v);
+    }
+    for (int v = 60; v <= 70; v++)
+    {
+        t3->registrarValor(v);
+    }
+    for (int v = 90; v <= 110; v++)
+    {
+        p1->registrarValor(v);
+    }
+    publicador.publicar();
+    std::cout.rdbuf(consola);
+
+    char ruta[ServidorConsultas::TAM_RUTA];
+    std::snprintf(ruta, sizeof(ruta), "/tmp/VerificadorConsultas-%ld.sock", static_cast<long>(getpid()));
+    ServidorConsultas servidor(publicador);
+    if (!servidor.iniciar(ruta))
+    {
+        std::cout << "ERROR: no se pudo iniciar el servidor en " << ruta << std::endl;
+        delete lista;
+        return 1;
+    }
+
+    int bytesLote = armarLote(peticiones);
+    int fd = conectar(ruta);
+    verificar(fd >= 0, "conexion", "no se pudo conectar al servidor");
+    if (fd >= 0)
+    {
+        // Todo el lote en una escritura, y otra vez byte a byte (peticiones partidas)
+        const int pasos[] = {TAM_BUFFER, 1};
+        for (int i = 0; i < 2; i++)
+        {
+            int recibidos = -1;
+            if (enviarTodo(fd, peticiones, bytesLote, pasos[i]))
+            {
+                recibidos = recibir(fd, NUM_PETICIONES);
+            }
+            verificar(recibidos > 0, i == 0 ? "pipelining" : "byte a byte", "no llegaron todas las respuestas");
+            if (recibidos > 0)
+            {
+                verificarLote(respuestas, recibidos, 100.0);
+            }
+        }
+        close(fd);
+    }
+
+    // Una petición que declara más de MAX_PETICION bytes cierra la conexión
+    fd = conectar(ruta);
+    if (fd >= 0)
+    {
+        unsigned char grande[TAM_CABECERA_PETICION];
+        std::memset(grande, 0, sizeof(grande));
+        unsigned char *q = grande;
+        escribirCampo<std::uint32_t>(q, static_cast<std::uint32_t>(MAX_PETICION + 1));
+        char byte;
+        bool cerrada = enviarTodo(fd, grande, TAM_CABECERA_PETICION, TAM_CABECERA_PETICION) &&
+                       read(fd, &byte, 1) == 0;
+        verificar(cerrada, "peticion larga", "el servidor no cerro la conexion");
+        close(fd);
+    }
+
+    servidor.detener();
+    std::cout.rdbuf(nullptr);
+    delete lista;
+    std::cout.rdbuf(consola);
+
+    std::cout << (fallos == 0 ? "Verificacion correcta." : "ERROR: respuestas del servidor incorrectas.")
+              << std::endl;
+    return (fallos == 0) ? 0 : 1;
+}
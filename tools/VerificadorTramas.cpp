@@ -0,0 +1,292 @@
+/**
+ * @file VerificadorTramas.cpp
+ * @brief Verificación del DecodificadorTramas con flujos de bytes construidos a mano
+ * @author FabiRamiro
+ * @date 2026-10-18
+ *
+ * Uso: VerificadorTramas
+ *
+ * Sustituto local del ESP32: arma tramas con codificarTrama() y se las da
+ * al decodificador partidas, pegadas, corruptas o mezcladas con bytes
+ * sueltos, y compara las lecturas entregadas y los contadores de
+ * resincronización con lo esperado. Los valores se eligen para que ningún
+ * byte interno de las tramas sea 0xA5, así los contadores son exactos.
+ * Imprime cada caso fallido y termina con 1 si hubo alguno.
+ */
+
+#include <iostream>
+#include <cstdio>
+#include <cstring>
+#include "ProtocoloBinario.h"
+
+namespace
+{
+    int fallos = 0;
+
+    void verificar(bool condicion, const char *caso, const char *detalle)
+    {
+        if (!condicion)
+        {
+            std::printf("FALLO [%s] %s\n", caso, detalle);
+            fallos++;
+        }
+    }
+
+    /**
+     * @brief Lectura de prueba
+     */
+    LecturaBinaria lectura(unsigned char tipo, unsigned short id, int valorCrudo)
+    {
+        LecturaBinaria l;
+        l.tipo = tipo;
+        l.id = id;
+        l.valorCrudo = valorCrudo;
+        l.secuencia = 0;
+        return l;
+    }
+
+    /**
+     * @brief Codifica una trama y comprueba que solo su primer byte sea SYNC
+     */
+    int armarTrama(const LecturaBinaria *lecturas, int cantidad, unsigned short secuencia, unsigned char *destino)
+    {
+        int n = codificarTrama(lecturas, cantidad, secuencia, destino);
+        for (int i = 1; i < n; i++)
+        {
+            if (destino[i] == SYNC_TRAMA)
+            {
+                std::printf("Trama de prueba con SYNC interno (secuencia %u, byte %d): cambiar los valores\n",
+                            static_cast<unsigned int>(secuencia), i);
+                fallos++;
+            }
+        }
+        return n;
+    }
+
+    /**
+     * @brief Extrae todas las lecturas disponibles
+     * @return Lecturas extraídas
+     */
+    int extraer(DecodificadorTramas &decodificador, LecturaBinaria *destino, int maximo)
+    {
+        int n = 0;
+        LecturaBinaria l;
+        while (n < maximo && decodificador.siguienteLectura(l))
+        {
+            destino[n++] = l;
+        }
+        return n;
+    }
+
+    bool iguales(const LecturaBinaria &a, const LecturaBinaria &b, unsigned short secuencia)
+    {
+        return a.tipo == b.tipo && a.id == b.id && a.valorCrudo == b.valorCrudo && a.secuencia == secuencia;
+    }
+}
+
+/**
+ * @brief Punto de entrada del verificador
+ * @return 0 si todos los casos pasan, 1 en caso contrario
+ */
+int main()
+{
+    const LecturaBinaria loteA[] = {lectura(TRAMA_TEMP, 1, 235), lectura(TRAMA_PRES, 2, 101),
+                                    lectura(TRAMA_TEMP, 3, -123)};
+    const LecturaBinaria loteB[] = {lectura(TRAMA_VIB, 7, -2048), lectura(TRAMA_VIB, 7, 2047)};
+    const LecturaBinaria loteC[] = {lectura(TRAMA_PRES, 300, 88)};
+
+    unsigned char tramaA[TAM_MAX_TRAMA], tramaB[TAM_MAX_TRAMA], tramaC[TAM_MAX_TRAMA];
+    int largoA = armarTrama(loteA, 3, 10, tramaA);
+    int largoB = armarTrama(loteB, 2, 11, tramaB);
+    int largoC = armarTrama(loteC, 1, 12, tramaC);
+    LecturaBinaria salida[4 * MAX_LECTURAS_TRAMA];
+
+    // Conversión de unidades e IDs textuales
+    {
+        char id[16];
+        loteA[2].formatearId(id, sizeof(id));
+        verificar(loteA[2].valor() == -12.3 && loteA[1].valor() == 101.0, "unidades", "valor() no convierte bien");
+        verificar(std::strcmp(id, "T-003") == 0, "unidades", "formatearId distinto de T-003");
+
+        unsigned char descarte[TAM_MAX_TRAMA];
+        verificar(codificarTrama(loteA, 0, 0, descarte) == 0 &&
+                      codificarTrama(loteA, MAX_LECTURAS_TRAMA + 1, 0, descarte) == 0,
+                  "codificar", "acepta cantidades fuera de rango");
+    }
+
+    // Trama partida en cada posición posible
+    for (int corte = 1; corte < largoA; corte++)
+    {
+        DecodificadorTramas d;
+        LecturaBinaria l;
+        d.alimentar(tramaA, corte);
+        verificar(!d.siguienteLectura(l), "partida", "entrega lecturas de una trama incompleta");
+        d.alimentar(tramaA + corte, largoA - corte);
+        int n = extraer(d, salida, 4 * MAX_LECTURAS_TRAMA);
+        bool correcta = n == 3;
+        for (int i = 0; correcta && i < 3; i++)
+        {
+            correcta = iguales(salida[i], loteA[i], 10);
+        }
+        verificar(correcta && d.getTramasValidas() == 1 && d.getBytesDescartados() == 0, "partida",
+                  "lecturas o contadores distintos tras completar la trama");
+    }
+
+    // Trama entregada de a un byte
+    {
+        DecodificadorTramas d;
+        int n = 0;
+        for (int i = 0; i < largoB; i++)
+        {
+            d.alimentar(tramaB + i, 1);
+            n += extraer(d, salida + n, 4 * MAX_LECTURAS_TRAMA - n);
+        }
+        verificar(n == 2 && iguales(salida[0], loteB[0], 11) && iguales(salida[1], loteB[1], 11), "byte a byte",
+                  "lecturas distintas");
+    }
+
+    // Tramas pegadas en un solo trozo
+    {
+        unsigned char flujo[3 * TAM_MAX_TRAMA];
+        int largo = 0;
+        std::memcpy(flujo + largo, tramaA, largoA);
+        largo += largoA;
+        std::memcpy(flujo + largo, tramaB, largoB);
+        largo += largoB;
+        std::memcpy(flujo + largo, tramaC, largoC);
+        largo += largoC;
+
+        DecodificadorTramas d;
+        verificar(d.alimentar(flujo, largo) == largo, "pegadas", "no acepta el flujo completo");
+        int n = extraer(d, salida, 4 * MAX_LECTURAS_TRAMA);
+        verificar(n == 6 && iguales(salida[0], loteA[0], 10) && iguales(salida[3], loteB[0], 11) &&
+                      iguales(salida[5], loteC[0], 12),
+                  "pegadas", "lecturas u orden distintos");
+        verificar(d.getTramasValidas() == 3 && d.getErroresCRC() == 0 && d.getTramasPerdidas() == 0, "pegadas",
+                  "contadores distintos");
+    }
+
+    // CRC inválido: se pierde solo esa trama y la siguiente llega íntegra
+    {
+        unsigned char flujo[2 * TAM_MAX_TRAMA];
+        std::memcpy(flujo, tramaA, largoA);
+        flujo[TAM_CABECERA_TRAMA + 3] ^= 0x01; // Un bit del valor de la primera lectura
+        std::memcpy(flujo + largoA, tramaB, largoB);
+
+        DecodificadorTramas d;
+        d.alimentar(flujo, largoA + largoB);
+        int n = extraer(d, salida, 4 * MAX_LECTURAS_TRAMA);
+        verificar(n == 2 && iguales(salida[0], loteB[0], 11), "crc", "no se recupera en la trama siguiente");
+        verificar(d.getErroresCRC() == 1 && d.getBytesDescartados() == static_cast<unsigned long>(largoA) &&
+                      d.getTramasValidas() == 1,
+                  "crc", "contadores de resincronizacion distintos");
+
+        // El CRC dañado (no los datos) también se detecta
+        std::memcpy(flujo, tramaC, largoC);
+        flujo[largoC - 1] ^= 0x80;
+        DecodificadorTramas d2;
+        d2.alimentar(flujo, largoC);
+        verificar(extraer(d2, salida, 4) == 0 && d2.getErroresCRC() == 1, "crc", "acepta un CRC alterado");
+    }
+
+    // SYNC sueltos: longitud imposible, longitud plausible sin trama detrás y basura sin SYNC
+    {
+        const unsigned char basura[] = {0x00, 0x13, SYNC_TRAMA, SYNC_TRAMA, 0x00, SYNC_TRAMA, 0x01, 0x07, 0x42};
+        unsigned char flujo[sizeof(basura) + TAM_MAX_TRAMA];
+        std::memcpy(flujo, basura, sizeof(basura));
+        std::memcpy(flujo + sizeof(basura), tramaC, largoC);
+
+        DecodificadorTramas d;
+        d.alimentar(flujo, sizeof(basura) + largoC);
+        int n = extraer(d, salida, 4 * MAX_LECTURAS_TRAMA);
+        verificar(n == 1 && iguales(salida[0], loteC[0], 12), "sync sueltos", "no decodifica la trama tras la basura");
+        // A5 A5 (N = 165), A5 00 (N = 0) y A5 01 (N = 1, CRC falso) se rechazan
+        verificar(d.getErroresCRC() == 3 && d.getBytesDescartados() == sizeof(basura) && d.getTramasValidas() == 1,
+                  "sync sueltos", "contadores de resincronizacion distintos");
+    }
+
+    // SYNC suelto cuya longitud abarca el inicio de una trama real
+    {
+        unsigned char flujo[2 + TAM_MAX_TRAMA];
+        flujo[0] = SYNC_TRAMA;
+        flujo[1] = 0x02;
+        std::memcpy(flujo + 2, tramaA, largoA);
+
+        DecodificadorTramas d;
+        d.alimentar(flujo, 2 + largoA);
+        int n = extraer(d, salida, 4 * MAX_LECTURAS_TRAMA);
+        verificar(n == 3 && iguales(salida[2], loteA[2], 10), "sync solapado", "pierde la trama real");
+        verificar(d.getErroresCRC() == 1 && d.getBytesDescartados() == 2, "sync solapado", "contadores distintos");
+    }
+
+    // Huecos de secuencia (incluido el paso de 65535 a 0)
+    {
+        DecodificadorTramas d;
+        const unsigned short secuencias[] = {65534, 65535, 2, 3};
+        unsigned char trama[TAM_MAX_TRAMA];
+        for (int i = 0; i < 4; i++)
+        {
+            int largo = armarTrama(loteC, 1, secuencias[i], trama);
+            d.alimentar(trama, largo);
+            extraer(d, salida, 4);
+        }
+        verificar(d.getTramasValidas() == 4 && d.getTramasPerdidas() == 2, "secuencia", "huecos mal contados");
+    }
+
+    // Flujo mayor que el buffer: alimentar() acepta parcial y se reintenta tras consumir
+    {
+        const int TRAMAS = 200;
+        unsigned char *flujo = new unsigned char[TRAMAS * TAM_MAX_TRAMA];
+        int largo = 0;
+        LecturaBinaria lote[MAX_LECTURAS_TRAMA];
+        for (int t = 0; t < TRAMAS; t++)
+        {
+            int cantidad = 1 + t % MAX_LECTURAS_TRAMA;
+            for (int i = 0; i < cantidad; i++)
+            {
+                lote[i] = lectura(TRAMA_PRES, static_cast<unsigned short>(1 + i), t * 3 + i);
+            }
+            largo += codificarTrama(lote, cantidad, static_cast<unsigned short>(t), flujo + largo);
+        }
+
+        DecodificadorTramas d;
+        int enviados = 0;
+        int esperadas = 0;
+        int recibidas = 0;
+        bool enOrden = true;
+        LecturaBinaria l;
+        for (int t = 0; t < TRAMAS; t++)
+        {
+            esperadas += 1 + t % MAX_LECTURAS_TRAMA;
+        }
+        while (enviados < largo)
+        {
+            int trozo = (largo - enviados < 700) ? largo - enviados : 700;
+            enviados += d.alimentar(flujo + enviados, trozo);
+            while (d.siguienteLectura(l))
+            {
+                unsigned short t = l.secuencia;
+                enOrden = enOrden && l.valorCrudo == t * 3 + (l.id - 1);
+                recibidas++;
+            }
+        }
+        verificar(recibidas == esperadas && enOrden && d.getTramasValidas() == TRAMAS && d.getTramasPerdidas() == 0,
+                  "buffer lleno", "lecturas perdidas o desordenadas");
+        delete[] flujo;
+    }
+
+    // reiniciar() vacía buffer y contadores
+    {
+        DecodificadorTramas d;
+        d.alimentar(tramaA, largoA - 1);
+        d.reiniciar();
+        d.alimentar(tramaB, largoB);
+        int n = extraer(d, salida, 4);
+        verificar(n == 2 && d.getTramasValidas() == 1 && d.getBytesDescartados() == 0, "reiniciar",
+                  "quedan bytes o contadores de antes");
+    }
+
+    std::cout << (fallos == 0 ? "Verificacion correcta." : "ERROR: el decodificador no entrega lo esperado.")
+              << std::endl;
+    return fallos == 0 ? 0 : 1;
+}